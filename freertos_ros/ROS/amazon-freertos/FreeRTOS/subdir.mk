@@ -6,7 +6,10 @@
 C_SRCS += \
 ../amazon-freertos/FreeRTOS/event_groups.c \
 ../amazon-freertos/FreeRTOS/list.c \
+../amazon-freertos/FreeRTOS/pollset.c \
 ../amazon-freertos/FreeRTOS/queue.c \
+../amazon-freertos/FreeRTOS/rwlock.c \
+../amazon-freertos/FreeRTOS/snapshot.c \
 ../amazon-freertos/FreeRTOS/stream_buffer.c \
 ../amazon-freertos/FreeRTOS/tasks.c \
 ../amazon-freertos/FreeRTOS/timers.c
@@ -14,7 +17,10 @@ C_SRCS += \
 OBJS += \
 ./amazon-freertos/FreeRTOS/event_groups.o \
 ./amazon-freertos/FreeRTOS/list.o \
+./amazon-freertos/FreeRTOS/pollset.o \
 ./amazon-freertos/FreeRTOS/queue.o \
+./amazon-freertos/FreeRTOS/rwlock.o \
+./amazon-freertos/FreeRTOS/snapshot.o \
 ./amazon-freertos/FreeRTOS/stream_buffer.o \
 ./amazon-freertos/FreeRTOS/tasks.o \
 ./amazon-freertos/FreeRTOS/timers.o
@@ -22,16 +28,19 @@ OBJS += \
 C_DEPS += \
 ./amazon-freertos/FreeRTOS/event_groups.d \
 ./amazon-freertos/FreeRTOS/list.d \
+./amazon-freertos/FreeRTOS/pollset.d \
 ./amazon-freertos/FreeRTOS/queue.d \
+./amazon-freertos/FreeRTOS/rwlock.d \
+./amazon-freertos/FreeRTOS/snapshot.d \
 ./amazon-freertos/FreeRTOS/stream_buffer.d \
 ./amazon-freertos/FreeRTOS/tasks.d \
 ./amazon-freertos/FreeRTOS/timers.d
 
 
 # Each subdirectory must supply rules for building sources it contributes
-amazon-freertos/FreeRTOS/%.o: ../amazon-freertos/FreeRTOS/%.c
+amazon-freertos/FreeRTOS/%.o: ../amazon-freertos/FreeRTOS/%.c $(PROFILE_STAMP)
 	@echo 'Building file: $<'
 	@echo 'Invoking: MCU C Compiler'
-	@gcc -fPIC -m64 -std=gnu99 -I../drivers -I../ros/portable -I../amazon-freertos/include -I../source -O0 -g -Wall -c -o "$@" "$<"
+	@gcc -fPIC -m64 -std=gnu99 -I../drivers -I../ros/portable -I../amazon-freertos/include -I../source $(PROFILE_CFLAGS) -Wall -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
@@ -17,9 +17,9 @@ C_DEPS += \
 
 
 # Each subdirectory must supply rules for building sources it contributes
-board/src/%.o: ../board/src/%.c
+board/src/%.o: ../board/src/%.c $(PROFILE_STAMP)
 	@echo 'Building file: $<'
 	@echo 'Invoking: MCU C Compiler'
-	@gcc -fPIC -m64 -std=gnu99 -I../drivers -I../ros/portable -I../amazon-freertos/portable -I../amazon-freertos/include -I../source -O0 -g -Wall -c -o "$@" "$<"
+	@gcc -fPIC -m64 -std=gnu99 -I../drivers -I../ros/portable -I../amazon-freertos/portable -I../amazon-freertos/include -I../source $(PROFILE_CFLAGS) -Wall -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
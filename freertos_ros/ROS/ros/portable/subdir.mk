@@ -5,22 +5,28 @@
 # Add inputs and outputs from these tool invocations to the build variables
 C_SRCS += \
 ../ros/portable/heap_1.c \
-../ros/portable/port.c
+../ros/portable/port.c \
+../ros/portable/port_trace.c \
+../ros/portable/shm_stream_buffer.c
 
 OBJS += \
 ./ros/portable/heap_1.o \
-./ros/portable/port.o
+./ros/portable/port.o \
+./ros/portable/port_trace.o \
+./ros/portable/shm_stream_buffer.o
 
 C_DEPS += \
 ./ros/portable/heap_1.d \
-./ros/portable/port.d
+./ros/portable/port.d \
+./ros/portable/port_trace.d \
+./ros/portable/shm_stream_buffer.d
 
 
 # Each subdirectory must supply rules for building sources it contributes
-ros/portable/%.o: ../ros/portable/%.c
+ros/portable/%.o: ../ros/portable/%.c $(PROFILE_STAMP)
 	@echo 'Building file: $<'
 	@echo 'Invoking: MCU C Compiler'
-	@gcc -fPIC -m64 -std=gnu99 -I../drivers -I../amazon-freertos/portable -I../amazon-freertos/include -I../ros/portable  -I../source -O0 -g -Wall -c -o "$@" "$<"
+	@gcc -fPIC -m64 -std=gnu99 -I../drivers -I../amazon-freertos/portable -I../amazon-freertos/include -I../ros/portable  -I../source $(PROFILE_CFLAGS) -Wall -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
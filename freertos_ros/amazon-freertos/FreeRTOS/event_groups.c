@@ -48,7 +48,12 @@ privileged Vs unprivileged linkage and placement. */
 /* The following bit fields convey control information in a task's event list
 item value.  It is important they don't clash with the
 taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
-#if configUSE_16_BIT_TICKS == 1
+#if( configUSE_64_BIT_EVENT_BITS == 1 )
+	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x0100000000000000ULL
+	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200000000000000ULL
+	#define eventWAIT_FOR_ALL_BITS			0x0400000000000000ULL
+	#define eventEVENT_BITS_CONTROL_BYTES	0xff00000000000000ULL
+#elif configUSE_16_BIT_TICKS == 1
 	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x0100U
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200U
 	#define eventWAIT_FOR_ALL_BITS			0x0400U
@@ -60,6 +65,29 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+/* The number of bits available to the application, below the control bits. */
+#define eventNUM_EVENT_BITS		( ( sizeof( EventBits_t ) * ( size_t ) 8 ) - ( size_t ) 8 )
+
+/* Whether interrupts set or clear bits by pending a function to the timer
+service task. */
+#if( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_64_BIT_EVENT_BITS == 1 ) || ( ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) && ( configEVENT_GROUP_ISR_MAX_WAKES > 0 ) ) ) )
+	#define eventPEND_FROM_ISR		1
+#else
+	#define eventPEND_FROM_ISR		0
+#endif
+
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+	/* Interrupts set bits and unblock tasks themselves, except while a task
+	holds the event group: they then leave the bits to that task. */
+	#define eventLOCK_WAITERS( pxEventBits )		prvLockWaiters( pxEventBits )
+	#define eventUNLOCK_WAITERS( pxEventBits )	prvUnlockWaiters( pxEventBits )
+#else
+	/* Only tasks access the lists of waiting tasks, suspending the scheduler
+	is enough. */
+	#define eventLOCK_WAITERS( pxEventBits )
+	#define eventUNLOCK_WAITERS( pxEventBits )
+#endif
+
 typedef struct xEventGroupDefinition
 {
 	EventBits_t uxEventBits;
@@ -72,6 +100,23 @@ typedef struct xEventGroupDefinition
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
 	#endif
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+		List_t xTasksWaitingForBit[ eventNUM_EVENT_BITS ]; /*< Tasks waiting for one bit, or for all of several bits filed under one that is not set.  xTasksWaitingForBits then only holds the tasks waiting for any of several bits. */
+		EventBits_t uxIndexedBits;		/*< The bits whose list in xTasksWaitingForBit may not be empty. */
+	#endif
+
+	#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		EventBits_t uxDeferredBitsToClear; /*< Bits to clear on exit of tasks unblocked by an interrupt, cleared by the timer service task when it unblocks the tasks the interrupt left. */
+		EventBits_t uxBitsToUnblock;	/*< Bits interrupts set while a task held the event group, set by that task before it releases it. */
+		BaseType_t xWaitersLocked;		/*< pdTRUE while a task accesses the bits and the lists of waiting tasks with interrupts enabled. */
+	#endif
+
+	#if( configUSE_64_BIT_EVENT_BITS == 1 )
+		EventBits_t uxPendedBitsToClear;		/*< Bits interrupts cleared before setting them, cleared first by the timer service task. */
+		EventBits_t uxPendedBitsToSet;			/*< Bits interrupts set, set next by the timer service task. */
+		EventBits_t uxPendedBitsToClearAfter;	/*< Bits interrupts set then cleared, cleared last by the timer service task. */
+	#endif
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
@@ -86,6 +131,75 @@ typedef struct xEventGroupDefinition
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the lists of tasks waiting for bits of a new event group.
+ */
+static void prvInitialiseWaitLists( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the list a task that waits for uxBitsWaitedFor, with the control
+ * bits, is placed on while the bits of the event group are uxCurrentEventBits.
+ */
+static List_t *prvGetWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsWaitedFor, const EventBits_t uxCurrentEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the tasks whose wait condition is met now that uxBitsToSet have
+ * been set, and return the bits they clear on exit.  From a task puxWakes is
+ * NULL.  From an interrupt it holds the number of tasks that may still be
+ * unblocked, and the search stops when it reaches 0.  Returns in
+ * *pxHigherPriorityTaskWoken whether an unblocked task has a priority above
+ * the running task.
+ */
+static EventBits_t prvUnblockTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, UBaseType_t *puxWakes, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * prvUnblockTasks() for the tasks of one list.
+ */
+static EventBits_t prvUnblockTasksOfList( EventGroup_t *pxEventBits, List_t *pxList, UBaseType_t *puxWakes, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * xEventGroupSetBits() with the scheduler suspended and the event group held.
+ */
+static void prvSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	/*
+	 * Called by a task with the scheduler suspended.  From prvLockWaiters() to
+	 * prvUnlockWaiters() interrupts leave the bits and the lists of waiting
+	 * tasks to the task, which sets the bits they set and unblocks their
+	 * tasks before it releases the event group.  Interrupts are only masked
+	 * to hand the event group over, not while the lists are searched.
+	 */
+	static void prvLockWaiters( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+	static void prvUnlockWaiters( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( eventPEND_FROM_ISR == 1 )
+
+	/*
+	 * Pend the setting (xSetBits is pdTRUE) or clearing of uxBits to the timer
+	 * service task from an interrupt.  A pended function is passed 32 bits, so
+	 * with 64-bit event bits the bits are kept in the event group, and the
+	 * timer service task applies all the bits pended since it last ran at
+	 * once.  Returns pdFAIL, and nothing is pended, if the timer command queue
+	 * is full.
+	 */
+	static BaseType_t prvPendBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBits, const BaseType_t xSetBits, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( ( eventPEND_FROM_ISR == 1 ) && ( configUSE_64_BIT_EVENT_BITS == 1 ) )
+
+	/*
+	 * Run by the timer service task: apply the bits prvPendBitsFromISR() kept
+	 * in the event group.
+	 */
+	static void prvPendedBitsCallback( void *pvEventGroup, const uint32_t ulUnused ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,7 +227,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitLists( pxEventBits );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -149,7 +263,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitLists( pxEventBits );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -189,10 +303,11 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventLOCK_WAITERS( pxEventBits );
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
-		( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+		prvSetBits( xEventGroup, uxBitsToSet );
 
 		if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
 		{
@@ -214,7 +329,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), pxEventBits->uxEventBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -231,6 +346,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			}
 		}
 	}
+	eventUNLOCK_WAITERS( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -312,6 +428,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventLOCK_WAITERS( pxEventBits );
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -369,7 +486,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, ( uxBitsToWaitFor | uxControlBits ), uxCurrentEventBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -379,6 +496,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventUNLOCK_WAITERS( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -470,14 +588,14 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_64_BIT_EVENT_BITS == 1 ) ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
 		BaseType_t xReturn;
 
 		traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL );
+		xReturn = prvPendBitsFromISR( xEventGroup, uxBitsToClear, pdFALSE, NULL );
 
 		return xReturn;
 	}
@@ -494,6 +612,13 @@ EventBits_t uxReturn;
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
 		uxReturn = pxEventBits->uxEventBits;
+
+		#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		{
+			/* Include the bits left to the task that holds the event group. */
+			uxReturn |= pxEventBits->uxBitsToUnblock;
+		}
+		#endif
 	}
 	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -503,93 +628,65 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t *pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
+BaseType_t xNoTaskToUnblock = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
-	vTaskSuspendAll();
+	#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
 	{
-		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
-
-		pxListItem = listGET_HEAD_ENTRY( pxList );
-
-		/* Set the bits. */
-		pxEventBits->uxEventBits |= uxBitsToSet;
-
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
+		/* When no waiting task can be unblocked by the bits, they are set
+		with interrupts masked rather than by taking the event group. */
+		taskENTER_CRITICAL();
 		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
-
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+			xNoTaskToUnblock = listLIST_IS_EMPTY( &( pxEventBits->xTasksWaitingForBits ) );
 
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+			#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
 			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+				if( ( pxEventBits->uxIndexedBits & uxBitsToSet ) != ( EventBits_t ) 0 )
 				{
-					xMatchFound = pdTRUE;
+					xNoTaskToUnblock = pdFALSE;
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+			#endif
+
+			if( xNoTaskToUnblock != pdFALSE )
 			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
+				traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+				pxEventBits->uxEventBits |= uxBitsToSet;
+				pxEventBits->uxEventBits &= ~( pxEventBits->uxDeferredBitsToClear );
+				pxEventBits->uxDeferredBitsToClear = 0;
 			}
 			else
 			{
-				/* Need all bits to be set, but not all the bits were set. */
-			}
-
-			if( xMatchFound != pdFALSE )
-			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-				{
-					uxBitsToClear |= uxBitsWaitedFor;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+				mtCOVERAGE_TEST_MARKER();
 			}
-
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
 		}
+		taskEXIT_CRITICAL();
+	}
+	#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
 
-		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-		bit was set in the control word. */
-		pxEventBits->uxEventBits &= ~uxBitsToClear;
+	if( xNoTaskToUnblock == pdFALSE )
+	{
+		vTaskSuspendAll();
+		eventLOCK_WAITERS( pxEventBits );
+		{
+			prvSetBits( xEventGroup, uxBitsToSet );
+		}
+		eventUNLOCK_WAITERS( pxEventBits );
+		( void ) xTaskResumeAll();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
 	}
-	( void ) xTaskResumeAll();
 
 	return pxEventBits->uxEventBits;
 }
@@ -604,13 +701,33 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		eventLOCK_WAITERS( pxEventBits );
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being deleted
+				and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+
+			#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+			{
+			size_t x;
+
+				for( x = 0; x < eventNUM_EVENT_BITS; x++ )
+				{
+					pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ x ] );
+
+					while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+					{
+						vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+				}
+			}
+			#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
 		}
+		eventUNLOCK_WAITERS( pxEventBits );
 
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
@@ -653,6 +770,59 @@ void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToCl
 }
 /*-----------------------------------------------------------*/
 
+#if( ( eventPEND_FROM_ISR == 1 ) && ( configUSE_64_BIT_EVENT_BITS == 1 ) )
+
+	static void prvPendedBitsCallback( void *pvEventGroup, const uint32_t ulUnused )
+	{
+	EventGroup_t *pxEventBits = ( EventGroup_t * ) pvEventGroup;
+	EventBits_t uxBitsToClear, uxBitsToSet, uxBitsToClearAfter;
+
+		( void ) ulUnused;
+
+		taskENTER_CRITICAL();
+		{
+			uxBitsToClear = pxEventBits->uxPendedBitsToClear;
+			uxBitsToSet = pxEventBits->uxPendedBitsToSet;
+			uxBitsToClearAfter = pxEventBits->uxPendedBitsToClearAfter;
+
+			pxEventBits->uxPendedBitsToClear = 0;
+			pxEventBits->uxPendedBitsToSet = 0;
+			pxEventBits->uxPendedBitsToClearAfter = 0;
+		}
+		taskEXIT_CRITICAL();
+
+		/* In the order the interrupts set and cleared each bit. */
+		if( uxBitsToClear != ( EventBits_t ) 0 )
+		{
+			( void ) xEventGroupClearBits( pvEventGroup, uxBitsToClear );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxBitsToSet != ( EventBits_t ) 0 )
+		{
+			( void ) xEventGroupSetBits( pvEventGroup, uxBitsToSet );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxBitsToClearAfter != ( EventBits_t ) 0 )
+		{
+			( void ) xEventGroupClearBits( pvEventGroup, uxBitsToClearAfter );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
 {
 BaseType_t xWaitConditionMet = pdFALSE;
@@ -688,14 +858,408 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvInitialiseWaitLists( EventGroup_t *pxEventBits )
+{
+	vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+	{
+	size_t x;
+
+		for( x = 0; x < eventNUM_EVENT_BITS; x++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForBit[ x ] ) );
+		}
+
+		pxEventBits->uxIndexedBits = 0;
+	}
+	#endif
+
+	#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+	{
+		pxEventBits->uxDeferredBitsToClear = 0;
+		pxEventBits->uxBitsToUnblock = 0;
+		pxEventBits->xWaitersLocked = pdFALSE;
+	}
+	#endif
+
+	#if( configUSE_64_BIT_EVENT_BITS == 1 )
+	{
+		pxEventBits->uxPendedBitsToClear = 0;
+		pxEventBits->uxPendedBitsToSet = 0;
+		pxEventBits->uxPendedBitsToClearAfter = 0;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static List_t *prvGetWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsWaitedFor, const EventBits_t uxCurrentEventBits )
+{
+List_t *pxList = &( pxEventBits->xTasksWaitingForBits );
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+	{
+	EventBits_t uxIndexBits, uxBit;
+	size_t x;
+
+		uxIndexBits = uxBitsWaitedFor & ~eventEVENT_BITS_CONTROL_BYTES;
+
+		if( ( uxBitsWaitedFor & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 )
+		{
+			/* The wait cannot end before the bits that are not set yet are
+			set, so the task only needs to be looked at when one of them is. */
+			uxIndexBits &= ~uxCurrentEventBits;
+		}
+		else if( ( uxIndexBits & ( uxIndexBits - ( EventBits_t ) 1 ) ) != ( EventBits_t ) 0 )
+		{
+			/* Waiting for any of several bits, the task stays on the list
+			that is searched each time bits are set. */
+			uxIndexBits = 0;
+		}
+		else
+		{
+			/* Waiting for a single bit. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( x = 0, uxBit = 1; uxIndexBits != ( EventBits_t ) 0; x++, uxBit <<= 1 )
+		{
+			if( ( uxIndexBits & uxBit ) != ( EventBits_t ) 0 )
+			{
+				pxEventBits->uxIndexedBits |= uxBit;
+				pxList = &( pxEventBits->xTasksWaitingForBit[ x ] );
+				break;
+			}
+		}
+	}
+	#else
+	{
+		( void ) uxBitsWaitedFor;
+		( void ) uxCurrentEventBits;
+	}
+	#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+
+	return pxList;
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvUnblockTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, UBaseType_t *puxWakes, BaseType_t *pxHigherPriorityTaskWoken )
+{
+EventBits_t uxBitsToClear = 0;
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+	{
+	EventBits_t uxBitsToSearch, uxBit;
+	size_t x;
+
+		/* Only the lists of the bits just set can hold tasks whose wait
+		condition is now met. */
+		uxBitsToSearch = uxBitsToSet & pxEventBits->uxIndexedBits;
+
+		for( x = 0, uxBit = 1; uxBitsToSearch != ( EventBits_t ) 0; x++, uxBit <<= 1 )
+		{
+			if( ( uxBitsToSearch & uxBit ) != ( EventBits_t ) 0 )
+			{
+				uxBitsToSearch &= ~uxBit;
+				uxBitsToClear |= prvUnblockTasksOfList( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ x ] ), puxWakes, pxHigherPriorityTaskWoken );
+
+				if( listLIST_IS_EMPTY( &( pxEventBits->xTasksWaitingForBit[ x ] ) ) != pdFALSE )
+				{
+					pxEventBits->uxIndexedBits &= ~uxBit;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+	#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+
+	uxBitsToClear |= prvUnblockTasksOfList( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), puxWakes, pxHigherPriorityTaskWoken );
+
+	return uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvUnblockTasksOfList( EventGroup_t *pxEventBits, List_t *pxList, UBaseType_t *puxWakes, BaseType_t *pxHigherPriorityTaskWoken )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+BaseType_t xMatchFound;
+
+	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	pxListItem = listGET_HEAD_ENTRY( pxList );
+
+	while( pxListItem != pxListEnd )
+	{
+		/* An interrupt leaves the tasks it is not allowed to unblock to the
+		timer service task. */
+		if( ( puxWakes != NULL ) && ( *puxWakes == ( UBaseType_t ) 0 ) )
+		{
+			break;
+		}
+
+		pxNext = listGET_NEXT( pxListItem );
+		uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+		xMatchFound = pdFALSE;
+
+		/* Split the bits waited for from the control bits. */
+		uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+		uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+		if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		{
+			/* Just looking for single bit being set. */
+			if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+			{
+				xMatchFound = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+		{
+			/* All bits are set. */
+			xMatchFound = pdTRUE;
+		}
+		else
+		{
+			/* Need all bits to be set, but not all the bits were set. */
+			#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+			{
+				if( pxList != &( pxEventBits->xTasksWaitingForBits ) )
+				{
+					/* The bit the task was filed under is set, file it under
+					one it still waits for. */
+					( void ) uxListRemove( pxListItem );
+					vListInsertEnd( prvGetWaitList( pxEventBits, uxBitsWaitedFor | uxControlBits, pxEventBits->uxEventBits ), pxListItem );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+		}
+
+		if( xMatchFound != pdFALSE )
+		{
+			/* The bits match.  Should the bits be cleared on exit? */
+			if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+			{
+				uxBitsToClear |= uxBitsWaitedFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Store the actual event flag value in the task's event list
+			item before removing the task from the event list.  The
+			eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+			that is was unblocked due to its required bits matching, rather
+			than because it timed out. */
+			if( puxWakes == NULL )
+			{
+				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+			else
+			{
+				#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+				{
+					if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					( *puxWakes )--;
+				}
+				#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+			}
+		}
+
+		/* Move onto the next list item.  Note pxListItem->pxNext is not
+		used here as the list item may have been removed from the event list
+		and inserted into the ready/pending reading list. */
+		pxListItem = pxNext;
+	}
+
+	return uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
+{
+EventBits_t uxBitsToClear;
+EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+
+	/* Set the bits. */
+	pxEventBits->uxEventBits |= uxBitsToSet;
+
+	/* See if the new bit value should unblock any tasks. */
+	uxBitsToClear = prvUnblockTasks( pxEventBits, uxBitsToSet, NULL, &xHigherPriorityTaskWoken );
+
+	#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+	{
+		/* Also clear the bits of the tasks an interrupt unblocked before it
+		left the others to this function. */
+		uxBitsToClear |= pxEventBits->uxDeferredBitsToClear;
+		pxEventBits->uxDeferredBitsToClear = 0;
+	}
+	#endif
+
+	/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT bit
+	was set in the control word. */
+	pxEventBits->uxEventBits &= ~uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	static void prvLockWaiters( EventGroup_t *pxEventBits )
+	{
+		/* Wait for an interrupt that is unblocking tasks to finish.  After
+		this no interrupt accesses the bits or the lists until the event group
+		is released. */
+		taskENTER_CRITICAL();
+		{
+			pxEventBits->xWaitersLocked = pdTRUE;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvUnlockWaiters( EventGroup_t *pxEventBits )
+	{
+	EventBits_t uxBitsToSet, uxBitsToClear;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				uxBitsToSet = pxEventBits->uxBitsToUnblock;
+				pxEventBits->uxBitsToUnblock = 0;
+
+				if( uxBitsToSet == ( EventBits_t ) 0 )
+				{
+					pxEventBits->xWaitersLocked = pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( uxBitsToSet == ( EventBits_t ) 0 )
+			{
+				break;
+			}
+
+			/* Set the bits the interrupts left, as if they were set after
+			the operation of the task. */
+			pxEventBits->uxEventBits |= uxBitsToSet;
+			uxBitsToClear = prvUnblockTasks( pxEventBits, uxBitsToSet, NULL, &xHigherPriorityTaskWoken );
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
+	UBaseType_t uxSavedInterruptStatus, uxWakes;
+	EventBits_t uxBitsToClear;
+	BaseType_t xReturn = pdPASS, xHigherPriorityTaskWoken = pdFALSE;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+		#if( configEVENT_GROUP_ISR_MAX_WAKES > 0 )
+		{
+			uxWakes = ( UBaseType_t ) configEVENT_GROUP_ISR_MAX_WAKES;
+		}
+		#else
+		{
+			uxWakes = ~( UBaseType_t ) 0;
+		}
+		#endif
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxEventBits->xWaitersLocked != pdFALSE )
+			{
+				/* A task is searching the lists with interrupts enabled.  It
+				sets the bits, and unblocks their tasks, once it is done. */
+				pxEventBits->uxBitsToUnblock |= uxBitsToSet;
+			}
+			else
+			{
+				pxEventBits->uxEventBits |= uxBitsToSet;
+				uxBitsToClear = prvUnblockTasks( pxEventBits, uxBitsToSet, &uxWakes, &xHigherPriorityTaskWoken );
+
+				if( uxWakes != ( UBaseType_t ) 0 )
+				{
+					pxEventBits->uxEventBits &= ~uxBitsToClear;
+				}
+				else
+				{
+					/* There may be more tasks to unblock than the interrupt is
+					allowed to.  The bits stay set for the timer service task to
+					unblock them, and it clears the bits of all on exit. */
+					pxEventBits->uxDeferredBitsToClear |= uxBitsToClear;
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		#if( configEVENT_GROUP_ISR_MAX_WAKES > 0 )
+		{
+			if( uxWakes == ( UBaseType_t ) 0 )
+			{
+				xReturn = prvPendBitsFromISR( xEventGroup, uxBitsToSet, pdTRUE, &xHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#elif ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_64_BIT_EVENT_BITS == 1 ) ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	BaseType_t xReturn;
 
 		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken );
+		xReturn = prvPendBitsFromISR( xEventGroup, uxBitsToSet, pdTRUE, pxHigherPriorityTaskWoken );
 
 		return xReturn;
 	}
@@ -703,6 +1267,72 @@ BaseType_t xWaitConditionMet = pdFALSE;
 #endif
 /*-----------------------------------------------------------*/
 
+#if( eventPEND_FROM_ISR == 1 )
+
+	static BaseType_t prvPendBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBits, const BaseType_t xSetBits, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	BaseType_t xReturn = pdPASS;
+
+		#if( configUSE_64_BIT_EVENT_BITS == 1 )
+		{
+		EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
+		UBaseType_t uxSavedInterruptStatus;
+		BaseType_t xAlreadyPended;
+
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xAlreadyPended = ( ( pxEventBits->uxPendedBitsToClear | pxEventBits->uxPendedBitsToSet | pxEventBits->uxPendedBitsToClearAfter ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE;
+
+				if( xSetBits != pdFALSE )
+				{
+					pxEventBits->uxPendedBitsToSet |= uxBits;
+					pxEventBits->uxPendedBitsToClearAfter &= ~uxBits;
+				}
+				else
+				{
+					/* Bits an earlier interrupt set are cleared once they are
+					set, the others before any bit is set. */
+					pxEventBits->uxPendedBitsToClearAfter |= ( uxBits & pxEventBits->uxPendedBitsToSet );
+					pxEventBits->uxPendedBitsToClear |= ( uxBits & ~( pxEventBits->uxPendedBitsToSet ) );
+				}
+
+				if( xAlreadyPended == pdFALSE )
+				{
+					xReturn = xTimerPendFunctionCallFromISR( prvPendedBitsCallback, ( void * ) xEventGroup, 0UL, pxHigherPriorityTaskWoken );
+
+					if( xReturn == pdFAIL )
+					{
+						/* Keep nothing, so the interrupt can try again. */
+						pxEventBits->uxPendedBitsToClear = 0;
+						pxEventBits->uxPendedBitsToSet = 0;
+						pxEventBits->uxPendedBitsToClearAfter = 0;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* The timer service task has yet to apply the bits pended
+					before, it applies these with them. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#else
+		{
+			xReturn = xTimerPendFunctionCallFromISR( ( xSetBits != pdFALSE ) ? vEventGroupSetBitsCallback : vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBits, pxHigherPriorityTaskWoken );
+		}
+		#endif /* configUSE_64_BIT_EVENT_BITS */
+
+		return xReturn;
+	}
+
+#endif /* eventPEND_FROM_ISR */
+/*-----------------------------------------------------------*/
+
 #if (configUSE_TRACE_FACILITY == 1)
 
 	UBaseType_t uxEventGroupGetNumber( void* xEventGroup )
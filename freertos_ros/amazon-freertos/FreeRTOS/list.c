@@ -30,6 +30,31 @@
 #include "FreeRTOS.h"
 #include "list.h"
 
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+
+	/*
+	 * Link pxNewListItem in the skip index of pxList, in a random number of
+	 * levels, and return the item after which it goes in the list itself.
+	 */
+	static ListItem_t *prvSkipIndexInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Unlink pxItemToRemove from the levels of the skip index it is in.
+	 */
+	static void prvSkipIndexRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The number of levels an item is linked in, each level with a
+	 * probability of one in four of the level below.
+	 */
+	static UBaseType_t prvSkipIndexLevels( void ) PRIVILEGED_FUNCTION;
+
+	/* The state of the xorshift generator that draws the levels.  Lists are
+	only changed with interrupts masked or the scheduler suspended. */
+	static uint32_t ulSkipIndexSeed = 0x2545F491UL;
+
+#endif /* configUSE_LIST_SKIP_INDEX */
+
 /*-----------------------------------------------------------
  * PUBLIC LIST API documented in list.h
  *----------------------------------------------------------*/
@@ -52,6 +77,20 @@ void vListInitialise( List_t * const pxList )
 
 	pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+	{
+	UBaseType_t uxLevel;
+
+		/* The levels of the index are empty. */
+		for( uxLevel = ( UBaseType_t ) 0; uxLevel < ( UBaseType_t ) configLIST_SKIP_LEVELS; uxLevel++ )
+		{
+			pxList->xSkipHeads[ uxLevel ].pxItem = NULL;
+			pxList->xSkipHeads[ uxLevel ].pxNext = NULL;
+			pxList->xSkipHeads[ uxLevel ].pxPrevious = NULL;
+		}
+	}
+	#endif /* configUSE_LIST_SKIP_INDEX */
+
 	/* Write known values into the list if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -64,6 +103,14 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 	/* Make sure the list item is not recorded as being on a list. */
 	pxItem->pvContainer = NULL;
 
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+	{
+		/* The item is only indexed once its owner gives it links. */
+		pxItem->uxSkipLevels = ( UBaseType_t ) 0;
+		pxItem->pxSkipLinks = NULL;
+	}
+	#endif
+
 	/* Write known values into the list item if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_FIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE( pxItem );
@@ -96,6 +143,13 @@ ListItem_t * const pxIndex = pxList->pxIndex;
 	/* Remember which list the item is in. */
 	pxNewListItem->pvContainer = ( void * ) pxList;
 
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+	{
+		/* The list might not be sorted, so the item is not indexed. */
+		pxNewListItem->uxSkipLevels = ( UBaseType_t ) 0;
+	}
+	#endif
+
 	( pxList->uxNumberOfItems )++;
 }
 /*-----------------------------------------------------------*/
@@ -103,7 +157,7 @@ ListItem_t * const pxIndex = pxList->pxIndex;
 void vListInsert( List_t * const pxList, ListItem_t * const pxNewListItem )
 {
 ListItem_t *pxIterator;
-const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+const ListItemValue_t xValueOfInsertion = pxNewListItem->xItemValue;
 
 	/* Only effective when configASSERT() is also defined, these tests may catch
 	the list data structures being overwritten in memory.  They will not catch
@@ -122,6 +176,13 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 	if( xValueOfInsertion == portMAX_DELAY )
 	{
 		pxIterator = pxList->xListEnd.pxPrevious;
+
+		#if( configUSE_LIST_SKIP_INDEX == 1 )
+		{
+			/* Items that never expire are only kept at the end. */
+			pxNewListItem->uxSkipLevels = ( UBaseType_t ) 0;
+		}
+		#endif
 	}
 	else
 	{
@@ -147,7 +208,19 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 			   before vTaskStartScheduler() has been called?).
 		**********************************************************************/
 
-		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		#if( configUSE_LIST_SKIP_INDEX == 1 )
+		{
+			/* Start from the last item the index skips to, whose value is
+			lower or equal. */
+			pxIterator = prvSkipIndexInsert( pxList, pxNewListItem );
+		}
+		#else
+		{
+			pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		}
+		#endif /* configUSE_LIST_SKIP_INDEX */
+
+		for( ; pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext )
 		{
 			/* There is nothing to do here, just iterating to the wanted
 			insertion position. */
@@ -173,6 +246,19 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 item. */
 List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+	{
+		if( pxItemToRemove->uxSkipLevels != ( UBaseType_t ) 0 )
+		{
+			prvSkipIndexRemove( pxItemToRemove );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_LIST_SKIP_INDEX */
+
 	pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
 	pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
 
@@ -196,3 +282,363 @@ List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+
+	static ListItem_t *prvSkipIndexInsert( List_t * const pxList, ListItem_t * const pxNewListItem )
+	{
+	const ListItemValue_t xValueOfInsertion = pxNewListItem->xItemValue;
+	ListSkipLink_t *pxLink, *pxNewLink;
+	ListSkipLink_t *pxPreviousLinks[ configLIST_SKIP_LEVELS ];
+	UBaseType_t uxLevel, uxLevels;
+	ListItem_t *pxReturn;
+
+		/* Find the last link of each level whose next item has a value lower
+		or equal, from the top level down.  The value is read from the item,
+		never kept in the link, so that it is the one the list is searched
+		with even if it was changed in place.  The links of an item, and the
+		heads of the list, are arrays by level, so the link one level down is
+		the previous element. */
+		pxLink = &( pxList->xSkipHeads[ configLIST_SKIP_LEVELS - 1 ] );
+		uxLevel = ( UBaseType_t ) configLIST_SKIP_LEVELS;
+
+		for( ;; )
+		{
+			while( ( pxLink->pxNext != NULL ) && ( pxLink->pxNext->pxItem->xItemValue <= xValueOfInsertion ) )
+			{
+				pxLink = pxLink->pxNext;
+			}
+
+			uxLevel--;
+			pxPreviousLinks[ uxLevel ] = pxLink;
+
+			if( uxLevel == ( UBaseType_t ) 0 )
+			{
+				break;
+			}
+
+			pxLink--;
+		}
+
+		/* The search in the list itself starts from the item of the lowest
+		level link found, or from the list end if that is a head. */
+		if( pxLink->pxItem == NULL )
+		{
+			pxReturn = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		}
+		else
+		{
+			pxReturn = pxLink->pxItem;
+		}
+
+		/* Index the item.  As its value is at least that of the item at each
+		level it goes after, and below that of the next one, the order of the
+		items at every level is the order of the list. */
+		if( ( pxNewListItem->pxSkipLinks != NULL ) && ( pxList->uxNumberOfItems >= ( UBaseType_t ) configLIST_SKIP_MIN_ITEMS ) )
+		{
+			uxLevels = prvSkipIndexLevels();
+		}
+		else
+		{
+			uxLevels = ( UBaseType_t ) 0;
+		}
+
+		for( uxLevel = ( UBaseType_t ) 0; uxLevel < uxLevels; uxLevel++ )
+		{
+			pxLink = pxPreviousLinks[ uxLevel ];
+			pxNewLink = &( pxNewListItem->pxSkipLinks[ uxLevel ] );
+
+			pxNewLink->pxItem = pxNewListItem;
+			pxNewLink->pxNext = pxLink->pxNext;
+			pxNewLink->pxPrevious = pxLink;
+
+			if( pxNewLink->pxNext != NULL )
+			{
+				pxNewLink->pxNext->pxPrevious = pxNewLink;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxLink->pxNext = pxNewLink;
+		}
+
+		pxNewListItem->uxSkipLevels = uxLevels;
+
+		return pxReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSkipIndexRemove( ListItem_t * const pxItemToRemove )
+	{
+	ListSkipLink_t *pxLink;
+	UBaseType_t uxLevel;
+
+		for( uxLevel = ( UBaseType_t ) 0; uxLevel < pxItemToRemove->uxSkipLevels; uxLevel++ )
+		{
+			pxLink = &( pxItemToRemove->pxSkipLinks[ uxLevel ] );
+
+			/* The previous link takes the next item. */
+			pxLink->pxPrevious->pxNext = pxLink->pxNext;
+
+			if( pxLink->pxNext != NULL )
+			{
+				pxLink->pxNext->pxPrevious = pxLink->pxPrevious;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		pxItemToRemove->uxSkipLevels = ( UBaseType_t ) 0;
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvSkipIndexLevels( void )
+	{
+	uint32_t ulRandom;
+	UBaseType_t uxLevels = ( UBaseType_t ) 0;
+
+		ulSkipIndexSeed ^= ulSkipIndexSeed << 13;
+		ulSkipIndexSeed ^= ulSkipIndexSeed >> 17;
+		ulSkipIndexSeed ^= ulSkipIndexSeed << 5;
+		ulRandom = ulSkipIndexSeed;
+
+		/* Each pair of zero bits from the bottom adds a level. */
+		while( ( ( ulRandom & 0x03UL ) == 0UL ) && ( uxLevels < ( UBaseType_t ) configLIST_SKIP_LEVELS ) )
+		{
+			uxLevels++;
+			ulRandom >>= 2;
+		}
+
+		return uxLevels;
+	}
+
+#endif /* configUSE_LIST_SKIP_INDEX */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	#define listWHEEL_SLOT_MASK		( listWHEEL_SLOTS - ( TickType_t ) 1 )
+	#define listWHEEL_ROUND_MASK	( listWHEEL_ROUNDS - ( TickType_t ) 1 )
+
+	#define listWHEEL_MARK( pulMap, uxIndex )		( ( pulMap )[ ( uxIndex ) >> 5 ] |= ( 1UL << ( ( uxIndex ) & 31UL ) ) )
+	#define listWHEEL_UNMARK( pulMap, uxIndex )		( ( pulMap )[ ( uxIndex ) >> 5 ] &= ~( 1UL << ( ( uxIndex ) & 31UL ) ) )
+	#define listWHEEL_IS_MARKED( pulMap, uxIndex )	( ( ( pulMap )[ ( uxIndex ) >> 5 ] & ( 1UL << ( ( uxIndex ) & 31UL ) ) ) != 0UL )
+
+	void vListWheelInitialise( ListWheel_t * const pxWheel, const TickType_t xTime )
+	{
+	UBaseType_t ux;
+
+		pxWheel->xTime = xTime;
+
+		for( ux = 0; ux < ( UBaseType_t ) listWHEEL_SLOTS; ux++ )
+		{
+			vListInitialise( &( pxWheel->xSlots[ ux ] ) );
+		}
+
+		for( ux = 0; ux < ( UBaseType_t ) listWHEEL_ROUNDS; ux++ )
+		{
+			vListInitialise( &( pxWheel->xRounds[ ux ] ) );
+		}
+
+		for( ux = 0; ux < ( sizeof( pxWheel->ulSlotMap ) / sizeof( pxWheel->ulSlotMap[ 0 ] ) ); ux++ )
+		{
+			pxWheel->ulSlotMap[ ux ] = 0UL;
+		}
+
+		for( ux = 0; ux < ( sizeof( pxWheel->ulRoundMap ) / sizeof( pxWheel->ulRoundMap[ 0 ] ) ); ux++ )
+		{
+			pxWheel->ulRoundMap[ ux ] = 0UL;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xListWheelInsert( ListWheel_t * const pxWheel, ListItem_t * const pxNewListItem )
+	{
+	const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( pxNewListItem );
+	TickType_t xTicksToExpiry = xExpiryTime - pxWheel->xTime;
+	UBaseType_t uxIndex;
+	BaseType_t xReturn = pdPASS;
+
+		if( xTicksToExpiry < listWHEEL_SLOTS )
+		{
+			/* The list at the wheel time has already been returned by
+			pxListWheelAdvance(), so an item that is already due goes in the
+			list of the next tick. */
+			if( xTicksToExpiry == ( TickType_t ) 0 )
+			{
+				xTicksToExpiry = ( TickType_t ) 1;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxIndex = ( UBaseType_t ) ( ( pxWheel->xTime + xTicksToExpiry ) & listWHEEL_SLOT_MASK );
+			vListInsertEnd( &( pxWheel->xSlots[ uxIndex ] ), pxNewListItem );
+			listWHEEL_MARK( pxWheel->ulSlotMap, uxIndex );
+		}
+		else if( xTicksToExpiry < listWHEEL_HORIZON )
+		{
+			/* The item expires in a later turn of level 0, and that turn
+			starts before the level 1 list it is placed in is reused.  The
+			index wraps with the tick count as the sizes are powers of 2. */
+			uxIndex = ( UBaseType_t ) ( ( xExpiryTime >> configTIMING_WHEEL_SLOT_BITS ) & listWHEEL_ROUND_MASK );
+			vListInsertEnd( &( pxWheel->xRounds[ uxIndex ] ), pxNewListItem );
+			listWHEEL_MARK( pxWheel->ulRoundMap, uxIndex );
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	List_t *pxListWheelAdvance( ListWheel_t * const pxWheel )
+	{
+	UBaseType_t uxIndex, uxRound;
+	List_t *pxRound;
+	ListItem_t *pxItem;
+
+		( pxWheel->xTime )++;
+		uxIndex = ( UBaseType_t ) ( pxWheel->xTime & listWHEEL_SLOT_MASK );
+
+		if( uxIndex == ( UBaseType_t ) 0 )
+		{
+			/* A new turn of level 0 starts.  Spread the items that expire
+			during it over level 0. */
+			uxRound = ( UBaseType_t ) ( ( pxWheel->xTime >> configTIMING_WHEEL_SLOT_BITS ) & listWHEEL_ROUND_MASK );
+
+			if( listWHEEL_IS_MARKED( pxWheel->ulRoundMap, uxRound ) )
+			{
+				listWHEEL_UNMARK( pxWheel->ulRoundMap, uxRound );
+				pxRound = &( pxWheel->xRounds[ uxRound ] );
+
+				while( listLIST_IS_EMPTY( pxRound ) == pdFALSE )
+				{
+					pxItem = listGET_HEAD_ENTRY( pxRound );
+					( void ) uxListRemove( pxItem );
+					uxRound = ( UBaseType_t ) ( listGET_LIST_ITEM_VALUE( pxItem ) & listWHEEL_SLOT_MASK );
+					vListInsertEnd( &( pxWheel->xSlots[ uxRound ] ), pxItem );
+					listWHEEL_MARK( pxWheel->ulSlotMap, uxRound );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		listWHEEL_UNMARK( pxWheel->ulSlotMap, uxIndex );
+
+		return &( pxWheel->xSlots[ uxIndex ] );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vListWheelMigrate( ListWheel_t * const pxWheel, List_t * const pxList )
+	{
+	ListItem_t *pxItem;
+
+		while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+		{
+			pxItem = listGET_HEAD_ENTRY( pxList );
+
+			if( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxItem ) - pxWheel->xTime ) < listWHEEL_HORIZON )
+			{
+				( void ) uxListRemove( pxItem );
+				( void ) xListWheelInsert( pxWheel, pxItem );
+			}
+			else
+			{
+				/* The list is sorted, so no later item is closer. */
+				break;
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	TickType_t xListWheelGetTicksToNextExpiry( ListWheel_t * const pxWheel, BaseType_t * const pxWheelWasEmpty )
+	{
+	TickType_t xTicks, xReturn = listWHEEL_HORIZON;
+	UBaseType_t uxIndex;
+
+		*pxWheelWasEmpty = pdTRUE;
+
+		/* Level 0 holds one tick per list, so the first list that is not empty
+		gives the exact time.  Clear the marks of lists that have been emptied
+		by uxListRemove() on the way. */
+		for( xTicks = ( TickType_t ) 1; xTicks < listWHEEL_SLOTS; xTicks++ )
+		{
+			uxIndex = ( UBaseType_t ) ( ( pxWheel->xTime + xTicks ) & listWHEEL_SLOT_MASK );
+
+			if( pxWheel->ulSlotMap[ uxIndex >> 5 ] == 0UL )
+			{
+				/* Skip the rest of an empty word of the bitmap. */
+				xTicks += ( TickType_t ) ( 31UL - ( uxIndex & 31UL ) );
+			}
+			else if( listWHEEL_IS_MARKED( pxWheel->ulSlotMap, uxIndex ) )
+			{
+				if( listLIST_IS_EMPTY( &( pxWheel->xSlots[ uxIndex ] ) ) == pdFALSE )
+				{
+					xReturn = xTicks;
+					*pxWheelWasEmpty = pdFALSE;
+					break;
+				}
+				else
+				{
+					listWHEEL_UNMARK( pxWheel->ulSlotMap, uxIndex );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Items in level 1 expire at the start of the next turn at the
+		earliest. */
+		for( uxIndex = 0; uxIndex < ( UBaseType_t ) listWHEEL_ROUNDS; uxIndex++ )
+		{
+			if( listWHEEL_IS_MARKED( pxWheel->ulRoundMap, uxIndex ) )
+			{
+				if( listLIST_IS_EMPTY( &( pxWheel->xRounds[ uxIndex ] ) ) == pdFALSE )
+				{
+					xTicks = listWHEEL_SLOTS - ( pxWheel->xTime & listWHEEL_SLOT_MASK );
+
+					if( xTicks < xReturn )
+					{
+						xReturn = xTicks;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					*pxWheelWasEmpty = pdFALSE;
+					break;
+				}
+				else
+				{
+					listWHEEL_UNMARK( pxWheel->ulRoundMap, uxIndex );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,664 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "pollset.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include poll set functionality.  This #if is closed at the very bottom of
+this file.  If you want to include poll sets then ensure configUSE_POLL_SETS is
+set to 1 in FreeRTOSConfig.h. */
+#if( configUSE_POLL_SETS == 1 )
+
+/* The kinds of source a member stands for. */
+#define pollsetTYPE_QUEUE			( ( uint8_t ) 0 )
+#define pollsetTYPE_STREAM_BUFFER	( ( uint8_t ) 1 )
+#define pollsetTYPE_NOTIFICATION	( ( uint8_t ) 2 )
+
+/* Sources mark their members ready from interrupts, so the lists of a poll set
+are only accessed with interrupts masked. */
+typedef struct xPollSetMember
+{
+	ListItem_t xReadyListItem;				/*< On the ready list of the poll set while the member may be ready, on the list of free members while it is not in use, in no list otherwise. */
+	void *pvSource;							/*< The queue, stream buffer or task, NULL while the member is not in use. */
+	void *pvUserData;
+	struct xPollSetDefinition *pxPollSet;
+	UBaseType_t uxIndex;					/*< The notification index, for a member of type pollsetTYPE_NOTIFICATION. */
+	uint8_t ucType;
+	uint8_t ucMode;							/*< pollsetLEVEL_TRIGGERED or pollsetEDGE_TRIGGERED. */
+} PollSetMember_t;
+
+typedef struct xPollSetDefinition
+{
+	List_t xReadyMembers;					/*< Members sent to since they were last found empty, in the order they became ready. */
+	List_t xFreeMembers;
+	List_t xTasksWaiting;					/*< Tasks waiting for a member to be ready, in priority order. */
+	UBaseType_t uxMembers;
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;		/*< Set to pdTRUE if the poll set is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} PollSet_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise a new poll set with all of its uxMaxMembers members free.
+ */
+static void prvInitialisePollSet( PollSet_t *pxPollSet, PollSetMember_t *pxMembers, UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take a free member of pxPollSet for pvSource, whose pointer to its member is
+ * *ppvSourceMember, and put it on the ready list if the source can be read.
+ * Returns NULL if the source is a member of a poll set already, or cannot be
+ * polled (ppvSourceMember is NULL), or if no member is free.
+ */
+static PollSetMemberHandle_t prvAddMember( PollSet_t * const pxPollSet, void * const pvSource, void ** const ppvSourceMember, const UBaseType_t uxIndex, const uint8_t ucType, const UBaseType_t uxMode, void * const pvUserData ) PRIVILEGED_FUNCTION;
+
+/*
+ * The pointer a source keeps to the member it was added as.
+ */
+static void **prvGetSourceMember( const PollSetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the source of a member can be read now.  Called with
+ * interrupts masked.
+ */
+static BaseType_t prvIsReadable( const PollSetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move up to uxMaxEvents ready members from the ready list to pxEvents, and
+ * return their number.  Members found empty leave the list, and members
+ * returned in level mode go back to its end.  Called with interrupts masked.
+ */
+static UBaseType_t prvCollectReadyMembers( PollSet_t * const pxPollSet, PollSetEvent_t * const pxEvents, const UBaseType_t uxMaxEvents ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	PollSetHandle_t xPollSetCreateStatic( UBaseType_t uxMaxMembers, StaticPollSetMember_t *pxMemberBuffer, StaticPollSet_t *pxPollSetBuffer )
+	{
+	PollSet_t *pxPollSet;
+
+		/* A StaticPollSet_t object and an array of StaticPollSetMember_t
+		objects must be provided. */
+		configASSERT( pxPollSetBuffer );
+		configASSERT( pxMemberBuffer );
+		configASSERT( uxMaxMembers > ( UBaseType_t ) 0 );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structures used to declare
+			variables of type StaticPollSet_t and StaticPollSetMember_t equals
+			the size of the real structures. */
+			volatile size_t xSize = sizeof( StaticPollSet_t );
+			configASSERT( xSize == sizeof( PollSet_t ) );
+			xSize = sizeof( StaticPollSetMember_t );
+			configASSERT( xSize == sizeof( PollSetMember_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		pxPollSet = ( PollSet_t * ) pxPollSetBuffer; /*lint !e740 PollSet_t and StaticPollSet_t are guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		if( pxPollSet != NULL )
+		{
+			prvInitialisePollSet( pxPollSet, ( PollSetMember_t * ) pxMemberBuffer, uxMaxMembers );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note that
+				this poll set was created statically in case it is later
+				deleted. */
+				pxPollSet->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+
+		return ( PollSetHandle_t ) pxPollSet;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	PollSetHandle_t xPollSetCreate( UBaseType_t uxMaxMembers )
+	{
+	PollSet_t *pxPollSet;
+
+		configASSERT( uxMaxMembers > ( UBaseType_t ) 0 );
+
+		/* The members follow the poll set in the same allocation.  The size of
+		PollSet_t is a multiple of the alignment of its pointers, which is that
+		of the members. */
+		pxPollSet = ( PollSet_t * ) pvPortMalloc( sizeof( PollSet_t ) + ( ( size_t ) uxMaxMembers * sizeof( PollSetMember_t ) ) );
+
+		if( pxPollSet != NULL )
+		{
+			prvInitialisePollSet( pxPollSet, ( PollSetMember_t * ) &( pxPollSet[ 1 ] ), uxMaxMembers );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note this
+				poll set was allocated dynamically in case it is later
+				deleted. */
+				pxPollSet->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( PollSetHandle_t ) pxPollSet;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialisePollSet( PollSet_t *pxPollSet, PollSetMember_t *pxMembers, UBaseType_t uxMaxMembers )
+{
+UBaseType_t x;
+
+	vListInitialise( &( pxPollSet->xReadyMembers ) );
+	vListInitialise( &( pxPollSet->xFreeMembers ) );
+	vListInitialise( &( pxPollSet->xTasksWaiting ) );
+	pxPollSet->uxMembers = ( UBaseType_t ) 0;
+
+	for( x = ( UBaseType_t ) 0; x < uxMaxMembers; x++ )
+	{
+		vListInitialiseItem( &( pxMembers[ x ].xReadyListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxMembers[ x ].xReadyListItem ), &( pxMembers[ x ] ) );
+		pxMembers[ x ].pvSource = NULL;
+		pxMembers[ x ].pxPollSet = pxPollSet;
+		vListInsertEnd( &( pxPollSet->xFreeMembers ), &( pxMembers[ x ].xReadyListItem ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPollSetDelete( PollSetHandle_t xPollSet )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+
+	configASSERT( pxPollSet );
+
+	/* The sources point to their members, and the waiting tasks to the list of
+	the poll set. */
+	configASSERT( pxPollSet->uxMembers == ( UBaseType_t ) 0 );
+	configASSERT( listLIST_IS_EMPTY( &( pxPollSet->xTasksWaiting ) ) != pdFALSE );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The poll set can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxPollSet );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The poll set could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxPollSet->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxPollSet );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* The poll set must have been statically allocated, so is not going to
+		be deleted.  Avoid compiler warnings about the unused parameter. */
+		( void ) pxPollSet;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+PollSetMemberHandle_t xPollSetAddQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue, UBaseType_t uxMode, void *pvUserData )
+{
+	configASSERT( xQueue );
+
+	return prvAddMember( ( PollSet_t * ) xPollSet, ( void * ) xQueue, ppvQueueGetPollSetMember( xQueue ), ( UBaseType_t ) 0, pollsetTYPE_QUEUE, uxMode, pvUserData );
+}
+/*-----------------------------------------------------------*/
+
+PollSetMemberHandle_t xPollSetAddStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer, UBaseType_t uxMode, void *pvUserData )
+{
+	configASSERT( xStreamBuffer );
+
+	return prvAddMember( ( PollSet_t * ) xPollSet, ( void * ) xStreamBuffer, ppvStreamBufferGetPollSetMember( xStreamBuffer ), ( UBaseType_t ) 0, pollsetTYPE_STREAM_BUFFER, uxMode, pvUserData );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	PollSetMemberHandle_t xPollSetAddNotification( PollSetHandle_t xPollSet, TaskHandle_t xTask, UBaseType_t uxIndexToWatch, UBaseType_t uxMode, void *pvUserData )
+	{
+		configASSERT( uxIndexToWatch < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		/* The member is checked from other tasks, so it holds the handle of
+		the task rather than NULL. */
+		if( xTask == NULL )
+		{
+			xTask = xTaskGetCurrentTaskHandle();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return prvAddMember( ( PollSet_t * ) xPollSet, ( void * ) xTask, ppvTaskGetPollSetMember( xTask, uxIndexToWatch ), uxIndexToWatch, pollsetTYPE_NOTIFICATION, uxMode, pvUserData );
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+static PollSetMemberHandle_t prvAddMember( PollSet_t * const pxPollSet, void * const pvSource, void ** const ppvSourceMember, const UBaseType_t uxIndex, const uint8_t ucType, const UBaseType_t uxMode, void * const pvUserData )
+{
+PollSetMember_t *pxMember = NULL;
+BaseType_t xYieldRequired = pdFALSE;
+
+	configASSERT( pxPollSet );
+	configASSERT( ( uxMode == pollsetLEVEL_TRIGGERED ) || ( uxMode == pollsetEDGE_TRIGGERED ) );
+
+	/* Sources are sent to from interrupts, which read the pointer to their
+	member with interrupts masked. */
+	taskENTER_CRITICAL();
+	{
+		if( ( ppvSourceMember != NULL ) && ( *ppvSourceMember == NULL ) && ( listLIST_IS_EMPTY( &( pxPollSet->xFreeMembers ) ) == pdFALSE ) )
+		{
+			pxMember = ( PollSetMember_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxPollSet->xFreeMembers ) );
+			( void ) uxListRemove( &( pxMember->xReadyListItem ) );
+
+			pxMember->pvSource = pvSource;
+			pxMember->pvUserData = pvUserData;
+			pxMember->uxIndex = uxIndex;
+			pxMember->ucType = ucType;
+			pxMember->ucMode = ( uint8_t ) uxMode;
+			*ppvSourceMember = ( void * ) pxMember;
+			( pxPollSet->uxMembers )++;
+
+			/* What was sent before the source was added is not lost. */
+			if( prvIsReadable( pxMember ) != pdFALSE )
+			{
+				xYieldRequired = xPollSetMemberReady( pxMember );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( PollSetMemberHandle_t ) pxMember;
+}
+/*-----------------------------------------------------------*/
+
+void vPollSetRemove( PollSetHandle_t xPollSet, PollSetMemberHandle_t xMember )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+PollSetMember_t * const pxMember = ( PollSetMember_t * ) xMember;
+
+	configASSERT( pxPollSet );
+	configASSERT( pxMember );
+	configASSERT( pxMember->pxPollSet == pxPollSet );
+	configASSERT( pxMember->pvSource != NULL );
+
+	taskENTER_CRITICAL();
+	{
+		*prvGetSourceMember( pxMember ) = NULL;
+
+		if( listLIST_ITEM_CONTAINER( &( pxMember->xReadyListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxMember->xReadyListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxMember->pvSource = NULL;
+		vListInsertEnd( &( pxPollSet->xFreeMembers ), &( pxMember->xReadyListItem ) );
+		( pxPollSet->uxMembers )--;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPollSetWait( PollSetHandle_t xPollSet, PollSetEvent_t *pxEvents, UBaseType_t uxMaxEvents, TickType_t xTicksToWait )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+TimeOut_t xTimeOut;
+BaseType_t xEntryTimeSet = pdFALSE;
+BaseType_t xBlocked;
+UBaseType_t uxEvents;
+
+	configASSERT( pxPollSet );
+	configASSERT( pxEvents );
+	configASSERT( uxMaxEvents > ( UBaseType_t ) 0 );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		xBlocked = pdFALSE;
+
+		/* The scheduler is suspended so the task is placed on the list of
+		waiting tasks before a member can be sent to, and interrupts are masked
+		as they send to members too. */
+		vTaskSuspendAll();
+		taskENTER_CRITICAL();
+		{
+			uxEvents = prvCollectReadyMembers( pxPollSet, pxEvents, uxMaxEvents );
+
+			if( uxEvents != ( UBaseType_t ) 0 )
+			{
+				/* Members left ready in level mode are handed to another
+				waiting task, as no send will wake it for them.  It is held
+				pending until the scheduler is resumed. */
+				if( ( listLIST_IS_EMPTY( &( pxPollSet->xReadyMembers ) ) == pdFALSE ) && ( listLIST_IS_EMPTY( &( pxPollSet->xTasksWaiting ) ) == pdFALSE ) )
+				{
+					( void ) xTaskRemoveFromEventList( &( pxPollSet->xTasksWaiting ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* No block time, so give up now. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+				else
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+					xBlocked = pdTRUE;
+				}
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				xBlocked = pdTRUE;
+			}
+			else
+			{
+				/* Timed out. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xBlocked != pdFALSE )
+			{
+				vTaskPlaceOnEventList( &( pxPollSet->xTasksWaiting ), xTicksToWait );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xTaskResumeAll() == pdFALSE )
+		{
+			if( xBlocked != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xBlocked == pdFALSE )
+		{
+			break;
+		}
+		else
+		{
+			/* Unblocked by a send or by the timeout - try again. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxEvents;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPollSetGetMemberCount( PollSetHandle_t xPollSet )
+{
+	configASSERT( xPollSet );
+
+	return ( ( PollSet_t * ) xPollSet )->uxMembers;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPollSetMemberReady( void *pvMember )
+{
+PollSetMember_t * const pxMember = ( PollSetMember_t * ) pvMember;
+PollSet_t * const pxPollSet = pxMember->pxPollSet;
+BaseType_t xReturn = pdFALSE;
+
+	/* A member already on the ready list was sent to since it was last found
+	empty, and a task was woken for it then.  The send costs nothing more. */
+	if( listLIST_ITEM_CONTAINER( &( pxMember->xReadyListItem ) ) == NULL )
+	{
+		vListInsertEnd( &( pxPollSet->xReadyMembers ), &( pxMember->xReadyListItem ) );
+
+		if( listLIST_IS_EMPTY( &( pxPollSet->xTasksWaiting ) ) == pdFALSE )
+		{
+			/* One task per member that becomes ready. */
+			xReturn = xTaskRemoveFromEventList( &( pxPollSet->xTasksWaiting ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void **prvGetSourceMember( const PollSetMember_t * const pxMember )
+{
+void **ppvSourceMember;
+
+	switch( pxMember->ucType )
+	{
+		case pollsetTYPE_QUEUE :
+			ppvSourceMember = ppvQueueGetPollSetMember( ( QueueHandle_t ) pxMember->pvSource );
+			break;
+
+		case pollsetTYPE_STREAM_BUFFER :
+			ppvSourceMember = ppvStreamBufferGetPollSetMember( ( StreamBufferHandle_t ) pxMember->pvSource );
+			break;
+
+		default :
+			#if( configUSE_TASK_NOTIFICATIONS == 1 )
+			{
+				ppvSourceMember = ppvTaskGetPollSetMember( ( TaskHandle_t ) pxMember->pvSource, pxMember->uxIndex );
+			}
+			#else
+			{
+				ppvSourceMember = NULL;
+			}
+			#endif
+			break;
+	}
+
+	configASSERT( ppvSourceMember );
+
+	return ppvSourceMember;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsReadable( const PollSetMember_t * const pxMember )
+{
+BaseType_t xReturn;
+
+	switch( pxMember->ucType )
+	{
+		case pollsetTYPE_QUEUE :
+			/* A semaphore can be taken while its count is not 0. */
+			if( uxQueueMessagesWaitingFromISR( ( QueueHandle_t ) pxMember->pvSource ) != ( UBaseType_t ) 0 )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+			break;
+
+		case pollsetTYPE_STREAM_BUFFER :
+			if( xStreamBufferIsEmpty( ( StreamBufferHandle_t ) pxMember->pvSource ) == pdFALSE )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+			break;
+
+		default :
+			#if( configUSE_TASK_NOTIFICATIONS == 1 )
+			{
+				xReturn = xTaskGenericNotifyIsPending( ( TaskHandle_t ) pxMember->pvSource, pxMember->uxIndex );
+			}
+			#else
+			{
+				xReturn = pdFALSE;
+			}
+			#endif
+			break;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCollectReadyMembers( PollSet_t * const pxPollSet, PollSetEvent_t * const pxEvents, const UBaseType_t uxMaxEvents )
+{
+UBaseType_t uxEvents = ( UBaseType_t ) 0;
+UBaseType_t uxToVisit = listCURRENT_LIST_LENGTH( &( pxPollSet->xReadyMembers ) );
+PollSetMember_t *pxMember;
+
+	/* Each member on the list is visited once at most.  Those returned in
+	level mode go back behind the members not visited yet, so a member that is
+	always ready does not keep the others out.  Members found empty were read
+	since they were sent to, and leave the list until the next send, so the
+	list is only as long as the number of members sent to. */
+	while( ( uxToVisit > ( UBaseType_t ) 0 ) && ( uxEvents < uxMaxEvents ) )
+	{
+		uxToVisit--;
+
+		pxMember = ( PollSetMember_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxPollSet->xReadyMembers ) );
+		( void ) uxListRemove( &( pxMember->xReadyListItem ) );
+
+		if( prvIsReadable( pxMember ) != pdFALSE )
+		{
+			pxEvents[ uxEvents ].xMember = ( PollSetMemberHandle_t ) pxMember;
+			pxEvents[ uxEvents ].pvSource = pxMember->pvSource;
+			pxEvents[ uxEvents ].pvUserData = pxMember->pvUserData;
+			uxEvents++;
+
+			if( pxMember->ucMode == ( uint8_t ) pollsetLEVEL_TRIGGERED )
+			{
+				vListInsertEnd( &( pxPollSet->xReadyMembers ), &( pxMember->xReadyListItem ) );
+			}
+			else
+			{
+				/* Returned once per send in edge mode. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxEvents;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include poll set functionality.  If you want to include poll sets then
+ensure configUSE_POLL_SETS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_POLL_SETS == 1 */
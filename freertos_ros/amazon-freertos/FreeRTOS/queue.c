@@ -41,6 +41,10 @@ task.h is included from an application file. */
 	#include "croutine.h"
 #endif
 
+#if ( configUSE_POLL_SETS == 1 )
+	#include "pollset.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -115,11 +119,26 @@ typedef struct QueueDefinition
 		struct QueueDefinition *pxQueueSetContainer;
 	#endif
 
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvPollSetMember;		/*< The member of a poll set the queue was added as, NULL if none. */
+	#endif
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxQueueNumber;
 		uint8_t ucQueueType;
 	#endif
 
+	#if( configUSE_MUTEX_STATS == 1 )
+		MutexStats_t xMutexStats;	/*< Contention statistics when the structure is used as a mutex. */
+		uint32_t ulTimeTaken;		/*< When the mutex holder took the mutex, in configMUTEX_STATS_TIME() units. */
+	#endif
+
+	#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+		UBaseType_t uxMaxSpins;		/*< The spins of a task that finds the mutex held, before it blocks.  0 for a mutex that is not adaptive. */
+		UBaseType_t uxMaxYields;	/*< The yields of a task that finds the mutex held, before it blocks. */
+		AdaptiveMutexStats_t xAdaptiveStats;
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -223,6 +242,15 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+	/*
+	 * Spin or yield while an adaptive mutex is held by a task that is about to
+	 * give it back, within the limits of the mutex.  Returns pdTRUE if the
+	 * calling task spun or yielded at all.
+	 */
+	static BaseType_t prvSpinOnAdaptiveMutex( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -443,6 +471,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		pxNewQueue->pvPollSetMember = NULL;
+	}
+	#endif /* configUSE_POLL_SETS */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -463,6 +497,23 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.uxRecursiveCallCount = 0;
 
+			#if( configUSE_MUTEX_STATS == 1 )
+			{
+				( void ) memset( &( pxNewQueue->xMutexStats ), 0x00, sizeof( pxNewQueue->xMutexStats ) );
+				pxNewQueue->ulTimeTaken = 0;
+			}
+			#endif
+
+			#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+			{
+				/* Not adaptive unless created by xQueueCreateAdaptiveMutex() or
+				given limits. */
+				pxNewQueue->uxMaxSpins = 0;
+				pxNewQueue->uxMaxYields = 0;
+				( void ) memset( &( pxNewQueue->xAdaptiveStats ), 0x00, sizeof( pxNewQueue->xAdaptiveStats ) );
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
@@ -493,6 +544,69 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_ADAPTIVE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateAdaptiveMutex( void )
+	{
+	QueueHandle_t xNewMutex;
+
+		xNewMutex = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+		if( xNewMutex != NULL )
+		{
+			vQueueSetAdaptiveMutexLimits( xNewMutex, ( UBaseType_t ) configADAPTIVE_MUTEX_MAX_SPINS, ( UBaseType_t ) configADAPTIVE_MUTEX_MAX_YIELDS );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewMutex;
+	}
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+	void vQueueSetAdaptiveMutexLimits( QueueHandle_t xMutex, UBaseType_t uxMaxSpins, UBaseType_t uxMaxYields )
+	{
+	Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		taskENTER_CRITICAL();
+		{
+			pxMutex->uxMaxSpins = uxMaxSpins;
+			pxMutex->uxMaxYields = uxMaxYields;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+	void vQueueGetAdaptiveMutexStats( QueueHandle_t xMutex, AdaptiveMutexStats_t * const pxStats )
+	{
+	Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxStats );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxMutex->xAdaptiveStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
 	QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue )
@@ -543,7 +657,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+#if ( ( configUSE_MUTEXES == 1 ) && ( ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) || ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) ) )
 
 	void* xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
 	{
@@ -569,6 +683,45 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif
 /*-----------------------------------------------------------*/
 
+#if( configUSE_MUTEX_STATS == 1 )
+
+	void vQueueGetMutexStats( QueueHandle_t xMutex, MutexStats_t * const pxStats )
+	{
+	Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxStats );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxMutex->xMutexStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEX_STATS == 1 )
+
+	void vQueueResetMutexStats( QueueHandle_t xMutex )
+	{
+	Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( &( pxMutex->xMutexStats ), 0x00, sizeof( pxMutex->xMutexStats ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_RECURSIVE_MUTEXES == 1 )
 
 	BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
@@ -754,6 +907,28 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				traceQUEUE_SEND( pxQueue );
 				xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
+				#if ( configUSE_POLL_SETS == 1 )
+				{
+					/* The queue can be read, so put it on the ready list of
+					its poll set. */
+					if( pxQueue->pvPollSetMember != NULL )
+					{
+						if( xPollSetMemberReady( pxQueue->pvPollSetMember ) != pdFALSE )
+						{
+							queueYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_POLL_SETS */
+
 				#if ( configUSE_QUEUE_SETS == 1 )
 				{
 					if( pxQueue->pxQueueSetContainer != NULL )
@@ -966,6 +1141,29 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			the scheduler is suspended before accessing the ready lists. */
 			( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
+			#if ( configUSE_POLL_SETS == 1 )
+			{
+				/* Tasks are only placed on the list of a poll set with
+				interrupts masked, so the poll set is updated even when the
+				queue is locked. */
+				if( pxQueue->pvPollSetMember != NULL )
+				{
+					if( ( xPollSetMemberReady( pxQueue->pvPollSetMember ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
+
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
 			if( cTxLock == queueUNLOCKED )
@@ -1131,6 +1329,27 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			messages (semaphores) available. */
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
 
+			#if ( configUSE_POLL_SETS == 1 )
+			{
+				/* As in xQueueGenericSendFromISR(). */
+				if( pxQueue->pvPollSetMember != NULL )
+				{
+					if( ( xPollSetMemberReady( pxQueue->pvPollSetMember ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
+
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
 			if( cTxLock == queueUNLOCKED )
@@ -1390,6 +1609,14 @@ void *pvBuffer = NULL;
 	BaseType_t xInheritanceOccurred = pdFALSE;
 #endif
 
+#if( configUSE_MUTEX_STATS == 1 )
+	uint32_t ulTimeWaitStarted = 0;
+#endif
+
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+	BaseType_t xSpun = pdFALSE;
+#endif
+
 	/* Check the queue pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1405,6 +1632,21 @@ void *pvBuffer = NULL;
 	#endif
 
 
+	/* An adaptive mutex that is held by a task about to give it back is waited
+	for without blocking first. */
+	#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+	{
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( ( pxQueue->uxMaxSpins | pxQueue->uxMaxYields ) != ( UBaseType_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+		{
+			xSpun = prvSpinOnAdaptiveMutex( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_ADAPTIVE_MUTEXES */
+
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
 	of execution time efficiency. */
@@ -1434,6 +1676,37 @@ void *pvBuffer = NULL;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->pxMutexHolder = ( int8_t * ) pvTaskIncrementMutexHeldCount(); /*lint !e961 Cast is not redundant as TaskHandle_t is a typedef. */
+
+						#if( configUSE_MUTEX_STATS == 1 )
+						{
+							pxQueue->ulTimeTaken = configMUTEX_STATS_TIME();
+							( pxQueue->xMutexStats.ulAcquisitions )++;
+
+							/* The entry time is only set once the mutex was
+							found held with a block time. */
+							if( ( xEntryTimeSet != pdFALSE ) && ( ( pxQueue->ulTimeTaken - ulTimeWaitStarted ) > pxQueue->xMutexStats.ulMaxWaitTime ) )
+							{
+								pxQueue->xMutexStats.ulMaxWaitTime = pxQueue->ulTimeTaken - ulTimeWaitStarted;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_MUTEX_STATS */
+
+						#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+						{
+							if( ( xSpun != pdFALSE ) && ( xEntryTimeSet == pdFALSE ) )
+							{
+								( pxQueue->xAdaptiveStats.ulAcquiredWithoutBlocking )++;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_ADAPTIVE_MUTEXES */
 					}
 					else
 					{
@@ -1488,6 +1761,33 @@ void *pvBuffer = NULL;
 					so configure the timeout structure ready to block. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if( configUSE_MUTEX_STATS == 1 )
+					{
+						if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+						{
+							ulTimeWaitStarted = configMUTEX_STATS_TIME();
+							( pxQueue->xMutexStats.ulContendedWaits )++;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_MUTEX_STATS */
+
+					#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+					{
+						if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( ( pxQueue->uxMaxSpins | pxQueue->uxMaxYields ) != ( UBaseType_t ) 0 ) )
+						{
+							( pxQueue->xAdaptiveStats.ulFallbacks )++;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_ADAPTIVE_MUTEXES */
 				}
 				else
 				{
@@ -1521,6 +1821,12 @@ void *pvBuffer = NULL;
 					{
 						taskENTER_CRITICAL();
 						{
+							#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+							{
+								vTaskSetMutexWaitedFor( ( void * ) pxQueue );
+							}
+							#endif
+
 							xInheritanceOccurred = xTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
 						}
 						taskEXIT_CRITICAL();
@@ -1542,6 +1848,14 @@ void *pvBuffer = NULL;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+				{
+					/* No longer blocked on the mutex, whether it was given, the
+					wait timed out or was aborted. */
+					vTaskSetMutexWaitedFor( NULL );
+				}
+				#endif
 			}
 			else
 			{
@@ -1947,6 +2261,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	configASSERT( pxQueue );
 	traceQUEUE_DELETE( pxQueue );
 
+	/* A queue must be removed from its poll set before it is deleted. */
+	#if ( configUSE_POLL_SETS == 1 )
+	{
+		configASSERT( pxQueue->pvPollSetMember == NULL );
+	}
+	#endif
+
 	#if ( configQUEUE_REGISTRY_SIZE > 0 )
 	{
 		vQueueUnregisterQueue( pxQueue );
@@ -2012,6 +2333,70 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+	static BaseType_t prvSpinOnAdaptiveMutex( Queue_t * const pxQueue )
+	{
+	UBaseType_t uxSpins = 0, uxYields = 0;
+	eMutexHolderState eHolderState;
+
+		/* The count is read without a critical section while spinning, the
+		take that follows checks it again. */
+		while( portLOAD_ACQUIRE( &( pxQueue->uxMessagesWaiting ) ) == ( UBaseType_t ) 0 )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Tasks that already block for the mutex get it first, so as
+				not to starve them. */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					eHolderState = eTaskGetMutexHolderState( ( void * ) pxQueue->pxMutexHolder );
+				}
+				else
+				{
+					eHolderState = eHolderBlocked;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( eHolderState == eHolderRunning ) && ( uxSpins < pxQueue->uxMaxSpins ) )
+			{
+				portSPIN_PAUSE();
+				uxSpins++;
+			}
+			else if( ( eHolderState == eHolderReady ) && ( uxYields < pxQueue->uxMaxYields ) )
+			{
+				/* On a single core the holder was preempted with the mutex,
+				let it run on to the give. */
+				taskYIELD();
+				uxYields++;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		if( ( uxSpins | uxYields ) != ( UBaseType_t ) 0 )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxQueue->xAdaptiveStats.ulSpins += ( uint32_t ) uxSpins;
+				pxQueue->xAdaptiveStats.ulYields += ( uint32_t ) uxYields;
+			}
+			taskEXIT_CRITICAL();
+
+			return pdTRUE;
+		}
+		else
+		{
+			return pdFALSE;
+		}
+	}
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_MUTEXES == 1 )
 
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
@@ -2054,6 +2439,23 @@ UBaseType_t uxMessagesWaiting;
 		{
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
+				#if( configUSE_MUTEX_STATS == 1 )
+				{
+				const uint32_t ulTimeHeld = configMUTEX_STATS_TIME() - pxQueue->ulTimeTaken;
+
+					/* The mutex is given once when it is created, before it is
+					held. */
+					if( ( pxQueue->pxMutexHolder != NULL ) && ( ulTimeHeld > pxQueue->xMutexStats.ulMaxHoldTime ) )
+					{
+						pxQueue->xMutexStats.ulMaxHoldTime = ulTimeHeld;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_MUTEX_STATS */
+
 				/* The mutex is no longer being held. */
 				xReturn = xTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
 				pxQueue->pxMutexHolder = NULL;
@@ -2761,6 +3163,13 @@ BaseType_t xReturn;
 				/* Cannot add a queue/semaphore to more than one queue set. */
 				xReturn = pdFAIL;
 			}
+			#if ( configUSE_POLL_SETS == 1 )
+			else if( ( ( Queue_t * ) xQueueOrSemaphore )->pvPollSetMember != NULL )
+			{
+				/* Nor to a queue set and a poll set. */
+				xReturn = pdFAIL;
+			}
+			#endif
 			else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
 			{
 				/* Cannot add a queue/semaphore to a queue set if there are already
@@ -2897,6 +3306,34 @@ BaseType_t xReturn;
 	}
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POLL_SETS == 1 )
+
+	void **ppvQueueGetPollSetMember( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		/* A queue in a queue set cannot also be in a poll set. */
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			if( pxQueue->pxQueueSetContainer != NULL )
+			{
+				return NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		return &( pxQueue->pvPollSetMember );
+	}
+
+#endif /* configUSE_POLL_SETS */
 
 
 
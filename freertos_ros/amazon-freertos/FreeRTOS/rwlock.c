@@ -0,0 +1,747 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* Interrupts take and give locks, so the state of a lock and its lists of
+waiting tasks are only accessed with interrupts masked. */
+typedef struct xRWLockDefinition
+{
+	volatile UBaseType_t uxReaders;			/*< The number of tasks and interrupts holding the lock for reading. */
+	volatile UBaseType_t uxWritersWaiting;	/*< The number of tasks waiting for the write lock, including those unblocked that have not taken it yet.  Readers wait while it is not 0. */
+	TaskHandle_t xWriter;					/*< The task holding the lock for writing, NULL if none or if an interrupt holds it. */
+	volatile BaseType_t xWriteLocked;		/*< pdTRUE while the lock is held for writing. */
+	List_t xTasksWaitingToRead;				/*< Tasks waiting for the read lock, in priority order. */
+	List_t xTasksWaitingToWrite;			/*< Tasks waiting for the write lock, in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;		/*< Set to pdTRUE if the lock is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise a new lock, free.
+ */
+static void prvInitialiseRWLock( RWLock_t *pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take the lock for writing (xWrite is pdTRUE) or for reading, waiting for up
+ * to xTicksToWait ticks.  Shared by xRWLockTakeRead() and xRWLockTakeWrite().
+ */
+static BaseType_t prvTakeLock( RWLock_t * const pxRWLock, const BaseType_t xWrite, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the tasks that can take the lock now it was given back by the last
+ * reader or by the writer: the highest priority waiting writer or, when no
+ * writer waits, all the waiting readers.  Called with interrupts masked, from
+ * a task or from an interrupt.  Returns pdTRUE if an unblocked task has a
+ * priority above the running task.
+ */
+static BaseType_t prvUnblockWaitingTasks( RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_MUTEXES == 1 )
+
+	/*
+	 * The priority of the highest priority task waiting for the lock, for the
+	 * writer to drop to when a task that passed its priority on times out.
+	 */
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer )
+	{
+	RWLock_t *pxRWLock;
+
+		/* A StaticRWLock_t object must be provided. */
+		configASSERT( pxRWLockBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticRWLock_t equals the size of the real lock
+			structure. */
+			volatile size_t xSize = sizeof( StaticRWLock_t );
+			configASSERT( xSize == sizeof( RWLock_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		pxRWLock = ( RWLock_t * ) pxRWLockBuffer; /*lint !e740 RWLock_t and StaticRWLock_t are guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		if( pxRWLock != NULL )
+		{
+			prvInitialiseRWLock( pxRWLock );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note that
+				this lock was created statically in case it is later deleted. */
+				pxRWLock->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+
+		return ( RWLockHandle_t ) pxRWLock;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreate( void )
+	{
+	RWLock_t *pxRWLock;
+
+		pxRWLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) );
+
+		if( pxRWLock != NULL )
+		{
+			prvInitialiseRWLock( pxRWLock );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note this
+				lock was allocated dynamically in case it is later deleted. */
+				pxRWLock->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( RWLockHandle_t ) pxRWLock;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseRWLock( RWLock_t *pxRWLock )
+{
+	pxRWLock->uxReaders = ( UBaseType_t ) 0;
+	pxRWLock->uxWritersWaiting = ( UBaseType_t ) 0;
+	pxRWLock->xWriter = NULL;
+	pxRWLock->xWriteLocked = pdFALSE;
+	vListInitialise( &( pxRWLock->xTasksWaitingToRead ) );
+	vListInitialise( &( pxRWLock->xTasksWaitingToWrite ) );
+}
+/*-----------------------------------------------------------*/
+
+void vRWLockDelete( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+
+	configASSERT( pxRWLock );
+
+	/* A lock that is held or waited for cannot be deleted. */
+	configASSERT( ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) && ( pxRWLock->xWriteLocked == pdFALSE ) );
+	configASSERT( pxRWLock->uxWritersWaiting == ( UBaseType_t ) 0 );
+	configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) != pdFALSE );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The lock can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxRWLock );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The lock could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxRWLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxRWLock );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* The lock must have been statically allocated, so is not going to be
+		deleted.  Avoid compiler warnings about the unused parameter. */
+		( void ) pxRWLock;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+	return prvTakeLock( ( RWLock_t * ) xRWLock, pdFALSE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+	return prvTakeLock( ( RWLock_t * ) xRWLock, pdTRUE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeLock( RWLock_t * const pxRWLock, const BaseType_t xWrite, TickType_t xTicksToWait )
+{
+TimeOut_t xTimeOut;
+BaseType_t xEntryTimeSet = pdFALSE;
+BaseType_t xBlocked, xYieldRequired, xReturn = pdFAIL;
+List_t * const pxWaitList = ( xWrite != pdFALSE ) ? &( pxRWLock->xTasksWaitingToWrite ) : &( pxRWLock->xTasksWaitingToRead );
+
+#if( configUSE_MUTEXES == 1 )
+	BaseType_t xInheritanceOccurred = pdFALSE;
+#endif
+
+	configASSERT( pxRWLock );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		xBlocked = pdFALSE;
+		xYieldRequired = pdFALSE;
+
+		/* The scheduler is suspended so the task is placed on the list of
+		waiting tasks before another task can give the lock, and interrupts are
+		masked as they can give the lock too. */
+		vTaskSuspendAll();
+		taskENTER_CRITICAL();
+		{
+			if( xWrite != pdFALSE )
+			{
+				/* A task taking a lock it holds for writing would wait for
+				itself. */
+				#if( configUSE_MUTEXES == 1 )
+				{
+					configASSERT( pxRWLock->xWriter != xTaskGetCurrentTaskHandle() );
+				}
+				#endif
+
+				if( ( pxRWLock->xWriteLocked == pdFALSE ) && ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) )
+				{
+					pxRWLock->xWriteLocked = pdTRUE;
+
+					#if( configUSE_MUTEXES == 1 )
+					{
+						/* Record the writer to pass priorities on to, as the
+						holder of a mutex. */
+						pxRWLock->xWriter = ( TaskHandle_t ) pvTaskIncrementMutexHeldCount();
+					}
+					#endif
+
+					if( xEntryTimeSet != pdFALSE )
+					{
+						( pxRWLock->uxWritersWaiting )--;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xReturn = pdPASS;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Writer preference - readers also wait for the writers that
+				wait. */
+				if( ( pxRWLock->xWriteLocked == pdFALSE ) && ( pxRWLock->uxWritersWaiting == ( UBaseType_t ) 0 ) )
+				{
+					( pxRWLock->uxReaders )++;
+					xReturn = pdPASS;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( xReturn != pdFAIL )
+			{
+				/* The lock was taken. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* No block time, so give up now. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+				else
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+
+					if( xWrite != pdFALSE )
+					{
+						( pxRWLock->uxWritersWaiting )++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xBlocked = pdTRUE;
+				}
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				xBlocked = pdTRUE;
+			}
+			else
+			{
+				/* Timed out.  A writer that gives up may have been the last
+				writer keeping the readers out. */
+				if( xWrite != pdFALSE )
+				{
+					( pxRWLock->uxWritersWaiting )--;
+
+					if( ( pxRWLock->uxWritersWaiting == ( UBaseType_t ) 0 ) && ( pxRWLock->xWriteLocked == pdFALSE ) )
+					{
+						xYieldRequired = prvUnblockWaitingTasks( pxRWLock );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The writer only keeps the priority of the tasks still
+				waiting. */
+				#if( configUSE_MUTEXES == 1 )
+				{
+					if( xInheritanceOccurred != pdFALSE )
+					{
+						vTaskPriorityDisinheritAfterTimeout( pxRWLock->xWriter, prvGetDisinheritPriorityAfterTimeout( pxRWLock ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_MUTEXES */
+			}
+
+			if( xBlocked != pdFALSE )
+			{
+				#if( configUSE_MUTEXES == 1 )
+				{
+					/* Pass the priority of the calling task on to the writer,
+					if a task holds the lock for writing. */
+					if( ( pxRWLock->xWriteLocked != pdFALSE ) && ( pxRWLock->xWriter != NULL ) )
+					{
+						xInheritanceOccurred |= xTaskPriorityInherit( pxRWLock->xWriter );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_MUTEXES */
+
+				vTaskPlaceOnEventList( pxWaitList, xTicksToWait );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xTaskResumeAll() == pdFALSE )
+		{
+			if( ( xBlocked != pdFALSE ) || ( xYieldRequired != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xBlocked == pdFALSE )
+		{
+			break;
+		}
+		else
+		{
+			/* Unblocked by a give or by the timeout - try again. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xYieldRequired = pdFALSE, xReturn = pdFAIL;
+
+	configASSERT( pxRWLock );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxRWLock->uxReaders > ( UBaseType_t ) 0 )
+		{
+			( pxRWLock->uxReaders )--;
+
+			if( pxRWLock->uxReaders == ( UBaseType_t ) 0 )
+			{
+				xYieldRequired = prvUnblockWaitingTasks( pxRWLock );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xYieldRequired = pdFALSE, xReturn = pdFAIL;
+
+	configASSERT( pxRWLock );
+
+	taskENTER_CRITICAL();
+	{
+		#if( configUSE_MUTEXES == 1 )
+			if( ( pxRWLock->xWriteLocked != pdFALSE ) && ( pxRWLock->xWriter == xTaskGetCurrentTaskHandle() ) )
+		#else
+			if( pxRWLock->xWriteLocked != pdFALSE )
+		#endif
+		{
+			pxRWLock->xWriteLocked = pdFALSE;
+
+			#if( configUSE_MUTEXES == 1 )
+			{
+				/* Drop the priority inherited through the lock, as for a
+				mutex. */
+				pxRWLock->xWriter = NULL;
+				xYieldRequired = xTaskPriorityDisinherit( xTaskGetCurrentTaskHandle() );
+			}
+			#endif /* configUSE_MUTEXES */
+
+			xYieldRequired |= prvUnblockWaitingTasks( pxRWLock );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTryTakeReadFromISR( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxRWLock );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( pxRWLock->xWriteLocked == pdFALSE ) && ( pxRWLock->uxWritersWaiting == ( UBaseType_t ) 0 ) )
+		{
+			( pxRWLock->uxReaders )++;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTryTakeWriteFromISR( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxRWLock );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( pxRWLock->xWriteLocked == pdFALSE ) && ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) )
+		{
+			/* No task holds the lock, so there is no writer to pass a
+			priority on to. */
+			pxRWLock->xWriteLocked = pdTRUE;
+			pxRWLock->xWriter = NULL;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxRWLock );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxRWLock->uxReaders > ( UBaseType_t ) 0 )
+		{
+			( pxRWLock->uxReaders )--;
+
+			if( ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) && ( prvUnblockWaitingTasks( pxRWLock ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveWriteFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxRWLock );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* Only a lock taken by an interrupt has no writer. */
+		if( ( pxRWLock->xWriteLocked != pdFALSE ) && ( pxRWLock->xWriter == NULL ) )
+		{
+			pxRWLock->xWriteLocked = pdFALSE;
+
+			if( ( prvUnblockWaitingTasks( pxRWLock ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+
+	configASSERT( pxRWLock );
+
+	return pxRWLock->uxReaders;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingTasks( RWLock_t * const pxRWLock )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) == pdFALSE )
+	{
+		/* The unblocked writer still counts as waiting until it takes the
+		lock, so no reader gets in before it. */
+		xHigherPriorityTaskWoken = xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToWrite ) );
+	}
+	else if( pxRWLock->uxWritersWaiting == ( UBaseType_t ) 0 )
+	{
+		while( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToRead ) ) != pdFALSE )
+			{
+				xHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	else
+	{
+		/* A writer that was unblocked before is about to take the lock. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEXES == 1 )
+
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t * const pxRWLock )
+	{
+	UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+	UBaseType_t uxPriority;
+
+		/* Both lists are in priority order, so the highest priority task
+		waiting is at the head of one of them. */
+		if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToRead ) ) > 0 )
+		{
+			uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToRead ) ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToWrite ) ) > 0 )
+		{
+			uxPriority = ( UBaseType_t ) ( configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToWrite ) ) );
+
+			if( uxPriority > uxHighestPriorityOfWaitingTasks )
+			{
+				uxHighestPriorityOfWaitingTasks = uxPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxHighestPriorityOfWaitingTasks;
+	}
+
+#endif /* configUSE_MUTEXES */
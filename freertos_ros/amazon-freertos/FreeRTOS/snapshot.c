@@ -0,0 +1,591 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "snapshot.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The value of uxWriting while no buffer is being written. */
+#define snapshotNOT_WRITING			( ( UBaseType_t ) configSNAPSHOT_MAX_BUFFERS )
+
+/* The size of the structure, rounded up so the buffers that follow it in the
+same allocation are aligned. */
+#define snapshotHEADER_SIZE			( ( sizeof( Snapshot_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The readers of a buffer are counted without masking interrupts if the port
+can change the count atomically, as threads that are not tasks read snapshots
+too. */
+#if( defined( portFETCH_AND_INCREMENT ) && defined( portFETCH_AND_DECREMENT ) )
+	#define snapshotPIN( pulReaders )		( void ) portFETCH_AND_INCREMENT( pulReaders )
+	#define snapshotUNPIN( pulReaders )		( void ) portFETCH_AND_DECREMENT( pulReaders )
+#else
+	#define snapshotPIN( pulReaders )		prvChangeReaders( ( pulReaders ), pdTRUE )
+	#define snapshotUNPIN( pulReaders )		prvChangeReaders( ( pulReaders ), pdFALSE )
+#endif
+
+typedef struct xSnapshotDefinition
+{
+	size_t xSnapshotSize;				/*< The number of bytes of a value. */
+	size_t xBufferStride;				/*< The number of bytes between two buffers, xSnapshotSize rounded up to the alignment. */
+	UBaseType_t uxBuffers;				/*< 1 for a sequence lock. */
+	volatile UBaseType_t uxLatest;		/*< The buffer that holds the latest value. */
+	UBaseType_t uxWriting;				/*< The buffer between pvSnapshotWriteBegin() and ulSnapshotWriteEnd(), or snapshotNOT_WRITING. */
+	volatile uint32_t ulSequence;		/*< With one buffer, twice the version, odd while a value is written.  Otherwise the version of the latest value. */
+	volatile uint32_t ulReaders[ configSNAPSHOT_MAX_BUFFERS ];	/*< The number of readers that pin each buffer. */
+	uint32_t ulVersions[ configSNAPSHOT_MAX_BUFFERS ];			/*< The version of the value in each buffer. */
+	uint8_t *pucBuffers;				/*< The uxBuffers buffers of the values. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the snapshot is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} Snapshot_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise a new snapshot, with a value of all zeros.
+ */
+static void prvInitialiseNewSnapshot( Snapshot_t * const pxSnapshot, size_t xSnapshotSizeBytes, UBaseType_t uxBuffers, uint8_t * const pucBuffers ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write a value to a sequence lock.  Called with interrupts masked.
+ */
+static void prvWriteSequenceLock( Snapshot_t * const pxSnapshot, const void *pvValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pin the buffer of the latest value of a snapshot of two or more buffers, so
+ * it is not written until it is unpinned, and return its index.  Adds the
+ * number of times the buffer was replaced while it was pinned to *puxRetries.
+ */
+static UBaseType_t prvPinLatest( Snapshot_t * const pxSnapshot, UBaseType_t * const puxRetries ) PRIVILEGED_FUNCTION;
+
+#if( !( defined( portFETCH_AND_INCREMENT ) && defined( portFETCH_AND_DECREMENT ) ) )
+
+	/*
+	 * Add one reader (xPin is pdTRUE) to or remove one from *pulReaders with
+	 * interrupts masked.
+	 */
+	static void prvChangeReaders( volatile uint32_t * const pulReaders, const BaseType_t xPin ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	SnapshotHandle_t xSnapshotCreate( size_t xSnapshotSizeBytes, UBaseType_t uxBuffers )
+	{
+	Snapshot_t *pxSnapshot;
+
+		configASSERT( xSnapshotSizeBytes > ( size_t ) 0 );
+		configASSERT( ( uxBuffers > ( UBaseType_t ) 0 ) && ( uxBuffers <= ( UBaseType_t ) configSNAPSHOT_MAX_BUFFERS ) );
+
+		/* The buffers follow the structure in the same allocation. */
+		pxSnapshot = ( Snapshot_t * ) pvPortMalloc( snapshotHEADER_SIZE + snapshotSTORAGE_SIZE_BYTES( xSnapshotSizeBytes, uxBuffers ) );
+
+		if( pxSnapshot != NULL )
+		{
+			prvInitialiseNewSnapshot( pxSnapshot, xSnapshotSizeBytes, uxBuffers, ( ( uint8_t * ) pxSnapshot ) + snapshotHEADER_SIZE );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note this
+				snapshot was allocated dynamically in case it is later
+				deleted. */
+				pxSnapshot->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( SnapshotHandle_t ) pxSnapshot;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	SnapshotHandle_t xSnapshotCreateStatic( size_t xSnapshotSizeBytes, UBaseType_t uxBuffers, uint8_t *pucSnapshotStorageArea, StaticSnapshot_t *pxStaticSnapshot )
+	{
+	Snapshot_t * const pxSnapshot = ( Snapshot_t * ) pxStaticSnapshot; /*lint !e740 Snapshot_t and StaticSnapshot_t are guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		configASSERT( pucSnapshotStorageArea );
+		configASSERT( pxStaticSnapshot );
+		configASSERT( xSnapshotSizeBytes > ( size_t ) 0 );
+		configASSERT( ( uxBuffers > ( UBaseType_t ) 0 ) && ( uxBuffers <= ( UBaseType_t ) configSNAPSHOT_MAX_BUFFERS ) );
+		configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucSnapshotStorageArea ) & ( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) == 0 );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticSnapshot_t equals the size of the real
+			snapshot structure. */
+			volatile size_t xSize = sizeof( StaticSnapshot_t );
+			configASSERT( xSize == sizeof( Snapshot_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pucSnapshotStorageArea != NULL ) && ( pxStaticSnapshot != NULL ) )
+		{
+			prvInitialiseNewSnapshot( pxSnapshot, xSnapshotSizeBytes, uxBuffers, pucSnapshotStorageArea );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note that
+				this snapshot was created statically in case it is later
+				deleted. */
+				pxSnapshot->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			return ( SnapshotHandle_t ) pxSnapshot;
+		}
+		else
+		{
+			return NULL;
+		}
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSnapshot( Snapshot_t * const pxSnapshot, size_t xSnapshotSizeBytes, UBaseType_t uxBuffers, uint8_t * const pucBuffers )
+{
+	( void ) memset( ( void * ) pxSnapshot, 0x00, sizeof( Snapshot_t ) );
+	( void ) memset( ( void * ) pucBuffers, 0x00, snapshotSTORAGE_SIZE_BYTES( xSnapshotSizeBytes, uxBuffers ) );
+
+	pxSnapshot->xSnapshotSize = xSnapshotSizeBytes;
+	pxSnapshot->xBufferStride = snapshotSTORAGE_SIZE_BYTES( xSnapshotSizeBytes, 1 );
+	pxSnapshot->uxBuffers = uxBuffers;
+	pxSnapshot->uxLatest = ( UBaseType_t ) 0;
+	pxSnapshot->uxWriting = snapshotNOT_WRITING;
+	pxSnapshot->pucBuffers = pucBuffers;
+}
+/*-----------------------------------------------------------*/
+
+void vSnapshotDelete( SnapshotHandle_t xSnapshot )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+UBaseType_t x;
+
+	configASSERT( pxSnapshot );
+
+	/* A snapshot that is read or written cannot be deleted. */
+	configASSERT( pxSnapshot->uxWriting == snapshotNOT_WRITING );
+
+	for( x = 0; x < pxSnapshot->uxBuffers; x++ )
+	{
+		configASSERT( pxSnapshot->ulReaders[ x ] == 0U );
+	}
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The snapshot can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxSnapshot );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The snapshot could have been allocated statically or dynamically,
+		so check before attempting to free the memory. */
+		if( pxSnapshot->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxSnapshot );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* The snapshot must have been statically allocated, so is not going
+		to be deleted.  Avoid compiler warnings about the unused parameter. */
+		( void ) pxSnapshot;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSnapshotWrite( SnapshotHandle_t xSnapshot, const void *pvValue )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+BaseType_t xReturn = pdPASS;
+void *pvBuffer;
+
+	configASSERT( pxSnapshot );
+	configASSERT( pvValue );
+
+	if( pxSnapshot->uxBuffers == ( UBaseType_t ) 1 )
+	{
+		/* Tasks and interrupts never find a sequence lock being written, only
+		readers that run beside the kernel can. */
+		taskENTER_CRITICAL();
+		{
+			prvWriteSequenceLock( pxSnapshot, pvValue );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		pvBuffer = pvSnapshotWriteBegin( xSnapshot );
+
+		if( pvBuffer != NULL )
+		{
+			( void ) memcpy( pvBuffer, pvValue, pxSnapshot->xSnapshotSize );
+			( void ) ulSnapshotWriteEnd( xSnapshot );
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSnapshotWriteFromISR( SnapshotHandle_t xSnapshot, const void *pvValue )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+BaseType_t xReturn = pdPASS;
+UBaseType_t uxSavedInterruptStatus;
+void *pvBuffer;
+
+	configASSERT( pxSnapshot );
+	configASSERT( pvValue );
+
+	if( pxSnapshot->uxBuffers == ( UBaseType_t ) 1 )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			prvWriteSequenceLock( pxSnapshot, pvValue );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		pvBuffer = pvSnapshotWriteBegin( xSnapshot );
+
+		if( pvBuffer != NULL )
+		{
+			( void ) memcpy( pvBuffer, pvValue, pxSnapshot->xSnapshotSize );
+			( void ) ulSnapshotWriteEnd( xSnapshot );
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSequenceLock( Snapshot_t * const pxSnapshot, const void *pvValue )
+{
+const uint32_t ulSequence = pxSnapshot->ulSequence;
+
+	/* The sequence is odd while the value is copied, and the copy is ordered
+	between the two updates of the sequence. */
+	pxSnapshot->ulSequence = ulSequence + 1U;
+	portMEMORY_BARRIER();
+
+	( void ) memcpy( ( void * ) pxSnapshot->pucBuffers, pvValue, pxSnapshot->xSnapshotSize );
+
+	portSTORE_RELEASE( &( pxSnapshot->ulSequence ), ulSequence + 2U );
+}
+/*-----------------------------------------------------------*/
+
+void *pvSnapshotWriteBegin( SnapshotHandle_t xSnapshot )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+UBaseType_t x, uxBuffer;
+void *pvReturn = NULL;
+
+	configASSERT( pxSnapshot );
+	configASSERT( pxSnapshot->uxBuffers > ( UBaseType_t ) 1 );
+	configASSERT( pxSnapshot->uxWriting == snapshotNOT_WRITING );
+
+	/* The latest value was published before the readers are counted, and a
+	reader checks the buffer it pinned is still the latest once it is counted,
+	so either the writer sees the reader or the reader sees the buffer was
+	replaced and tries again. */
+	portMEMORY_BARRIER();
+
+	/* Start after the latest buffer, so the oldest values are overwritten
+	first. */
+	for( x = ( UBaseType_t ) 1; x < pxSnapshot->uxBuffers; x++ )
+	{
+		uxBuffer = ( pxSnapshot->uxLatest + x ) % pxSnapshot->uxBuffers;
+
+		if( portLOAD_ACQUIRE( &( pxSnapshot->ulReaders[ uxBuffer ] ) ) == 0U )
+		{
+			pxSnapshot->uxWriting = uxBuffer;
+			pvReturn = ( void * ) &( pxSnapshot->pucBuffers[ uxBuffer * pxSnapshot->xBufferStride ] );
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulSnapshotWriteEnd( SnapshotHandle_t xSnapshot )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+const UBaseType_t uxBuffer = pxSnapshot->uxWriting;
+uint32_t ulVersion;
+
+	configASSERT( uxBuffer != snapshotNOT_WRITING );
+
+	ulVersion = pxSnapshot->ulSequence + 1U;
+	pxSnapshot->ulVersions[ uxBuffer ] = ulVersion;
+
+	/* Publish the buffer once the value is complete. */
+	portSTORE_RELEASE( &( pxSnapshot->uxLatest ), uxBuffer );
+	portSTORE_RELEASE( &( pxSnapshot->ulSequence ), ulVersion );
+
+	pxSnapshot->uxWriting = snapshotNOT_WRITING;
+
+	return ulVersion;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulSnapshotRead( SnapshotHandle_t xSnapshot, void *pvBuffer, UBaseType_t *puxRetries )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+UBaseType_t uxRetries = 0, uxBuffer;
+uint32_t ulSequence;
+
+	configASSERT( pxSnapshot );
+	configASSERT( pvBuffer );
+
+	if( pxSnapshot->uxBuffers == ( UBaseType_t ) 1 )
+	{
+		for( ;; )
+		{
+			ulSequence = portLOAD_ACQUIRE( &( pxSnapshot->ulSequence ) );
+
+			if( ( ulSequence & 1U ) == 0U )
+			{
+				( void ) memcpy( pvBuffer, ( const void * ) pxSnapshot->pucBuffers, pxSnapshot->xSnapshotSize );
+
+				/* The copy is complete before the sequence is read again. */
+				portMEMORY_BARRIER();
+
+				if( pxSnapshot->ulSequence == ulSequence )
+				{
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Only a reader beside the kernel finds a write in progress,
+				and the writer has interrupts masked. */
+				portSPIN_PAUSE();
+			}
+
+			uxRetries++;
+		}
+
+		ulSequence >>= 1;
+	}
+	else
+	{
+		uxBuffer = prvPinLatest( pxSnapshot, &uxRetries );
+		{
+			( void ) memcpy( pvBuffer, ( const void * ) &( pxSnapshot->pucBuffers[ uxBuffer * pxSnapshot->xBufferStride ] ), pxSnapshot->xSnapshotSize );
+			ulSequence = pxSnapshot->ulVersions[ uxBuffer ];
+		}
+		portMEMORY_BARRIER();
+		snapshotUNPIN( &( pxSnapshot->ulReaders[ uxBuffer ] ) );
+	}
+
+	if( puxRetries != NULL )
+	{
+		*puxRetries = uxRetries;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ulSequence;
+}
+/*-----------------------------------------------------------*/
+
+const void *pvSnapshotReadBegin( SnapshotHandle_t xSnapshot, uint32_t *pulVersion )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+UBaseType_t uxBuffer;
+
+	configASSERT( pxSnapshot );
+	configASSERT( pxSnapshot->uxBuffers > ( UBaseType_t ) 1 );
+
+	uxBuffer = prvPinLatest( pxSnapshot, NULL );
+
+	if( pulVersion != NULL )
+	{
+		*pulVersion = pxSnapshot->ulVersions[ uxBuffer ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( const void * ) &( pxSnapshot->pucBuffers[ uxBuffer * pxSnapshot->xBufferStride ] );
+}
+/*-----------------------------------------------------------*/
+
+void vSnapshotReadEnd( SnapshotHandle_t xSnapshot, const void *pvValue )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+UBaseType_t uxBuffer;
+
+	configASSERT( pxSnapshot );
+	configASSERT( ( ( const uint8_t * ) pvValue >= pxSnapshot->pucBuffers ) && ( ( const uint8_t * ) pvValue < &( pxSnapshot->pucBuffers[ pxSnapshot->uxBuffers * pxSnapshot->xBufferStride ] ) ) );
+
+	uxBuffer = ( UBaseType_t ) ( ( size_t ) ( ( const uint8_t * ) pvValue - pxSnapshot->pucBuffers ) / pxSnapshot->xBufferStride );
+	configASSERT( pxSnapshot->ulReaders[ uxBuffer ] > 0U );
+
+	/* The reads of the value are complete before the writer can see the
+	buffer is free. */
+	portMEMORY_BARRIER();
+	snapshotUNPIN( &( pxSnapshot->ulReaders[ uxBuffer ] ) );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulSnapshotGetVersion( SnapshotHandle_t xSnapshot )
+{
+Snapshot_t * const pxSnapshot = ( Snapshot_t * ) xSnapshot;
+uint32_t ulVersion;
+
+	configASSERT( pxSnapshot );
+
+	ulVersion = portLOAD_ACQUIRE( &( pxSnapshot->ulSequence ) );
+
+	if( pxSnapshot->uxBuffers == ( UBaseType_t ) 1 )
+	{
+		ulVersion >>= 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ulVersion;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvPinLatest( Snapshot_t * const pxSnapshot, UBaseType_t * const puxRetries )
+{
+UBaseType_t uxBuffer;
+
+	for( ;; )
+	{
+		uxBuffer = portLOAD_ACQUIRE( &( pxSnapshot->uxLatest ) );
+		snapshotPIN( &( pxSnapshot->ulReaders[ uxBuffer ] ) );
+
+		/* Counted before the latest buffer is read again - see
+		pvSnapshotWriteBegin(). */
+		portMEMORY_BARRIER();
+
+		if( portLOAD_ACQUIRE( &( pxSnapshot->uxLatest ) ) == uxBuffer )
+		{
+			break;
+		}
+		else
+		{
+			/* The writer may have chosen the buffer before it was counted. */
+			snapshotUNPIN( &( pxSnapshot->ulReaders[ uxBuffer ] ) );
+
+			if( puxRetries != NULL )
+			{
+				( *puxRetries )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return uxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+#if( !( defined( portFETCH_AND_INCREMENT ) && defined( portFETCH_AND_DECREMENT ) ) )
+
+	static void prvChangeReaders( volatile uint32_t * const pulReaders, const BaseType_t xPin )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* Interrupts read snapshots too. */
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( xPin != pdFALSE )
+			{
+				( *pulReaders )++;
+			}
+			else
+			{
+				( *pulReaders )--;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif
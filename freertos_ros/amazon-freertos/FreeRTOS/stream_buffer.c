@@ -39,6 +39,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "stream_buffer.h"
 
+#if( configUSE_POLL_SETS == 1 )
+	#include "pollset.h"
+#endif
+
 #if( configUSE_TASK_NOTIFICATIONS != 1 )
 	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -54,18 +58,42 @@ or #defined the notification macros away, them provide default implementations
 that uses task notifications. */
 /*lint -save -e9026 Function like macros allowed and needed here so they can be overidden. */
 #ifndef sbRECEIVE_COMPLETED
-	#define sbRECEIVE_COMPLETED( pxStreamBuffer )										\
-		vTaskSuspendAll();																\
-		{																				\
-			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
+	#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+		/* The scheduler is only suspended when a writer is blocked and the
+		space it waits for is free.  The tail has been published before the
+		handle is read, so a writer that is not seen here sees the space before
+		it blocks. */
+		#define sbRECEIVE_COMPLETED( pxStreamBuffer )									\
+			portMEMORY_BARRIER();														\
+			if( ( ( pxStreamBuffer )->xTaskWaitingToSend != NULL ) &&					\
+				( prvSpacesAvailable( pxStreamBuffer ) >= ( pxStreamBuffer )->xSpaceToWakeWriter ) ) \
 			{																			\
-				( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,			\
-									  ( uint32_t ) 0,									\
-									  eNoAction );										\
-				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
+				vTaskSuspendAll();														\
+				{																		\
+					if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )				\
+					{																	\
+						( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,	\
+											  ( uint32_t ) 0,							\
+											  eNoAction );								\
+						( pxStreamBuffer )->xTaskWaitingToSend = NULL;					\
+					}																	\
+				}																		\
+				( void ) xTaskResumeAll();												\
+			}
+	#else
+		#define sbRECEIVE_COMPLETED( pxStreamBuffer )									\
+			vTaskSuspendAll();															\
+			{																			\
+				if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )					\
+				{																		\
+					( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,		\
+										  ( uint32_t ) 0,								\
+										  eNoAction );									\
+					( pxStreamBuffer )->xTaskWaitingToSend = NULL;						\
+				}																		\
 			}																			\
-		}																				\
-		( void ) xTaskResumeAll();
+			( void ) xTaskResumeAll();
+	#endif /* configUSE_LOCK_FREE_STREAM_BUFFERS */
 #endif /* sbRECEIVE_COMPLETED */
 
 #ifndef sbRECEIVE_COMPLETED_FROM_ISR
@@ -93,18 +121,39 @@ that uses task notifications. */
 or #defined the notification macro away, them provide a default implementation
 that uses task notifications. */
 #ifndef sbSEND_COMPLETED
-	#define sbSEND_COMPLETED( pxStreamBuffer )											\
-		vTaskSuspendAll();																\
-		{																				\
+	#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+		/* As sbRECEIVE_COMPLETED(), the scheduler is only suspended when a
+		reader is blocked. */
+		#define sbSEND_COMPLETED( pxStreamBuffer )										\
+			portMEMORY_BARRIER();														\
 			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
 			{																			\
-				( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive,		\
-									  ( uint32_t ) 0,									\
-									  eNoAction );										\
-				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
+				vTaskSuspendAll();														\
+				{																		\
+					if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )				\
+					{																	\
+						( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive, \
+											  ( uint32_t ) 0,							\
+											  eNoAction );								\
+						( pxStreamBuffer )->xTaskWaitingToReceive = NULL;				\
+					}																	\
+				}																		\
+				( void ) xTaskResumeAll();												\
+			}
+	#else
+		#define sbSEND_COMPLETED( pxStreamBuffer )										\
+			vTaskSuspendAll();															\
+			{																			\
+				if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )					\
+				{																		\
+					( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive,	\
+										  ( uint32_t ) 0,								\
+										  eNoAction );									\
+					( pxStreamBuffer )->xTaskWaitingToReceive = NULL;					\
+				}																		\
 			}																			\
-		}																				\
-		( void ) xTaskResumeAll();
+			( void ) xTaskResumeAll();
+	#endif /* configUSE_LOCK_FREE_STREAM_BUFFERS */
 #endif /* sbSEND_COMPLETED */
 
 #ifndef sbSEND_COMPLETE_FROM_ISR
@@ -134,6 +183,39 @@ that uses task notifications. */
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+#define sbFLAGS_IS_MULTI_PRODUCER		( ( uint8_t ) 4 ) /* Set if the stream buffer is the reader side of a multi-producer message buffer, in which case it has no storage area of its own. */
+#define sbFLAGS_IS_LANE					( ( uint8_t ) 8 ) /* Set if the stream buffer is the lane of one writer of a multi-producer message buffer. */
+
+#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+	/* The messages of a lane carry a sequence number after their length, which
+	the reader of the multi-producer message buffer uses to take the messages
+	of all the lanes in the order they were sent. */
+	#define sbBYTES_TO_STORE_SEQUENCE	( sizeof( uint32_t ) )
+	#define sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer )						\
+		( ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_LANE ) != ( uint8_t ) 0 ) ?	\
+		  ( sbBYTES_TO_STORE_MESSAGE_LENGTH + sbBYTES_TO_STORE_SEQUENCE ) :		\
+		  sbBYTES_TO_STORE_MESSAGE_LENGTH )
+	#define sbWRITE_SEQUENCE( pxStreamBuffer )										\
+		if( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_LANE ) != ( uint8_t ) 0 )	\
+		{																			\
+			prvWriteSequence( pxStreamBuffer );										\
+		}
+#else
+	#define sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer )	sbBYTES_TO_STORE_MESSAGE_LENGTH
+	#define sbWRITE_SEQUENCE( pxStreamBuffer )
+#endif
+
+#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+	/* Only the writer moves xHead and only the reader moves xTail.  Each side
+	publishes its index with release semantics once the bytes it covers have
+	been copied, and reads the index of the other side with acquire semantics,
+	so the data and the space are seen without a critical section. */
+	#define sbGET_INDEX( xIndex )			portLOAD_ACQUIRE( &( xIndex ) )
+	#define sbSET_INDEX( xIndex, xValue )	portSTORE_RELEASE( &( xIndex ), ( xValue ) )
+#else
+	#define sbGET_INDEX( xIndex )			( xIndex )
+	#define sbSET_INDEX( xIndex, xValue )	( xIndex ) = ( xValue )
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -152,6 +234,22 @@ typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+		size_t xSendTriggerLevelBytes;	/* The number of free bytes a task that is blocked on a full buffer waits for, see xStreamBufferSetSendTriggerLevel(). */
+		size_t xSpaceToWakeWriter;		/* The number of free bytes the task in xTaskWaitingToSend waits for. */
+	#endif
+
+	#if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+		struct xSTREAM_BUFFER **ppxLanes;	/* The lanes of a multi-producer message buffer, one per writer. */
+		struct xSTREAM_BUFFER *pxGroup;		/* The multi-producer message buffer a lane belongs to. */
+		size_t xLanes;						/* The number of lanes in ppxLanes. */
+		uint32_t ulNextSequence;			/* The sequence number of the next message sent to any lane. */
+	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvPollSetMember;				/* The member of a poll set the buffer was added as, NULL if none. */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -160,12 +258,43 @@ typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
 /*
- * Add xCount bytes from pucData into the pxStreamBuffer message buffer.
- * Returns the number of bytes written, which will either equal xCount in the
- * success case, or 0 if there was not enough space in the buffer (in which case
- * no data is written into the buffer).
+ * The number of bytes that can be written to the buffer.
+ */
+static size_t prvSpacesAvailable( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block the calling task for up to xTicksToWait ticks until there are
+ * xRequiredSpace free bytes in the buffer, and return the free space.  Used by
+ * the writer.
+ */
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer, size_t xRequiredSpace, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block the calling task for up to xTicksToWait ticks until there are more
+ * than xBytesToStoreMessageLength bytes in the buffer, and return the number
+ * of bytes in the buffer.  Used by the reader.
+ */
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer, size_t xBytesToStoreMessageLength, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Describe the xCount bytes of the storage area that start at xIndex in
+ * pxRegion, as one part up to the end of the storage area and one part from
+ * its start when they wrap.
  */
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+static void prvGetRegion( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, size_t xCount, StreamBufferRegion_t * const pxRegion ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the index xCount bytes after xIndex in the storage area.
+ */
+static size_t prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes from pucData into the pxStreamBuffer buffer, starting at
+ * xHead, and return the index that follows the last byte written.  The caller
+ * checks there is space and publishes the returned index as the new head once
+ * everything it writes has been copied.
+ */
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead ) PRIVILEGED_FUNCTION;
 
 /*
  * If the stream buffer is being used as a message buffer, then reads an entire
@@ -194,13 +323,15 @@ static size_t prvWriteMessageToBuffer(  StreamBuffer_t * const pxStreamBuffer,
 										size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
 
 /*
- * Read xMaxCount bytes from the pxStreamBuffer message buffer and write them
- * to pucData.
+ * Copy xCount bytes from the pxStreamBuffer buffer, starting at xTail, to
+ * pucData and return the index that follows the last byte read.  The caller
+ * publishes the returned index as the new tail once everything it reads has
+ * been copied.
  */
 static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  uint8_t *pucData,
-									  size_t xMaxCount,
-									  size_t xBytesAvailable ); PRIVILEGED_FUNCTION
+									  size_t xCount,
+									  size_t xTail ) PRIVILEGED_FUNCTION;
 
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
@@ -212,6 +343,44 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  size_t xTriggerLevelBytes,
 										  BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+
+	/*
+	 * Take the next sequence number of the multi-producer message buffer of
+	 * pxLane and write it into the message that starts at the head of the lane,
+	 * just before the message is made visible to the reader.
+	 */
+	static void prvWriteSequence( StreamBuffer_t * const pxLane ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the lane of pxGroup whose next message has the lowest sequence
+	 * number, and the length of that message in *pxMessageLength, or NULL if
+	 * all the lanes are empty.
+	 */
+	static StreamBuffer_t *prvSelectLane( const StreamBuffer_t * const pxGroup, size_t * const pxMessageLength ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * xStreamBufferReceive() for a multi-producer message buffer.  Blocks on
+	 * all the lanes at once.
+	 */
+	static size_t prvReceiveFromLanes( StreamBuffer_t * const pxGroup,
+									   void *pvRxData,
+									   size_t xBufferLengthBytes,
+									   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
+#if( configUSE_POLL_SETS == 1 )
+
+	/*
+	 * Put a buffer that was written to on the ready list of its poll set, if
+	 * it is a member of one, and unblock the task waiting for the poll set.
+	 */
+	static void prvNotifyPollSet( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+	static void prvNotifyPollSetFromISR( StreamBuffer_t * const pxStreamBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_POLL_SETS */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -266,6 +435,82 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 ) )
+
+	StreamBufferHandle_t xStreamBufferGenericCreateMultiProducer( size_t xLanes, size_t xLaneSizeBytes )
+	{
+	StreamBuffer_t *pxGroup, *pxLane;
+	size_t x;
+
+		configASSERT( xLanes > ( size_t ) 0 );
+		configASSERT( xLaneSizeBytes > ( sbBYTES_TO_STORE_MESSAGE_LENGTH + sbBYTES_TO_STORE_SEQUENCE ) );
+
+		/* The structure of the reader side is followed by the array of lanes,
+		it has no storage area of its own.  Each lane is a message buffer with
+		its own storage area. */
+		pxGroup = ( StreamBuffer_t * ) pvPortMalloc( sizeof( StreamBuffer_t ) + ( xLanes * sizeof( StreamBuffer_t * ) ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxGroup != NULL )
+		{
+			prvInitialiseNewStreamBuffer( pxGroup, ( uint8_t * ) &( pxGroup[ 1 ] ), ( size_t ) 0, ( size_t ) 1, pdTRUE );
+			pxGroup->ucFlags |= sbFLAGS_IS_MULTI_PRODUCER;
+			pxGroup->ppxLanes = ( StreamBuffer_t ** ) &( pxGroup[ 1 ] );
+
+			traceSTREAM_BUFFER_CREATE( pxGroup, pdTRUE );
+
+			for( x = 0; x < xLanes; x++ )
+			{
+				pxLane = ( StreamBuffer_t * ) xStreamBufferGenericCreate( xLaneSizeBytes, ( size_t ) 0, pdTRUE );
+
+				if( pxLane == NULL )
+				{
+					break;
+				}
+
+				pxLane->ucFlags |= sbFLAGS_IS_LANE;
+				pxLane->pxGroup = pxGroup;
+				pxGroup->ppxLanes[ x ] = pxLane;
+				pxGroup->xLanes++;
+			}
+
+			if( pxGroup->xLanes < xLanes )
+			{
+				/* Frees the lanes created so far too. */
+				vStreamBufferDelete( ( StreamBufferHandle_t ) pxGroup );
+				pxGroup = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			traceSTREAM_BUFFER_CREATE_FAILED( pdTRUE );
+		}
+
+		return ( StreamBufferHandle_t ) pxGroup;
+	}
+
+#endif /* ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+
+	StreamBufferHandle_t xStreamBufferGetLane( StreamBufferHandle_t xStreamBuffer, size_t xLane )
+	{
+	const StreamBuffer_t * const pxGroup = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+
+		configASSERT( pxGroup );
+		configASSERT( ( pxGroup->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 );
+		configASSERT( xLane < pxGroup->xLanes );
+
+		return ( StreamBufferHandle_t ) pxGroup->ppxLanes[ xLane ];
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+/*-----------------------------------------------------------*/
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
@@ -340,6 +585,33 @@ StreamBuffer_t * pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9
 
 	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+	/* A buffer must be removed from its poll set before it is deleted. */
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		configASSERT( pxStreamBuffer->pvPollSetMember == NULL );
+	}
+	#endif
+
+	#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+	{
+		size_t x;
+
+		/* The lanes of a multi-producer message buffer were allocated
+		separately, and go with it. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			for( x = 0; x < pxStreamBuffer->xLanes; x++ )
+			{
+				vStreamBufferDelete( ( StreamBufferHandle_t ) pxStreamBuffer->ppxLanes[ x ] );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
 	{
 		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -373,9 +645,18 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 #if( configUSE_TRACE_FACILITY == 1 )
 	UBaseType_t uxStreamBufferNumber;
 #endif
+#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+	size_t xSendTriggerLevelBytes;
+#endif
+#if( configUSE_POLL_SETS == 1 )
+	void *pvPollSetMember;
+#endif
 
 	configASSERT( pxStreamBuffer );
 
+	/* Resetting would overwrite the lanes of a multi-producer message buffer. */
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 	{
 		/* Store the stream buffer number so it can be restored after the
@@ -384,6 +665,19 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 	}
 	#endif
 
+	#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+	{
+		xSendTriggerLevelBytes = pxStreamBuffer->xSendTriggerLevelBytes;
+	}
+	#endif
+
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		/* A reset buffer stays in its poll set. */
+		pvPollSetMember = pxStreamBuffer->pvPollSetMember;
+	}
+	#endif
+
 	/* Can only reset a message buffer if there are no tasks blocked on it. */
 	if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
 	{
@@ -411,6 +705,18 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 			}
 			#endif
 
+			#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+			{
+				pxStreamBuffer->xSendTriggerLevelBytes = xSendTriggerLevelBytes;
+			}
+			#endif
+
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				pxStreamBuffer->pvPollSetMember = pvPollSetMember;
+			}
+			#endif
+
 			traceSTREAM_BUFFER_RESET( xStreamBuffer );
 		}
 	}
@@ -448,6 +754,38 @@ BaseType_t xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+
+	BaseType_t xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+	BaseType_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		/* The space a blocked writer waits for is at least the space its own
+		write needs, a trigger level of 0 is the same as 1. */
+		if( xTriggerLevel == ( size_t ) 0 )
+		{
+			xTriggerLevel = ( size_t ) 1; /*lint !e9044 Parameter modified to ensure it doesn't have a dangerous value. */
+		}
+
+		if( xTriggerLevel < pxStreamBuffer->xLength )
+		{
+			pxStreamBuffer->xSendTriggerLevelBytes = xTriggerLevel;
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_LOCK_FREE_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
 size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
 {
 const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
@@ -455,18 +793,30 @@ size_t xSpace;
 
 	configASSERT( pxStreamBuffer );
 
-	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-	xSpace -= pxStreamBuffer->xHead;
-	xSpace -= ( size_t ) 1;
-
-	if( xSpace >= pxStreamBuffer->xLength )
+	#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
 	{
-		xSpace -= pxStreamBuffer->xLength;
+		size_t x;
+
+		/* A multi-producer message buffer has no storage area of its own, its
+		space is that of all its lanes. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xSpace = 0;
+			for( x = 0; x < pxStreamBuffer->xLanes; x++ )
+			{
+				xSpace += prvSpacesAvailable( pxStreamBuffer->ppxLanes[ x ] );
+			}
+		}
+		else
+		{
+			xSpace = prvSpacesAvailable( pxStreamBuffer );
+		}
 	}
-	else
+	#else
 	{
-		mtCOVERAGE_TEST_MARKER();
+		xSpace = prvSpacesAvailable( pxStreamBuffer );
 	}
+	#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
 
 	return xSpace;
 }
@@ -479,7 +829,30 @@ size_t xReturn;
 
 	configASSERT( pxStreamBuffer );
 
-	xReturn = prvBytesInBuffer( pxStreamBuffer );
+	#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+	{
+		size_t x;
+
+		/* The data of a multi-producer message buffer is in its lanes. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xReturn = 0;
+			for( x = 0; x < pxStreamBuffer->xLanes; x++ )
+			{
+				xReturn += prvBytesInBuffer( pxStreamBuffer->ppxLanes[ x ] );
+			}
+		}
+		else
+		{
+			xReturn = prvBytesInBuffer( pxStreamBuffer );
+		}
+	}
+	#else
+	{
+		xReturn = prvBytesInBuffer( pxStreamBuffer );
+	}
+	#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -490,9 +863,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
 						  TickType_t xTicksToWait )
 {
 StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
-size_t xReturn, xSpace = 0;
+size_t xReturn, xSpace;
 size_t xRequiredSpace = xDataLengthBytes;
-TimeOut_t xTimeOut;
 
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
@@ -500,64 +872,18 @@ TimeOut_t xTimeOut;
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
 	increased by the amount of bytes needed to store the length of the
-	message. */
+	message, and its sequence number in a lane of a multi-producer message
+	buffer. */
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
 	{
-		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
-
-	if( xTicksToWait != ( TickType_t ) 0 )
-	{
-		vTaskSetTimeOutState( &xTimeOut );
-
-		do
-		{
-			/* Wait until the required number of bytes are free in the message
-			buffer. */
-			taskENTER_CRITICAL();
-			{
-				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-
-				if( xSpace < xRequiredSpace )
-				{
-					/* Clear notification state as going to wait for space. */
-					( void ) xTaskNotifyStateClear( NULL );
-
-					/* Should only be one writer. */
-					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-				}
-				else
-				{
-					taskEXIT_CRITICAL();
-					break;
-				}
-			}
-			taskEXIT_CRITICAL();
-
-			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
-			pxStreamBuffer->xTaskWaitingToSend = NULL;
-
-		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	if( xSpace == ( size_t ) 0 )
-	{
-		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
 
 	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
@@ -565,6 +891,14 @@ TimeOut_t xTimeOut;
 	{
 		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
 
+		#if( configUSE_POLL_SETS == 1 )
+		{
+			/* Any data makes the buffer ready in its poll set, whatever the
+			trigger level. */
+			prvNotifyPollSet( pxStreamBuffer );
+		}
+		#endif
+
 		/* Was a task waiting for the data? */
 		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
 		{
@@ -600,21 +934,28 @@ size_t xRequiredSpace = xDataLengthBytes;
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
 	increased by the amount of bytes needed to store the length of the
-	message. */
+	message, and its sequence number in a lane of a multi-producer message
+	buffer. */
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
 	{
-		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+	xSpace = prvSpacesAvailable( pxStreamBuffer );
 	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
 	if( xReturn > ( size_t ) 0 )
 	{
+		#if( configUSE_POLL_SETS == 1 )
+		{
+			prvNotifyPollSetFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		#endif
+
 		/* Was a task waiting for the data? */
 		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
 		{
@@ -643,7 +984,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 									   size_t xRequiredSpace )
 {
 	BaseType_t xShouldWrite;
-	size_t xReturn;
+	size_t xReturn, xNextHead = pxStreamBuffer->xHead;
 
 	if( xSpace == ( size_t ) 0 )
 	{
@@ -666,7 +1007,10 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 		into the buffer.  Start by writing the length of the data, the data
 		itself will be written later in this function. */
 		xShouldWrite = pdTRUE;
-		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+
+		/* The sequence number of a message in a lane is filled in last. */
+		xNextHead = prvAdvanceIndex( pxStreamBuffer, xNextHead, sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer ) - sbBYTES_TO_STORE_MESSAGE_LENGTH );
 	}
 	else
 	{
@@ -676,8 +1020,12 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 	if( xShouldWrite != pdFALSE )
 	{
-		/* Writes the data itself. */
-		xReturn = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+		/* Writes the data itself, then makes the length and the data visible
+		to the reader in one go. */
+		xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+		sbWRITE_SEQUENCE( pxStreamBuffer );
+		sbSET_INDEX( pxStreamBuffer->xHead, xNextHead );
+		xReturn = xDataLengthBytes;
 	}
 	else
 	{
@@ -699,6 +1047,21 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 	configASSERT( pvRxData );
 	configASSERT( pxStreamBuffer );
 
+	#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+	{
+		/* The reader of a multi-producer message buffer takes the messages
+		from the lanes. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			return prvReceiveFromLanes( pxStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
 	/* This receive function is used by both message buffers, which store
 	discrete messages, and stream buffers, which store a continuous stream of
 	bytes.  Discrete messages include an additional
@@ -713,63 +1076,16 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		xBytesToStoreMessageLength = 0;
 	}
 
-	if( xTicksToWait != ( TickType_t ) 0 )
+	xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+
+	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
+	holds the number of bytes used to store the message length) or a stream of
+	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+	available must be greater than xBytesToStoreMessageLength to be able to
+	read bytes from the buffer. */
+	if( xBytesAvailable > xBytesToStoreMessageLength )
 	{
-		/* Checking if there is data and clearing the notification state must be
-		performed atomically. */
-		taskENTER_CRITICAL();
-		{
-			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-
-			/* If this function was invoked by a message buffer read then
-			xBytesToStoreMessageLength holds the number of bytes used to hold
-			the length of the next discrete message.  If this function was
-			invoked by a stream buffer read then xBytesToStoreMessageLength will
-			be 0. */
-			if( xBytesAvailable <= xBytesToStoreMessageLength )
-			{
-				/* Clear notification state as going to wait for data. */
-				( void ) xTaskNotifyStateClear( NULL );
-
-				/* Should only be one reader. */
-				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-		}
-		taskEXIT_CRITICAL();
-
-		if( xBytesAvailable <= xBytesToStoreMessageLength )
-		{
-			/* Wait for data to be available. */
-			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
-			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
-			pxStreamBuffer->xTaskWaitingToReceive = NULL;
-
-			/* Recheck the data available after blocking. */
-			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-	}
-	else
-	{
-		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-	}
-
-	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
-	holds the number of bytes used to store the message length) or a stream of
-	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-	available must be greater than xBytesToStoreMessageLength to be able to
-	read bytes from the buffer. */
-	if( xBytesAvailable > xBytesToStoreMessageLength )
-	{
-		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
+		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
 
 		/* Was a task waiting for space in the buffer? */
 		if( xReceivedLength != ( size_t ) 0 )
@@ -849,22 +1165,228 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+							 size_t xDataLengthBytes,
+							 StreamBufferRegion_t * const pxRegion,
+							 TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn, xSpace, xIndex;
+size_t xRequiredSpace = xDataLengthBytes, xBytesToStoreMessageLength = 0;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxRegion );
+	configASSERT( xDataLengthBytes > ( size_t ) 0 );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
+		xRequiredSpace += xBytesToStoreMessageLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+
+	if( xBytesToStoreMessageLength != ( size_t ) 0 )
+	{
+		/* A message is reserved whole or not at all. */
+		xReturn = ( xSpace >= xRequiredSpace ) ? xDataLengthBytes : ( size_t ) 0;
+	}
+	else
+	{
+		/* A stream buffer hands out as much of the space as there is. */
+		xReturn = configMIN( xSpace, xDataLengthBytes );
+	}
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		/* The space for the length of a message is left in front of the
+		region, xStreamBufferCommit() fills it in.  Nothing is visible to the
+		reader until then, as the head does not move.  In a lane, the space
+		left also covers the sequence number. */
+		xIndex = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xHead, xBytesToStoreMessageLength );
+		prvGetRegion( pxStreamBuffer, xIndex, xReturn, pxRegion );
+	}
+	else
+	{
+		prvGetRegion( pxStreamBuffer, ( size_t ) 0, ( size_t ) 0, pxRegion );
+		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xNextHead, xRequiredSpace = xDataLengthBytes;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xDataLengthBytes > ( size_t ) 0 )
+	{
+		xNextHead = pxStreamBuffer->xHead;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* The length goes in the space left in front of the message by
+			xStreamBufferReserve(). */
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
+			configASSERT( xRequiredSpace <= prvSpacesAvailable( pxStreamBuffer ) );
+			xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+			xNextHead = prvAdvanceIndex( pxStreamBuffer, xNextHead, sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer ) - sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		}
+		else
+		{
+			/* No more than was reserved can be committed. */
+			configASSERT( xRequiredSpace <= prvSpacesAvailable( pxStreamBuffer ) );
+		}
+
+		/* The data is already in place, make it visible to the reader. */
+		xNextHead = prvAdvanceIndex( pxStreamBuffer, xNextHead, xDataLengthBytes );
+		sbWRITE_SEQUENCE( pxStreamBuffer );
+		sbSET_INDEX( pxStreamBuffer->xHead, xNextHead );
+
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xDataLengthBytes );
+
+		#if( configUSE_POLL_SETS == 1 )
+		{
+			prvNotifyPollSet( pxStreamBuffer );
+		}
+		#endif
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* Committing nothing drops the reservation. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+									StreamBufferRegion_t * const pxRegion,
+									TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength = 0, xIndex;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxRegion );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+
+	if( xBytesAvailable > xBytesToStoreMessageLength )
+	{
+		xIndex = pxStreamBuffer->xTail;
+
+		if( xBytesToStoreMessageLength != ( size_t ) 0 )
+		{
+			/* Read the length of the next message without removing it, the
+			region is the message itself. */
+			xIndex = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xReturn, xBytesToStoreMessageLength, xIndex );
+			configASSERT( xReturn <= ( xBytesAvailable - xBytesToStoreMessageLength ) );
+		}
+		else
+		{
+			xReturn = xBytesAvailable;
+		}
+
+		prvGetRegion( pxStreamBuffer, xIndex, xReturn, pxRegion );
+	}
+	else
+	{
+		prvGetRegion( pxStreamBuffer, ( size_t ) 0, ( size_t ) 0, pxRegion );
+		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xNextTail, xNextMessageLength;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xBytesToConsume > ( size_t ) 0 )
+	{
+		xNextTail = pxStreamBuffer->xTail;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* A message is removed whole, together with its length. */
+			configASSERT( prvBytesInBuffer( pxStreamBuffer ) > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+			configASSERT( xBytesToConsume == xNextMessageLength );
+		}
+		else
+		{
+			/* No more than was peeked can be consumed. */
+			configASSERT( xBytesToConsume <= prvBytesInBuffer( pxStreamBuffer ) );
+		}
+
+		xNextTail = prvAdvanceIndex( pxStreamBuffer, xNextTail, xBytesToConsume );
+		sbSET_INDEX( pxStreamBuffer->xTail, xNextTail );
+
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesToConsume );
+
+		/* Was a task waiting for space in the buffer? */
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xBytesToConsume;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
 										void *pvRxData,
 										size_t xBufferLengthBytes,
 										size_t xBytesAvailable,
 										size_t xBytesToStoreMessageLength )
 {
-size_t xOriginalTail, xReceivedLength, xNextMessageLength;
+size_t xOriginalTail, xNextTail, xReceivedLength, xNextMessageLength;
+
+	/* The tail is only published once the whole message has been read, so the
+	writer never reuses the space of a message that is still being read. */
+	xOriginalTail = pxStreamBuffer->xTail;
+	xNextTail = xOriginalTail;
 
 	if( xBytesToStoreMessageLength != ( size_t ) 0 )
 	{
 		/* A discrete message is being received.  First receive the length
-		of the message.  A copy of the tail is stored so the buffer can be
-		returned to its prior state if the length of the message is too
-		large for the provided buffer. */
-		xOriginalTail = pxStreamBuffer->xTail;
-		( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xNextMessageLength, xBytesToStoreMessageLength, xBytesAvailable );
+		of the message. */
+		xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xNextMessageLength, xBytesToStoreMessageLength, xNextTail );
 
 		/* Reduce the number of bytes available by the number of bytes just
 		read out. */
@@ -875,9 +1397,9 @@ size_t xOriginalTail, xReceivedLength, xNextMessageLength;
 		if( xNextMessageLength > xBufferLengthBytes )
 		{
 			/* The user has provided insufficient space to read the message
-			so return the buffer to its previous state (so the length of
-			the message is in the buffer again). */
-			pxStreamBuffer->xTail = xOriginalTail;
+			so leave the buffer in its previous state (so the length of the
+			message is still in the buffer). */
+			xNextTail = xOriginalTail;
 			xNextMessageLength = 0;
 		}
 		else
@@ -893,7 +1415,18 @@ size_t xOriginalTail, xReceivedLength, xNextMessageLength;
 	}
 
 	/* Read the actual data. */
-	xReceivedLength = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xNextMessageLength, xBytesAvailable ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+	xReceivedLength = configMIN( xBytesAvailable, xNextMessageLength );
+
+	if( xReceivedLength > ( size_t ) 0 )
+	{
+		xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xReceivedLength, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	sbSET_INDEX( pxStreamBuffer->xTail, xNextTail );
 
 	return xReceivedLength;
 }
@@ -907,9 +1440,38 @@ size_t xTail;
 
 	configASSERT( pxStreamBuffer );
 
+	#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+	{
+		size_t x;
+
+		/* A multi-producer message buffer is empty when all its lanes are. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xReturn = pdTRUE;
+			for( x = 0; x < pxStreamBuffer->xLanes; x++ )
+			{
+				if( xStreamBufferIsEmpty( ( StreamBufferHandle_t ) pxStreamBuffer->ppxLanes[ x ] ) == pdFALSE )
+				{
+					xReturn = pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			return xReturn;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
 	/* True if no bytes are available. */
-	xTail = pxStreamBuffer->xTail;
-	if( pxStreamBuffer->xHead == xTail )
+	xTail = sbGET_INDEX( pxStreamBuffer->xTail );
+	if( sbGET_INDEX( pxStreamBuffer->xHead ) == xTail )
 	{
 		xReturn = pdTRUE;
 	}
@@ -943,6 +1505,40 @@ const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer
 		xBytesToStoreMessageLength = 0;
 	}
 
+	#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+	{
+		size_t x;
+
+		/* A multi-producer message buffer is full when no lane can take a
+		message, and a lane also stores the sequence number of each one. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xReturn = pdTRUE;
+			for( x = 0; x < pxStreamBuffer->xLanes; x++ )
+			{
+				if( xStreamBufferIsFull( ( StreamBufferHandle_t ) pxStreamBuffer->ppxLanes[ x ] ) == pdFALSE )
+				{
+					xReturn = pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			return xReturn;
+		}
+		else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_LANE ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength += sbBYTES_TO_STORE_SEQUENCE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
 	/* True if the available space equals zero. */
 	if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
 	{
@@ -1017,14 +1613,12 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead )
 {
-size_t xNextHead, xFirstLength;
+size_t xNextHead = xHead, xFirstLength;
 
 	configASSERT( xCount > ( size_t ) 0 );
 
-	xNextHead = pxStreamBuffer->xHead;
-
 	/* Calculate the number of bytes that can be added in the first write -
 	which may be less than the total number of bytes that need to be added if
 	the buffer will wrap back to the beginning. */
@@ -1057,64 +1651,231 @@ size_t xNextHead, xFirstLength;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	pxStreamBuffer->xHead = xNextHead;
+	return xNextHead;
+}
+/*-----------------------------------------------------------*/
 
-	return xCount;
+static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xCount, size_t xTail )
+{
+size_t xFirstLength, xNextTail = xTail;
+
+	configASSERT( xCount > ( size_t ) 0 );
+
+	/* Calculate the number of bytes that can be read - which may be
+	less than the number wanted if the data wraps around to the start of
+	the buffer. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+
+	/* Obtain the number of bytes it is possible to obtain in the first
+	read.  Asserts check bounds of read and write. */
+	configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
+	memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	/* If the total number of wanted bytes is greater than the number
+	that could be read in the first read... */
+	if( xCount > xFirstLength )
+	{
+		/*...then read the remaining bytes from the start of the buffer. */
+		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+		memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Move the tail pointer to effectively remove the data read from
+	the buffer. */
+	xNextTail += xCount;
+
+	if( xNextTail >= pxStreamBuffer->xLength )
+	{
+		xNextTail -= pxStreamBuffer->xLength;
+	}
+
+	return xNextTail;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer, size_t xRequiredSpace, TickType_t xTicksToWait )
 {
-size_t xCount, xFirstLength, xNextTail;
+size_t xSpace = 0;
+TimeOut_t xTimeOut;
 
-	/* Use the minimum of the wanted bytes and the available bytes. */
-	xCount = configMIN( xBytesAvailable, xMaxCount );
+	/* Only the lanes of a multi-producer message buffer are written to. */
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
 
-	if( xCount > ( size_t ) 0 )
+	#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
 	{
-		xNextTail = pxStreamBuffer->xTail;
+		/* Only the writer reduces the space, so space that is free now is
+		still free when the data is written, and the critical section is only
+		needed to block. */
+		xSpace = prvSpacesAvailable( pxStreamBuffer );
+	}
+	#endif /* configUSE_LOCK_FREE_STREAM_BUFFERS */
 
-		/* Calculate the number of bytes that can be read - which may be
-		less than the number wanted if the data wraps around to the start of
-		the buffer. */
-		xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+	if( ( xTicksToWait != ( TickType_t ) 0 ) && ( xSpace < xRequiredSpace ) )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
 
-		/* Obtain the number of bytes it is possible to obtain in the first
-		read.  Asserts check bounds of read and write. */
-		configASSERT( xFirstLength <= xMaxCount );
-		configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
-		memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+		do
+		{
+			/* Wait until the required number of bytes are free in the message
+			buffer. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = prvSpacesAvailable( pxStreamBuffer );
 
-		/* If the total number of wanted bytes is greater than the number
-		that could be read in the first read... */
-		if( xCount > xFirstLength )
+				if( xSpace < xRequiredSpace )
+				{
+					/* Clear notification state as going to wait for space. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one writer. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+
+					#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+					{
+						/* The reader only wakes this task once the space it
+						needs is free. */
+						pxStreamBuffer->xSpaceToWakeWriter = configMAX( xRequiredSpace, pxStreamBuffer->xSendTriggerLevelBytes );
+					}
+					#endif
+
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					taskEXIT_CRITICAL();
+					break;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( ( StreamBufferHandle_t ) pxStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xSpace == ( size_t ) 0 )
+	{
+		xSpace = prvSpacesAvailable( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer, size_t xBytesToStoreMessageLength, TickType_t xTicksToWait )
+{
+size_t xBytesAvailable;
+
+	/* The lanes of a multi-producer message buffer are only read through
+	xStreamBufferReceive() on the multi-producer message buffer itself. */
+	configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MULTI_PRODUCER | sbFLAGS_IS_LANE ) ) == ( uint8_t ) 0 );
+
+	#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+	{
+		/* Only the reader removes data, so data that is there now is still
+		there when it is read, and the critical section is only needed to
+		block. */
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
+	#else
+	{
+		xBytesAvailable = 0;
+	}
+	#endif /* configUSE_LOCK_FREE_STREAM_BUFFERS */
+
+	if( ( xTicksToWait != ( TickType_t ) 0 ) && ( xBytesAvailable <= xBytesToStoreMessageLength ) )
+	{
+		/* Checking if there is data and clearing the notification state must be
+		performed atomically. */
+		taskENTER_CRITICAL();
 		{
-			/*...then read the remaining bytes from the start of the buffer. */
-			configASSERT( xCount <= xMaxCount );
-			memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			/* If this function was invoked by a message buffer read then
+			xBytesToStoreMessageLength holds the number of bytes used to hold
+			the length of the next discrete message.  If this function was
+			invoked by a stream buffer read then xBytesToStoreMessageLength will
+			be 0. */
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable <= xBytesToStoreMessageLength )
+		{
+			/* Wait for data to be available. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( ( StreamBufferHandle_t ) pxStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			/* Recheck the data available after blocking. */
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+	}
+	else
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
 
-		/* Move the tail pointer to effectively remove the data read from
-		the buffer. */
-		xNextTail += xCount;
 
-		if( xNextTail >= pxStreamBuffer->xLength )
-		{
-			xNextTail -= pxStreamBuffer->xLength;
-		}
+	return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
 
-		pxStreamBuffer->xTail = xNextTail;
+static void prvGetRegion( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, size_t xCount, StreamBufferRegion_t * const pxRegion )
+{
+	/* The first part runs from xIndex to the end of the storage area at most,
+	the rest wraps around to the start of the storage area. */
+	pxRegion->xFirstLength = configMIN( pxStreamBuffer->xLength - xIndex, xCount );
+	pxRegion->pucFirst = ( pxRegion->xFirstLength > ( size_t ) 0 ) ? &( pxStreamBuffer->pucBuffer[ xIndex ] ) : NULL;
+	pxRegion->xSecondLength = xCount - pxRegion->xFirstLength;
+	pxRegion->pucSecond = ( pxRegion->xSecondLength > ( size_t ) 0 ) ? pxStreamBuffer->pucBuffer : NULL;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, size_t xCount )
+{
+size_t xNextIndex = xIndex + xCount;
+
+	if( xNextIndex >= pxStreamBuffer->xLength )
+	{
+		xNextIndex -= pxStreamBuffer->xLength;
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	return xCount;
+	return xNextIndex;
 }
 /*-----------------------------------------------------------*/
 
@@ -1123,7 +1884,7 @@ static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 /* Returns the distance between xTail and xHead. */
 size_t xCount;
 
-	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount = pxStreamBuffer->xLength + sbGET_INDEX( pxStreamBuffer->xHead );
 	xCount -= pxStreamBuffer->xTail;
 	if ( xCount >= pxStreamBuffer->xLength )
 	{
@@ -1138,6 +1899,29 @@ size_t xCount;
 }
 /*-----------------------------------------------------------*/
 
+static size_t prvSpacesAvailable( const StreamBuffer_t * const pxStreamBuffer )
+{
+/* Returns the free space, one byte less than the distance between xHead and
+xTail so a full buffer is not mistaken for an empty one. */
+size_t xSpace;
+
+	xSpace = pxStreamBuffer->xLength + sbGET_INDEX( pxStreamBuffer->xTail );
+	xSpace -= pxStreamBuffer->xHead;
+	xSpace -= ( size_t ) 1;
+
+	if( xSpace >= pxStreamBuffer->xLength )
+	{
+		xSpace -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  uint8_t * const pucBuffer,
 										  size_t xBufferSizeBytes,
@@ -1162,11 +1946,271 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	pxStreamBuffer->xLength = xBufferSizeBytes;
 	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
 
+	#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+	{
+		pxStreamBuffer->xSendTriggerLevelBytes = ( size_t ) 1;
+	}
+	#endif
+
 	if( xIsMessageBuffer != pdFALSE )
 	{
 		pxStreamBuffer->ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
 	}
 }
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+
+	static void prvWriteSequence( StreamBuffer_t * const pxLane )
+	{
+	StreamBuffer_t * const pxGroup = pxLane->pxGroup;
+	uint32_t ulSequence;
+
+		/* The sequence number is taken when the message is complete, so the
+		messages of all the lanes are ordered by the time they were sent. */
+		#ifdef portFETCH_AND_INCREMENT
+		{
+			ulSequence = portFETCH_AND_INCREMENT( &( pxGroup->ulNextSequence ) );
+		}
+		#else
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* Lanes can be written to from interrupts too. */
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				ulSequence = pxGroup->ulNextSequence;
+				pxGroup->ulNextSequence++;
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#endif /* portFETCH_AND_INCREMENT */
+
+		( void ) prvWriteBytesToBuffer( pxLane, ( const uint8_t * ) &ulSequence, sbBYTES_TO_STORE_SEQUENCE, prvAdvanceIndex( pxLane, pxLane->xHead, sbBYTES_TO_STORE_MESSAGE_LENGTH ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	static StreamBuffer_t *prvSelectLane( const StreamBuffer_t * const pxGroup, size_t * const pxMessageLength )
+	{
+	StreamBuffer_t *pxLane, *pxOldest = NULL;
+	size_t x, xIndex, xLength;
+	uint32_t ulSequence, ulOldestSequence = 0;
+
+		*pxMessageLength = 0;
+
+		for( x = 0; x < pxGroup->xLanes; x++ )
+		{
+			pxLane = pxGroup->ppxLanes[ x ];
+
+			/* A lane only ever holds whole messages. */
+			if( prvBytesInBuffer( pxLane ) > ( sbBYTES_TO_STORE_MESSAGE_LENGTH + sbBYTES_TO_STORE_SEQUENCE ) )
+			{
+				xIndex = prvReadBytesFromBuffer( pxLane, ( uint8_t * ) &xLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxLane->xTail );
+				( void ) prvReadBytesFromBuffer( pxLane, ( uint8_t * ) &ulSequence, sbBYTES_TO_STORE_SEQUENCE, xIndex );
+
+				/* The difference is compared rather than the values, so the
+				order holds when the sequence numbers wrap. */
+				if( ( pxOldest == NULL ) || ( ( int32_t ) ( ulSequence - ulOldestSequence ) < 0 ) )
+				{
+					pxOldest = pxLane;
+					ulOldestSequence = ulSequence;
+					*pxMessageLength = xLength;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return pxOldest;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvReceiveFromLanes( StreamBuffer_t * const pxGroup,
+									   void *pvRxData,
+									   size_t xBufferLengthBytes,
+									   TickType_t xTicksToWait )
+	{
+	StreamBuffer_t *pxLane;
+	size_t x, xMessageLength, xNextTail, xReceivedLength = 0;
+	TimeOut_t xTimeOut;
+
+		pxLane = prvSelectLane( pxGroup, &xMessageLength );
+
+		if( ( pxLane == NULL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+
+			do
+			{
+				/* Checking the lanes and clearing the notification state must
+				be performed atomically. */
+				taskENTER_CRITICAL();
+				{
+					pxLane = prvSelectLane( pxGroup, &xMessageLength );
+
+					if( pxLane == NULL )
+					{
+						/* Clear notification state as going to wait for data. */
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one reader.  It waits on every lane,
+						the first writer to send a message wakes it. */
+						configASSERT( pxGroup->xTaskWaitingToReceive == NULL );
+						pxGroup->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+
+						for( x = 0; x < pxGroup->xLanes; x++ )
+						{
+							pxGroup->ppxLanes[ x ]->xTaskWaitingToReceive = pxGroup->xTaskWaitingToReceive;
+						}
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( ( StreamBufferHandle_t ) pxGroup );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+
+				/* The writer that woke this task only cleared its own lane. */
+				for( x = 0; x < pxGroup->xLanes; x++ )
+				{
+					pxGroup->ppxLanes[ x ]->xTaskWaitingToReceive = NULL;
+				}
+				pxGroup->xTaskWaitingToReceive = NULL;
+
+				pxLane = prvSelectLane( pxGroup, &xMessageLength );
+
+			} while( ( pxLane == NULL ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxLane == NULL )
+		{
+			traceSTREAM_BUFFER_RECEIVE_FAILED( ( StreamBufferHandle_t ) pxGroup );
+		}
+		else if( xMessageLength <= xBufferLengthBytes )
+		{
+			xNextTail = prvAdvanceIndex( pxLane, pxLane->xTail, sbBYTES_TO_STORE_MESSAGE_LENGTH + sbBYTES_TO_STORE_SEQUENCE );
+			xNextTail = prvReadBytesFromBuffer( pxLane, ( uint8_t * ) pvRxData, xMessageLength, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+			sbSET_INDEX( pxLane->xTail, xNextTail );
+			xReceivedLength = xMessageLength;
+
+			traceSTREAM_BUFFER_RECEIVE( ( StreamBufferHandle_t ) pxGroup, xReceivedLength );
+
+			/* Was the writer of the lane waiting for space? */
+			sbRECEIVE_COMPLETED( pxLane );
+		}
+		else
+		{
+			/* The message does not fit in pvRxData, leave it in the lane as
+			xMessageBufferReceive() does. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReceivedLength;
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
+#if( configUSE_POLL_SETS == 1 )
+
+	static void prvNotifyPollSet( StreamBuffer_t * const pxStreamBuffer )
+	{
+	BaseType_t xYieldRequired = pdFALSE;
+
+		/* Checked again with interrupts masked, as the buffer can be removed
+		from its poll set meanwhile. */
+		if( pxStreamBuffer->pvPollSetMember != NULL )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxStreamBuffer->pvPollSetMember != NULL )
+				{
+					xYieldRequired = xPollSetMemberReady( pxStreamBuffer->pvPollSetMember );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xYieldRequired != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvNotifyPollSetFromISR( StreamBuffer_t * const pxStreamBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxStreamBuffer->pvPollSetMember != NULL )
+			{
+				if( ( xPollSetMemberReady( pxStreamBuffer->pvPollSetMember ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	/*-----------------------------------------------------------*/
+
+	void **ppvStreamBufferGetPollSetMember( StreamBufferHandle_t xStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+
+		configASSERT( pxStreamBuffer );
+
+		/* The lanes of a multi-producer message buffer are not sent to as one
+		buffer, so neither they nor the buffer they make up can be polled. */
+		if( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MULTI_PRODUCER | sbFLAGS_IS_LANE ) ) != ( uint8_t ) 0 )
+		{
+			return NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return &( pxStreamBuffer->pvPollSetMember );
+	}
+
+#endif /* configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
@@ -38,8 +38,13 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "queue.h"
 #include "stack_macros.h"
 
+#if( configUSE_POLL_SETS == 1 )
+	#include "pollset.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -64,7 +69,8 @@ functions but without including stdio.h here. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
-/* Values that can be assigned to the ucNotifyState member of the TCB. */
+/* Values that can be assigned to the entries of the ucNotifyState member of
+the TCB. */
 #define taskNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED		( ( uint8_t ) 2 )
@@ -131,7 +137,32 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
-	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
+	#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/* The ready list at configEDF_PRIORITY is kept sorted by absolute deadline,
+	so the task to run is always the one at its head.  The other priorities
+	share the processor time in round robin. */
+	#define taskSELECT_FROM_READY_LIST( uxPriority )													\
+	{																									\
+		if( ( uxPriority ) == ( UBaseType_t ) configEDF_PRIORITY )										\
+		{																								\
+			pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) ); \
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );		\
+		}																								\
+	}
+
+#else
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
+/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
 	performed in a generic way that is not optimised to any particular
 	microcontroller architecture. */
 
@@ -160,7 +191,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );													\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -190,7 +221,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -211,7 +242,10 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 /*-----------------------------------------------------------*/
 
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
+count overflows.  A 64-bit tick count does not, and pxOverflowDelayedTaskList
+stays empty. */
+#if( configUSE_64_BIT_TICKS == 0 )
+
 #define taskSWITCH_DELAYED_LISTS()																	\
 {																									\
 	List_t *pxTemp;																					\
@@ -226,17 +260,63 @@ count overflows. */
 	prvResetNextTaskUnblockTime();																	\
 }
 
+#endif /* configUSE_64_BIT_TICKS */
+
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )																\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/* At configEDF_PRIORITY the task is instead inserted in order of absolute
+	deadline, behind the tasks that have the same deadline.  Tasks that were
+	not created with xTaskCreateEDF() have a deadline of portMAX_DELAY so go to
+	the end. */
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )								\
+		{																								\
+			listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->xEDFAbsoluteDeadline );	\
+			vListInsert( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																								\
+		else																							\
+		{																								\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																								\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#else
+
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+/*
+ * Evaluates to true if pxTCB, just unblocked, should run in place of the
+ * running task: it has a higher priority or, at configEDF_PRIORITY, an earlier
+ * absolute deadline.
+ */
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	#define prvTaskPreemptsCurrentTask( pxTCB )															\
+		( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||										\
+		  ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&							\
+			( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&						\
+			( ( pxTCB )->xEDFAbsoluteDeadline < pxCurrentTCB->xEDFAbsoluteDeadline ) ) )
+
+#else
+
+	#define prvTaskPreemptsCurrentTask( pxTCB ) ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
 /*
@@ -255,7 +335,9 @@ being used for another purpose.  The following bit definition is used to inform
 the scheduler that the value should not be changed - in which case it is the
 responsibility of whichever module is using the value to ensure it gets set back
 to its original value when it is released. */
-#if( configUSE_16_BIT_TICKS == 1 )
+#if( configUSE_64_BIT_EVENT_BITS == 1 )
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000000000000000ULL
+#elif( configUSE_16_BIT_TICKS == 1 )
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000U
 #else
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
@@ -274,28 +356,68 @@ typedef struct tskTaskControlBlock
 		xMPU_SETTINGS	xMPUSettings;		/*< The MPU settings are defined as part of the port layer.  THIS MUST BE THE SECOND MEMBER OF THE TCB STRUCT. */
 	#endif
 
+	/* The members read or written by every context switch and every tick come
+	first, so that they share as few cache lines as possible.  The name and the
+	numbers come next, as the debuggers find them at the offsets exported in
+	FreeRTOSDebugConfig, which must fit in a byte.  The members only used by
+	some of the API functions come last. */
 	ListItem_t			xStateListItem;	/*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
-	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
 	UBaseType_t			uxPriority;			/*< The priority of the task.  0 is the lowest priority. */
+	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
+
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		UBaseType_t		uxCriticalNesting;	/*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
+	#endif
+
 	StackType_t			*pxStack;			/*< Points to the start of the stack. */
-	char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
 	#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
 		StackType_t		*pxEndOfStack;		/*< Points to the highest valid address for the stack. */
 	#endif
 
-	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
-		UBaseType_t		uxCriticalNesting;	/*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
+	#if ( configUSE_MUTEXES == 1 )
+		UBaseType_t		uxBasePriority;		/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
+		UBaseType_t		uxMutexesHeld;
 	#endif
 
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+	#endif
+
+	char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxTCBNumber;		/*< Stores a number that increments each time a TCB is created.  It allows debuggers to determine when a task has been deleted and then recreated. */
 		UBaseType_t		uxTaskNumber;		/*< Stores a number specifically for use by third party trace code. */
 	#endif
 
-	#if ( configUSE_MUTEXES == 1 )
-		UBaseType_t		uxBasePriority;		/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
-		UBaseType_t		uxMutexesHeld;
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xEDFPeriod;				/*< Time between job releases, or 0 if the task was not created with xTaskCreateEDF(). */
+		TickType_t		xEDFRelativeDeadline;
+		TickType_t		xEDFBudget;				/*< Ticks a job may execute for, or 0 for no limit. */
+		TickType_t		xEDFReleaseTime;		/*< Release time of the current job. */
+		TickType_t		xEDFAbsoluteDeadline;	/*< Key of the task in the configEDF_PRIORITY ready list. */
+		TickType_t		xEDFBudgetUsed;
+		UBaseType_t		uxEDFDeadlineMisses;
+		UBaseType_t		uxEDFMissReported;		/*< Set to pdTRUE once the miss of the current job has been counted. */
+		TaskDeadlineMissHookFunction_t pxEDFDeadlineMissHook;
+	#endif
+
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		void			*pvMutexWaitedFor;		/*< The mutex the task is blocked on, or NULL.  Lets priority inheritance follow a chain of held mutexes. */
+	#endif
+
+	#if( ( configUSE_POLL_SETS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 1 ) )
+		void			*pvPollSetMember[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];	/*< The member of a poll set each notification index was added as, NULL if none. */
+	#endif
+
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+
+	#if( INCLUDE_xTaskAbortDelay == 1 )
+		uint8_t ucDelayAborted;
 	#endif
 
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
@@ -306,10 +428,6 @@ typedef struct tskTaskControlBlock
 		void			*pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 
-	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
-	#endif
-
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -321,19 +439,17 @@ typedef struct tskTaskControlBlock
 		struct	_reent xNewLib_reent;
 	#endif
 
-	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
-	#endif
-
 	/* See the comments above the definition of
 	tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE. */
 	#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
 		uint8_t	ucStaticallyAllocated; 		/*< Set to pdTRUE if the task is a statically allocated to ensure no attempt is made to free the memory. */
 	#endif
 
-	#if( INCLUDE_xTaskAbortDelay == 1 )
-		uint8_t ucDelayAborted;
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		/* The links of the list items in the skip index of a sorted list,
+		last so that the members above keep their offsets. */
+		ListSkipLink_t	xStateSkipLinks[ configLIST_SKIP_LEVELS ];
+		ListSkipLink_t	xEventSkipLinks[ configLIST_SKIP_LEVELS ];
 	#endif
 
 } tskTCB;
@@ -355,6 +471,12 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	PRIVILEGED_DATA static ListWheel_t xDelayedTaskWheel;				/*< Delayed tasks that wake within listWHEEL_HORIZON ticks.  The others wait in the delayed task lists. */
+
+#endif
+
 #if( INCLUDE_vTaskDelete == 1 )
 
 	PRIVILEGED_DATA static List_t xTasksWaitingTermination;				/*< Tasks that have been deleted - but their memory not yet freed. */
@@ -390,6 +512,16 @@ when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* pdFALSE while xTaskIncrementTicks() catches up on the ticks that follow
+	the first of a batch.  The running task has not necessarily run for those
+	ticks, and cannot complete its job before it runs again, so they are not
+	charged to the budget of its job. */
+	PRIVILEGED_DATA static BaseType_t xEDFChargeTick = pdTRUE;
+
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
@@ -397,6 +529,23 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( configUSE_TCB_SLAB == 1 )
+
+	/* Each TCB of a slab takes a whole number of cache lines, so a TCB starts
+	on a cache line when the slab does. */
+	#define tskTCB_SLAB_SLOT_SIZE	( ( sizeof( TCB_t ) + ( size_t ) portCACHE_LINE_SIZE - ( size_t ) 1 ) & ~( ( size_t ) portCACHE_LINE_SIZE - ( size_t ) 1 ) )
+
+	/* A TCB of a slab that no task uses, linked in the free list through its
+	first bytes. */
+	typedef struct tskTCB_SLAB_SLOT
+	{
+		struct tskTCB_SLAB_SLOT *pxNextFree;
+	} TCBSlabSlot_t;
+
+	PRIVILEGED_DATA static TCBSlabSlot_t *pxFreeTCBs = NULL;	/*< The free TCBs of all the slabs. */
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -563,6 +712,66 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Allocate and free the TCB of a task that is created dynamically, from a slab
+ * of TCBs if configUSE_TCB_SLAB is 1, otherwise from the heap.
+ */
+#if( configUSE_TCB_SLAB == 1 )
+
+	static TCB_t *prvAllocateTCB( void ) PRIVILEGED_FUNCTION;
+
+	#if( ( INCLUDE_vTaskDelete == 1 ) || ( portSTACK_GROWTH > 0 ) )
+		static void prvFreeTCB( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	#endif
+
+#else
+
+	#define prvAllocateTCB() ( ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ) )
+	#define prvFreeTCB( pxTCB ) vPortFree( pxTCB )
+
+#endif
+
+/*
+ * Allocate the TCB and stack of a task that is created dynamically.  Returns
+ * NULL if either could not be allocated.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static TCB_t *prvAllocateTCBAndStack( const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Move pxTCB to the priority uxNewPriority it inherits or disinherits, in the
+ * ready list of that priority if it is ready.
+ */
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static void prvSetInheritedPriority( TCB_t * const pxTCB, const UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * If pxTCB is blocked on a mutex, re-sort it in the list of tasks waiting for
+ * the mutex after its priority changed and return the holder of the mutex.
+ * Returns NULL if pxTCB is not blocked on a mutex.
+ */
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static TCB_t *prvRepositionOnMutexWaitList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Count a deadline miss of the current job of pxTCB, at most once per job,
+ * if the job has not completed by xTimeNow.
+ */
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvEDFCheckDeadline( TCB_t * const pxTCB, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -692,7 +901,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) prvAllocateTCB();
 
 			if( pxNewTCB != NULL )
 			{
@@ -739,6 +948,31 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 	TCB_t *pxNewTCB;
 	BaseType_t xReturn;
 
+		pxNewTCB = prvAllocateTCBAndStack( usStackDepth );
+
+		if( pxNewTCB != NULL )
+		{
+			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+			prvAddNewTaskToReadyList( pxNewTCB );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static TCB_t *prvAllocateTCBAndStack( const configSTACK_DEPTH_TYPE usStackDepth )
+	{
+	TCB_t *pxNewTCB;
+
 		/* If the stack grows down then allocate the stack then the TCB so the stack
 		does not grow into the TCB.  Likewise if the stack grows up then allocate
 		the TCB then the stack. */
@@ -747,7 +981,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) prvAllocateTCB();
 
 			if( pxNewTCB != NULL )
 			{
@@ -759,7 +993,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				if( pxNewTCB->pxStack == NULL )
 				{
 					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
+					prvFreeTCB( pxNewTCB );
 					pxNewTCB = NULL;
 				}
 			}
@@ -774,7 +1008,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+				pxNewTCB = ( TCB_t * ) prvAllocateTCB(); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -804,9 +1038,145 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
 			}
 			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewTCB;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TCB_SLAB == 1 )
+
+	static TCB_t *prvAllocateTCB( void )
+	{
+	TCB_t *pxTCB;
+	TCBSlabSlot_t *pxSlot;
+	uint8_t *pucSlab;
+	UBaseType_t x;
+
+		vTaskSuspendAll();
+		{
+			if( pxFreeTCBs == NULL )
+			{
+				/* All the TCBs are in use.  Allocate a new slab from the heap,
+				with room to start its first TCB on a cache line.  A slab is
+				never returned to the heap. */
+				pucSlab = ( uint8_t * ) pvPortMalloc( ( tskTCB_SLAB_SLOT_SIZE * ( size_t ) configTCB_SLAB_TCBS ) + ( size_t ) portCACHE_LINE_SIZE - ( size_t ) 1 );
+
+				if( pucSlab != NULL )
+				{
+					pucSlab += ( ( size_t ) portCACHE_LINE_SIZE - ( ( size_t ) pucSlab & ( ( size_t ) portCACHE_LINE_SIZE - ( size_t ) 1 ) ) ) & ( ( size_t ) portCACHE_LINE_SIZE - ( size_t ) 1 );
+
+					/* Link the TCBs from the last, so they are handed out in
+					the order of their addresses. */
+					for( x = ( UBaseType_t ) configTCB_SLAB_TCBS; x > ( UBaseType_t ) 0; x-- )
+					{
+						pxSlot = ( TCBSlabSlot_t * ) ( pucSlab + ( tskTCB_SLAB_SLOT_SIZE * ( size_t ) ( x - ( UBaseType_t ) 1 ) ) ); /*lint !e826 The slot is as large as a TCB. */
+						pxSlot->pxNextFree = pxFreeTCBs;
+						pxFreeTCBs = pxSlot;
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB = ( TCB_t * ) pxFreeTCBs; /*lint !e826 The slot is as large as a TCB. */
+
+			if( pxFreeTCBs != NULL )
+			{
+				pxFreeTCBs = pxFreeTCBs->pxNextFree;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return pxTCB;
+	}
+
+#endif /* configUSE_TCB_SLAB */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_TCB_SLAB == 1 ) && ( ( INCLUDE_vTaskDelete == 1 ) || ( portSTACK_GROWTH > 0 ) ) )
+
+	static void prvFreeTCB( TCB_t *pxTCB )
+	{
+	TCBSlabSlot_t * const pxSlot = ( TCBSlabSlot_t * ) pxTCB;
+
+		/* The TCB goes back to the free list, at the head so the next task
+		created takes the TCB that was used last. */
+		vTaskSuspendAll();
+		{
+			pxSlot->pxNextFree = pxFreeTCBs;
+			pxFreeTCBs = pxSlot;
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_TCB_SLAB */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_EDF_SCHEDULING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskCreateEDF(	TaskFunction_t pxTaskCode,
+								const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								void * const pvParameters,
+								const EDFParameters_t * const pxEDFParameters,
+								TaskHandle_t * const pxCreatedTask )
+	{
+	TCB_t *pxNewTCB;
+	BaseType_t xReturn;
+
+		configASSERT( pxEDFParameters );
+		configASSERT( pxEDFParameters->xPeriod > ( TickType_t ) 0 );
+		configASSERT( pxEDFParameters->xRelativeDeadline > ( TickType_t ) 0 );
+
+		pxNewTCB = prvAllocateTCBAndStack( usStackDepth );
+
+		if( pxNewTCB != NULL )
+		{
+			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, ( UBaseType_t ) configEDF_PRIORITY, pxCreatedTask, pxNewTCB, NULL );
+
+			/* The first job is released now.  The ready list insertion made
+			by prvAddNewTaskToReadyList() uses the deadline, so it must be
+			set first. */
+			pxNewTCB->xEDFPeriod = pxEDFParameters->xPeriod;
+			pxNewTCB->xEDFRelativeDeadline = pxEDFParameters->xRelativeDeadline;
+			pxNewTCB->xEDFBudget = pxEDFParameters->xBudget;
+			pxNewTCB->pxEDFDeadlineMissHook = pxEDFParameters->pxDeadlineMissHook;
+			pxNewTCB->xEDFReleaseTime = xTaskGetTickCount();
+			pxNewTCB->xEDFAbsoluteDeadline = pxNewTCB->xEDFReleaseTime + pxNewTCB->xEDFRelativeDeadline;
 
-			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
 			prvAddNewTaskToReadyList( pxNewTCB );
+
+			/* prvAddNewTaskToReadyList() only preempts the running task if
+			the new task has a higher priority.  At the same priority the
+			deadlines decide. */
+			if( ( xSchedulerRunning != pdFALSE ) &&
+				( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&
+				( pxNewTCB->xEDFAbsoluteDeadline < pxCurrentTCB->xEDFAbsoluteDeadline ) )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
 			xReturn = pdPASS;
 		}
 		else
@@ -817,7 +1187,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		return xReturn;
 	}
 
-#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+#endif /* ( configUSE_EDF_SCHEDULING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
 static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
@@ -931,9 +1301,22 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	{
+		pxNewTCB->pvMutexWaitedFor = NULL;
+	}
+	#endif
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+	{
+		listSET_LIST_ITEM_SKIP_LINKS( &( pxNewTCB->xStateListItem ), pxNewTCB->xStateSkipLinks );
+		listSET_LIST_ITEM_SKIP_LINKS( &( pxNewTCB->xEventListItem ), pxNewTCB->xEventSkipLinks );
+	}
+	#endif
+
 	/* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
 	back to	the containing TCB from a generic item in a list. */
 	listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
@@ -982,8 +1365,17 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				pxNewTCB->pvPollSetMember[ x ] = NULL;
+			}
+			#endif
+		}
 	}
 	#endif
 
@@ -1000,6 +1392,23 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		/* Not a deadline scheduled task unless xTaskCreateEDF() says
+		otherwise.  The maximum deadline places the task behind any deadline
+		scheduled task that shares its ready list. */
+		pxNewTCB->xEDFPeriod = ( TickType_t ) 0;
+		pxNewTCB->xEDFRelativeDeadline = portMAX_DELAY;
+		pxNewTCB->xEDFBudget = ( TickType_t ) 0;
+		pxNewTCB->xEDFReleaseTime = ( TickType_t ) 0;
+		pxNewTCB->xEDFAbsoluteDeadline = portMAX_DELAY;
+		pxNewTCB->xEDFBudgetUsed = ( TickType_t ) 0;
+		pxNewTCB->uxEDFDeadlineMisses = ( UBaseType_t ) 0;
+		pxNewTCB->uxEDFMissReported = pdFALSE;
+		pxNewTCB->pxEDFDeadlineMissHook = NULL;
+	}
+	#endif
+
 	//printf("tasks --> prvInitialiseNewTask --> before --> port.c \n");
 
 	/* Initialize the TCB stack to look as if the task was already running,
@@ -1126,6 +1535,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			being deleted. */
 			pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
+			/* The notifications of a task must be removed from their poll sets
+			before it is deleted. */
+			#if( ( configUSE_POLL_SETS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 1 ) )
+			{
+			UBaseType_t x;
+
+				for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+				{
+					configASSERT( pxTCB->pvPollSetMember[ x ] == NULL );
+				}
+			}
+			#endif
+
 			/* Remove task from the ready list. */
 			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 			{
@@ -1336,6 +1758,122 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvEDFCheckDeadline( TCB_t * const pxTCB, const TickType_t xTimeNow )
+	{
+		/* The job missed its deadline if the tick count reached the deadline
+		before the job completed.  The subtraction keeps the test correct when
+		the tick count overflows between the release and now. */
+		if( ( pxTCB->xEDFPeriod != ( TickType_t ) 0 ) &&
+			( pxTCB->uxEDFMissReported == pdFALSE ) &&
+			( ( TickType_t ) ( xTimeNow - pxTCB->xEDFReleaseTime ) >= pxTCB->xEDFRelativeDeadline ) )
+		{
+			pxTCB->uxEDFMissReported = pdTRUE;
+			( pxTCB->uxEDFDeadlineMisses )++;
+
+			if( pxTCB->pxEDFDeadlineMissHook != NULL )
+			{
+				pxTCB->pxEDFDeadlineMissHook( ( TaskHandle_t ) pxTCB, pxTCB->xEDFAbsoluteDeadline );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskEDFWaitForNextPeriod( void )
+	{
+	TickType_t xTimeNow, xPreviousRelease;
+	BaseType_t xAlreadyYielded;
+
+		configASSERT( pxCurrentTCB->xEDFPeriod != ( TickType_t ) 0 );
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		vTaskSuspendAll();
+		{
+			xTimeNow = xTickCount;
+
+			/* Record a miss if the job completed too late. */
+			prvEDFCheckDeadline( pxCurrentTCB, xTimeNow );
+
+			/* Start the next job. */
+			xPreviousRelease = pxCurrentTCB->xEDFReleaseTime;
+			pxCurrentTCB->xEDFReleaseTime += pxCurrentTCB->xEDFPeriod;
+			pxCurrentTCB->xEDFAbsoluteDeadline = pxCurrentTCB->xEDFReleaseTime + pxCurrentTCB->xEDFRelativeDeadline;
+			pxCurrentTCB->xEDFBudgetUsed = ( TickType_t ) 0;
+			pxCurrentTCB->uxEDFMissReported = pdFALSE;
+
+			if( ( TickType_t ) ( xTimeNow - xPreviousRelease ) < pxCurrentTCB->xEDFPeriod )
+			{
+				/* As in vTaskDelayUntil(), the task cannot be in an event
+				list as it is the currently executing task. */
+				prvAddCurrentTaskToDelayedList( pxCurrentTCB->xEDFReleaseTime - xTimeNow, pdFALSE );
+			}
+			else
+			{
+				/* The next job has already been released.  Its later deadline
+				moves the task within its ready list. */
+				if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvAddTaskToReadyList( pxCurrentTCB );
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		/* Force a reschedule if xTaskResumeAll has not already done so, either
+		this task is now blocked or another task may have an earlier
+		deadline. */
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	UBaseType_t uxTaskEDFGetDeadlineMisses( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxEDFDeadlineMisses;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) )
 
 	eTaskState eTaskGetState( TaskHandle_t xTask )
@@ -1366,6 +1904,13 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				eReturn = eBlocked;
 			}
 
+			#if( configUSE_TIMING_WHEEL == 1 )
+				else if( listWHEEL_CONTAINS_LIST( &xDelayedTaskWheel, pxStateList ) != pdFALSE )
+				{
+					eReturn = eBlocked;
+				}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 				else if( pxStateList == &xSuspendedTaskList )
 				{
@@ -1672,11 +2217,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -1994,6 +2544,14 @@ BaseType_t xReturn;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( TickType_t ) 0U;
 
+		#if( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* No task can be delayed yet, so the wheel is empty and only its
+			time needs to follow the tick count. */
+			vListWheelInitialise( &xDelayedTaskWheel, xTickCount );
+		}
+		#endif /* configUSE_TIMING_WHEEL */
+
 		/* If configGENERATE_RUN_TIME_STATS is defined then the following
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
@@ -2002,6 +2560,10 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		/* The first task is switched in without a call to
+		vTaskSwitchContext(). */
+		traceTASK_SWITCHED_IN();
+
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
 		if( xPortStartScheduler() != pdFALSE )
@@ -2045,7 +2607,20 @@ void vTaskSuspendAll( void )
 	BaseType_t.  Please read Richard Barry's reply in the following link to a
 	post in the FreeRTOS support forum before reporting this as a bug! -
 	http://goo.gl/wu4acr */
-	++uxSchedulerSuspended;
+	#if( portSUSPEND_ALL_IN_CRITICAL == 1 )
+	{
+		/* The port needs the suspension to be a kernel entry of its own. */
+		taskENTER_CRITICAL();
+		{
+			++uxSchedulerSuspended;
+		}
+		taskEXIT_CRITICAL();
+	}
+	#else
+	{
+		++uxSchedulerSuspended;
+	}
+	#endif /* portSUSPEND_ALL_IN_CRITICAL */
 }
 /*----------------------------------------------------------*/
 
@@ -2388,6 +2963,20 @@ TCB_t *pxTCB;
 				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
 			}
 
+			#if( configUSE_TIMING_WHEEL == 1 )
+			{
+				for( uxQueue = 0; ( uxQueue < ( UBaseType_t ) listWHEEL_SLOTS ) && ( pxTCB == NULL ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel.xSlots[ uxQueue ] ), pcNameToQuery );
+				}
+
+				for( uxQueue = 0; ( uxQueue < ( UBaseType_t ) listWHEEL_ROUNDS ) && ( pxTCB == NULL ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel.xRounds[ uxQueue ] ), pcNameToQuery );
+				}
+			}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
 				if( pxTCB == NULL )
@@ -2441,6 +3030,20 @@ TCB_t *pxTCB;
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
+				#if( configUSE_TIMING_WHEEL == 1 )
+				{
+					for( uxQueue = 0; uxQueue < ( UBaseType_t ) listWHEEL_SLOTS; uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel.xSlots[ uxQueue ] ), eBlocked );
+					}
+
+					for( uxQueue = 0; uxQueue < ( UBaseType_t ) listWHEEL_ROUNDS; uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel.xRounds[ uxQueue ] ), eBlocked );
+					}
+				}
+				#endif
+
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
 					/* Fill in an TaskStatus_t structure with information on
@@ -2572,7 +3175,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( prvTaskPreemptsCurrentTask( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2601,7 +3204,9 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 BaseType_t xTaskIncrementTick( void )
 {
 TCB_t * pxTCB;
-TickType_t xItemValue;
+#if( configUSE_TIMING_WHEEL == 0 )
+	TickType_t xItemValue;
+#endif
 BaseType_t xSwitchRequired = pdFALSE;
 
 	/* Called by the portable layer each time a tick interrupt occurs.
@@ -2618,15 +3223,162 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+		#if( configUSE_64_BIT_TICKS == 0 )
 		{
-			taskSWITCH_DELAYED_LISTS();
+			if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+			{
+				taskSWITCH_DELAYED_LISTS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		else
+		#endif /* configUSE_64_BIT_TICKS */
+
+		#if( configUSE_EDF_SCHEDULING == 1 )
 		{
-			mtCOVERAGE_TEST_MARKER();
+			/* Charge the tick to the running job if it belongs to a deadline
+			scheduled task.  Only a task that is still in the ready list is
+			charged, as the running task may have just blocked. */
+			if( ( pxCurrentTCB->xEDFPeriod != ( TickType_t ) 0 ) &&
+				( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				prvEDFCheckDeadline( pxCurrentTCB, xConstTickCount );
+
+				if( xEDFChargeTick != pdFALSE )
+				{
+					( pxCurrentTCB->xEDFBudgetUsed )++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( ( pxCurrentTCB->xEDFBudget != ( TickType_t ) 0 ) && ( pxCurrentTCB->xEDFBudgetUsed > pxCurrentTCB->xEDFBudget ) )
+				{
+				TickType_t xTicksToRelease;
+
+					/* The job has overrun its budget.  It is abandoned - counted
+					as a deadline miss - and the task is throttled until the
+					next release, from where it continues as the next job. */
+					if( pxCurrentTCB->uxEDFMissReported == pdFALSE )
+					{
+						pxCurrentTCB->uxEDFMissReported = pdTRUE;
+						( pxCurrentTCB->uxEDFDeadlineMisses )++;
+
+						if( pxCurrentTCB->pxEDFDeadlineMissHook != NULL )
+						{
+							pxCurrentTCB->pxEDFDeadlineMissHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->xEDFAbsoluteDeadline );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					pxCurrentTCB->xEDFReleaseTime += pxCurrentTCB->xEDFPeriod;
+					pxCurrentTCB->xEDFAbsoluteDeadline = pxCurrentTCB->xEDFReleaseTime + pxCurrentTCB->xEDFRelativeDeadline;
+					pxCurrentTCB->xEDFBudgetUsed = ( TickType_t ) 0;
+					pxCurrentTCB->uxEDFMissReported = pdFALSE;
+
+					xTicksToRelease = pxCurrentTCB->xEDFReleaseTime - xConstTickCount;
+
+					if( ( xTicksToRelease != ( TickType_t ) 0 ) && ( xTicksToRelease <= pxCurrentTCB->xEDFPeriod ) )
+					{
+						/* The next release is in the future. */
+						prvAddCurrentTaskToDelayedList( xTicksToRelease, pdFALSE );
+					}
+					else
+					{
+						/* The next release has already passed, so only the
+						position of the task in the ready list changes. */
+						( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+						prvAddTaskToReadyList( pxCurrentTCB );
+					}
+
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The earliest deadline ready task might be waiting behind a
+			higher priority task. */
+			if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) ) == pdFALSE )
+			{
+				pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) );
+				prvEDFCheckDeadline( pxTCB, xConstTickCount );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+		#endif /* configUSE_EDF_SCHEDULING */
+
+		#if( configUSE_TIMING_WHEEL == 1 )
+		{
+		List_t *pxExpiredTasks;
+
+			/* Tasks that wake too far ahead for the wheel wait in the sorted
+			delayed lists.  Move them into the wheel as they come within its
+			reach - only the heads of the lists need to be checked. */
+			vListWheelMigrate( &xDelayedTaskWheel, pxDelayedTaskList );
+
+			#if( configUSE_64_BIT_TICKS == 0 )
+			{
+				vListWheelMigrate( &xDelayedTaskWheel, pxOverflowDelayedTaskList );
+			}
+			#endif
+
+			/* Every task in the list the wheel returns for this tick wakes
+			now, so no wake time needs to be compared. */
+			pxExpiredTasks = pxListWheelAdvance( &xDelayedTaskWheel );
+
+			while( listLIST_IS_EMPTY( pxExpiredTasks ) == pdFALSE )
+			{
+				pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExpiredTasks );
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Is the task waiting on an event also?  If so remove it from
+				the event list. */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvAddTaskToReadyList( pxTCB );
 
+				#if (  configUSE_PREEMPTION == 1 )
+				{
+					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
+			}
+		}
+		#else
 		/* See if this tick has made a timeout expire.  Tasks are stored in
 		the	queue in the order of their wake time - meaning once one task
 		has been found whose block time has not expired there is no need to
@@ -2708,6 +3460,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 				}
 			}
 		}
+		#endif /* configUSE_TIMING_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
@@ -2761,10 +3514,97 @@ BaseType_t xSwitchRequired = pdFALSE;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_PREEMPTION */
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTicks( TickType_t xTicksToAdvance )
+{
+BaseType_t xSwitchRequired = pdFALSE;
+#if( ( configUSE_EDF_SCHEDULING == 0 ) && ( configUSE_TIMING_WHEEL == 0 ) )
+	TickType_t xTicksToJump;
+#endif
+
+	configASSERT( xTicksToAdvance > ( TickType_t ) 0 );
+
+	while( xTicksToAdvance > ( TickType_t ) 0 )
+	{
+		#if( ( configUSE_EDF_SCHEDULING == 0 ) && ( configUSE_TIMING_WHEEL == 0 ) )
+		{
+			/* Until the next delayed task is due nothing but the tick count
+			changes, so those ticks are stepped over in one go, as
+			vTaskStepTick() does after a tickless idle period.  The tick that
+			unblocks a task and the last tick go through xTaskIncrementTick().
+			xNextTaskUnblockTime is never more than portMAX_DELAY, so the step
+			cannot overflow the tick count.  While the scheduler is suspended
+			xTaskIncrementTick() only counts the ticks in uxPendedTicks, which
+			xTaskResumeAll() unwinds later. */
+			if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) && ( xNextTaskUnblockTime > xTickCount ) )
+			{
+				xTicksToJump = ( xNextTaskUnblockTime - xTickCount ) - ( TickType_t ) 1;
+
+				if( xTicksToJump > ( xTicksToAdvance - ( TickType_t ) 1 ) )
+				{
+					xTicksToJump = xTicksToAdvance - ( TickType_t ) 1;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xTickCount += xTicksToJump;
+				xTicksToAdvance -= xTicksToJump;
+				traceINCREASE_TICK_COUNT( xTicksToJump );
+
+				#if ( configUSE_TICK_HOOK == 1 )
+				{
+					/* The hook still sees every tick. */
+					while( xTicksToJump > ( TickType_t ) 0 )
+					{
+						vApplicationTickHook();
+						xTicksToJump--;
+					}
+				}
+				#endif /* configUSE_TICK_HOOK */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* ( configUSE_EDF_SCHEDULING == 0 ) && ( configUSE_TIMING_WHEEL == 0 ) */
+
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			xSwitchRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xTicksToAdvance--;
+
+		#if( configUSE_EDF_SCHEDULING == 1 )
+		{
+			/* Only the first tick of the batch is charged to the running
+			job, a job whose budget covers its cost is never abandoned
+			because the host delivered its ticks late. */
+			xEDFChargeTick = pdFALSE;
 		}
+		#endif
 	}
-	#endif /* configUSE_PREEMPTION */
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		xEDFChargeTick = pdTRUE;
+	}
+	#endif
 
 	return xSwitchRequired;
 }
@@ -2936,7 +3776,7 @@ void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksT
 }
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const ListItemValue_t xItemValue, const TickType_t xTicksToWait )
 {
 	configASSERT( pxEventList );
 
@@ -3027,7 +3867,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( prvTaskPreemptsCurrentTask( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3061,7 +3901,7 @@ BaseType_t xReturn;
 }
 /*-----------------------------------------------------------*/
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const ListItemValue_t xItemValue )
 {
 TCB_t *pxUnblockedTCB;
 
@@ -3084,7 +3924,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( prvTaskPreemptsCurrentTask( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3095,6 +3935,53 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const ListItemValue_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+		called from a critical section within an ISR.  It is used by event
+		groups that interrupts set bits in directly. */
+
+		/* Store the new item value in the event list. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		/* As xTaskRemoveFromEventList(). */
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed. */
+			vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+		}
+
+		if( prvTaskPreemptsCurrentTask( pxUnblockedTCB ) )
+		{
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3297,6 +4184,8 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 		}
 		#endif /* configUSE_IDLE_HOOK */
 
+		portIDLE();
+
 		/* This conditional compilation should use inequality to 0, not equality
 		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
 		user defined low power mode	implementations require
@@ -3474,6 +4363,12 @@ UBaseType_t uxPriority;
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
 	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+
+	#if( configUSE_TIMING_WHEEL == 1 )
+	{
+		vListWheelInitialise( &xDelayedTaskWheel, xTickCount );
+	}
+	#endif /* configUSE_TIMING_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -3705,7 +4600,7 @@ static void prvCheckTasksWaitingTermination( void )
 			/* The task can only have been allocated dynamically - free both
 			the stack and TCB. */
 			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			prvFreeTCB( pxTCB );
 		}
 		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
 		{
@@ -3717,13 +4612,13 @@ static void prvCheckTasksWaitingTermination( void )
 				/* Both the stack and TCB were allocated dynamically, so both
 				must be freed. */
 				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				prvFreeTCB( pxTCB );
 			}
 			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
 			{
 				/* Only the stack was statically allocated, so the TCB is the
 				only memory that must be freed. */
-				vPortFree( pxTCB );
+				prvFreeTCB( pxTCB );
 			}
 			else
 			{
@@ -3862,6 +4757,32 @@ TCB_t *pxTCB;
 
 				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 
+				#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+				{
+				TCB_t *pxTCB = pxMutexHolderTCB;
+				UBaseType_t uxDepth;
+
+					/* If the mutex holder is itself blocked on a mutex, then the
+					holder of that mutex is also in the way of this task, and so
+					on down the chain.  Each holder that has a lower priority
+					inherits the priority of this task.  The walk stops at a
+					holder that already has the priority, as everything after it
+					in the chain has it too. */
+					for( uxDepth = ( UBaseType_t ) 1; uxDepth < ( UBaseType_t ) configPRIORITY_INHERITANCE_MAX_DEPTH; uxDepth++ )
+					{
+						pxTCB = prvRepositionOnMutexWaitList( pxTCB );
+
+						if( ( pxTCB == NULL ) || ( pxTCB->uxPriority >= pxCurrentTCB->uxPriority ) )
+						{
+							break;
+						}
+
+						traceTASK_PRIORITY_INHERIT( pxTCB, pxCurrentTCB->uxPriority );
+						prvSetInheritedPriority( pxTCB, pxCurrentTCB->uxPriority );
+					}
+				}
+				#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+
 				/* Inheritance occurred. */
 				xReturn = pdTRUE;
 			}
@@ -4057,6 +4978,50 @@ TCB_t *pxTCB;
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+
+					#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+					{
+					TCB_t *pxWaitingTCB = pxTCB, *pxHolderTCB;
+					UBaseType_t uxDepth;
+
+						/* The priority the mutex holder had may have been passed
+						on down a chain of held mutexes.  Each holder in the
+						chain goes back to the greater of its base priority and
+						the priority of the highest priority task still waiting
+						for the mutex it holds, with the same single mutex
+						simplification as above.  The running task disinherits
+						when it gives its mutexes back. */
+						for( uxDepth = ( UBaseType_t ) 1; uxDepth < ( UBaseType_t ) configPRIORITY_INHERITANCE_MAX_DEPTH; uxDepth++ )
+						{
+							pxHolderTCB = prvRepositionOnMutexWaitList( pxWaitingTCB );
+
+							if( ( pxHolderTCB == NULL ) || ( pxHolderTCB == pxCurrentTCB ) || ( pxHolderTCB->uxMutexesHeld != uxOnlyOneMutexHeld ) )
+							{
+								break;
+							}
+
+							uxPriorityToUse = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( ( List_t * ) listLIST_ITEM_CONTAINER( &( pxWaitingTCB->xEventListItem ) ) );
+
+							if( uxPriorityToUse < pxHolderTCB->uxBasePriority )
+							{
+								uxPriorityToUse = pxHolderTCB->uxBasePriority;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+
+							if( pxHolderTCB->uxPriority == uxPriorityToUse )
+							{
+								break;
+							}
+
+							traceTASK_PRIORITY_DISINHERIT( pxHolderTCB, uxPriorityToUse );
+							prvSetInheritedPriority( pxHolderTCB, uxPriorityToUse );
+							pxWaitingTCB = pxHolderTCB;
+						}
+					}
+					#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
 				}
 				else
 				{
@@ -4077,6 +5042,144 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static void prvSetInheritedPriority( TCB_t * const pxTCB, const UBaseType_t uxNewPriority )
+	{
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTCB->uxPriority = uxNewPriority;
+
+		/* There is one ready list per priority, so a ready task moves. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( uxPriorityUsedOnEntry );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static TCB_t *prvRepositionOnMutexWaitList( TCB_t * const pxTCB )
+	{
+	List_t * const pxEventList = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+	TCB_t *pxHolderTCB = NULL;
+
+		/* Called from a critical section.  A task that was unblocked while the
+		scheduler was suspended is in the pending ready list and still has the
+		mutex recorded until it runs, so the mutex is only followed while the
+		task is in the list of tasks waiting for it. */
+		if( ( pxTCB->pvMutexWaitedFor != NULL ) && ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+		{
+			/* The list of waiting tasks is in priority order, and the event
+			list item value of the task has been changed to its new priority. */
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+
+			pxHolderTCB = ( TCB_t * ) xQueueGetMutexHolderFromISR( ( QueueHandle_t ) pxTCB->pvMutexWaitedFor );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxHolderTCB;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+	eMutexHolderState eTaskGetMutexHolderState( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = ( TCB_t * ) pxMutexHolder;
+	eMutexHolderState eReturn = eHolderBlocked;
+
+		/* The holder can be NULL if the mutex was given since the caller found
+		it held. */
+		if( pxTCB != NULL )
+		{
+			if( portTASK_IS_RUNNING_ON_OTHER_CORE( pxMutexHolder ) != pdFALSE )
+			{
+				eReturn = eHolderRunning;
+			}
+			else if( ( pxTCB->uxPriority == pxCurrentTCB->uxPriority ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				/* A yield goes round robin to the next ready task of the
+				priority, except at the EDF priority where the task with the
+				earliest deadline runs, which may be the calling task again. */
+				#if( configUSE_EDF_SCHEDULING == 1 )
+				{
+					if( pxTCB->uxPriority != ( UBaseType_t ) configEDF_PRIORITY )
+					{
+						eReturn = eHolderReady;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#else
+				{
+					eReturn = eHolderReady;
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return eReturn;
+	}
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	void vTaskSetMutexWaitedFor( void *pvMutex )
+	{
+		/* Only the task itself writes the field, and other tasks read it from
+		critical sections. */
+		pxCurrentTCB->pvMutexWaitedFor = pvMutex;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
 	void vTaskEnterCritical( void )
@@ -4391,9 +5494,9 @@ TCB_t *pxTCB;
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-TickType_t uxTaskResetEventItemValue( void )
+ListItemValue_t uxTaskResetEventItemValue( void )
 {
-TickType_t uxReturn;
+ListItemValue_t uxReturn;
 
 	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
 
@@ -4424,17 +5527,19 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4462,17 +5567,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4480,7 +5585,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4492,22 +5597,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4540,14 +5647,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4556,11 +5663,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4572,44 +5679,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4626,6 +5734,28 @@ TickType_t uxReturn;
 
 			traceTASK_NOTIFY();
 
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				/* The notification can be taken, so put the index on the
+				ready list of its poll set. */
+				if( pxTCB->pvPollSetMember[ uxIndexToNotify ] != NULL )
+				{
+					if( xPollSetMemberReady( pxTCB->pvPollSetMember[ uxIndexToNotify ] ) != pdFALSE )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
+
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
 			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
@@ -4652,7 +5782,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( prvTaskPreemptsCurrentTask( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4678,7 +5808,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4686,6 +5816,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4711,30 +5842,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4751,6 +5882,34 @@ TickType_t uxReturn;
 
 			traceTASK_NOTIFY_FROM_ISR();
 
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				/* As in xTaskGenericNotify(). */
+				if( pxTCB->pvPollSetMember[ uxIndexToNotify ] != NULL )
+				{
+					if( xPollSetMemberReady( pxTCB->pvPollSetMember[ uxIndexToNotify ] ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							xYieldPending = pdTRUE;
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
+
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
 			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
@@ -4770,7 +5929,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( prvTaskPreemptsCurrentTask( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4802,13 +5961,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4832,15 +5992,43 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				/* As in xTaskGenericNotify(). */
+				if( pxTCB->pvPollSetMember[ uxIndexToNotify ] != NULL )
+				{
+					if( xPollSetMemberReady( pxTCB->pvPollSetMember[ uxIndexToNotify ] ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							xYieldPending = pdTRUE;
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
+
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
 			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
@@ -4860,7 +6048,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( prvTaskPreemptsCurrentTask( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4891,20 +6079,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -4920,6 +6110,40 @@ TickType_t uxReturn;
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_POLL_SETS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 1 ) )
+
+	void **ppvTaskGetPollSetMember( TaskHandle_t xTask, UBaseType_t uxIndex )
+	{
+	TCB_t * const pxTCB = prvGetTCBFromHandle( xTask );
+
+		configASSERT( uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		return &( pxTCB->pvPollSetMember[ uxIndex ] );
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskGenericNotifyIsPending( TaskHandle_t xTask, UBaseType_t uxIndex )
+	{
+	const TCB_t * const pxTCB = prvGetTCBFromHandle( xTask );
+	BaseType_t xReturn;
+
+		configASSERT( uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		if( pxTCB->ucNotifyState[ uxIndex ] == taskNOTIFICATION_RECEIVED )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
+
 
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
@@ -4961,12 +6185,27 @@ const TickType_t xConstTickCount = xTickCount;
 		{
 			/* Calculate the time at which the task should be woken if the event
 			does not occur.  This may overflow but this doesn't matter, the
-			kernel will manage it correctly. */
-			xTimeToWake = xConstTickCount + xTicksToWait;
+			kernel will manage it correctly.  A 64-bit tick count does not
+			overflow, and a wake time beyond it is never reached. */
+			#if( configUSE_64_BIT_TICKS == 1 )
+				xTimeToWake = ( xTicksToWait < ( portMAX_DELAY - xConstTickCount ) ) ? ( xConstTickCount + xTicksToWait ) : portMAX_DELAY;
+			#else
+				xTimeToWake = xConstTickCount + xTicksToWait;
+			#endif
 
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+			#if( configUSE_TIMING_WHEEL == 1 )
+				if( xListWheelInsert( &xDelayedTaskWheel, &( pxCurrentTCB->xStateListItem ) ) != pdFAIL )
+				{
+					/* The task wakes within reach of the wheel, which does not
+					use xNextTaskUnblockTime. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+				else
+			#endif
+			#if( configUSE_64_BIT_TICKS == 0 )
 			if( xTimeToWake < xConstTickCount )
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
@@ -4974,6 +6213,7 @@ const TickType_t xConstTickCount = xTickCount;
 				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
+			#endif
 			{
 				/* The wake time has not overflowed, so the current block list
 				is used. */
@@ -4997,18 +6237,34 @@ const TickType_t xConstTickCount = xTickCount;
 	{
 		/* Calculate the time at which the task should be woken if the event
 		does not occur.  This may overflow but this doesn't matter, the kernel
-		will manage it correctly. */
-		xTimeToWake = xConstTickCount + xTicksToWait;
+		will manage it correctly.  A 64-bit tick count does not overflow, and a
+		wake time beyond it is never reached. */
+		#if( configUSE_64_BIT_TICKS == 1 )
+			xTimeToWake = ( xTicksToWait < ( portMAX_DELAY - xConstTickCount ) ) ? ( xConstTickCount + xTicksToWait ) : portMAX_DELAY;
+		#else
+			xTimeToWake = xConstTickCount + xTicksToWait;
+		#endif
 
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+		#if( configUSE_TIMING_WHEEL == 1 )
+			if( xListWheelInsert( &xDelayedTaskWheel, &( pxCurrentTCB->xStateListItem ) ) != pdFAIL )
+			{
+				/* The task wakes within reach of the wheel, which does not use
+				xNextTaskUnblockTime. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else
+		#endif
+		#if( configUSE_64_BIT_TICKS == 0 )
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
 			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 		}
 		else
+		#endif
 		{
 			/* The wake time has not overflowed, so the current block list is used. */
 			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
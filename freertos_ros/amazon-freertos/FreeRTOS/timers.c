@@ -80,6 +80,14 @@ typedef struct tmrTimerControl
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t 			ucStaticallyAllocated; /*<< Set to pdTRUE if the timer was created statically so no attempt is made to free the memory again if the timer is later deleted. */
 	#endif
+
+	#if( configTIMER_SERVICE_TASKS > 1 )
+		UBaseType_t			uxTimerService;		/*<< The index of the timer service task that processes the timer's commands and calls its callback. */
+	#endif
+
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		ListSkipLink_t		xTimerSkipLinks[ configLIST_SKIP_LEVELS ];	/*<< The links of xTimerListItem in the skip index of a sorted list. */
+	#endif
 } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -105,7 +113,14 @@ typedef struct tmrCallbackParameters
 	uint32_t ulParameter2;					/* << The value that will be used as the callback functions second parameter. */
 } CallbackParameters_t;
 
-/* The structure that contains the two message types, along with an identifier
+typedef struct tmrBulkParameters
+{
+	TickType_t			xMessageValue;		/*<< The command time, as for a single timer. */
+	Timer_t * const *	ppxTimers;			/*<< The timers to which the command will be applied. */
+	UBaseType_t			uxNumberOfTimers;	/*<< The number of timers in ppxTimers. */
+} BulkParameters_t;
+
+/* The structure that contains the message types, along with an identifier
 that is used to determine which message type is valid. */
 typedef struct tmrTimerQueueMessage
 {
@@ -113,6 +128,7 @@ typedef struct tmrTimerQueueMessage
 	union
 	{
 		TimerParameter_t xTimerParameters;
+		BulkParameters_t xBulkParameters;
 
 		/* Don't include xCallbackParameters if it is not going to be used as
 		it makes the structure (and therefore the timer queue) larger. */
@@ -125,20 +141,51 @@ typedef struct tmrTimerQueueMessage
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+/* The state of one timer service task.  There are configTIMER_SERVICE_TASKS of
+them, each with its own priority, command queue and active timers, so a slow
+callback only delays the timers of its own service. */
+typedef struct tmrTimerService
+{
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access these lists. */
+	List_t				xActiveTimerList1;
+	List_t				xActiveTimerList2;
+	List_t				*pxCurrentTimerList;
+	List_t				*pxOverflowTimerList;
+
+	#if( configUSE_TIMING_WHEEL == 1 )
+		/* Active timers that expire within listWHEEL_HORIZON ticks of the
+		wheel time are held in a timing wheel rather than in the lists above.
+		The wheel time is the tick up to which expired timers have been
+		processed. */
+		ListWheel_t		xActiveTimerWheel;
+	#endif
+
+	/* A queue that is used to send commands to the timer service task. */
+	QueueHandle_t		xTimerQueue;
+	TaskHandle_t		xTimerTaskHandle;
 
-/* A queue that is used to send commands to the timer service task. */
-PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
-PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
+	#if( configUSE_64_BIT_TICKS == 0 )
+		/* The tick count when prvSampleTimeNow() was last called, to detect
+		the overflow of the tick count. */
+		TickType_t		xLastTime;
+	#endif
+} TimerService_t;
+
+PRIVILEGED_DATA static TimerService_t xTimerServices[ configTIMER_SERVICE_TASKS ];
 
 /*lint -restore */
 
+/* The priority of each timer service task. */
+static const UBaseType_t uxTimerServicePriorities[ configTIMER_SERVICE_TASKS ] = configTIMER_SERVICE_TASK_PRIORITIES;
+
+#if( configTIMER_SERVICE_TASKS > 1 )
+	#define prvGetTimerService( pxTimer ) ( &( xTimerServices[ ( pxTimer )->uxTimerService ] ) )
+#else
+	#define prvGetTimerService( pxTimer ) ( &( xTimerServices[ 0 ] ) )
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -149,6 +196,14 @@ PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 	and TCB. */
 	extern void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
 
+	#if( configTIMER_SERVICE_TASKS > 1 )
+
+		/* The same for the timer service tasks other than the first, which
+		is the one vApplicationGetTimerTaskMemory() provides for. */
+		extern void vApplicationGetTimerServiceTaskMemory( UBaseType_t uxTimerService, StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+
+	#endif
+
 #endif
 
 /*
@@ -160,7 +215,7 @@ static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
 /*
  * The timer service task (daemon).  Timer functionality is controlled by this
  * task.  Other tasks communicate with the timer service task using the
- * xTimerQueue queue.
+ * xTimerQueue queue of the service passed in pvParameters.
  */
 static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
 
@@ -168,7 +223,7 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
  * Called by the timer service task to interpret and process a command it
  * received on the timer queue.
  */
-static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
+static void prvProcessReceivedCommands( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
@@ -180,19 +235,56 @@ static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const Tic
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto reload timer, then call its callback.
  */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvProcessExpiredTimer( Timer_t * const pxTimer, const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * Process every timer that expires up to xTimeNow in one pass, in expiry
+ * order.  With configUSE_TIMING_WHEEL the timer wheel is advanced up to
+ * xTimeNow, moving timers from the sorted lists into the wheel as they come
+ * within its reach.
  */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+static void prvProcessExpiredTimers( TimerService_t * const pxService, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Put an auto reload timer that expired at xExpiredTime back in the active
+ * list and call its callback for that expiry.  If the following expiry time
+ * has passed as well the callback is then called again, once per period that
+ * has been missed, so the callbacks come in expiry order.
+ */
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Apply one of the single timer commands to pxTimer.
+ */
+static void prvProcessTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xMessageValue ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Return the number of ticks from the wheel time until a timer in the
+	 * wheel might expire, or a timer in the sorted lists must be moved into the
+	 * wheel, whichever comes first.  *pxListWasEmpty is set to pdTRUE if there
+	 * are no active timers.
+	 */
+	static TickType_t prvGetTicksToNextWheelEvent( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_64_BIT_TICKS == 0 )
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
  * if a tick count overflow occurred since prvSampleTimeNow() was last called.
  */
-static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+static TickType_t prvSampleTimeNow( TimerService_t * const pxService, BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
 
 /*
  * If the timer list contains any active timers then return the expire time of
@@ -200,13 +292,13 @@ static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched
  * timer list does not contain any timers then return 0 and set *pxListWasEmpty
  * to pdTRUE.
  */
-static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+static TickType_t prvGetNextExpireTime( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
 
 /*
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+static void prvProcessTimerOrBlockTask( TimerService_t * const pxService, const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
 /*
  * Called after a Timer_t structure has been allocated either statically or
@@ -217,55 +309,83 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 									const UBaseType_t uxAutoReload,
 									void * const pvTimerID,
 									TimerCallbackFunction_t pxCallbackFunction,
+									const UBaseType_t uxTimerService,
 									Timer_t *pxNewTimer ) PRIVILEGED_FUNCTION;
 /*-----------------------------------------------------------*/
 
 BaseType_t xTimerCreateTimerTask( void )
 {
 BaseType_t xReturn = pdFAIL;
+TimerService_t *pxService;
+UBaseType_t uxTimerService;
 
 	/* This function is called when the scheduler is started if
 	configUSE_TIMERS is set to 1.  Check that the infrastructure used by the
-	timer service task has been created/initialised.  If timers have already
+	timer service tasks has been created/initialised.  If timers have already
 	been created then the initialisation will already have been performed. */
 	prvCheckForValidListAndQueue();
 
-	if( xTimerQueue != NULL )
+	for( uxTimerService = 0; uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS; uxTimerService++ )
 	{
-		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		pxService = &( xTimerServices[ uxTimerService ] );
+		xReturn = pdFAIL;
+
+		if( pxService->xTimerQueue != NULL )
 		{
-			StaticTask_t *pxTimerTaskTCBBuffer = NULL;
-			StackType_t *pxTimerTaskStackBuffer = NULL;
-			uint32_t ulTimerTaskStackSize;
-
-			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
-			xTimerTaskHandle = xTaskCreateStatic(	prvTimerTask,
-													configTIMER_SERVICE_TASK_NAME,
-													ulTimerTaskStackSize,
-													NULL,
-													( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-													pxTimerTaskStackBuffer,
-													pxTimerTaskTCBBuffer );
-
-			if( xTimerTaskHandle != NULL )
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
-				xReturn = pdPASS;
+				StaticTask_t *pxTimerTaskTCBBuffer = NULL;
+				StackType_t *pxTimerTaskStackBuffer = NULL;
+				uint32_t ulTimerTaskStackSize;
+
+				#if( configTIMER_SERVICE_TASKS > 1 )
+				if( uxTimerService != ( UBaseType_t ) 0 )
+				{
+					vApplicationGetTimerServiceTaskMemory( uxTimerService, &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
+				}
+				else
+				#endif /* configTIMER_SERVICE_TASKS */
+				{
+					vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
+				}
+
+				pxService->xTimerTaskHandle = xTaskCreateStatic(	prvTimerTask,
+																	configTIMER_SERVICE_TASK_NAME,
+																	ulTimerTaskStackSize,
+																	( void * ) pxService,
+																	uxTimerServicePriorities[ uxTimerService ] | portPRIVILEGE_BIT,
+																	pxTimerTaskStackBuffer,
+																	pxTimerTaskTCBBuffer );
+
+				if( pxService->xTimerTaskHandle != NULL )
+				{
+					xReturn = pdPASS;
+				}
 			}
+			#else
+			{
+				xReturn = xTaskCreate(	prvTimerTask,
+										configTIMER_SERVICE_TASK_NAME,
+										configTIMER_TASK_STACK_DEPTH,
+										( void * ) pxService,
+										uxTimerServicePriorities[ uxTimerService ] | portPRIVILEGE_BIT,
+										&( pxService->xTimerTaskHandle ) );
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
 		}
-		#else
+		else
 		{
-			xReturn = xTaskCreate(	prvTimerTask,
-									configTIMER_SERVICE_TASK_NAME,
-									configTIMER_TASK_STACK_DEPTH,
-									NULL,
-									( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-									&xTimerTaskHandle );
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xReturn == pdFAIL )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif /* configSUPPORT_STATIC_ALLOCATION */
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
 	}
 
 	configASSERT( xReturn );
@@ -280,6 +400,17 @@ BaseType_t xReturn = pdFAIL;
 								const UBaseType_t uxAutoReload,
 								void * const pvTimerID,
 								TimerCallbackFunction_t pxCallbackFunction )
+	{
+		return xTimerCreateForService( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, ( UBaseType_t ) 0 );
+	}
+	/*-----------------------------------------------------------*/
+
+	TimerHandle_t xTimerCreateForService(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const TickType_t xTimerPeriodInTicks,
+											const UBaseType_t uxAutoReload,
+											void * const pvTimerID,
+											TimerCallbackFunction_t pxCallbackFunction,
+											const UBaseType_t uxTimerService )
 	{
 	Timer_t *pxNewTimer;
 
@@ -287,7 +418,7 @@ BaseType_t xReturn = pdFAIL;
 
 		if( pxNewTimer != NULL )
 		{
-			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, uxTimerService, pxNewTimer );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -313,6 +444,18 @@ BaseType_t xReturn = pdFAIL;
 										void * const pvTimerID,
 										TimerCallbackFunction_t pxCallbackFunction,
 										StaticTimer_t *pxTimerBuffer )
+	{
+		return xTimerCreateStaticForService( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, ( UBaseType_t ) 0, pxTimerBuffer );
+	}
+	/*-----------------------------------------------------------*/
+
+	TimerHandle_t xTimerCreateStaticForService(	const char * const pcTimerName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const TickType_t xTimerPeriodInTicks,
+												const UBaseType_t uxAutoReload,
+												void * const pvTimerID,
+												TimerCallbackFunction_t pxCallbackFunction,
+												const UBaseType_t uxTimerService,
+												StaticTimer_t *pxTimerBuffer )
 	{
 	Timer_t *pxNewTimer;
 
@@ -332,7 +475,7 @@ BaseType_t xReturn = pdFAIL;
 
 		if( pxNewTimer != NULL )
 		{
-			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, uxTimerService, pxNewTimer );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -354,10 +497,12 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 									const UBaseType_t uxAutoReload,
 									void * const pvTimerID,
 									TimerCallbackFunction_t pxCallbackFunction,
+									const UBaseType_t uxTimerService,
 									Timer_t *pxNewTimer )
 {
 	/* 0 is not a valid value for xTimerPeriodInTicks. */
 	configASSERT( ( xTimerPeriodInTicks > 0 ) );
+	configASSERT( ( uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS ) );
 
 	if( pxNewTimer != NULL )
 	{
@@ -373,6 +518,23 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+
+		#if( configUSE_LIST_SKIP_INDEX == 1 )
+		{
+			listSET_LIST_ITEM_SKIP_LINKS( &( pxNewTimer->xTimerListItem ), pxNewTimer->xTimerSkipLinks );
+		}
+		#endif
+
+		#if( configTIMER_SERVICE_TASKS > 1 )
+		{
+			pxNewTimer->uxTimerService = uxTimerService;
+		}
+		#else
+		{
+			( void ) uxTimerService;
+		}
+		#endif /* configTIMER_SERVICE_TASKS */
+
 		traceTIMER_CREATE( pxNewTimer );
 	}
 }
@@ -382,11 +544,14 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommand
 {
 BaseType_t xReturn = pdFAIL;
 DaemonTaskMessage_t xMessage;
+QueueHandle_t xTimerQueue;
 
 	configASSERT( xTimer );
 
 	/* Send a message to the timer service task to perform a particular action
 	on a particular timer definition. */
+	xTimerQueue = prvGetTimerService( ( Timer_t * ) xTimer )->xTimerQueue;
+
 	if( xTimerQueue != NULL )
 	{
 		/* Send a command to the timer service task to start the xTimer timer. */
@@ -421,12 +586,71 @@ DaemonTaskMessage_t xMessage;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xTimerGenericCommandBulk( TimerHandle_t const * const pxTimers, const UBaseType_t uxNumberOfTimers, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdFAIL;
+DaemonTaskMessage_t xMessage;
+QueueHandle_t xTimerQueue;
+
+	configASSERT( pxTimers );
+	configASSERT( uxNumberOfTimers > ( UBaseType_t ) 0 );
+	configASSERT( ( xCommandID >= tmrCOMMAND_START_BULK ) && ( xCommandID <= tmrCOMMAND_STOP_BULK ) );
+
+	#if( ( configASSERT_DEFINED == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) )
+	{
+		UBaseType_t uxIndex;
+
+		/* The message goes to a single timer service task, which must be the
+		one of every timer. */
+		for( uxIndex = 1; uxIndex < uxNumberOfTimers; uxIndex++ )
+		{
+			configASSERT( ( ( Timer_t * ) pxTimers[ uxIndex ] )->uxTimerService == ( ( Timer_t * ) pxTimers[ 0 ] )->uxTimerService );
+		}
+	}
+	#endif
+
+	/* One message carries the whole array to the timer service task. */
+	xTimerQueue = prvGetTimerService( ( Timer_t * ) pxTimers[ 0 ] )->xTimerQueue;
+
+	if( xTimerQueue != NULL )
+	{
+		xMessage.xMessageID = xCommandID;
+		xMessage.u.xBulkParameters.xMessageValue = xOptionalValue;
+		xMessage.u.xBulkParameters.ppxTimers = ( Timer_t * const * ) pxTimers;
+		xMessage.u.xBulkParameters.uxNumberOfTimers = uxNumberOfTimers;
+
+		if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+		{
+			xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+		}
+		else
+		{
+			xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
 {
-	/* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
-	started, then xTimerTaskHandle will be NULL. */
-	configASSERT( ( xTimerTaskHandle != NULL ) );
-	return xTimerTaskHandle;
+	return xTimerGetTimerServiceTaskHandle( ( UBaseType_t ) 0 );
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxTimerService )
+{
+	configASSERT( ( uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS ) );
+
+	/* If xTimerGetTimerServiceTaskHandle() is called before the scheduler has
+	been started, then xTimerTaskHandle will be NULL. */
+	configASSERT( ( xTimerServices[ uxTimerService ].xTimerTaskHandle != NULL ) );
+	return xTimerServices[ uxTimerService ].xTimerTaskHandle;
 }
 /*-----------------------------------------------------------*/
 
@@ -459,54 +683,83 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+static void prvProcessExpiredTimer( Timer_t * const pxTimer, const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 {
-BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
+	/* Remove the timer from the list of active timers. */
 	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 	traceTIMER_EXPIRED( pxTimer );
 
 	/* If the timer is an auto reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
+	expiry time and re-insert the timer in the list of active timers before
+	calling the timer callback. */
 	if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
 	{
-		/* The timer is inserted into a list using a time relative to anything
-		other than the current time.  It will therefore be inserted into the
-		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
-		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
 	}
 	else
 	{
-		mtCOVERAGE_TEST_MARKER();
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
 	}
+}
+/*-----------------------------------------------------------*/
 
-	/* Call the timer callback. */
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow )
+{
+BaseType_t xMissed;
+
+	/* The timer is inserted into a list using a time relative to anything
+	other than the current time.  It will therefore be inserted into the
+	correct list relative to the time this task thinks it is now.  A timer
+	that also missed its next expiry time is processed here rather than
+	through the timer queue, which a batch of late timers would fill.  The
+	callback for xExpiredTime comes before those of the expiry times missed. */
+	xMissed = prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime );
 	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+
+	while( xMissed != pdFALSE )
+	{
+		xExpiredTime += pxTimer->xTimerPeriodInTicks;
+		traceTIMER_EXPIRED( pxTimer );
+		xMissed = prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime );
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMING_WHEEL == 0 )
+
+	static void prvProcessExpiredTimers( TimerService_t * const pxService, const TickType_t xTimeNow )
+	{
+	TickType_t xNextExpireTime;
+
+		/* All of the timers that are due are processed before the task looks
+		at the command queue or at the time again.  A timer that is reloaded
+		into an expiry time that has also passed is processed within
+		prvReloadTimer(), so the loop ends. */
+		while( listLIST_IS_EMPTY( pxService->pxCurrentTimerList ) == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
+
+			if( xNextExpireTime <= xTimeNow )
+			{
+				prvProcessExpiredTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxService->pxCurrentTimerList ), xNextExpireTime, xTimeNow );
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void prvTimerTask( void *pvParameters )
 {
+TimerService_t * const pxService = ( TimerService_t * ) pvParameters;
 TickType_t xNextExpireTime;
 BaseType_t xListWasEmpty;
 
-	/* Just to avoid compiler warnings. */
-	( void ) pvParameters;
-
 	#if( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
 	{
 		extern void vApplicationDaemonTaskStartupHook( void );
@@ -514,28 +767,108 @@ BaseType_t xListWasEmpty;
 		/* Allow the application writer to execute some code in the context of
 		this task at the point the task starts executing.  This is useful if the
 		application includes initialisation code that would benefit from
-		executing after the scheduler has been started. */
-		vApplicationDaemonTaskStartupHook();
+		executing after the scheduler has been started.  The hook runs once,
+		in the first timer service task. */
+		if( pxService == &( xTimerServices[ 0 ] ) )
+		{
+			vApplicationDaemonTaskStartupHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 	#endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
 
+	#if( configUSE_TIMING_WHEEL == 1 )
+	{
+		/* No timer can be active before this task processes the first
+		command. */
+		vListWheelInitialise( &( pxService->xActiveTimerWheel ), xTaskGetTickCount() );
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+
 	for( ;; )
 	{
 		/* Query the timers list to see if it contains any timers, and if so,
 		obtain the time at which the next timer will expire. */
-		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+		xNextExpireTime = prvGetNextExpireTime( pxService, &xListWasEmpty );
 
 		/* If a timer has expired, process it.  Otherwise, block this task
 		until either a timer does expire, or a command is received. */
-		prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+		prvProcessTimerOrBlockTask( pxService, xNextExpireTime, xListWasEmpty );
 
 		/* Empty the command queue. */
-		prvProcessReceivedCommands();
+		prvProcessReceivedCommands( pxService );
 	}
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	static void prvProcessTimerOrBlockTask( TimerService_t * const pxService, const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+	{
+	TickType_t xTimeNow, xTicksToExpiry, xTicksElapsed;
+	BaseType_t xTimerListsWereSwitched;
+
+		vTaskSuspendAll();
+		{
+			/* As for the sorted lists, timers that remained in the current
+			list when the lists are switched have been processed within
+			prvSampleTimeNow(), and the next expire time must be obtained
+			again. */
+			xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
+
+			if( xTimerListsWereSwitched == pdFALSE )
+			{
+				/* The wheel time is never ahead of the tick count, so times
+				measured from it compare correctly across a tick count
+				overflow. */
+				xTicksToExpiry = xNextExpireTime - listWHEEL_GET_TIME( &( pxService->xActiveTimerWheel ) );
+				xTicksElapsed = xTimeNow - listWHEEL_GET_TIME( &( pxService->xActiveTimerWheel ) );
+
+				if( ( xListWasEmpty == pdFALSE ) && ( xTicksElapsed >= xTicksToExpiry ) )
+				{
+					( void ) xTaskResumeAll();
+					prvProcessExpiredTimers( pxService, xTimeNow );
+				}
+				else
+				{
+					if( xListWasEmpty != pdFALSE )
+					{
+						/* There is nothing the wheel could skip, so bring it
+						up to date in one step. */
+						listWHEEL_SET_TIME( &( pxService->xActiveTimerWheel ), xTimeNow );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					vQueueWaitForMessageRestricted( pxService->xTimerQueue, ( xTicksToExpiry - xTicksElapsed ), xListWasEmpty );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						/* Yield to wait for either a command to arrive, or
+						the block time to expire. */
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				( void ) xTaskResumeAll();
+			}
+		}
+	}
+
+#else /* configUSE_TIMING_WHEEL */
+
+static void prvProcessTimerOrBlockTask( TimerService_t * const pxService, const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
 BaseType_t xTimerListsWereSwitched;
@@ -547,14 +880,14 @@ BaseType_t xTimerListsWereSwitched;
 		then don't process this timer as any timers that remained in the list
 		when the lists were switched will have been processed within the
 		prvSampleTimeNow() function. */
-		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+		xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
 			/* The tick count has not overflowed, has the timer expired? */
 			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
 			{
 				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				prvProcessExpiredTimers( pxService, xTimeNow );
 			}
 			else
 			{
@@ -568,10 +901,10 @@ BaseType_t xTimerListsWereSwitched;
 				{
 					/* The current timer list is empty - is the overflow list
 					also empty? */
-					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					xListWasEmpty = listLIST_IS_EMPTY( pxService->pxOverflowTimerList );
 				}
 
-				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+				vQueueWaitForMessageRestricted( pxService->xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
 				if( xTaskResumeAll() == pdFALSE )
 				{
@@ -593,9 +926,125 @@ BaseType_t xTimerListsWereSwitched;
 		}
 	}
 }
+
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
-static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	static TickType_t prvGetNextExpireTime( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty )
+	{
+		/* The wheel is only a lower bound on the expire time of the timers in
+		level 1, so the task may wake without a timer to process, in which
+		case it only advances the wheel. */
+		return listWHEEL_GET_TIME( &( pxService->xActiveTimerWheel ) ) + prvGetTicksToNextWheelEvent( pxService, pxListWasEmpty );
+	}
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvGetTicksToNextWheelEvent( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty )
+	{
+	TickType_t xTicks, xTicksToWheel;
+	BaseType_t xWheelWasEmpty;
+	List_t *pxList;
+	UBaseType_t uxList;
+
+		xTicks = xListWheelGetTicksToNextExpiry( &( pxService->xActiveTimerWheel ), &xWheelWasEmpty );
+		*pxListWasEmpty = xWheelWasEmpty;
+
+		/* The sorted lists hold the timers that expire too far ahead for the
+		wheel.  Their heads are the first to come within its reach. */
+		for( uxList = 0; uxList < ( UBaseType_t ) 2; uxList++ )
+		{
+			pxList = ( uxList == ( UBaseType_t ) 0 ) ? pxService->pxCurrentTimerList : pxService->pxOverflowTimerList;
+
+			if( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+			{
+				xTicksToWheel = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList ) - listWHEEL_GET_TIME( &( pxService->xActiveTimerWheel ) );
+
+				if( xTicksToWheel >= listWHEEL_HORIZON )
+				{
+					xTicksToWheel -= ( listWHEEL_HORIZON - ( TickType_t ) 1 );
+				}
+				else
+				{
+					xTicksToWheel = ( TickType_t ) 1;
+				}
+
+				if( xTicksToWheel < xTicks )
+				{
+					xTicks = xTicksToWheel;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				*pxListWasEmpty = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xTicks;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvProcessExpiredTimers( TimerService_t * const pxService, const TickType_t xTimeNow )
+	{
+	List_t *pxExpiredTimers;
+	Timer_t *pxTimer;
+	TickType_t xTicksToNow, xTicks;
+	BaseType_t xListWasEmpty;
+
+		for( ;; )
+		{
+			vListWheelMigrate( &( pxService->xActiveTimerWheel ), pxService->pxCurrentTimerList );
+
+			#if( configUSE_64_BIT_TICKS == 0 )
+			{
+				vListWheelMigrate( &( pxService->xActiveTimerWheel ), pxService->pxOverflowTimerList );
+			}
+			#endif
+
+			xTicksToNow = xTimeNow - listWHEEL_GET_TIME( &( pxService->xActiveTimerWheel ) );
+
+			if( xTicksToNow == ( TickType_t ) 0 )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Jump over the ticks at which nothing can expire. */
+			xTicks = prvGetTicksToNextWheelEvent( pxService, &xListWasEmpty );
+
+			if( xTicks > xTicksToNow )
+			{
+				listWHEEL_SET_TIME( &( pxService->xActiveTimerWheel ), xTimeNow );
+			}
+			else
+			{
+				listWHEEL_SET_TIME( &( pxService->xActiveTimerWheel ), listWHEEL_GET_TIME( &( pxService->xActiveTimerWheel ) ) + ( xTicks - ( TickType_t ) 1 ) );
+				pxExpiredTimers = pxListWheelAdvance( &( pxService->xActiveTimerWheel ) );
+
+				/* Timers that are reloaded go to later ticks, so the list
+				empties. */
+				while( listLIST_IS_EMPTY( pxExpiredTimers ) == pdFALSE )
+				{
+					pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExpiredTimers );
+					prvProcessExpiredTimer( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ), xTimeNow );
+				}
+			}
+		}
+	}
+
+#else /* configUSE_TIMING_WHEEL */
+
+static TickType_t prvGetNextExpireTime( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty )
 {
 TickType_t xNextExpireTime;
 
@@ -606,10 +1055,10 @@ TickType_t xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+	*pxListWasEmpty = listLIST_IS_EMPTY( pxService->pxCurrentTimerList );
 	if( *pxListWasEmpty == pdFALSE )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
 	}
 	else
 	{
@@ -619,26 +1068,37 @@ TickType_t xNextExpireTime;
 
 	return xNextExpireTime;
 }
+
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
-static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+static TickType_t prvSampleTimeNow( TimerService_t * const pxService, BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
 	xTimeNow = xTaskGetTickCount();
 
-	if( xTimeNow < xLastTime )
-	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
-	}
-	else
+	#if( configUSE_64_BIT_TICKS == 1 )
 	{
+		/* The tick count does not overflow, the lists are never switched. */
+		( void ) pxService;
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
+	#else
+	{
+		if( xTimeNow < pxService->xLastTime )
+		{
+			prvSwitchTimerLists( pxService );
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
 
-	xLastTime = xTimeNow;
+		pxService->xLastTime = xTimeNow;
+	}
+	#endif /* configUSE_64_BIT_TICKS */
 
 	return xTimeNow;
 }
@@ -646,11 +1106,38 @@ PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Va
 
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 {
+TimerService_t * const pxService = prvGetTimerService( pxTimer );
 BaseType_t xProcessTimerNow = pdFALSE;
 
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+	#if( configUSE_TIMING_WHEEL == 1 )
+		/* The wheel only moves forward in prvProcessExpiredTimers(), which
+		processes the timers in expiry order up to the current time.  A timer
+		that expires after the wheel time therefore goes in the wheel even when
+		its expiry time has already passed, so a timer that is reloaded late is
+		processed once per period without going through the command queue. */
+		if( ( ( TickType_t ) ( xNextExpiryTime - listWHEEL_GET_TIME( &( pxService->xActiveTimerWheel ) ) ) - ( TickType_t ) 1 ) < ( listWHEEL_HORIZON - ( TickType_t ) 1 ) )
+		{
+			( void ) xListWheelInsert( &( pxService->xActiveTimerWheel ), &( pxTimer->xTimerListItem ) );
+		}
+		else
+	#endif
+	#if( configUSE_64_BIT_TICKS == 1 )
+	if( xNextExpiryTime <= xTimeNow )
+	{
+		/* The tick count does not overflow, so the expiry time elapsed
+		between the command to start/reset a timer was issued, and the time
+		the command was processed. */
+		( void ) xCommandTime;
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		vListInsert( pxService->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+	}
+	#else
 	if( xNextExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
@@ -663,7 +1150,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			vListInsert( pxService->pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
 		}
 	}
 	else
@@ -677,22 +1164,131 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			vListInsert( pxService->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
 		}
 	}
+	#endif /* configUSE_64_BIT_TICKS */
 
 	return xProcessTimerNow;
 }
 /*-----------------------------------------------------------*/
 
-static void	prvProcessReceivedCommands( void )
+static void prvProcessTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xMessageValue )
 {
-DaemonTaskMessage_t xMessage;
-Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
+BaseType_t xTimerListsWereSwitched;
 TickType_t xTimeNow;
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+	{
+		/* The timer is in a list, remove it. */
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xMessageValue );
+
+	/* In this case the xTimerListsWereSwitched parameter is not used, but
+	it must be present in the function call.  prvSampleTimeNow() must be
+	called after the message is received from xTimerQueue so there is no
+	possibility of a higher priority task adding a message to the message
+	queue with a time that is ahead of the timer daemon task (because it
+	pre-empted the timer daemon task after the xTimeNow value was set). */
+	xTimeNow = prvSampleTimeNow( prvGetTimerService( pxTimer ), &xTimerListsWereSwitched );
+
+	switch( xCommandID )
+	{
+		case tmrCOMMAND_START :
+	    case tmrCOMMAND_START_FROM_ISR :
+	    case tmrCOMMAND_RESET :
+	    case tmrCOMMAND_RESET_FROM_ISR :
+		case tmrCOMMAND_START_DONT_TRACE :
+			/* Start or restart a timer. */
+			if( prvInsertTimerInActiveList( pxTimer,  xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessageValue ) != pdFALSE )
+			{
+				/* The timer expired before it was added to the active
+				timer list.  Process it now, as prvProcessExpiredTimer()
+				does. */
+				traceTIMER_EXPIRED( pxTimer );
+
+				if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+				{
+					prvReloadTimer( pxTimer, xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+				}
+				else
+				{
+					pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			break;
+
+		case tmrCOMMAND_STOP :
+		case tmrCOMMAND_STOP_FROM_ISR :
+			/* The timer has already been removed from the active list.
+			There is nothing to do here. */
+			break;
+
+		case tmrCOMMAND_CHANGE_PERIOD :
+		case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+			pxTimer->xTimerPeriodInTicks = xMessageValue;
+			configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+			/* The new period does not really have a reference, and can
+			be longer or shorter than the old one.  The command time is
+			therefore set to the current time, and as the period cannot
+			be zero the next expiry time can only be in the future,
+			meaning (unlike for the xTimerStart() case above) there is
+			no fail case that needs to be handled here. */
+			( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+			break;
+
+		case tmrCOMMAND_DELETE :
+			/* The timer has already been removed from the active list,
+			just free up the memory if the memory was dynamically
+			allocated. */
+			#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+			{
+				/* The timer can only have been allocated dynamically -
+				free it again. */
+				vPortFree( pxTimer );
+			}
+			#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+			{
+				/* The timer could have been allocated statically or
+				dynamically, so check before attempting to free the
+				memory. */
+				if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+				{
+					vPortFree( pxTimer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+			break;
+
+		default	:
+			/* Don't expect to get here. */
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void	prvProcessReceivedCommands( TimerService_t * const pxService )
+{
+DaemonTaskMessage_t xMessage;
+BaseType_t xCommandID;
+UBaseType_t uxIndex;
+
+	while( xQueueReceive( pxService->xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 		{
@@ -720,119 +1316,31 @@ TickType_t xTimeNow;
 		function calls. */
 		if( xMessage.xMessageID >= ( BaseType_t ) 0 )
 		{
-			/* The messages uses the xTimerParameters member to work on a
-			software timer. */
-			pxTimer = xMessage.u.xTimerParameters.pxTimer;
-
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+			if( ( xMessage.xMessageID >= tmrCOMMAND_START_BULK ) && ( xMessage.xMessageID <= tmrCOMMAND_STOP_BULK ) )
 			{
-				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				/* The messages uses the xBulkParameters member to apply the
+				command of a single timer to each timer of an array. */
+				xCommandID = tmrCOMMAND_START + ( xMessage.xMessageID - tmrCOMMAND_START_BULK );
+
+				for( uxIndex = 0; uxIndex < xMessage.u.xBulkParameters.uxNumberOfTimers; uxIndex++ )
+				{
+					prvProcessTimerCommand( xMessage.u.xBulkParameters.ppxTimers[ uxIndex ], xCommandID, xMessage.u.xBulkParameters.xMessageValue );
+				}
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-
-			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
-
-			/* In this case the xTimerListsWereSwitched parameter is not used, but
-			it must be present in the function call.  prvSampleTimeNow() must be
-			called after the message is received from xTimerQueue so there is no
-			possibility of a higher priority task adding a message to the message
-			queue with a time that is ahead of the timer daemon task (because it
-			pre-empted the timer daemon task after the xTimeNow value was set). */
-			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-
-			switch( xMessage.xMessageID )
-			{
-				case tmrCOMMAND_START :
-			    case tmrCOMMAND_START_FROM_ISR :
-			    case tmrCOMMAND_RESET :
-			    case tmrCOMMAND_RESET_FROM_ISR :
-				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-					{
-						/* The timer expired before it was added to the active
-						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-					break;
-
-				case tmrCOMMAND_STOP :
-				case tmrCOMMAND_STOP_FROM_ISR :
-					/* The timer has already been removed from the active list.
-					There is nothing to do here. */
-					break;
-
-				case tmrCOMMAND_CHANGE_PERIOD :
-				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
-					pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-					/* The new period does not really have a reference, and can
-					be longer or shorter than the old one.  The command time is
-					therefore set to the current time, and as the period cannot
-					be zero the next expiry time can only be in the future,
-					meaning (unlike for the xTimerStart() case above) there is
-					no fail case that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-					break;
-
-				case tmrCOMMAND_DELETE :
-					/* The timer has already been removed from the active list,
-					just free up the memory if the memory was dynamically
-					allocated. */
-					#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-					{
-						/* The timer can only have been allocated dynamically -
-						free it again. */
-						vPortFree( pxTimer );
-					}
-					#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-					{
-						/* The timer could have been allocated statically or
-						dynamically, so check before attempting to free the
-						memory. */
-						if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-						{
-							vPortFree( pxTimer );
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-					break;
-
-				default	:
-					/* Don't expect to get here. */
-					break;
+				/* The messages uses the xTimerParameters member to work on a
+				software timer. */
+				prvProcessTimerCommand( xMessage.u.xTimerParameters.pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
 			}
 		}
 	}
 }
 /*-----------------------------------------------------------*/
 
-static void prvSwitchTimerLists( void )
+#if( configUSE_64_BIT_TICKS == 0 )
+
+static void prvSwitchTimerLists( TimerService_t * const pxService )
 {
 TickType_t xNextExpireTime, xReloadTime;
 List_t *pxTemp;
@@ -843,12 +1351,12 @@ BaseType_t xResult;
 	If there are any timers still referenced from the current timer list
 	then they must have expired and should be processed before the lists
 	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	while( listLIST_IS_EMPTY( pxService->pxCurrentTimerList ) == pdFALSE )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
 
 		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
 		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 		traceTIMER_EXPIRED( pxTimer );
 
@@ -870,7 +1378,7 @@ BaseType_t xResult;
 			{
 				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
 				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				vListInsert( pxService->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
 			}
 			else
 			{
@@ -885,53 +1393,70 @@ BaseType_t xResult;
 		}
 	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
+	pxTemp = pxService->pxCurrentTimerList;
+	pxService->pxCurrentTimerList = pxService->pxOverflowTimerList;
+	pxService->pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_64_BIT_TICKS */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
 {
-	/* Check that the list from which active timers are referenced, and the
-	queue used to communicate with the timer service, have been
-	initialised. */
+TimerService_t *pxService;
+UBaseType_t uxTimerService;
+
+	/* Check that the lists from which active timers are referenced, and the
+	queues used to communicate with the timer services, have been
+	initialised.  All of the services are initialised at once, the first
+	queue is only created once the others are. */
 	taskENTER_CRITICAL();
 	{
-		if( xTimerQueue == NULL )
+		if( xTimerServices[ 0 ].xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
-
-			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			for( uxTimerService = ( UBaseType_t ) configTIMER_SERVICE_TASKS; uxTimerService > ( UBaseType_t ) 0; uxTimerService-- )
 			{
-				/* The timer queue is allocated statically in case
-				configSUPPORT_DYNAMIC_ALLOCATION is 0. */
-				static StaticQueue_t xStaticTimerQueue; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
-				static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+				pxService = &( xTimerServices[ uxTimerService - ( UBaseType_t ) 1 ] );
 
-				xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
-			}
-			#else
-			{
-				xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
-			}
-			#endif
+				vListInitialise( &( pxService->xActiveTimerList1 ) );
+				vListInitialise( &( pxService->xActiveTimerList2 ) );
+				pxService->pxCurrentTimerList = &( pxService->xActiveTimerList1 );
+				pxService->pxOverflowTimerList = &( pxService->xActiveTimerList2 );
 
-			#if ( configQUEUE_REGISTRY_SIZE > 0 )
-			{
-				if( xTimerQueue != NULL )
+				#if( configUSE_64_BIT_TICKS == 0 )
 				{
-					vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+					pxService->xLastTime = ( TickType_t ) 0U;
 				}
-				else
+				#endif
+
+				#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* The timer queues are allocated statically in case
+					configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+					static StaticQueue_t xStaticTimerQueue[ configTIMER_SERVICE_TASKS ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+					static uint8_t ucStaticTimerQueueStorage[ configTIMER_SERVICE_TASKS ][ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+
+					pxService->xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ uxTimerService - ( UBaseType_t ) 1 ][ 0 ] ), &( xStaticTimerQueue[ uxTimerService - ( UBaseType_t ) 1 ] ) );
+				}
+				#else
+				{
+					pxService->xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
+				}
+				#endif
+
+				#if ( configQUEUE_REGISTRY_SIZE > 0 )
+				{
+					if( pxService->xTimerQueue != NULL )
+					{
+						vQueueAddToRegistry( pxService->xTimerQueue, "TmrQ" );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configQUEUE_REGISTRY_SIZE */
 			}
-			#endif /* configQUEUE_REGISTRY_SIZE */
 		}
 		else
 		{
@@ -1008,7 +1533,7 @@ Timer_t * const pxTimer = ( Timer_t * ) xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+		xReturn = xQueueSendFromISR( xTimerServices[ 0 ].xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 
 		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
@@ -1028,7 +1553,7 @@ Timer_t * const pxTimer = ( Timer_t * ) xTimer;
 		/* This function can only be called after a timer has been created or
 		after the scheduler has been started because, until then, the timer
 		queue does not exist. */
-		configASSERT( xTimerQueue );
+		configASSERT( xTimerServices[ 0 ].xTimerQueue );
 
 		/* Complete the message with the function parameters and post it to the
 		daemon task. */
@@ -1037,7 +1562,7 @@ Timer_t * const pxTimer = ( Timer_t * ) xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+		xReturn = xQueueSendToBack( xTimerServices[ 0 ].xTimerQueue, &xMessage, xTicksToWait );
 
 		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
@@ -266,6 +266,12 @@ extern "C" {
 	#define portCLEAN_UP_TCB( pxTCB ) ( void ) pxTCB
 #endif
 
+#ifndef portSUSPEND_ALL_IN_CRITICAL
+	/* Set to 1 by a port that needs vTaskSuspendAll() in a critical
+	section. */
+	#define portSUSPEND_ALL_IN_CRITICAL 0
+#endif
+
 #ifndef portPRE_TASK_DELETE_HOOK
 	#define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxYieldPending )
 #endif
@@ -762,6 +768,12 @@ extern "C" {
 	#define portTASK_CALLS_SECURE_FUNCTIONS()
 #endif
 
+#ifndef portIDLE
+	/* Called on each pass of the idle task, lets a port that runs on a host
+	operating system give the processor back to it. */
+	#define portIDLE()
+#endif
+
 #ifndef configUSE_TIME_SLICING
 	#define configUSE_TIME_SLICING 1
 #endif
@@ -806,10 +818,306 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+/* The number of notification values and states each task holds, so separate
+senders can each notify a task through an index of their own. */
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
 
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL 0
+#endif
+
+#if( configUSE_TIMING_WHEEL == 1 )
+	/* The delayed task list and the active timer lists keep the items that
+	expire within 2^( SLOT_BITS + ROUND_BITS ) ticks in a two level timing
+	wheel, see ListWheel_t in list.h. */
+	#ifndef configTIMING_WHEEL_SLOT_BITS
+		#define configTIMING_WHEEL_SLOT_BITS 6
+	#endif
+
+	#ifndef configTIMING_WHEEL_ROUND_BITS
+		#define configTIMING_WHEEL_ROUND_BITS 6
+	#endif
+
+	#if( ( ( configUSE_16_BIT_TICKS == 1 ) && ( ( configTIMING_WHEEL_SLOT_BITS + configTIMING_WHEEL_ROUND_BITS ) > 15 ) ) || ( ( configTIMING_WHEEL_SLOT_BITS + configTIMING_WHEEL_ROUND_BITS ) > 31 ) )
+		#error The timing wheel must cover less than half the range of the tick count
+	#endif
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TIMING_WHEEL cannot be used with configUSE_TICKLESS_IDLE as the expected idle time is not known
+	#endif
+#endif
+
+#ifndef configUSE_LIST_SKIP_INDEX
+	#define configUSE_LIST_SKIP_INDEX 0
+#endif
+
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+	/* Sorted lists keep a skip list of up to configLIST_SKIP_LEVELS levels over
+	their items, see ListSkipLink_t in list.h.  Each level links about a
+	quarter of the items of the level below, so 4 levels keep the searches
+	of lists of a few thousand items short.
+
+	Each link is three pointers.  Every list holds configLIST_SKIP_LEVELS
+	links, every list item a pointer to its links and their number, and every
+	TCB the links of its two list items, and every timer those of its one, at
+	the end of the structure.  On a 64-bit host with 4 levels a list grows by
+	96 bytes, a list item by 16, a TCB by 224 and a timer by 112. */
+	#ifndef configLIST_SKIP_LEVELS
+		#define configLIST_SKIP_LEVELS 4
+	#endif
+
+	/* Items inserted in a list holding fewer items than this are only linked
+	in the list itself, as a short list is searched faster without the
+	index. */
+	#ifndef configLIST_SKIP_MIN_ITEMS
+		#define configLIST_SKIP_MIN_ITEMS 16
+	#endif
+
+	#if( ( configLIST_SKIP_LEVELS < 1 ) || ( configLIST_SKIP_LEVELS > 16 ) )
+		#error configLIST_SKIP_LEVELS must be between 1 and 16
+	#endif
+#endif
+
+#ifndef portCACHE_LINE_SIZE
+	#define portCACHE_LINE_SIZE 64
+#endif
+
+#if( ( portCACHE_LINE_SIZE & ( portCACHE_LINE_SIZE - 1 ) ) != 0 )
+	#error portCACHE_LINE_SIZE must be a power of two
+#endif
+
+#ifndef configUSE_TCB_SLAB
+	#define configUSE_TCB_SLAB 0
+#endif
+
+#if( configUSE_TCB_SLAB == 1 )
+	/* The TCBs of the tasks created with xTaskCreate() are taken from slabs of
+	configTCB_SLAB_TCBS TCBs, each TCB starting on a cache line.  A slab is
+	allocated from the FreeRTOS heap when all the TCBs are in use, and is kept
+	when its tasks are deleted. */
+	#ifndef configTCB_SLAB_TCBS
+		#define configTCB_SLAB_TCBS 8
+	#endif
+
+	#if( configTCB_SLAB_TCBS < 1 )
+		#error configTCB_SLAB_TCBS must be at least 1
+	#endif
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+		#error configUSE_TCB_SLAB cannot be used without configSUPPORT_DYNAMIC_ALLOCATION
+	#endif
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+	/* Tasks created with xTaskCreateEDF() run at this priority, where they are
+	ordered by absolute deadline rather than in round robin. */
+	#ifndef configEDF_PRIORITY
+		#define configEDF_PRIORITY ( configMAX_PRIORITIES - 2 )
+	#endif
+
+	#if( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+		#error configEDF_PRIORITY must be above the idle priority and below configMAX_PRIORITIES
+	#endif
+#endif
+
+/* When a task blocks on a mutex held by a task that is itself blocked on a
+mutex, the priority is passed on down the chain of holders, up to
+configPRIORITY_INHERITANCE_MAX_DEPTH tasks, which bounds the time spent in the
+critical section. */
+#ifndef configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+	#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 0
+#endif
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	#ifndef configPRIORITY_INHERITANCE_MAX_DEPTH
+		#define configPRIORITY_INHERITANCE_MAX_DEPTH 8
+	#endif
+
+	#if( configUSE_MUTEXES != 1 )
+		#error configUSE_MUTEXES must be set to 1 to use configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+	#endif
+
+	#if( configPRIORITY_INHERITANCE_MAX_DEPTH < 2 )
+		#error configPRIORITY_INHERITANCE_MAX_DEPTH must be at least 2, the holder and the holder it waits for
+	#endif
+#endif
+
+#ifndef configUSE_MUTEX_STATS
+	#define configUSE_MUTEX_STATS 0
+#endif
+
+#if( configUSE_MUTEX_STATS == 1 )
+	/* The clock of the hold and wait times, read in critical sections. */
+	#ifndef configMUTEX_STATS_TIME
+		#define configMUTEX_STATS_TIME() ( ( uint32_t ) xTaskGetTickCountFromISR() )
+	#endif
+
+	#if( configUSE_MUTEXES != 1 )
+		#error configUSE_MUTEXES must be set to 1 to use configUSE_MUTEX_STATS
+	#endif
+#endif
+
+/* An adaptive mutex, created with xSemaphoreCreateAdaptiveMutex(), does not
+block straight away when it is held.  The taking task spins up to
+configADAPTIVE_MUTEX_MAX_SPINS times while the holder runs on another core, and
+yields up to configADAPTIVE_MUTEX_MAX_YIELDS times while the holder is ready at
+its own priority, before it blocks as for any mutex.  The limits can be changed
+per mutex with vSemaphoreSetAdaptiveMutexLimits(). */
+#ifndef configUSE_ADAPTIVE_MUTEXES
+	#define configUSE_ADAPTIVE_MUTEXES 0
+#endif
+
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+	#ifndef configADAPTIVE_MUTEX_MAX_SPINS
+		#define configADAPTIVE_MUTEX_MAX_SPINS 1000
+	#endif
+
+	#ifndef configADAPTIVE_MUTEX_MAX_YIELDS
+		#define configADAPTIVE_MUTEX_MAX_YIELDS 1
+	#endif
+
+	#if( configUSE_MUTEXES != 1 )
+		#error configUSE_MUTEXES must be set to 1 to use configUSE_ADAPTIVE_MUTEXES
+	#endif
+#endif
+
+/* A port that runs tasks on more than one core defines
+portTASK_IS_RUNNING_ON_OTHER_CORE( xTask ) as pdTRUE while xTask is running on
+a core other than that of the calling task, and portSPIN_PAUSE() as the pause
+instruction of a spin loop.  The ROS port runs one task at a time. */
+#ifndef portTASK_IS_RUNNING_ON_OTHER_CORE
+	#define portTASK_IS_RUNNING_ON_OTHER_CORE( xTask ) ( pdFALSE )
+#endif
+
+#ifndef portSPIN_PAUSE
+	#define portSPIN_PAUSE()
+#endif
+
+#ifndef configUSE_LOCK_FREE_STREAM_BUFFERS
+	#define configUSE_LOCK_FREE_STREAM_BUFFERS 0
+#endif
+
+#ifndef configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS
+	#define configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS 0
+#endif
+
+#ifndef configUSE_POLL_SETS
+	#define configUSE_POLL_SETS 0
+#endif
+
+#ifndef portNATIVE_WORD_BITS
+	#define portNATIVE_WORD_BITS 32
+#endif
+
+/* A 64-bit tick count does not overflow, so the kernel leaves out the handling
+of the overflow delayed task and timer lists. */
+#ifndef configUSE_64_BIT_TICKS
+	#define configUSE_64_BIT_TICKS 0
+#endif
+
+#if( ( configUSE_64_BIT_TICKS == 1 ) && ( ( portNATIVE_WORD_BITS != 64 ) || ( configUSE_16_BIT_TICKS == 1 ) ) )
+	#error configUSE_64_BIT_TICKS needs a port with a 64-bit native word and configUSE_16_BIT_TICKS set to 0
+#endif
+
+#ifndef configUSE_64_BIT_EVENT_BITS
+	#if( ( portNATIVE_WORD_BITS == 64 ) && ( configUSE_16_BIT_TICKS == 0 ) )
+		#define configUSE_64_BIT_EVENT_BITS 1
+	#else
+		#define configUSE_64_BIT_EVENT_BITS 0
+	#endif
+#endif
+
+#if( ( configUSE_64_BIT_EVENT_BITS == 1 ) && ( ( portNATIVE_WORD_BITS != 64 ) || ( configUSE_16_BIT_TICKS == 1 ) ) )
+	#error configUSE_64_BIT_EVENT_BITS needs a port with a 64-bit native word and configUSE_16_BIT_TICKS set to 0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_BIT_INDEX
+	#define configUSE_EVENT_GROUP_BIT_INDEX 0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR
+	#define configUSE_EVENT_GROUP_DIRECT_ISR 0
+#endif
+
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+	/* The number of tasks xEventGroupSetBitsFromISR() unblocks itself, the
+	timer service task unblocks any others.  0 for no limit. */
+	#ifndef configEVENT_GROUP_ISR_MAX_WAKES
+		#if( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+			#define configEVENT_GROUP_ISR_MAX_WAKES 8
+		#else
+			#define configEVENT_GROUP_ISR_MAX_WAKES 0
+		#endif
+	#endif
+
+	#if( ( configEVENT_GROUP_ISR_MAX_WAKES != 0 ) && ( ( INCLUDE_xTimerPendFunctionCall != 1 ) || ( configUSE_TIMERS != 1 ) ) )
+		#error configEVENT_GROUP_ISR_MAX_WAKES needs INCLUDE_xTimerPendFunctionCall and configUSE_TIMERS set to 1
+	#endif
+#endif
+
+/* Memory ordering for the parts of the kernel that share data without a
+critical section.  The defaults are enough when tasks and interrupts run on a
+single core, a port that runs them on several cores must define the three. */
+#ifndef portLOAD_ACQUIRE
+	#define portLOAD_ACQUIRE( pxAddress ) ( *( pxAddress ) )
+#endif
+
+#ifndef portSTORE_RELEASE
+	#define portSTORE_RELEASE( pxAddress, xValue ) ( *( pxAddress ) = ( xValue ) )
+#endif
+
+#ifndef portMEMORY_BARRIER
+	#define portMEMORY_BARRIER()
+#endif
+
+/* A port can also define portFETCH_AND_INCREMENT( pulValue ), which increments
+the uint32_t at pulValue atomically and returns its previous value, and
+portFETCH_AND_DECREMENT( pulValue ), which decrements it.  Without them, the
+kernel masks interrupts around the increment or decrement. */
+
+/* The most buffers a snapshot can have (see snapshot.h). */
+#ifndef configSNAPSHOT_MAX_BUFFERS
+	#define configSNAPSHOT_MAX_BUFFERS 4
+#endif
+
+#if( configSNAPSHOT_MAX_BUFFERS < 2 )
+	#error configSNAPSHOT_MAX_BUFFERS must be at least 2
+#endif
+
+#ifndef configTIMER_SERVICE_TASKS
+	#define configTIMER_SERVICE_TASKS 1
+#endif
+
+#if( configTIMER_SERVICE_TASKS < 1 )
+	#error configTIMER_SERVICE_TASKS must be at least 1
+#endif
+
+/* The priority of each timer service task, as an array initialiser with
+configTIMER_SERVICE_TASKS entries.  Timers created with xTimerCreate() use the
+first one.  The kernel runs on one core, so there is no core affinity to set
+for a service. */
+#ifndef configTIMER_SERVICE_TASK_PRIORITIES
+	#if( configTIMER_SERVICE_TASKS > 1 )
+		#error configTIMER_SERVICE_TASK_PRIORITIES must be defined when there is more than one timer service task
+	#endif
+
+	#define configTIMER_SERVICE_TASK_PRIORITIES { ( UBaseType_t ) configTIMER_TASK_PRIORITY }
+#endif
+
 #ifndef configSUPPORT_STATIC_ALLOCATION
 	/* Defaults to 0 for backward compatibility. */
 	#define configSUPPORT_STATIC_ALLOCATION 0
@@ -935,6 +1243,17 @@ point support. */
 	#define configUSE_TASK_FPU_SUPPORT 1
 #endif
 
+/*
+ * The value of a list item is a time, a priority or, for a task waiting on an
+ * event group, the bits the task waits for.  It is as wide as TickType_t, or as
+ * the event bits when these are 64 bits.
+ */
+#if( configUSE_64_BIT_EVENT_BITS == 1 )
+	typedef uint64_t ListItemValue_t;
+#else
+	typedef TickType_t ListItemValue_t;
+#endif
+
 /*
  * In line with software engineering best practice, FreeRTOS implements a strict
  * data hiding policy, so the real structures used by FreeRTOS to maintain the
@@ -945,17 +1264,28 @@ point support. */
  * real objects are used for this purpose.  The dummy list and list item
  * structures below are used for inclusion in such a dummy structure.
  */
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+	struct xSTATIC_LIST_SKIP_LINK
+	{
+		void *pvDummy1[ 3 ];
+	};
+#endif
+
 struct xSTATIC_LIST_ITEM
 {
-	TickType_t xDummy1;
+	ListItemValue_t xDummy1;
 	void *pvDummy2[ 4 ];
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		UBaseType_t uxDummy3;
+		void *pvDummy4;
+	#endif
 };
 typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
 
 /* See the comments above the struct xSTATIC_LIST_ITEM definition. */
 struct xSTATIC_MINI_LIST_ITEM
 {
-	TickType_t xDummy1;
+	ListItemValue_t xDummy1;
 	void *pvDummy2[ 2 ];
 };
 typedef struct xSTATIC_MINI_LIST_ITEM StaticMiniListItem_t;
@@ -966,6 +1296,9 @@ typedef struct xSTATIC_LIST
 	UBaseType_t uxDummy1;
 	void *pvDummy2;
 	StaticMiniListItem_t xDummy3;
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		struct xSTATIC_LIST_SKIP_LINK xDummy4[ configLIST_SKIP_LEVELS ];
+	#endif
 } StaticList_t;
 
 /*
@@ -987,44 +1320,65 @@ typedef struct xSTATIC_TCB
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 		xMPU_SETTINGS	xDummy2;
 	#endif
-	StaticListItem_t	xDummy3[ 2 ];
+	StaticListItem_t	xDummy3;
 	UBaseType_t			uxDummy5;
+	StaticListItem_t	xDummy4;
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		UBaseType_t		uxDummy9;
+	#endif
 	void				*pxDummy6;
-	uint8_t				ucDummy7[ configMAX_TASK_NAME_LEN ];
 	#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
 		void			*pxDummy8;
 	#endif
-	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
-		UBaseType_t		uxDummy9;
+	#if ( configUSE_MUTEXES == 1 )
+		UBaseType_t		uxDummy12[ 2 ];
 	#endif
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		uint32_t		ulDummy16;
+	#endif
+	uint8_t				ucDummy7[ configMAX_TASK_NAME_LEN ];
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxDummy10[ 2 ];
 	#endif
-	#if ( configUSE_MUTEXES == 1 )
-		UBaseType_t		uxDummy12[ 2 ];
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy22[ 6 ];
+		UBaseType_t		uxDummy23[ 2 ];
+		void			*pxDummy24;
 	#endif
+
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		void			*pvDummy25;
+	#endif
+
+	#if( ( configUSE_POLL_SETS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 1 ) )
+		void			*pvDummy26[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+
+	#if( INCLUDE_xTaskAbortDelay == 1 )
+		uint8_t ucDummy21;
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
 	#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
-	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
-	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
-	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
-	#endif
 	#if( ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) || ( portUSING_MPU_WRAPPERS == 1 ) )
 		uint8_t			uxDummy20;
 	#endif
 
-	#if( INCLUDE_xTaskAbortDelay == 1 )
-		uint8_t ucDummy21;
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		struct xSTATIC_LIST_SKIP_LINK xDummy27[ 2 ][ configLIST_SKIP_LEVELS ];
 	#endif
 
 } StaticTask_t;
@@ -1070,6 +1424,19 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if( configUSE_MUTEX_STATS == 1 )
+		uint32_t ulDummy10[ 5 ];
+	#endif
+
+	#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+		UBaseType_t uxDummy11[ 2 ];
+		uint32_t ulDummy12[ 4 ];
+	#endif
+
+	#if( configUSE_POLL_SETS == 1 )
+		void *pvDummy13;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1089,7 +1456,7 @@ typedef StaticQueue_t StaticSemaphore_t;
  */
 typedef struct xSTATIC_EVENT_GROUP
 {
-	TickType_t xDummy1;
+	ListItemValue_t xDummy1;
 	StaticList_t xDummy2;
 
 	#if( configUSE_TRACE_FACILITY == 1 )
@@ -1100,8 +1467,62 @@ typedef struct xSTATIC_EVENT_GROUP
 			uint8_t ucDummy4;
 	#endif
 
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+		StaticList_t xDummy5[ ( sizeof( ListItemValue_t ) * 8 ) - 8 ];
+		ListItemValue_t xDummy6;
+	#endif
+
+	#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		ListItemValue_t xDummy7[ 2 ];
+		BaseType_t xDummy8;
+	#endif
+
+	#if( configUSE_64_BIT_EVENT_BITS == 1 )
+		ListItemValue_t xDummy9[ 3 ];
+	#endif
+
 } StaticEventGroup_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real reader-writer lock structure is not
+ * accessible to the application code.  The StaticRWLock_t structure below is
+ * provided for the application writer to statically allocate the memory of a
+ * lock.  Its sizes and alignment requirements are guaranteed to match those of
+ * the genuine structure, no matter which architecture is being used, and no
+ * matter how the values in FreeRTOSConfig.h are set.
+ */
+typedef struct xSTATIC_RW_LOCK
+{
+	UBaseType_t uxDummy1[ 2 ];
+	void *pvDummy2;
+	BaseType_t xDummy3;
+	StaticList_t xDummy4[ 2 ];
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy5;
+	#endif
+
+} StaticRWLock_t;
+
+/*
+ * As StaticRWLock_t, the StaticSnapshot_t structure below is provided for the
+ * application writer to statically allocate the memory of a snapshot, along
+ * with its storage area.
+ */
+typedef struct xSTATIC_SNAPSHOT
+{
+	size_t uxDummy1[ 2 ];
+	UBaseType_t uxDummy2[ 3 ];
+	uint32_t ulDummy3[ 1 + ( 2 * configSNAPSHOT_MAX_BUFFERS ) ];
+	void *pvDummy4;
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy5;
+	#endif
+
+} StaticSnapshot_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1131,6 +1552,14 @@ typedef struct xSTATIC_TIMER
 		uint8_t 		ucDummy7;
 	#endif
 
+	#if( configTIMER_SERVICE_TASKS > 1 )
+		UBaseType_t		uxDummy8;
+	#endif
+
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		struct xSTATIC_LIST_SKIP_LINK xDummy9[ configLIST_SKIP_LEVELS ];
+	#endif
+
 } StaticTimer_t;
 
 /*
@@ -1155,11 +1584,46 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+		size_t uxDummy5[ 2 ];
+	#endif
+	#if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+		void *pvDummy6[ 2 ];
+		size_t uxDummy7;
+		uint32_t ulDummy8;
+	#endif
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvDummy9;
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * As StaticRWLock_t, the StaticPollSet_t structure below is provided for the
+ * application writer to statically allocate the memory of a poll set, and the
+ * StaticPollSetMember_t structure for the memory of its members.
+ */
+typedef struct xSTATIC_POLL_SET
+{
+	StaticList_t xDummy1[ 3 ];
+	UBaseType_t uxDummy2;
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy3;
+	#endif
+
+} StaticPollSet_t;
+
+typedef struct xSTATIC_POLL_SET_MEMBER
+{
+	StaticListItem_t xDummy1;
+	void *pvDummy2[ 3 ];
+	UBaseType_t uxDummy3;
+	uint8_t ucDummy4[ 2 ];
+} StaticPollSetMember_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,8 @@
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 /**
  * An event group is a collection of bits to which an application can assign a
  * meaning.  For example, an application may create an event group to convey
@@ -81,14 +83,20 @@ extern "C" {
 typedef void * EventGroupHandle_t;
 
 /*
- * The type that holds event bits always matches TickType_t - therefore the
- * number of bits it holds is set by configUSE_16_BIT_TICKS (16 bits if set to 1,
- * 32 bits if set to 0.
+ * The type that holds event bits matches TickType_t - therefore the number of
+ * bits it holds is set by configUSE_16_BIT_TICKS (16 bits if set to 1, 32 bits
+ * if set to 0) - unless configUSE_64_BIT_EVENT_BITS is set to 1, in which case
+ * it holds 64 bits.  configUSE_64_BIT_EVENT_BITS defaults to 1 when the port
+ * declares a 64-bit native word.
  *
  * \defgroup EventBits_t EventBits_t
  * \ingroup EventGroup
  */
-typedef TickType_t EventBits_t;
+#if( configUSE_64_BIT_EVENT_BITS == 1 )
+	typedef uint64_t EventBits_t;
+#else
+	typedef TickType_t EventBits_t;
+#endif
 
 /**
  * event_groups.h
@@ -113,7 +121,8 @@ typedef TickType_t EventBits_t;
  * on the configUSE_16_BIT_TICKS setting in FreeRTOSConfig.h.  If
  * configUSE_16_BIT_TICKS is 1 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configUSE_16_BIT_TICKS is set to 0 then each event group has
- * 24 usable bits (bit 0 to bit 23).  The EventBits_t type is used to store
+ * 24 usable bits (bit 0 to bit 23), or 56 usable bits (bit 0 to bit 55) if
+ * configUSE_64_BIT_EVENT_BITS is set to 1.  The EventBits_t type is used to store
  * event bits within an event group.
  *
  * @return If the event group was created then a handle to the event group is
@@ -169,7 +178,8 @@ typedef TickType_t EventBits_t;
  * on the configUSE_16_BIT_TICKS setting in FreeRTOSConfig.h.  If
  * configUSE_16_BIT_TICKS is 1 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configUSE_16_BIT_TICKS is set to 0 then each event group has
- * 24 usable bits (bit 0 to bit 23).  The EventBits_t type is used to store
+ * 24 usable bits (bit 0 to bit 23), or 56 usable bits (bit 0 to bit 55) if
+ * configUSE_64_BIT_EVENT_BITS is set to 1.  The EventBits_t type is used to store
  * event bits within an event group.
  *
  * @param pxEventGroupBuffer pxEventGroupBuffer must point to a variable of type
@@ -368,6 +378,11 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * With configUSE_64_BIT_EVENT_BITS set to 1 the message cannot hold the bits, so
+ * they are kept in the event group until the timer task runs.  The bits that
+ * interrupts set and clear in the meantime are applied together, each bit in
+ * the order it was set and cleared, with a single message.
+ *
  * @param xEventGroup The event group in which the bits are to be cleared.
  *
  * @param uxBitsToClear A bitwise value that indicates the bit or bits to clear.
@@ -403,7 +418,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_64_BIT_EVENT_BITS == 1 ) )
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
@@ -499,6 +514,21 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * When configUSE_EVENT_GROUP_DIRECT_ISR is set to 1 in FreeRTOSConfig.h the
+ * bits are set, and the waiting tasks unblocked, by xEventGroupSetBitsFromISR()
+ * itself.  A task that sets bits, or waits for them, only masks interrupts to
+ * take and to release the event group, not while it searches the waiting
+ * tasks: an interrupt that finds the event group taken leaves its bits to the
+ * task, which sets them and unblocks their tasks before it releases the event
+ * group.  To keep the time spent in the interrupt bounded, it unblocks at
+ * most configEVENT_GROUP_ISR_MAX_WAKES tasks (8 by default, 0 for no limit),
+ * and then leaves the bits set for the timer task to unblock the others.
+ * configUSE_EVENT_GROUP_BIT_INDEX set to 1 files each waiting task under one of
+ * the bits it waits for, so only the tasks waiting for the bits being set are
+ * looked at, rather than all the waiting tasks.  It costs one list per bit in
+ * each event group.  With configUSE_64_BIT_EVENT_BITS set to 1, the bits left
+ * to the timer task are applied as described for xEventGroupClearBitsFromISR().
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -555,7 +585,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) || ( configUSE_64_BIT_EVENT_BITS == 1 ) )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
@@ -747,6 +777,8 @@ void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToCl
 	void vEventGroupSetNumber( void* xEventGroup, UBaseType_t uxEventGroupNumber ) PRIVILEGED_FUNCTION;
 #endif
 
+portEND_EXPORTED_API
+
 #ifdef __cplusplus
 }
 #endif
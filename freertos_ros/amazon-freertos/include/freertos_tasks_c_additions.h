@@ -122,6 +122,19 @@ const uint8_t FreeRTOSDebugConfig[] =
     0 /* pad to 32-bit boundary */
 };
 
+/* NOTE!!
+ * The offsets are exported as bytes, so the members above must stay within the
+ * first 256 bytes of the TCB when its layout changes. The array size is
+ * negative, and the build fails, if one does not.
+ */
+typedef char FreeRTOSDebugConfigOffsetsFit[
+    ((offsetof(struct tskTaskControlBlock, xStateListItem) <= 255U) &&
+     (offsetof(struct tskTaskControlBlock, xEventListItem) <= 255U) &&
+     (offsetof(struct tskTaskControlBlock, pxStack) <= 255U) &&
+     (offsetof(struct tskTaskControlBlock, pcTaskName) <= 255U) &&
+     (offsetof(struct tskTaskControlBlock, uxTCBNumber) <= 255U) &&
+     (offsetof(struct tskTaskControlBlock, uxTaskNumber) <= 255U)) ? 1 : -1];
+
 #ifdef __cplusplus
 }
 #endif
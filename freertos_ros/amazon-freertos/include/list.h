@@ -96,6 +96,8 @@
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 /* Macros that can be used to place known values within the list structures,
 then check that the known values do not get corrupted during the execution of
 the application.   These may catch the list data structures being overwritten in
@@ -133,17 +135,55 @@ use of FreeRTOS.*/
 #endif /* configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES */
 
 
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+
+	/*
+	 * A link of one level of the skip index of a sorted list.  The items of
+	 * a list are scattered over the TCBs, timers and other objects that
+	 * contain them, so each step of a search through the list reads another
+	 * cache line.  vListInsert() therefore also links the items it inserts in
+	 * up to configLIST_SKIP_LEVELS levels above the list, each of which skips
+	 * about four items of the level below, and searches from the top level
+	 * down.
+	 *
+	 * The links of an item are not in the item: the object that contains the
+	 * item provides an array of configLIST_SKIP_LEVELS links for it with
+	 * listSET_LIST_ITEM_SKIP_LINKS(), which the TCB and the timer keep after
+	 * their other members.  An item without links is only linked in the list.
+	 *
+	 * The list itself is unchanged and the index only speeds up vListInsert(),
+	 * so the items are walked, taken from the head and returned in turn by
+	 * listGET_OWNER_OF_NEXT_ENTRY() as before.  Items inserted with
+	 * vListInsertEnd() are only linked in the list.  The search reads the
+	 * value of each item it compares from the item itself, as the search of
+	 * the list does, so the value of an item that is changed while the item
+	 * is in a list, as tasks.c does for the event list item of a task that
+	 * inherits a priority, is seen by the index as by the list.
+	 */
+	typedef struct xLIST_SKIP_LINK
+	{
+		struct xLIST_ITEM *pxItem;						/*< The item the link belongs to, NULL for the heads of the list. */
+		struct xLIST_SKIP_LINK *pxNext;					/*< The link of the next item at this level, NULL after the last one. */
+		struct xLIST_SKIP_LINK *pxPrevious;				/*< The link of the previous item at this level, or of the list. */
+	} ListSkipLink_t;
+
+#endif /* configUSE_LIST_SKIP_INDEX */
+
 /*
  * Definition of the only type of object that a list can contain.
  */
 struct xLIST_ITEM
 {
 	listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE			/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
-	configLIST_VOLATILE TickType_t xItemValue;			/*< The value being listed.  In most cases this is used to sort the list in descending order. */
+	configLIST_VOLATILE ListItemValue_t xItemValue;		/*< The value being listed.  In most cases this is used to sort the list in descending order. */
 	struct xLIST_ITEM * configLIST_VOLATILE pxNext;		/*< Pointer to the next ListItem_t in the list. */
 	struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;	/*< Pointer to the previous ListItem_t in the list. */
 	void * pvOwner;										/*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
 	void * configLIST_VOLATILE pvContainer;				/*< Pointer to the list in which this list item is placed (if any). */
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		UBaseType_t uxSkipLevels;						/*< The number of levels of the skip index of its list the item is linked in. */
+		ListSkipLink_t *pxSkipLinks;					/*< The configLIST_SKIP_LEVELS links of the item, the lowest level first, or NULL to keep it out of the index. */
+	#endif
 	listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE			/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 };
 typedef struct xLIST_ITEM ListItem_t;					/* For some reason lint wants this as two separate definitions. */
@@ -151,7 +191,7 @@ typedef struct xLIST_ITEM ListItem_t;					/* For some reason lint wants this as
 struct xMINI_LIST_ITEM
 {
 	listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE			/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
-	configLIST_VOLATILE TickType_t xItemValue;
+	configLIST_VOLATILE ListItemValue_t xItemValue;
 	struct xLIST_ITEM * configLIST_VOLATILE pxNext;
 	struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;
 };
@@ -166,9 +206,58 @@ typedef struct xLIST
 	volatile UBaseType_t uxNumberOfItems;
 	ListItem_t * configLIST_VOLATILE pxIndex;			/*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
 	MiniListItem_t xListEnd;							/*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+		ListSkipLink_t xSkipHeads[ configLIST_SKIP_LEVELS ];	/*< The heads of the levels of the skip index, the lowest level first. */
+	#endif
 	listSECOND_LIST_INTEGRITY_CHECK_VALUE				/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	/* Number of slots in each level of a timing wheel, and the number of ticks
+	ahead of the wheel time that an item can be placed in the wheel. */
+	#define listWHEEL_SLOTS		( ( TickType_t ) 1 << configTIMING_WHEEL_SLOT_BITS )
+	#define listWHEEL_ROUNDS	( ( TickType_t ) 1 << configTIMING_WHEEL_ROUND_BITS )
+	#define listWHEEL_HORIZON	( listWHEEL_SLOTS * listWHEEL_ROUNDS )
+
+	/*
+	 * A two level timing wheel, used in place of a list sorted by time when
+	 * many items are waiting.  Items are list items whose item value is the
+	 * tick at which they expire.  Level 0 has one list per tick for the next
+	 * listWHEEL_SLOTS ticks, level 1 has one list per turn of level 0.  The
+	 * lists are not sorted, so inserting an item is O(1).  The level 1 list of
+	 * a turn is spread over level 0 when the turn starts.
+	 *
+	 * As every list of the wheel is a List_t an item can be removed from the
+	 * wheel with uxListRemove(), without reference to the wheel.  The bitmaps
+	 * are therefore only a hint of which lists are not empty.
+	 */
+	typedef struct xLIST_WHEEL
+	{
+		TickType_t xTime;								/*< The tick up to which the wheel has been advanced. */
+		List_t xSlots[ listWHEEL_SLOTS ];				/*< Level 0, the items that expire at each of the next ticks. */
+		List_t xRounds[ listWHEEL_ROUNDS ];				/*< Level 1, the items that expire in each of the next turns of level 0. */
+		uint32_t ulSlotMap[ ( listWHEEL_SLOTS + 31 ) / 32 ];	/*< One bit per level 0 list that might not be empty. */
+		uint32_t ulRoundMap[ ( listWHEEL_ROUNDS + 31 ) / 32 ];	/*< One bit per level 1 list that might not be empty. */
+	} ListWheel_t;
+
+	/*
+	 * Evaluates to pdTRUE if pxList is one of the lists of the timing wheel
+	 * pxWheel, so if an item contained in pxList is waiting in the wheel.
+	 */
+	#define listWHEEL_CONTAINS_LIST( pxWheel, pxList )	( ( ( ( const List_t * ) ( pxList ) >= &( ( pxWheel )->xSlots[ 0 ] ) ) && ( ( const List_t * ) ( pxList ) <= &( ( pxWheel )->xRounds[ listWHEEL_ROUNDS - 1 ] ) ) ) ? pdTRUE : pdFALSE )
+
+	/*
+	 * Access macros to the time of a timing wheel.  The time can only be moved
+	 * forward to the tick before the one returned by
+	 * xListWheelGetTicksToNextExpiry(), as the wheel would otherwise skip
+	 * items, which lets a wheel that is not advanced every tick catch up.
+	 */
+	#define listWHEEL_GET_TIME( pxWheel )			( ( pxWheel )->xTime )
+	#define listWHEEL_SET_TIME( pxWheel, xNewTime )	( ( pxWheel )->xTime = ( xNewTime ) )
+
+#endif /* configUSE_TIMING_WHEEL */
+
 /*
  * Access macro to set the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -178,6 +267,21 @@ typedef struct xLIST
  */
 #define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )		( ( pxListItem )->pvOwner = ( void * ) ( pxOwner ) )
 
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+
+	/*
+	 * Access macro to give a list item the array of configLIST_SKIP_LEVELS
+	 * links it is linked in the skip index of a sorted list with, see
+	 * ListSkipLink_t.  vListInitialiseItem() clears them, so this comes after
+	 * it.
+	 *
+	 * \page listSET_LIST_ITEM_SKIP_LINKS listSET_LIST_ITEM_SKIP_LINKS
+	 * \ingroup LinkedList
+	 */
+	#define listSET_LIST_ITEM_SKIP_LINKS( pxListItem, pxLinks )	( ( pxListItem )->pxSkipLinks = ( pxLinks ) )
+
+#endif /* configUSE_LIST_SKIP_INDEX */
+
 /*
  * Access macro to get the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -358,6 +462,9 @@ void vListInitialiseItem( ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
  * Insert a list item into a list.  The item will be inserted into the list in
  * a position determined by its item value (descending item value order).
  *
+ * The search takes a step per item of lower or equal value, or about
+ * log4 of their number with configUSE_LIST_SKIP_INDEX set to 1.
+ *
  * @param pxList The list into which the item is to be inserted.
  *
  * @param pxNewListItem The item that is to be placed in the list.
@@ -403,6 +510,87 @@ void vListInsertEnd( List_t * const pxList, ListItem_t * const pxNewListItem ) P
  */
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Must be called before a timing wheel is used.
+	 *
+	 * @param pxWheel The wheel being initialised.
+	 *
+	 * @param xTime The tick the wheel starts at.
+	 *
+	 * \page vListWheelInitialise vListWheelInitialise
+	 * \ingroup LinkedList
+	 */
+	void vListWheelInitialise( ListWheel_t * const pxWheel, const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Place a list item in a timing wheel according to its item value, which
+	 * is the tick at which it expires.  An item that expires at the wheel time
+	 * expires on the next advance of the wheel.
+	 *
+	 * @param pxWheel The wheel into which the item is to be inserted.
+	 *
+	 * @param pxNewListItem The list item to be inserted.
+	 *
+	 * @return pdPASS if the item was inserted.  pdFAIL if it expires
+	 * listWHEEL_HORIZON ticks or more after the wheel time, in which case the
+	 * caller must hold it elsewhere, normally a sorted list from which
+	 * vListWheelMigrate() later moves it.
+	 *
+	 * \page xListWheelInsert xListWheelInsert
+	 * \ingroup LinkedList
+	 */
+	BaseType_t xListWheelInsert( ListWheel_t * const pxWheel, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Advance a timing wheel by one tick.
+	 *
+	 * @param pxWheel The wheel to advance.
+	 *
+	 * @return The list of the items that expire at the new wheel time.  The
+	 * caller must remove every item from it before the wheel is advanced
+	 * again.
+	 *
+	 * \page pxListWheelAdvance pxListWheelAdvance
+	 * \ingroup LinkedList
+	 */
+	List_t *pxListWheelAdvance( ListWheel_t * const pxWheel ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move the items at the head of a list sorted by expiry time into a timing
+	 * wheel, for as long as they expire within listWHEEL_HORIZON ticks of the
+	 * wheel time.
+	 *
+	 * @param pxWheel The wheel into which the items are moved.
+	 *
+	 * @param pxList The sorted list from which the items are taken.
+	 *
+	 * \page vListWheelMigrate vListWheelMigrate
+	 * \ingroup LinkedList
+	 */
+	void vListWheelMigrate( ListWheel_t * const pxWheel, List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Obtain the number of ticks from the wheel time until the earliest tick
+	 * at which an advance of the wheel may return an item.  The value is exact
+	 * when the earliest item is in level 0, otherwise it is the start of the
+	 * next turn of level 0.
+	 *
+	 * @param pxWheel The wheel to query.
+	 *
+	 * @param pxWheelWasEmpty Set to pdTRUE if the wheel contains no items, in
+	 * which case the returned value is listWHEEL_HORIZON.
+	 *
+	 * \page xListWheelGetTicksToNextExpiry xListWheelGetTicksToNextExpiry
+	 * \ingroup LinkedList
+	 */
+	TickType_t xListWheelGetTicksToNextExpiry( ListWheel_t * const pxWheel, BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMING_WHEEL */
+
+portEND_EXPORTED_API
+
 #ifdef __cplusplus
 }
 #endif
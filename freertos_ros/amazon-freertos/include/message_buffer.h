@@ -494,6 +494,139 @@ const TickType_t xBlockTime = pdMS_TO_TICKS( 20 );
  */
 #define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) xStreamBufferReceive( ( StreamBufferHandle_t ) xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferReserve( MessageBufferHandle_t xMessageBuffer,
+                              size_t xMaxMessageLengthBytes,
+                              StreamBufferRegion_t * const pxRegion,
+                              TickType_t xTicksToWait );
+</pre>
+ *
+ * Reserves space for a message of up to xMaxMessageLengthBytes bytes, for the
+ * writer to build in place.  The message is sent with xMessageBufferCommit(),
+ * which also stores its length, so a serializer can reserve for the largest
+ * message and commit the length it actually wrote.
+ *
+ * See xStreamBufferReserve() for the parameters.
+ *
+ * @return xMaxMessageLengthBytes, or 0 if the space for the message and its
+ * length did not become free before the block time expired.
+ *
+ * \defgroup xMessageBufferReserve xMessageBufferReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReserve( xMessageBuffer, xMaxMessageLengthBytes, pxRegion, xTicksToWait ) xStreamBufferReserve( ( StreamBufferHandle_t ) xMessageBuffer, xMaxMessageLengthBytes, pxRegion, xTicksToWait )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferCommit( MessageBufferHandle_t xMessageBuffer, size_t xMessageLengthBytes );
+</pre>
+ *
+ * Sends the message built in the region returned by the last call to
+ * xMessageBufferReserve().  xMessageLengthBytes must not be more than was
+ * reserved, 0 drops the reservation without sending a message.
+ *
+ * \defgroup xMessageBufferCommit xMessageBufferCommit
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCommit( xMessageBuffer, xMessageLengthBytes ) xStreamBufferCommit( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLengthBytes )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferPeek( MessageBufferHandle_t xMessageBuffer,
+                           StreamBufferRegion_t * const pxRegion,
+                           TickType_t xTicksToWait );
+</pre>
+ *
+ * Hands the reader the next message where it lies in the message buffer,
+ * rather than copying it out with xMessageBufferReceive().  The message stays
+ * in the buffer until it is removed with xMessageBufferConsume().
+ *
+ * See xStreamBufferPeekContiguous() for the parameters.
+ *
+ * @return The length of the next message, or 0 if the block time expired
+ * before a message was available.
+ *
+ * \defgroup xMessageBufferPeek xMessageBufferPeek
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferPeek( xMessageBuffer, pxRegion, xTicksToWait ) xStreamBufferPeekContiguous( ( StreamBufferHandle_t ) xMessageBuffer, pxRegion, xTicksToWait )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferConsume( MessageBufferHandle_t xMessageBuffer, size_t xMessageLengthBytes );
+</pre>
+ *
+ * Removes the message returned by the last call to xMessageBufferPeek().
+ * xMessageLengthBytes must be the length the peek returned.
+ *
+ * \defgroup xMessageBufferConsume xMessageBufferConsume
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferConsume( xMessageBuffer, xMessageLengthBytes ) xStreamBufferConsume( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLengthBytes )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMultiProducer( size_t xLanes, size_t xLaneSizeBytes );
+</pre>
+ *
+ * Creates a message buffer that several tasks or interrupts can send to
+ * without a mutex.  Each writer gets a lane of its own, a message buffer of
+ * xLaneSizeBytes bytes returned by xMessageBufferGetLane(), and sends to it
+ * with xMessageBufferSend(), xMessageBufferSendFromISR() or
+ * xMessageBufferReserve() and xMessageBufferCommit().  Each message in a lane
+ * takes 4 bytes more than in a message buffer, for its sequence number.
+ *
+ * The single reader calls xMessageBufferReceive() on the returned handle.  It
+ * blocks until a message is sent to any lane, and receives the messages of
+ * all the lanes in the order they were sent - strictly within a lane, and
+ * in the order their sends completed across lanes.  On the returned handle
+ * xMessageBufferIsEmpty(), xMessageBufferIsFull() and
+ * xMessageBufferSpaceAvailable() query all the lanes: it is empty when every
+ * lane is, full when no lane can take a message, and its space is the sum of
+ * theirs.  The other reader functions and xMessageBufferReset() are not
+ * supported on it.
+ *
+ * configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS must be set to 1 in
+ * FreeRTOSConfig.h for xMessageBufferCreateMultiProducer() to be available.
+ *
+ * @param xLanes The number of writers.
+ *
+ * @param xLaneSizeBytes The size of the storage area of each lane.
+ *
+ * @return The handle of the multi-producer message buffer, or NULL if there
+ * was not enough heap memory for it and its lanes.
+ *
+ * \defgroup xMessageBufferCreateMultiProducer xMessageBufferCreateMultiProducer
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateMultiProducer( xLanes, xLaneSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateMultiProducer( xLanes, xLaneSizeBytes )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferGetLane( MessageBufferHandle_t xMessageBuffer, size_t xLane );
+</pre>
+ *
+ * Returns lane xLane, from 0, of a message buffer created with
+ * xMessageBufferCreateMultiProducer().  Only one writer may send to a lane.
+ *
+ * \defgroup xMessageBufferGetLane xMessageBufferGetLane
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferGetLane( xMessageBuffer, xLane ) ( MessageBufferHandle_t ) xStreamBufferGetLane( ( StreamBufferHandle_t ) xMessageBuffer, xLane )
+
 
 /**
  * message_buffer.h
@@ -0,0 +1,265 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef POLL_SET_H
+#define POLL_SET_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include pollset.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+portBEGIN_EXPORTED_API
+
+/**
+ * A poll set lets a task wait for any of many sources at once - queues,
+ * semaphores, stream and message buffers, and indexes of task notifications -
+ * and returns a batch of the sources that are ready to be read.
+ *
+ * Unlike a queue set, a send to a member does not post the handle of the
+ * member to another queue.  A member is put on the ready list of its poll set
+ * by the first send that finds it off the list, so the cost of a send does not
+ * depend on the number of members, the number of members is only limited by
+ * the size given when the poll set is created, and uxPollSetWait() only looks
+ * at the members that were sent to.
+ *
+ * A member is level triggered or edge triggered:
+ *
+ * - pollsetLEVEL_TRIGGERED: the member is returned by every uxPollSetWait()
+ *   while it can be read, whether or not it was sent to since.  The reader
+ *   does not have to empty it.
+ *
+ * - pollsetEDGE_TRIGGERED: the member is returned once after it was sent to,
+ *   and not again until it is sent to again, so the reader should empty it.
+ *
+ * Returning a member does not read from it: the task reads from the member
+ * with the usual functions and a block time of 0, as another task may have
+ * read it first.  Members that can be read at once are returned in turn, so a
+ * member that is always ready does not keep the others out.
+ *
+ * A source can be a member of one poll set at a time, and cannot also be a
+ * member of a queue set.  A source must be removed from its poll set before
+ * it is deleted.  The holder of a mutex does not inherit the priority of a task
+ * that waits for the mutex through a poll set.
+ *
+ * configUSE_POLL_SETS must be set to 1 in FreeRTOSConfig.h for poll sets to
+ * be available.
+ *
+ * \defgroup PollSet
+ */
+
+/**
+ * pollset.h
+ *
+ * Type by which poll sets are referenced.
+ *
+ * \defgroup PollSetHandle_t PollSetHandle_t
+ * \ingroup PollSet
+ */
+typedef void * PollSetHandle_t;
+
+/**
+ * pollset.h
+ *
+ * Type by which the members of a poll set are referenced, as returned when a
+ * source is added to the set.
+ *
+ * \defgroup PollSetMemberHandle_t PollSetMemberHandle_t
+ * \ingroup PollSet
+ */
+typedef void * PollSetMemberHandle_t;
+
+/**
+ * pollset.h
+ *
+ * A member returned by uxPollSetWait().
+ *
+ * \ingroup PollSet
+ */
+typedef struct xPOLL_SET_EVENT
+{
+	PollSetMemberHandle_t xMember;	/*< The member that is ready. */
+	void *pvSource;					/*< The handle of the queue, semaphore, stream buffer or task that was added. */
+	void *pvUserData;				/*< The value passed in when the member was added. */
+} PollSetEvent_t;
+
+/* Modes of the members of a poll set. */
+#define pollsetLEVEL_TRIGGERED		( ( UBaseType_t ) 0 )
+#define pollsetEDGE_TRIGGERED		( ( UBaseType_t ) 1 )
+
+/**
+ * pollset.h
+ *<pre>
+ PollSetHandle_t xPollSetCreate( UBaseType_t uxMaxMembers );
+ </pre>
+ *
+ * Creates an empty poll set that can hold up to uxMaxMembers members.  The
+ * memory of the set and of its members is allocated from the FreeRTOS heap,
+ * at once.
+ *
+ * @return NULL if there is not enough heap memory, otherwise the handle of the
+ * poll set.
+ *
+ * \defgroup xPollSetCreate xPollSetCreate
+ * \ingroup PollSet
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	PollSetHandle_t xPollSetCreate( UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pollset.h
+ *<pre>
+ PollSetHandle_t xPollSetCreateStatic( UBaseType_t uxMaxMembers,
+                                       StaticPollSetMember_t *pxMemberBuffer,
+                                       StaticPollSet_t *pxPollSetBuffer );
+ </pre>
+ *
+ * As xPollSetCreate(), in the memory of pxPollSetBuffer and of the array of
+ * uxMaxMembers StaticPollSetMember_t variables pxMemberBuffer points to.
+ *
+ * \defgroup xPollSetCreateStatic xPollSetCreateStatic
+ * \ingroup PollSet
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	PollSetHandle_t xPollSetCreateStatic( UBaseType_t uxMaxMembers, StaticPollSetMember_t *pxMemberBuffer, StaticPollSet_t *pxPollSetBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pollset.h
+ *<pre>
+ void vPollSetDelete( PollSetHandle_t xPollSet );
+ </pre>
+ *
+ * Deletes a poll set that has no members and that no task waits for.
+ *
+ * \defgroup vPollSetDelete vPollSetDelete
+ * \ingroup PollSet
+ */
+void vPollSetDelete( PollSetHandle_t xPollSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * pollset.h
+ *<pre>
+ PollSetMemberHandle_t xPollSetAddQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue, UBaseType_t uxMode, void *pvUserData );
+ PollSetMemberHandle_t xPollSetAddStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer, UBaseType_t uxMode, void *pvUserData );
+ PollSetMemberHandle_t xPollSetAddNotification( PollSetHandle_t xPollSet, TaskHandle_t xTask, UBaseType_t uxIndexToWatch, UBaseType_t uxMode, void *pvUserData );
+ </pre>
+ *
+ * Add a source to a poll set.  xPollSetAddQueue() also takes the handle of a
+ * semaphore or a mutex, which is ready when it can be taken.  A stream or
+ * message buffer is ready when it is not empty, whatever its trigger level.
+ * Multi-producer message buffers and their lanes cannot be added.  An index of
+ * the notifications of a task, the calling task if xTask is NULL, is ready when
+ * a notification is pending on it, until the task takes it.  A source that can
+ * already be read is ready at once.
+ *
+ * @param uxMode pollsetLEVEL_TRIGGERED or pollsetEDGE_TRIGGERED.
+ *
+ * @param pvUserData A value returned with the member by uxPollSetWait().
+ *
+ * @return The handle of the new member, or NULL if the source already is a
+ * member of a poll set or of a queue set, if it cannot be polled, or if the
+ * poll set is full.
+ *
+ * \defgroup xPollSetAddQueue xPollSetAddQueue
+ * \ingroup PollSet
+ */
+PollSetMemberHandle_t xPollSetAddQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue, UBaseType_t uxMode, void *pvUserData ) PRIVILEGED_FUNCTION;
+PollSetMemberHandle_t xPollSetAddStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer, UBaseType_t uxMode, void *pvUserData ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+	PollSetMemberHandle_t xPollSetAddNotification( PollSetHandle_t xPollSet, TaskHandle_t xTask, UBaseType_t uxIndexToWatch, UBaseType_t uxMode, void *pvUserData ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pollset.h
+ *<pre>
+ void vPollSetRemove( PollSetHandle_t xPollSet, PollSetMemberHandle_t xMember );
+ </pre>
+ *
+ * Removes a member from its poll set.  The source can then be deleted or added
+ * to a poll set again.
+ *
+ * \defgroup vPollSetRemove vPollSetRemove
+ * \ingroup PollSet
+ */
+void vPollSetRemove( PollSetHandle_t xPollSet, PollSetMemberHandle_t xMember ) PRIVILEGED_FUNCTION;
+
+/**
+ * pollset.h
+ *<pre>
+ UBaseType_t uxPollSetWait( PollSetHandle_t xPollSet, PollSetEvent_t *pxEvents, UBaseType_t uxMaxEvents, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Waits in the Blocked state for up to xTicksToWait ticks for members of the
+ * poll set to be ready, and returns up to uxMaxEvents of them in pxEvents.
+ *
+ * @return The number of members written to pxEvents, 0 if none was ready
+ * before the block time expired.
+ *
+ * \defgroup uxPollSetWait uxPollSetWait
+ * \ingroup PollSet
+ */
+UBaseType_t uxPollSetWait( PollSetHandle_t xPollSet, PollSetEvent_t *pxEvents, UBaseType_t uxMaxEvents, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * pollset.h
+ *<pre>
+ UBaseType_t uxPollSetGetMemberCount( PollSetHandle_t xPollSet );
+ </pre>
+ *
+ * @return The number of members of the poll set.
+ *
+ * \defgroup uxPollSetGetMemberCount uxPollSetGetMemberCount
+ * \ingroup PollSet
+ */
+UBaseType_t uxPollSetGetMemberCount( PollSetHandle_t xPollSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Called by queue.c, stream_buffer.c and tasks.c with
+ * interrupts masked, from a task or from an interrupt, when a source that is a
+ * member of a poll set was sent to.  Puts the member on the ready list of its
+ * poll set and unblocks a task waiting for the set.  Returns pdTRUE if the
+ * unblocked task has a priority above the running task.
+ */
+BaseType_t xPollSetMemberReady( void *pvMember ) PRIVILEGED_FUNCTION;
+
+portEND_EXPORTED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_SET_H */
@@ -84,10 +84,23 @@ must be set in the compiler's include path. */
 	#define portNUM_CONFIGURABLE_REGIONS 1
 #endif
 
+/* The kernel headers declare the API between portBEGIN_EXPORTED_API and
+portEND_EXPORTED_API, which a port can define to export only the API from a
+shared library. */
+#ifndef portBEGIN_EXPORTED_API
+	#define portBEGIN_EXPORTED_API
+#endif
+
+#ifndef portEND_EXPORTED_API
+	#define portEND_EXPORTED_API
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 #include "mpu_wrappers.h"
 
 /*
@@ -157,6 +170,8 @@ void vPortEndScheduler( void ) PRIVILEGED_FUNCTION;
 	void vPortStoreTaskMPUSettings( xMPU_SETTINGS *xMPUSettings, const struct xMEMORY_REGION * const xRegions, StackType_t *pxBottomOfStack, uint32_t ulStackDepth ) PRIVILEGED_FUNCTION;
 #endif
 
+portEND_EXPORTED_API
+
 #ifdef __cplusplus
 }
 #endif
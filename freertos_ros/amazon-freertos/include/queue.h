@@ -37,6 +37,8 @@
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 
 /**
  * Type by which queues are referenced.  For example, a call to xQueueCreate()
@@ -59,6 +61,30 @@ typedef void * QueueSetHandle_t;
  */
 typedef void * QueueSetMemberHandle_t;
 
+/**
+ * Contention statistics of a mutex, as returned by vSemaphoreGetMutexStats().
+ * Times are in the units of configMUTEX_STATS_TIME(), ticks by default.
+ */
+typedef struct xMUTEX_STATS
+{
+	uint32_t ulAcquisitions;	/*< The number of times the mutex was taken.  A recursive mutex counts once per outermost take. */
+	uint32_t ulContendedWaits;	/*< The number of takes that found the mutex held and blocked to wait for it. */
+	uint32_t ulMaxHoldTime;		/*< The longest time from a take of the mutex to the give that released it. */
+	uint32_t ulMaxWaitTime;		/*< The longest time a take that obtained the mutex blocked for. */
+} MutexStats_t;
+
+/**
+ * Counters of an adaptive mutex, as returned by
+ * vSemaphoreGetAdaptiveMutexStats().
+ */
+typedef struct xADAPTIVE_MUTEX_STATS
+{
+	uint32_t ulSpins;					/*< The number of times a taking task spun while the holder ran on another core. */
+	uint32_t ulYields;					/*< The number of times a taking task yielded to the holder. */
+	uint32_t ulAcquiredWithoutBlocking;	/*< The number of takes that found the mutex held and then obtained it by spinning or yielding. */
+	uint32_t ulFallbacks;				/*< The number of takes that found the mutex held and blocked, after spinning or yielding or because the holder was not about to run. */
+} AdaptiveMutexStats_t;
+
 /* For internal use only. */
 #define	queueSEND_TO_BACK		( ( BaseType_t ) 0 )
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
@@ -1417,6 +1443,26 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
 void* xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 void* xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use vSemaphoreGetMutexStats() and
+ * vSemaphoreResetMutexStats() instead of calling these functions directly.
+ */
+#if( configUSE_MUTEX_STATS == 1 )
+	void vQueueGetMutexStats( QueueHandle_t xMutex, MutexStats_t * const pxStats ) PRIVILEGED_FUNCTION;
+	void vQueueResetMutexStats( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Use xSemaphoreCreateAdaptiveMutex(),
+ * vSemaphoreSetAdaptiveMutexLimits() and vSemaphoreGetAdaptiveMutexStats()
+ * instead of calling these functions directly.
+ */
+#if( configUSE_ADAPTIVE_MUTEXES == 1 )
+	QueueHandle_t xQueueCreateAdaptiveMutex( void ) PRIVILEGED_FUNCTION;
+	void vQueueSetAdaptiveMutexLimits( QueueHandle_t xMutex, UBaseType_t uxMaxSpins, UBaseType_t uxMaxYields ) PRIVILEGED_FUNCTION;
+	void vQueueGetAdaptiveMutexStats( QueueHandle_t xMutex, AdaptiveMutexStats_t * const pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
  * xSemaphoreGiveMutexRecursive() instead of calling these functions directly.
@@ -1643,7 +1689,10 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue ) PRIV
 void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+void **ppvQueueGetPollSetMember( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
 
+portEND_EXPORTED_API
 
 #ifdef __cplusplus
 }
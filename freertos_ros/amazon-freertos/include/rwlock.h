@@ -0,0 +1,266 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include rwlock.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+portBEGIN_EXPORTED_API
+
+/**
+ * A reader-writer lock protects data that is read far more often than it is
+ * written.  Any number of tasks can hold the lock for reading at the same
+ * time, or a single task can hold it for writing.
+ *
+ * Writers are preferred: once a task waits for the write lock, tasks that ask
+ * for the read lock wait too, so a steady flow of readers cannot keep a writer
+ * out.  When the writer gives the lock back, another waiting writer gets it
+ * first and the waiting readers are unblocked once no writer is left.
+ *
+ * A task that waits for a lock held for writing passes its priority on to the
+ * writer, as with a mutex, and the writer drops it again when it gives the lock
+ * back or when the waiting task times out.  The readers holding a lock a writer
+ * waits for are not tracked, so they do not inherit a priority.
+ *
+ * Interrupts can take a lock for reading or for writing if it is free, and must
+ * give it back before they return.
+ *
+ * \defgroup RWLock
+ */
+
+/**
+ * rwlock.h
+ *
+ * Type by which reader-writer locks are referenced.  For example, a call to
+ * xRWLockCreate() returns an RWLockHandle_t variable that can then be used as
+ * a parameter to xRWLockTakeRead(), xRWLockGiveRead(), etc.
+ *
+ * \defgroup RWLockHandle_t RWLockHandle_t
+ * \ingroup RWLock
+ */
+typedef void * RWLockHandle_t;
+
+/**
+ * rwlock.h
+ *<pre>
+ RWLockHandle_t xRWLockCreate( void );
+ </pre>
+ *
+ * Creates a new reader-writer lock, free, and returns a handle by which it can
+ * be referenced.  The memory of the lock is allocated from the FreeRTOS heap.
+ *
+ * @return NULL if there is not enough heap memory for the lock, otherwise the
+ * handle of the lock.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLock
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	RWLockHandle_t xRWLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ *<pre>
+ RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer );
+ </pre>
+ *
+ * As xRWLockCreate(), but the memory of the lock is the StaticRWLock_t
+ * variable pointed to by pxRWLockBuffer.
+ *
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLock
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ *<pre>
+ void vRWLockDelete( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * Deletes a lock that no task or interrupt holds or waits for.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLock
+ */
+void vRWLockDelete( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Takes the lock for reading.  The calling task waits in the Blocked state for
+ * up to xTicksToWait ticks while the lock is held for writing or a task waits
+ * for the write lock.
+ *
+ * Read locks are not recursive.  A task that holds the lock for reading and
+ * takes it for reading again waits behind any task waiting for the write
+ * lock, which itself waits for the first read lock to be given back: the two
+ * tasks deadlock, or the second take times out.
+ *
+ * @param xRWLock The handle of the lock.
+ *
+ * @param xTicksToWait The maximum time to wait for the lock, in ticks.  0 to
+ * return at once, portMAX_DELAY to wait indefinitely if INCLUDE_vTaskSuspend
+ * is set to 1.
+ *
+ * @return pdPASS if the lock was taken for reading, pdFAIL if the wait timed
+ * out.
+ *
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * Gives back a lock taken by xRWLockTakeRead().  The last reader to give the
+ * lock back unblocks the highest priority task waiting for the write lock.
+ *
+ * @return pdPASS, or pdFAIL if the lock was not held for reading.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Takes the lock for writing.  The calling task waits in the Blocked state for
+ * up to xTicksToWait ticks while the lock is held, and stops readers taking
+ * the lock in the meantime.  A task must not take the write lock it already
+ * holds.
+ *
+ * @return pdPASS if the lock was taken for writing, pdFAIL if the wait timed
+ * out.
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * Gives back a lock taken by xRWLockTakeWrite(), which only the task that took
+ * it can do.  The task drops a priority inherited through the lock, then the
+ * highest priority task waiting for the write lock is unblocked or, if no task
+ * waits for it, all the tasks waiting for the read lock.
+ *
+ * @return pdPASS, or pdFAIL if the calling task did not hold the write lock.
+ *
+ * \defgroup xRWLockGiveWrite xRWLockGiveWrite
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockTryTakeReadFromISR( RWLockHandle_t xRWLock );
+ BaseType_t xRWLockTryTakeWriteFromISR( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * Take the lock for reading or for writing from an interrupt, if it can be
+ * taken without waiting.  A reader is refused while a task waits for the write
+ * lock, as in xRWLockTakeRead().  The interrupt must give the lock back with
+ * xRWLockGiveReadFromISR() or xRWLockGiveWriteFromISR() before it returns.
+ *
+ * @return pdPASS if the lock was taken, otherwise pdFAIL.
+ *
+ * \defgroup xRWLockTryTakeReadFromISR xRWLockTryTakeReadFromISR
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockTryTakeReadFromISR( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+BaseType_t xRWLockTryTakeWriteFromISR( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xRWLockGiveWriteFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Give back a lock taken by xRWLockTryTakeReadFromISR() or
+ * xRWLockTryTakeWriteFromISR(), unblocking the waiting tasks as
+ * xRWLockGiveRead() and xRWLockGiveWrite() do.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task that was unblocked
+ * has a priority above the interrupted task, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * @return pdPASS, or pdFAIL if the lock was not held that way.
+ *
+ * \defgroup xRWLockGiveReadFromISR xRWLockGiveReadFromISR
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xRWLockGiveWriteFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * @return The number of tasks and interrupts that hold the lock for reading.
+ *
+ * \defgroup uxRWLockGetReaderCount uxRWLockGetReaderCount
+ * \ingroup RWLock
+ */
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+portEND_EXPORTED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RW_LOCK_H */
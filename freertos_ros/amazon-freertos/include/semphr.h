@@ -1123,6 +1123,108 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreGetMutexHolderFromISR( xSemaphore ) xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * <pre>void vSemaphoreGetMutexStats( SemaphoreHandle_t xMutex, MutexStats_t *pxStats );</pre>
+ *
+ * Only available when configUSE_MUTEX_STATS is set to 1.
+ *
+ * Copy the contention statistics of a mutex or recursive mutex into *pxStats:
+ * the number of times it was taken, the number of takes that had to block,
+ * and the longest hold and wait times since the mutex was created or the
+ * statistics were last reset.  Times are in the units of
+ * configMUTEX_STATS_TIME().  The statistics are copied in a critical section,
+ * so they are consistent with each other.
+ *
+ * Example usage:
+ <pre>
+ MutexStats_t xStats;
+
+	vSemaphoreGetMutexStats( xMutex, &xStats );
+	if( xStats.ulContendedWaits > ( xStats.ulAcquisitions / 10 ) )
+	{
+		// More than one take in ten had to wait for the mutex.
+	}
+ </pre>
+ * \defgroup vSemaphoreGetMutexStats vSemaphoreGetMutexStats
+ * \ingroup Semaphores
+ */
+#define vSemaphoreGetMutexStats( xMutex, pxStats ) vQueueGetMutexStats( ( QueueHandle_t ) ( xMutex ), ( pxStats ) )
+
+/**
+ * semphr.h
+ * <pre>void vSemaphoreResetMutexStats( SemaphoreHandle_t xMutex );</pre>
+ *
+ * Only available when configUSE_MUTEX_STATS is set to 1.
+ *
+ * Set the contention statistics of a mutex back to zero, to measure from now
+ * on.
+ *
+ * \defgroup vSemaphoreResetMutexStats vSemaphoreResetMutexStats
+ * \ingroup Semaphores
+ */
+#define vSemaphoreResetMutexStats( xMutex ) vQueueResetMutexStats( ( QueueHandle_t ) ( xMutex ) )
+
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateAdaptiveMutex( void )</pre>
+ *
+ * Only available when configUSE_ADAPTIVE_MUTEXES and
+ * configSUPPORT_DYNAMIC_ALLOCATION are set to 1.
+ *
+ * Creates a mutex as xSemaphoreCreateMutex() does, that is taken and given
+ * with xSemaphoreTake() and xSemaphoreGive() and uses priority inheritance, but
+ * that does not block the taking task as soon as it is found held.  While the
+ * holder is running on another core the taking task spins, up to
+ * configADAPTIVE_MUTEX_MAX_SPINS times.  While the holder is ready at the
+ * priority of the taking task, which on a single core is the case when the
+ * holder was preempted, the taking task yields to it, up to
+ * configADAPTIVE_MUTEX_MAX_YIELDS times.  Otherwise, or once the limits are
+ * reached, the taking task blocks for the rest of its block time.  Spinning
+ * and yielding only pay off when the mutex is held for short times.
+ *
+ * @return A handle to the created mutex, or NULL if it could not be created.
+ *
+ * \defgroup xSemaphoreCreateAdaptiveMutex xSemaphoreCreateAdaptiveMutex
+ * \ingroup Semaphores
+ */
+#if( ( configUSE_ADAPTIVE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	#define xSemaphoreCreateAdaptiveMutex() xQueueCreateAdaptiveMutex()
+#endif
+
+/**
+ * semphr. h
+ * <pre>void vSemaphoreSetAdaptiveMutexLimits( SemaphoreHandle_t xMutex, UBaseType_t uxMaxSpins, UBaseType_t uxMaxYields );</pre>
+ *
+ * Only available when configUSE_ADAPTIVE_MUTEXES is set to 1.
+ *
+ * Set the number of times a task taking xMutex spins and yields before it
+ * blocks.  Any mutex can be made adaptive this way, including a statically
+ * allocated or recursive one, and 0 for both limits makes it a mutex that
+ * blocks straight away again.
+ *
+ * \defgroup vSemaphoreSetAdaptiveMutexLimits vSemaphoreSetAdaptiveMutexLimits
+ * \ingroup Semaphores
+ */
+#define vSemaphoreSetAdaptiveMutexLimits( xMutex, uxMaxSpins, uxMaxYields ) vQueueSetAdaptiveMutexLimits( ( QueueHandle_t ) ( xMutex ), ( uxMaxSpins ), ( uxMaxYields ) )
+
+/**
+ * semphr. h
+ * <pre>void vSemaphoreGetAdaptiveMutexStats( SemaphoreHandle_t xMutex, AdaptiveMutexStats_t *pxStats );</pre>
+ *
+ * Only available when configUSE_ADAPTIVE_MUTEXES is set to 1.
+ *
+ * Copy the counters of an adaptive mutex into *pxStats: the spins and yields
+ * of the tasks that found it held, and how many of those takes obtained it
+ * without blocking and how many blocked.  A high number of fallbacks against
+ * takes obtained without blocking means the limits are too low for how long
+ * the mutex is held, or the holder is often blocked with the mutex.
+ *
+ * \defgroup vSemaphoreGetAdaptiveMutexStats vSemaphoreGetAdaptiveMutexStats
+ * \ingroup Semaphores
+ */
+#define vSemaphoreGetAdaptiveMutexStats( xMutex, pxStats ) vQueueGetAdaptiveMutexStats( ( QueueHandle_t ) ( xMutex ), ( pxStats ) )
+
 /**
  * semphr.h
  * <pre>UBaseType_t uxSemaphoreGetCount( SemaphoreHandle_t xSemaphore );</pre>
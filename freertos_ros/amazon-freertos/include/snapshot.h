@@ -0,0 +1,243 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include snapshot.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+portBEGIN_EXPORTED_API
+
+/**
+ * A snapshot holds the latest value of a structure that one writer updates
+ * often and many readers read - the pose of a robot, the angles of its joints.
+ * Each read returns a whole value as the writer left it, with its version: the
+ * number of writes before it.  The writer never blocks and never waits for the
+ * readers, and readers never block.
+ *
+ * A snapshot with one buffer is a sequence lock.  The writer copies the value
+ * in with interrupts masked, so tasks and interrupts never find a write in
+ * progress.  A reader copies the value out again if the writer changed it
+ * meanwhile: a task preempted in the middle of its copy, or a reader running
+ * beside the kernel on another core - a thread of the ROS node.  This suits
+ * values small enough to copy with interrupts masked.
+ *
+ * A snapshot with two or more buffers (configSNAPSHOT_MAX_BUFFERS at most) is
+ * read the read-copy-update way.  The writer fills a buffer no reader uses and
+ * then publishes it as the latest, and a reader pins the latest buffer while
+ * it copies it out, or reads it in place between pvSnapshotReadBegin() and
+ * vSnapshotReadEnd().  Nothing is copied with interrupts masked, and readers
+ * never retry because of a write.  A write fails, and the value is dropped,
+ * if every buffer but the latest is pinned: with readers that each pin one
+ * buffer at a time, two buffers more than the number of readers that can be
+ * preempted while they pin one are enough for writes never to fail - three
+ * buffers for a single such reader.
+ *
+ * There must be one writer at a time, a task or an interrupt.  Snapshots can be
+ * read from tasks, from interrupts and from threads that are not tasks, as the
+ * read functions do not use the scheduler.
+ *
+ * \defgroup Snapshot
+ */
+
+/**
+ * snapshot.h
+ *
+ * Type by which snapshots are referenced.
+ *
+ * \defgroup SnapshotHandle_t SnapshotHandle_t
+ * \ingroup Snapshot
+ */
+typedef void * SnapshotHandle_t;
+
+/*
+ * The number of bytes of the storage area to pass to xSnapshotCreateStatic().
+ */
+#define snapshotSTORAGE_SIZE_BYTES( xSnapshotSizeBytes, uxBuffers ) \
+	( ( ( ( size_t ) ( xSnapshotSizeBytes ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) * ( size_t ) ( uxBuffers ) )
+
+/**
+ * snapshot.h
+ *<pre>
+ SnapshotHandle_t xSnapshotCreate( size_t xSnapshotSizeBytes, UBaseType_t uxBuffers );
+ </pre>
+ *
+ * Creates a snapshot of values of xSnapshotSizeBytes bytes, with uxBuffers
+ * buffers: 1 for a sequence lock, 2 to configSNAPSHOT_MAX_BUFFERS for reads
+ * that do not retry.  The value is all zero, version 0, until it is first
+ * written.  The memory is allocated from the FreeRTOS heap.
+ *
+ * @return NULL if there is not enough heap memory, otherwise the handle of the
+ * snapshot.
+ *
+ * \defgroup xSnapshotCreate xSnapshotCreate
+ * \ingroup Snapshot
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	SnapshotHandle_t xSnapshotCreate( size_t xSnapshotSizeBytes, UBaseType_t uxBuffers ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * snapshot.h
+ *<pre>
+ SnapshotHandle_t xSnapshotCreateStatic( size_t xSnapshotSizeBytes,
+                                         UBaseType_t uxBuffers,
+                                         uint8_t *pucSnapshotStorageArea,
+                                         StaticSnapshot_t *pxStaticSnapshot );
+ </pre>
+ *
+ * As xSnapshotCreate(), in the memory of pxStaticSnapshot and of
+ * pucSnapshotStorageArea, which must be aligned to portBYTE_ALIGNMENT and
+ * hold at least snapshotSTORAGE_SIZE_BYTES( xSnapshotSizeBytes, uxBuffers )
+ * bytes.
+ *
+ * \defgroup xSnapshotCreateStatic xSnapshotCreateStatic
+ * \ingroup Snapshot
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	SnapshotHandle_t xSnapshotCreateStatic( size_t xSnapshotSizeBytes, UBaseType_t uxBuffers, uint8_t *pucSnapshotStorageArea, StaticSnapshot_t *pxStaticSnapshot ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * snapshot.h
+ *<pre>
+ void vSnapshotDelete( SnapshotHandle_t xSnapshot );
+ </pre>
+ *
+ * Deletes a snapshot that is no longer written or read.
+ *
+ * \defgroup vSnapshotDelete vSnapshotDelete
+ * \ingroup Snapshot
+ */
+void vSnapshotDelete( SnapshotHandle_t xSnapshot ) PRIVILEGED_FUNCTION;
+
+/**
+ * snapshot.h
+ *<pre>
+ BaseType_t xSnapshotWrite( SnapshotHandle_t xSnapshot, const void *pvValue );
+ BaseType_t xSnapshotWriteFromISR( SnapshotHandle_t xSnapshot, const void *pvValue );
+ </pre>
+ *
+ * Copy a new value of the size given when the snapshot was created from
+ * pvValue, and make it the latest value.  xSnapshotWriteFromISR() is the
+ * version that can be called from an interrupt.
+ *
+ * @return pdPASS, or pdFAIL if readers pin every buffer the value could be
+ * written to, in which case the value is dropped.  A sequence lock is always
+ * written.
+ *
+ * \defgroup xSnapshotWrite xSnapshotWrite
+ * \ingroup Snapshot
+ */
+BaseType_t xSnapshotWrite( SnapshotHandle_t xSnapshot, const void *pvValue ) PRIVILEGED_FUNCTION;
+BaseType_t xSnapshotWriteFromISR( SnapshotHandle_t xSnapshot, const void *pvValue ) PRIVILEGED_FUNCTION;
+
+/**
+ * snapshot.h
+ *<pre>
+ void *pvSnapshotWriteBegin( SnapshotHandle_t xSnapshot );
+ uint32_t ulSnapshotWriteEnd( SnapshotHandle_t xSnapshot );
+ </pre>
+ *
+ * Write a new value in place, without copying it, in a snapshot of two or
+ * more buffers.  pvSnapshotWriteBegin() returns a buffer no reader uses, which
+ * holds an older value, or NULL if readers pin all of them.  The writer builds
+ * the new value there, then ulSnapshotWriteEnd() makes it the latest value and
+ * returns its version.  Both can be called from interrupts.
+ *
+ * \defgroup pvSnapshotWriteBegin pvSnapshotWriteBegin
+ * \ingroup Snapshot
+ */
+void *pvSnapshotWriteBegin( SnapshotHandle_t xSnapshot ) PRIVILEGED_FUNCTION;
+uint32_t ulSnapshotWriteEnd( SnapshotHandle_t xSnapshot ) PRIVILEGED_FUNCTION;
+
+/**
+ * snapshot.h
+ *<pre>
+ uint32_t ulSnapshotRead( SnapshotHandle_t xSnapshot, void *pvBuffer, UBaseType_t *puxRetries );
+ </pre>
+ *
+ * Copy the latest value to pvBuffer.  Can be called from tasks, interrupts and
+ * other threads.
+ *
+ * @param puxRetries If not NULL, set to the number of times the value was
+ * copied again because a write changed it during the copy (sequence lock) or
+ * the buffer was replaced while it was being pinned.
+ *
+ * @return The version of the value: the number of writes before it.
+ *
+ * \defgroup ulSnapshotRead ulSnapshotRead
+ * \ingroup Snapshot
+ */
+uint32_t ulSnapshotRead( SnapshotHandle_t xSnapshot, void *pvBuffer, UBaseType_t *puxRetries ) PRIVILEGED_FUNCTION;
+
+/**
+ * snapshot.h
+ *<pre>
+ const void *pvSnapshotReadBegin( SnapshotHandle_t xSnapshot, uint32_t *pulVersion );
+ void vSnapshotReadEnd( SnapshotHandle_t xSnapshot, const void *pvValue );
+ </pre>
+ *
+ * Read the latest value in place, without copying it, in a snapshot of two or
+ * more buffers.  pvSnapshotReadBegin() pins the buffer of the latest value and
+ * returns it, with its version in *pulVersion if pulVersion is not NULL.  The
+ * writer does not write to the buffer until vSnapshotReadEnd() is called with
+ * the pointer returned, so a pin should be short.
+ *
+ * \defgroup pvSnapshotReadBegin pvSnapshotReadBegin
+ * \ingroup Snapshot
+ */
+const void *pvSnapshotReadBegin( SnapshotHandle_t xSnapshot, uint32_t *pulVersion ) PRIVILEGED_FUNCTION;
+void vSnapshotReadEnd( SnapshotHandle_t xSnapshot, const void *pvValue ) PRIVILEGED_FUNCTION;
+
+/**
+ * snapshot.h
+ *<pre>
+ uint32_t ulSnapshotGetVersion( SnapshotHandle_t xSnapshot );
+ </pre>
+ *
+ * @return The version of the latest value, to check for a new value without
+ * reading it.
+ *
+ * \defgroup ulSnapshotGetVersion ulSnapshotGetVersion
+ * \ingroup Snapshot
+ */
+uint32_t ulSnapshotGetVersion( SnapshotHandle_t xSnapshot ) PRIVILEGED_FUNCTION;
+
+portEND_EXPORTED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SNAPSHOT_H */
@@ -55,6 +55,8 @@
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 /**
  * Type by which stream buffers are referenced.  For example, a call to
  * xStreamBufferCreate() returns an StreamBufferHandle_t variable that can
@@ -63,6 +65,22 @@ extern "C" {
  */
 typedef void * StreamBufferHandle_t;
 
+/**
+ * Part of the storage area of a stream buffer, as handed out by
+ * xStreamBufferReserve() and xStreamBufferPeekContiguous().  The storage area
+ * is a ring, so the region is described in two parts: xFirstLength bytes from
+ * pucFirst up to the end of the storage area, and xSecondLength bytes from
+ * pucSecond, the start of the storage area, when the region wraps.  A part
+ * that is not used has a length of 0 and a NULL pointer.
+ */
+typedef struct StreamBufferRegion
+{
+	uint8_t *pucFirst;
+	size_t xFirstLength;
+	uint8_t *pucSecond;
+	size_t xSecondLength;
+} StreamBufferRegion_t;
+
 
 /**
  * message_buffer.h
@@ -585,6 +603,156 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 									size_t xBufferLengthBytes,
 									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                             size_t xDataLengthBytes,
+                             StreamBufferRegion_t * const pxRegion,
+                             TickType_t xTicksToWait );
+</pre>
+ *
+ * Reserves space in a stream buffer for the writer to fill in place, rather
+ * than building the data elsewhere and copying it in with xStreamBufferSend().
+ * The data only becomes visible to the reader when it is committed with
+ * xStreamBufferCommit().
+ *
+ * The same single writer rule as xStreamBufferSend() applies, and the writer
+ * must not call xStreamBufferSend() between a reserve and its commit.  The
+ * region stays valid until the commit.
+ *
+ * @param xStreamBuffer The handle of the stream buffer in which space is being
+ * reserved.
+ *
+ * @param xDataLengthBytes The number of bytes wanted.  For a message buffer
+ * this is the largest message that will be committed.
+ *
+ * @param pxRegion Set to the reserved part of the storage area, in two parts
+ * if it wraps.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for enough space, as for xStreamBufferSend().
+ *
+ * @return The number of bytes reserved.  A stream buffer reserves as much of
+ * xDataLengthBytes as there is space for when the block time expires.  A
+ * message buffer reserves either xDataLengthBytes or, if the space for the
+ * message and its length is not free, 0.
+ *
+ * \defgroup xStreamBufferReserve xStreamBufferReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+							 size_t xDataLengthBytes,
+							 StreamBufferRegion_t * const pxRegion,
+							 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes );
+</pre>
+ *
+ * Makes the first xDataLengthBytes bytes of the region returned by the last
+ * call to xStreamBufferReserve() visible to the reader, and unblocks the
+ * reader if it is waiting for data.  For a message buffer the bytes are one
+ * message, and its length is stored in front of it by the commit.
+ *
+ * @param xStreamBuffer The handle of the stream buffer the space was reserved
+ * in.
+ *
+ * @param xDataLengthBytes The number of bytes written to the region, which
+ * must not be more than were reserved.  Committing 0 bytes drops the
+ * reservation.
+ *
+ * @return xDataLengthBytes.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferRegion_t * const pxRegion,
+                                    TickType_t xTicksToWait );
+</pre>
+ *
+ * Hands the reader the data in a stream buffer where it lies, rather than
+ * copying it out with xStreamBufferReceive().  The data stays in the buffer
+ * until it is removed with xStreamBufferConsume().
+ *
+ * The same single reader rule as xStreamBufferReceive() applies, and the
+ * reader must not call xStreamBufferReceive() between a peek and the consume
+ * of what it peeked.  The region stays valid until then.
+ *
+ * Example use:
+<pre>
+void vAFunction( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBufferRegion_t xRegion;
+size_t xBytes;
+
+    // Wait up to 100ms for data, then hand it to the parser in place.
+    xBytes = xStreamBufferPeekContiguous( xStreamBuffer, &xRegion, pdMS_TO_TICKS( 100 ) );
+
+    if( xBytes > 0 )
+    {
+        vParse( xRegion.pucFirst, xRegion.xFirstLength );
+        vParse( xRegion.pucSecond, xRegion.xSecondLength );
+        xStreamBufferConsume( xStreamBuffer, xBytes );
+    }
+}
+</pre>
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param pxRegion Set to the data, in two parts if it wraps.  For a message
+ * buffer the region is the next message, without its length.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data, as for xStreamBufferReceive().
+ *
+ * @return The number of bytes in the region: all the bytes in a stream buffer,
+ * or the length of the next message in a message buffer.  0 if the block time
+ * expired before there was any data.
+ *
+ * \defgroup xStreamBufferPeekContiguous xStreamBufferPeekContiguous
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+									StreamBufferRegion_t * const pxRegion,
+									TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume );
+</pre>
+ *
+ * Removes data the reader has processed in place after
+ * xStreamBufferPeekContiguous(), and unblocks the writer if it is waiting for
+ * space.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param xBytesToConsume The number of bytes to remove from the front of a
+ * stream buffer, up to the number returned by the peek.  For a message buffer
+ * this must be the length returned by the peek, and the whole message is
+ * removed.
+ *
+ * @return xBytesToConsume.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -749,6 +917,44 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, siz
  */
 BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+BaseType_t xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel );
+</pre>
+ *
+ * Only available when configUSE_LOCK_FREE_STREAM_BUFFERS is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * The send trigger level is the number of free bytes there must be in the
+ * stream buffer before a task that is blocked on the stream buffer to wait
+ * for space is moved out of the blocked state.  A task is never unblocked
+ * before there is enough space for the write it is blocked on, so the send
+ * trigger level only matters when it is larger than the writes.  For example,
+ * if a task writes 16 bytes at a time to a full stream buffer that has a send
+ * trigger level of 1024 then it is unblocked once the reader has freed 1024
+ * bytes, rather than once per 16 bytes read.  Setting a send trigger level of
+ * 0 will result in a send trigger level of 1 being used.  It is not valid to
+ * specify a send trigger level that is greater than the buffer size.
+ *
+ * The send trigger level is 1 when the stream buffer is created, and is kept
+ * when the stream buffer is reset.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being updated.
+ *
+ * @param xTriggerLevel The new send trigger level for the stream buffer.
+ *
+ * @return If xTriggerLevel was less than the stream buffer's internal length,
+ * which is one byte more than the xBufferSizeBytes it was created with, then
+ * the send trigger level will be updated and pdTRUE is returned.  Otherwise
+ * pdFALSE is returned.
+ *
+ * \defgroup xStreamBufferSetSendTriggerLevel xStreamBufferSetSendTriggerLevel
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -839,12 +1045,24 @@ StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 													   uint8_t * const pucStreamBufferStorageArea,
 													   StaticStreamBuffer_t * const pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+	StreamBufferHandle_t xStreamBufferGenericCreateMultiProducer( size_t xLanes,
+																  size_t xLaneSizeBytes ) PRIVILEGED_FUNCTION;
+	StreamBufferHandle_t xStreamBufferGetLane( StreamBufferHandle_t xStreamBuffer, size_t xLane ) PRIVILEGED_FUNCTION;
+#endif
+
 #if( configUSE_TRACE_FACILITY == 1 )
 	void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer, UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
 	UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 	uint8_t ucStreamBufferGetStreamBufferType( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 #endif
 
+#if( configUSE_POLL_SETS == 1 )
+	void **ppvStreamBufferGetPollSetMember( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+portEND_EXPORTED_API
+
 #if defined( __cplusplus )
 }
 #endif
@@ -39,6 +39,8 @@
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 /*-----------------------------------------------------------
  * MACROS AND DEFINITIONS
  *----------------------------------------------------------*/
@@ -123,6 +125,25 @@ typedef struct xTASK_PARAMETERS
 	#endif
 } TaskParameters_t;
 
+/*
+ * Prototype of the function called when a task created with xTaskCreateEDF()
+ * misses the deadline of one of its jobs.  It is called from the tick
+ * interrupt or from the task itself, so must not block.
+ */
+typedef void (*TaskDeadlineMissHookFunction_t)( TaskHandle_t xTask, TickType_t xAbsoluteDeadline );
+
+/*
+ * Timing parameters of a task created with xTaskCreateEDF().  All values are
+ * in ticks.
+ */
+typedef struct xEDF_PARAMETERS
+{
+	TickType_t xPeriod;			/* Time between two job releases.  Must not be 0. */
+	TickType_t xRelativeDeadline;	/* Time after its release by which each job must complete. */
+	TickType_t xBudget;			/* Ticks each job may execute before it is throttled until the next release, or 0 for no limit. */
+	TaskDeadlineMissHookFunction_t pxDeadlineMissHook;	/* Called once for each job that misses its deadline, can be NULL. */
+} EDFParameters_t;
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
 in the system. */
 typedef struct xTASK_STATUS
@@ -146,6 +167,14 @@ typedef enum
 	eNoTasksWaitingTimeout	/* No tasks are waiting for a timeout so it is safe to enter a sleep mode that can only be exited by an external interrupt. */
 } eSleepModeStatus;
 
+/* Possible return values for eTaskGetMutexHolderState(). */
+typedef enum
+{
+	eHolderBlocked = 0,	/* The mutex holder is blocked, suspended or ready below the priority of the calling task, so it will not give the mutex back soon - block. */
+	eHolderRunning,		/* The mutex holder is running on another core - spin. */
+	eHolderReady		/* The mutex holder is ready at the priority of the calling task - yield to it. */
+} eMutexHolderState;
+
 /**
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -153,6 +182,15 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * The index of the notification value and state used by the task notification
+ * functions that do not take an index, such as xTaskNotify() and
+ * ulTaskNotifyTake().
+ *
+ * \ingroup TaskNotifications
+ */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( 0 )
+
 /**
  * task. h
  *
@@ -832,6 +870,104 @@ void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xT
  */
 BaseType_t xTaskAbortDelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>BaseType_t xTaskCreateEDF( TaskFunction_t pvTaskCode, const char * const pcName, configSTACK_DEPTH_TYPE usStackDepth, void *pvParameters, const EDFParameters_t * const pxEDFParameters, TaskHandle_t *pvCreatedTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Create a periodic task scheduled by earliest deadline first.  The task is
+ * created at priority configEDF_PRIORITY, so it is preempted by any task of a
+ * higher fixed priority and preempts any task of a lower one.  Within that
+ * priority, the ready task whose current job has the earliest absolute
+ * deadline runs first.  Tasks created with xTaskCreate() at
+ * configEDF_PRIORITY are allowed, and only run when no deadline scheduled
+ * task is ready.
+ *
+ * The first job is released when the task is created.  Each job ends with a
+ * call to vTaskEDFWaitForNextPeriod().
+ *
+ * If xBudget is not 0, a job that is charged more than xBudget ticks is
+ * counted as a deadline miss and moved to the Blocked state until the next
+ * release, where it continues with the budget of the next job - the
+ * activation it ran into is skipped.  A tick is charged to the task that was
+ * running when it occurred.  When the port delivers several ticks at once
+ * with xTaskIncrementTicks(), only the first of them is charged.
+ *
+ * Deadlines are checked on each tick for the running task and the earliest
+ * ready one, and when a job completes.  Absolute deadlines are compared as
+ * tick counts, so a deadline that straddles a tick count overflow is ordered
+ * as if it were very early.
+ *
+ * @param pxEDFParameters The period, relative deadline, budget and deadline
+ * miss hook of the task.  The structure is copied, so it need not persist.
+ *
+ * See xTaskCreate() for the other parameters.
+ *
+ * @return pdPASS if the task was created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ *
+ * Example usage:
+   <pre>
+ void vPerceptionTask( void * pvParameters )
+ {
+	 for( ;; )
+	 {
+		 vProcessFrame();
+		 vTaskEDFWaitForNextPeriod();
+	 }
+ }
+
+ void vAFunction( void )
+ {
+ EDFParameters_t xParameters = { 33, 30, 20, vFrameDeadlineMissed };
+
+	 xTaskCreateEDF( vPerceptionTask, "Perception", STACK_SIZE, NULL, &xParameters, NULL );
+ }
+   </pre>
+ * \defgroup xTaskCreateEDF xTaskCreateEDF
+ * \ingroup Tasks
+ */
+#if( ( configUSE_EDF_SCHEDULING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	BaseType_t xTaskCreateEDF(	TaskFunction_t pxTaskCode,
+								const char * const pcName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								void * const pvParameters,
+								const EDFParameters_t * const pxEDFParameters,
+								TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskEDFWaitForNextPeriod( void );</pre>
+ *
+ * Complete the current job of a task created with xTaskCreateEDF() and block
+ * until the next one is released.  If the job completed after its deadline
+ * the deadline miss is recorded first.  If the next release time has already
+ * passed the function returns without blocking.
+ *
+ * \defgroup vTaskEDFWaitForNextPeriod vTaskEDFWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_EDF_SCHEDULING == 1 )
+	void vTaskEDFWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskEDFGetDeadlineMisses( TaskHandle_t xTask );</pre>
+ *
+ * @return The number of jobs of xTask, a task created with xTaskCreateEDF(),
+ * that missed their deadline.  Passing NULL queries the calling task.
+ *
+ * \defgroup uxTaskEDFGetDeadlineMisses uxTaskEDFGetDeadlineMisses
+ * \ingroup TaskUtils
+ */
+#if( configUSE_EDF_SCHEDULING == 1 )
+	UBaseType_t uxTaskEDFGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * <pre>UBaseType_t uxTaskPriorityGet( TaskHandle_t xTask );</pre>
@@ -1686,10 +1822,20 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
  *
+ * Each task holds configTASK_NOTIFICATION_ARRAY_ENTRIES notification values,
+ * each with its own pending state.  The functions whose name ends in Indexed,
+ * or Indexed followed by FromISR, take the index of the one they use; the
+ * others use index tskDEFAULT_INDEX_TO_NOTIFY, which is 0.  A task waits on one
+ * index at a time, and a notification sent to another index stays pending
+ * without unblocking it.  Senders that each notify a task through an index of
+ * their own - a driver, a timer, a ROS bridge - cannot overwrite each other's
+ * values, which they could with a single value.
+ *
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
@@ -1762,13 +1908,16 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1853,13 +2002,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1930,11 +2082,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWait, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWait ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -1976,11 +2131,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ * void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2031,11 +2188,14 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2100,11 +2260,14 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWait, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWait ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
@@ -2116,7 +2279,9 @@ uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2139,6 +2304,19 @@ BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
  */
 BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Equivalent to calling xTaskIncrementTick() xTicksToAdvance times, for a
+ * port that finds several tick periods have passed since the last tick it
+ * handled.  Every task whose timeout expires within those ticks is unblocked,
+ * and the return value tells whether a context switch is required once all
+ * of the ticks have been processed, so the port makes a single decision.
+ */
+BaseType_t xTaskIncrementTicks( TickType_t xTicksToAdvance ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -2171,7 +2349,7 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  * period.
  */
 void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const ListItemValue_t xItemValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
@@ -2211,7 +2389,23 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
  * making the call, otherwise pdFALSE.
  */
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const ListItemValue_t xItemValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * As vTaskRemoveFromUnorderedEventList(), but can be called from an interrupt,
+ * when the scheduler is not suspended.  Used by event groups when
+ * configUSE_EVENT_GROUP_DIRECT_ISR is 1, as interrupts then access their event
+ * lists.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const ListItemValue_t xItemValue ) PRIVILEGED_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
@@ -2227,7 +2421,7 @@ void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
  * THE EVENT BITS MODULE.
  */
-TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
+ListItemValue_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Return the handle of the calling task.
@@ -2322,12 +2516,38 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 void *pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Record the mutex the calling task is about to block
+ * on, or NULL once it stopped waiting, so priority inheritance can follow a
+ * chain of held mutexes.
+ */
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	void vTaskSetMutexWaitedFor( void *pvMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Called from a critical section by a task that found
+ * an adaptive mutex held by pxMutexHolder, to find out whether the holder can
+ * give it back without the calling task blocking.
+ */
+eMutexHolderState eTaskGetMutexHolderState( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Used by poll sets to record the member a
+ * notification index of xTask was added as, and to find out whether a
+ * notification is pending on the index.
+ */
+void **ppvTaskGetPollSetMember( TaskHandle_t xTask, UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyIsPending( TaskHandle_t xTask, UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+
+portEND_EXPORTED_API
 
 #ifdef __cplusplus
 }
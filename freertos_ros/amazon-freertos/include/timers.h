@@ -42,6 +42,8 @@ happens to also be including task.h. */
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 /*-----------------------------------------------------------
  * MACROS AND DEFINITIONS
  *----------------------------------------------------------*/
@@ -59,12 +61,15 @@ or interrupt version of the queue send function should be used. */
 #define tmrCOMMAND_STOP							( ( BaseType_t ) 3 )
 #define tmrCOMMAND_CHANGE_PERIOD				( ( BaseType_t ) 4 )
 #define tmrCOMMAND_DELETE						( ( BaseType_t ) 5 )
+#define tmrCOMMAND_START_BULK					( ( BaseType_t ) 6 )
+#define tmrCOMMAND_RESET_BULK					( ( BaseType_t ) 7 )
+#define tmrCOMMAND_STOP_BULK					( ( BaseType_t ) 8 )
 
-#define tmrFIRST_FROM_ISR_COMMAND				( ( BaseType_t ) 6 )
-#define tmrCOMMAND_START_FROM_ISR				( ( BaseType_t ) 6 )
-#define tmrCOMMAND_RESET_FROM_ISR				( ( BaseType_t ) 7 )
-#define tmrCOMMAND_STOP_FROM_ISR				( ( BaseType_t ) 8 )
-#define tmrCOMMAND_CHANGE_PERIOD_FROM_ISR		( ( BaseType_t ) 9 )
+#define tmrFIRST_FROM_ISR_COMMAND				( ( BaseType_t ) 9 )
+#define tmrCOMMAND_START_FROM_ISR				( ( BaseType_t ) 9 )
+#define tmrCOMMAND_RESET_FROM_ISR				( ( BaseType_t ) 10 )
+#define tmrCOMMAND_STOP_FROM_ISR				( ( BaseType_t ) 11 )
+#define tmrCOMMAND_CHANGE_PERIOD_FROM_ISR		( ( BaseType_t ) 12 )
 
 
 /**
@@ -362,6 +367,61 @@ typedef void (*PendedFunction_t)( void *, uint32_t );
 										StaticTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * TimerHandle_t xTimerCreateForService(	const char * const pcTimerName,
+ * 										TickType_t xTimerPeriodInTicks,
+ * 										UBaseType_t uxAutoReload,
+ * 										void * pvTimerID,
+ * 										TimerCallbackFunction_t pxCallbackFunction,
+ * 										UBaseType_t uxTimerService );
+ *
+ * TimerHandle_t xTimerCreateStaticForService(	const char * const pcTimerName,
+ * 											TickType_t xTimerPeriodInTicks,
+ * 											UBaseType_t uxAutoReload,
+ * 											void * pvTimerID,
+ * 											TimerCallbackFunction_t pxCallbackFunction,
+ * 											UBaseType_t uxTimerService,
+ * 											StaticTimer_t *pxTimerBuffer );
+ *
+ * The same as xTimerCreate() and xTimerCreateStatic(), but the timer is bound
+ * to the timer service task uxTimerService rather than to the first one.
+ *
+ * There are configTIMER_SERVICE_TASKS timer service tasks, each with its own
+ * command queue, its own active timers and the priority given to it in
+ * configTIMER_SERVICE_TASK_PRIORITIES.  The commands sent to a timer go to the
+ * queue of its service, and its callback runs in that service's task, so a
+ * callback that takes long only delays the timers of the same service.  Timers
+ * that must not be delayed by others are bound to a service of their own at
+ * a higher priority.
+ *
+ * A bulk command, such as xTimerStartBulk(), can only be applied to timers of
+ * the same service.  Pended function calls always run in the first service.
+ *
+ * @param uxTimerService The index of the timer service task, less than
+ * configTIMER_SERVICE_TASKS.
+ *
+ * The other parameters and the return value are those of xTimerCreate() and
+ * xTimerCreateStatic().
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	TimerHandle_t xTimerCreateForService(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const TickType_t xTimerPeriodInTicks,
+											const UBaseType_t uxAutoReload,
+											void * const pvTimerID,
+											TimerCallbackFunction_t pxCallbackFunction,
+											const UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	TimerHandle_t xTimerCreateStaticForService(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const TickType_t xTimerPeriodInTicks,
+												const UBaseType_t uxAutoReload,
+												void * const pvTimerID,
+												TimerCallbackFunction_t pxCallbackFunction,
+												const UBaseType_t uxTimerService,
+												StaticTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /**
  * void *pvTimerGetTimerID( TimerHandle_t xTimer );
  *
@@ -450,6 +510,16 @@ BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxTimerService );
+ *
+ * Returns the handle of the timer service task uxTimerService, see
+ * xTimerCreateForService().  xTimerGetTimerDaemonTaskHandle() returns the
+ * handle of the first one.  It is not valid to call
+ * xTimerGetTimerServiceTaskHandle() before the scheduler has been started.
+ */
+TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+
 /**
  * BaseType_t xTimerStart( TimerHandle_t xTimer, TickType_t xTicksToWait );
  *
@@ -786,6 +856,54 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  */
 #define xTimerReset( xTimer, xTicksToWait ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_RESET, ( xTaskGetTickCount() ), NULL, ( xTicksToWait ) )
 
+/**
+ * BaseType_t xTimerStartBulk( TimerHandle_t const *pxTimers,
+ *                             UBaseType_t uxNumberOfTimers,
+ *                             TickType_t xTicksToWait );
+ *
+ * BaseType_t xTimerResetBulk( TimerHandle_t const *pxTimers,
+ *                             UBaseType_t uxNumberOfTimers,
+ *                             TickType_t xTicksToWait );
+ *
+ * BaseType_t xTimerStopBulk( TimerHandle_t const *pxTimers,
+ *                            UBaseType_t uxNumberOfTimers,
+ *                            TickType_t xTicksToWait );
+ *
+ * Apply xTimerStart(), xTimerReset() or xTimerStop() to each of the
+ * uxNumberOfTimers timers in the pxTimers array with a single message on the
+ * timer command queue, instead of one message, and possibly one switch to the
+ * timer service task, per timer.  Every timer is given the same command
+ * time, the tick count at the time of the call.
+ *
+ * The timer service task reads the array when it processes the command, so
+ * the array must remain valid and unchanged until then - for example a
+ * static array of the timers a task resets in each of its cycles.  These
+ * macros must not be called from an interrupt service routine.
+ *
+ * @param pxTimers The handles of the timers.
+ *
+ * @param uxNumberOfTimers The number of handles in pxTimers.
+ *
+ * @param xTicksToWait As for xTimerStart().
+ *
+ * @return pdFAIL if the command could not be sent to the timer command queue
+ * before xTicksToWait ticks passed, otherwise pdPASS.
+ *
+ * Example usage:
+ * @verbatim
+ * static TimerHandle_t xWatchdogs[ NUM_WATCHDOGS ];
+ *
+ * void vCycle( void )
+ * {
+ *     // All of the watchdogs were fed in this cycle.
+ *     xTimerResetBulk( xWatchdogs, NUM_WATCHDOGS, portMAX_DELAY );
+ * }
+ * @endverbatim
+ */
+#define xTimerStartBulk( pxTimers, uxNumberOfTimers, xTicksToWait ) xTimerGenericCommandBulk( ( pxTimers ), ( uxNumberOfTimers ), tmrCOMMAND_START_BULK, ( xTaskGetTickCount() ), ( xTicksToWait ) )
+#define xTimerResetBulk( pxTimers, uxNumberOfTimers, xTicksToWait ) xTimerGenericCommandBulk( ( pxTimers ), ( uxNumberOfTimers ), tmrCOMMAND_RESET_BULK, ( xTaskGetTickCount() ), ( xTicksToWait ) )
+#define xTimerStopBulk( pxTimers, uxNumberOfTimers, xTicksToWait ) xTimerGenericCommandBulk( ( pxTimers ), ( uxNumberOfTimers ), tmrCOMMAND_STOP_BULK, 0U, ( xTicksToWait ) )
+
 /**
  * BaseType_t xTimerStartFromISR( 	TimerHandle_t xTimer,
  *									BaseType_t *pxHigherPriorityTaskWoken );
@@ -1262,12 +1380,15 @@ TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 BaseType_t xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTimerGenericCommandBulk( TimerHandle_t const * const pxTimers, const UBaseType_t uxNumberOfTimers, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
 #if( configUSE_TRACE_FACILITY == 1 )
 	void vTimerSetTimerNumber( TimerHandle_t xTimer, UBaseType_t uxTimerNumber ) PRIVILEGED_FUNCTION;
 	UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 #endif
 
+portEND_EXPORTED_API
+
 #ifdef __cplusplus
 }
 #endif
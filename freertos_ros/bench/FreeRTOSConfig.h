@@ -0,0 +1,242 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Configuration of the kernel benchmarks under bench/.  It follows
+ * source/FreeRTOSConfig.h, with a 1 kHz tick, more priorities, a larger heap,
+ * the tick hook used for time accounting and the optional features enabled.
+ *
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION                    1
+#ifndef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE                 0
+#endif
+#define configCPU_CLOCK_HZ                      (SystemCoreClock)
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMAX_PRIORITIES                    16
+#define configMINIMAL_STACK_SIZE                ((unsigned short)90)
+#define configMAX_TASK_NAME_LEN                 20
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   8
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_ALTERNATIVE_API               0 /* Deprecated! */
+#define configQUEUE_REGISTRY_SIZE               8
+#ifndef configUSE_QUEUE_SETS
+#define configUSE_QUEUE_SETS                    0
+#endif
+#ifndef configUSE_TIME_SLICING
+#define configUSE_TIME_SLICING                  0
+#endif
+#define configUSE_NEWLIB_REENTRANT              0
+#define configENABLE_BACKWARD_COMPATIBILITY     0
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+
+/* Used memory allocation (heap_x.c) */
+#define configFRTOS_MEMORY_SCHEME               4
+/* Tasks.c additions (e.g. Thread Aware Debug capability) */
+#ifndef configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H
+#define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H 1
+#endif
+
+/* Memory allocation related definitions. */
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   ((size_t)(16 * 1024 * 1024))
+#define configAPPLICATION_ALLOCATED_HEAP        0
+
+/* Hook function related definitions. */
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     1
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+
+/* Run time and task stats gathering related definitions. */
+#define configGENERATE_RUN_TIME_STATS           0
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    0
+
+/* Keep the port quiet, the benchmarks report on stdout. */
+#define configPORT_VERBOSE                      0
+
+/* Catch up with missed ticks in one call of the tick handler. */
+#ifndef configPORT_MAX_CATCH_UP_TICKS
+#define configPORT_MAX_CATCH_UP_TICKS           1000
+#endif
+
+/* Scheduling classes exercised by the benchmarks.  The options below can be
+ * overridden per benchmark from the Makefile. */
+#ifndef configUSE_EDF_SCHEDULING
+#define configUSE_EDF_SCHEDULING                1
+#endif
+
+/* Delayed tasks and timers on a timing wheel, 256 ticks by 64 turns. */
+#ifndef configUSE_TIMING_WHEEL
+#define configUSE_TIMING_WHEEL                  1
+#endif
+#define configTIMING_WHEEL_SLOT_BITS            8
+#define configTIMING_WHEEL_ROUND_BITS           6
+
+/* Sorted lists without a skip index, see bench_list. */
+#ifndef configUSE_LIST_SKIP_INDEX
+#define configUSE_LIST_SKIP_INDEX               0
+#endif
+
+/* Stream and message buffers without a critical section unless a task has to
+ * block. */
+#ifndef configUSE_LOCK_FREE_STREAM_BUFFERS
+#define configUSE_LOCK_FREE_STREAM_BUFFERS      1
+#endif
+
+/* Message buffers with a lane per writer. */
+#ifndef configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS
+#define configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS 1
+#endif
+
+/* Waits on many queues, stream buffers and notifications at once. */
+#ifndef configUSE_POLL_SETS
+#define configUSE_POLL_SETS                     1
+#endif
+
+/* Event group bits set by interrupts themselves, and waiting tasks filed under
+ * the bits they wait for. */
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR
+#define configUSE_EVENT_GROUP_DIRECT_ISR        1
+#endif
+#ifndef configUSE_EVENT_GROUP_BIT_INDEX
+#define configUSE_EVENT_GROUP_BIT_INDEX         1
+#endif
+
+/* Priorities passed on down chains of held mutexes, and the contention of each
+ * mutex timed in microseconds of the host clock. */
+#ifndef configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 1
+#endif
+#define configUSE_MUTEX_STATS                   1
+#include <stdint.h>
+uint32_t ulBenchNowUs( void );
+#define configMUTEX_STATS_TIME()                ulBenchNowUs()
+
+/* Mutexes that yield to a preempted holder before blocking. */
+#define configUSE_ADAPTIVE_MUTEXES              1
+
+/* With tickless idle the idle task moves the tick count on to the next task to
+ * wake rather than sleeping, see bench_ticks.c. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+#include <stdint.h>
+void vBenchSuppressTicksAndSleep( uint64_t ullExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vBenchSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Task aware debugging. */
+#define configRECORD_STACK_HIGH_ADDRESS         1
+
+/* Co-routine related definitions. */
+#define configUSE_CO_ROUTINES                   0
+#define configMAX_CO_ROUTINE_PRIORITIES         2
+
+/* Software timer related definitions. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            (configMINIMAL_STACK_SIZE * 2)
+
+/* A second timer service task below the tasks of the benchmarks, for timers
+ * with slow callbacks. */
+#define configTIMER_SERVICE_TASKS               2
+#define configTIMER_SERVICE_TASK_PRIORITIES     { configTIMER_TASK_PRIORITY, 2 }
+
+/* Define to trap errors during development. */
+void vBenchAssertFailed( const char *pcFile, int iLine );
+#define configASSERT(x) if(( x) == 0) { vBenchAssertFailed( __FILE__, __LINE__ ); }
+
+/* Optional functions - most linkers will remove unused functions anyway. */
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     0
+#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_eTaskGetState                   1
+#define INCLUDE_xTimerPendFunctionCall          1
+#define INCLUDE_xTaskAbortDelay                 1
+#define INCLUDE_xTaskGetHandle                  0
+#define INCLUDE_xTaskResumeFromISR              1
+
+
+/* Interrupt nesting behaviour configuration. Cortex-M specific. */
+#ifdef __NVIC_PRIO_BITS
+/* __BVIC_PRIO_BITS will be specified when CMSIS is being used. */
+#define configPRIO_BITS __NVIC_PRIO_BITS
+#else
+#define configPRIO_BITS 4 /* 15 priority levels */
+#endif
+
+/* The lowest interrupt priority that can be used in a call to a "set priority"
+function. */
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY ((1U << (configPRIO_BITS)) - 1)
+
+/* The highest interrupt priority that can be used by any interrupt service
+routine that makes calls to interrupt safe FreeRTOS API functions.  DO NOT CALL
+INTERRUPT SAFE FREERTOS API FUNCTIONS FROM ANY INTERRUPT THAT HAS A HIGHER
+PRIORITY THAN THIS! (higher priorities are lower numeric values. */
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY 2
+
+/* Interrupt priorities used by the kernel port layer itself.  These are generic
+to all Cortex-M ports, and do not rely on any particular library functions. */
+#define configKERNEL_INTERRUPT_PRIORITY (configLIBRARY_LOWEST_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+/* !!!! configMAX_SYSCALL_INTERRUPT_PRIORITY must not be set to zero !!!!
+See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+
+/* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
+standard names. */
+#define vPortSVCHandler SVC_Handler
+#define xPortPendSVHandler PendSV_Handler
+#define xPortSysTickHandler SysTick_Handler
+
+#endif /* FREERTOS_CONFIG_H */
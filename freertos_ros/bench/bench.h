@@ -0,0 +1,49 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> host benchmarks of the FreeRTOS kernel on the ROS port
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Each benchmark is a separate executable that links the kernel, the Linux
+ * port, heap_4.c, bench_main.c and one bench_<name>.c.  bench_main.c provides
+ * main(): it starts the host thread that drives the tick and then calls
+ * vStartFreeRTOS(), which in turn calls the freeRTOS_main() defined by the
+ * benchmark.  A benchmark prints its result lines on stdout as
+ * "bench=<name> key=value ..." and then ends the process with exit().
+ */
+
+/* Command line of the benchmark, after the options read by bench_main.c. */
+extern int iBenchArgc;
+extern char **ppcBenchArgv;
+
+/* Called from the tick hook, so from the tick thread, when not NULL. */
+extern void ( *pxBenchTickHook )( void );
+
+/* Called from the tick thread with the time vPortSysTickHandler() took, when
+not NULL. */
+extern void ( *pxBenchTickCost )( uint64_t ullNs );
+
+/* Tick period of the host tick thread, in microseconds. */
+extern unsigned long ulBenchTickPeriodUs;
+
+/* Return the integer argument at xIndex, or lDefault if there is none. */
+long lBenchArgument( int xIndex, long lDefault );
+
+static inline uint64_t ullBenchNowNs( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+
+#endif /* BENCH_H */
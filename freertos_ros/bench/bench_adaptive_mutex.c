@@ -0,0 +1,179 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> short critical sections under a mutex shared by many tasks
+ */
+
+/*
+ * Tasks of the same priority take a mutex, work for <section us> with it,
+ * give it and work for as long again without it, over and over.  Time slicing
+ * switches between the tasks on each tick, so a tick that comes in while a
+ * task holds the mutex leaves the mutex held by a preempted task, and the tasks
+ * that run next find it held.  The number of critical sections per second and
+ * the counters of the mutex are reported.
+ *
+ *   bench_adaptive_mutex [-t <tick us>] block|adaptive [<tasks>] [<section us>] [<max yields>] [<duration in ticks>]
+ *
+ * block     The mutex is created by xSemaphoreCreateMutex(): a task that finds
+ *           it held blocks until it is given.
+ * adaptive  The mutex is created by xSemaphoreCreateAdaptiveMutex() with up to
+ *           <max yields> yields: a task that finds it held by a preempted task
+ *           of its priority yields to the holder before it blocks.
+ *
+ * The ROS port runs one task at a time, so a holder is never running while
+ * another task takes the mutex and the spin limit is not exercised here.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION		1000
+#define benchMAX_TASKS				32
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchWORKER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+static BaseType_t xAdaptive;
+static long lTasks;
+static long lSectionUs;
+static long lDuration;
+
+static SemaphoreHandle_t xMutex;
+static volatile unsigned long ulSections[ benchMAX_TASKS ];
+static volatile unsigned long ulShared;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvBusyWaitUs( const long lUs )
+{
+const uint64_t ullEnd = ullBenchNowNs() + ( ( uint64_t ) lUs * 1000ULL );
+
+	while( ullBenchNowNs() < ullEnd )
+	{
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+const long lWorker = ( long ) ( uintptr_t ) pvParameters;
+unsigned long ulBefore;
+
+	for( ;; )
+	{
+		configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+		{
+			/* Another task in the critical section would show here. */
+			ulBefore = ulShared;
+			prvBusyWaitUs( lSectionUs );
+			ulShared = ulBefore + 1UL;
+		}
+		configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+
+		ulSections[ lWorker ]++;
+		prvBusyWaitUs( lSectionUs );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulStart, ulTotal, ulMin, ulMax;
+AdaptiveMutexStats_t xAdaptiveStats;
+MutexStats_t xStats;
+long x;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	vSemaphoreResetMutexStats( xMutex );
+	ulStart = ulShared;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	vTaskSuspendAll();
+
+	ulTotal = 0;
+	ulMin = ~0UL;
+	ulMax = 0;
+	for( x = 0; x < lTasks; x++ )
+	{
+		ulTotal += ulSections[ x ];
+		ulMin = ( ulSections[ x ] < ulMin ) ? ulSections[ x ] : ulMin;
+		ulMax = ( ulSections[ x ] > ulMax ) ? ulSections[ x ] : ulMax;
+	}
+
+	/* The shared count only misses increments if the mutex let two tasks in. */
+	configASSERT( ulShared == ulTotal );
+
+	vSemaphoreGetMutexStats( xMutex, &xStats );
+	vSemaphoreGetAdaptiveMutexStats( xMutex, &xAdaptiveStats );
+
+	printf( "bench=adaptive_mutex mode=%s tasks=%ld section_us=%ld tick_us=%lu sections_per_s=%.0f contended=%lu yields=%lu acquired_without_blocking=%lu fallbacks=%lu max_wait_us=%lu min_task=%lu max_task=%lu\n",
+			( xAdaptive != pdFALSE ) ? "adaptive" : "block",
+			lTasks,
+			lSectionUs,
+			ulBenchTickPeriodUs,
+			( ( double ) ( ulShared - ulStart ) * 1e9 ) / ( double ) ullWallNs,
+			( unsigned long ) ( xStats.ulContendedWaits + xAdaptiveStats.ulAcquiredWithoutBlocking ),
+			( unsigned long ) xAdaptiveStats.ulYields,
+			( unsigned long ) xAdaptiveStats.ulAcquiredWithoutBlocking,
+			( unsigned long ) xAdaptiveStats.ulFallbacks,
+			( unsigned long ) xStats.ulMaxWaitTime,
+			ulMin,
+			ulMax );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "adaptive";
+long x;
+
+	xAdaptive = ( strcmp( pcMode, "adaptive" ) == 0 ) ? pdTRUE : pdFALSE;
+	lTasks = lBenchArgument( 2, 8 );
+	lSectionUs = lBenchArgument( 3, 5 );
+	lDuration = lBenchArgument( 5, benchDEFAULT_DURATION );
+
+	configASSERT( ( lTasks > 1 ) && ( lTasks <= benchMAX_TASKS ) );
+
+	if( xAdaptive != pdFALSE )
+	{
+		xMutex = xSemaphoreCreateAdaptiveMutex();
+		configASSERT( xMutex );
+		vSemaphoreSetAdaptiveMutexLimits( xMutex, configADAPTIVE_MUTEX_MAX_SPINS, ( UBaseType_t ) lBenchArgument( 4, configADAPTIVE_MUTEX_MAX_YIELDS ) );
+	}
+	else
+	{
+		xMutex = xSemaphoreCreateMutex();
+		configASSERT( xMutex );
+	}
+
+	for( x = 0; x < lTasks; x++ )
+	{
+		xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchWORKER_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
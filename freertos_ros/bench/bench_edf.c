@@ -0,0 +1,227 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> EDF against rate monotonic scheduling
+ */
+
+/*
+ * Runs five periodic tasks with implicit deadlines (deadline == period) at a
+ * given total utilisation, either at rate monotonic fixed priorities or
+ * under the EDF band of the kernel, and reports the deadline misses.
+ *
+ *   bench_edf edf|edf-budget|rm <utilisation %> [<duration in ticks>]
+ *
+ * Execution time is counted in ticks by the tick hook, which charges each
+ * tick to the task that was running, so the result does not depend on the
+ * speed of the host.  A job is the busy loop that consumes its ticks.
+ *
+ * edf-budget exits with status 1 if it misses a deadline at 100 % load or
+ * below: the budget of each job covers its cost, so no job is abandoned.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define benchNUM_TASKS			5
+#define benchDEFAULT_DURATION	3000
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+typedef enum
+{
+	eBenchRM,
+	eBenchEDF,
+	eBenchEDFBudget
+} eBenchPolicy;
+
+typedef struct BENCH_PERIODIC
+{
+	TickType_t xPeriod;
+	TickType_t xCost;
+	TaskHandle_t xHandle;
+	volatile TickType_t xExecuted;	/* Ticks charged by the tick hook. */
+	UBaseType_t uxJobs;
+	UBaseType_t uxMisses;			/* Counted by the task itself under rm. */
+} BenchPeriodic_t;
+
+static BenchPeriodic_t xTasks[ benchNUM_TASKS ] =
+{
+	{ 50 }, { 70 }, { 110 }, { 130 }, { 170 }
+};
+
+static eBenchPolicy ePolicy;
+static long lLoad;
+static long lDuration;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvChargeTick( void )
+{
+TaskHandle_t xCurrent = xTaskGetCurrentTaskHandle();
+int i;
+
+	for( i = 0; i < benchNUM_TASKS; i++ )
+	{
+		if( xTasks[ i ].xHandle == xCurrent )
+		{
+			xTasks[ i ].xExecuted++;
+			break;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunJob( BenchPeriodic_t *pxTask )
+{
+const TickType_t xStart = pxTask->xExecuted;
+
+	while( ( TickType_t ) ( pxTask->xExecuted - xStart ) < pxTask->xCost )
+	{
+		/* Busy, the tick hook accounts for the time. */
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvEDFTask( void *pvParameters )
+{
+BenchPeriodic_t *pxTask = ( BenchPeriodic_t * ) pvParameters;
+
+	for( ;; )
+	{
+		prvRunJob( pxTask );
+		pxTask->uxJobs++;
+		vTaskEDFWaitForNextPeriod();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRMTask( void *pvParameters )
+{
+BenchPeriodic_t *pxTask = ( BenchPeriodic_t * ) pvParameters;
+TickType_t xRelease = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		prvRunJob( pxTask );
+		pxTask->uxJobs++;
+
+		/* Same rule as the kernel: late if the tick count reached the
+		deadline before the job completed. */
+		if( ( TickType_t ) ( xTaskGetTickCount() - xRelease ) >= pxTask->xPeriod )
+		{
+			pxTask->uxMisses++;
+		}
+
+		vTaskDelayUntil( &xRelease, pxTask->xPeriod );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+UBaseType_t uxJobs = 0, uxMisses = 0;
+int i;
+
+	( void ) pvParameters;
+
+	vTaskDelay( ( TickType_t ) lDuration );
+
+	vTaskSuspendAll();
+
+	for( i = 0; i < benchNUM_TASKS; i++ )
+	{
+		if( ePolicy != eBenchRM )
+		{
+			xTasks[ i ].uxMisses = uxTaskEDFGetDeadlineMisses( xTasks[ i ].xHandle );
+		}
+
+		uxJobs += xTasks[ i ].uxJobs;
+		uxMisses += xTasks[ i ].uxMisses;
+	}
+
+	printf( "bench=edf policy=%s load=%ld jobs=%lu misses=%lu miss_pct=%.1f",
+			( ePolicy == eBenchRM ) ? "rm" : ( ( ePolicy == eBenchEDF ) ? "edf" : "edf-budget" ),
+			lLoad, ( unsigned long ) uxJobs, ( unsigned long ) uxMisses,
+			( uxJobs != 0 ) ? ( 100.0 * uxMisses ) / ( double ) uxJobs : 0.0 );
+
+	for( i = 0; i < benchNUM_TASKS; i++ )
+	{
+		printf( " t%lu=%lu/%lu", ( unsigned long ) xTasks[ i ].xPeriod, ( unsigned long ) xTasks[ i ].uxMisses, ( unsigned long ) xTasks[ i ].uxJobs );
+	}
+
+	printf( "\n" );
+
+	/* A budget of at least the cost of each job never abandons a job of a
+	feasible task set. */
+	if( ( ePolicy == eBenchEDFBudget ) && ( lLoad <= 100 ) && ( uxMisses != 0 ) )
+	{
+		fprintf( stderr, "bench_edf: edf-budget missed %lu deadlines at %ld%% load\n", ( unsigned long ) uxMisses, lLoad );
+		exit( 1 );
+	}
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+char xName[ configMAX_TASK_NAME_LEN ];
+int i;
+
+	ePolicy = eBenchEDF;
+	if( iBenchArgc > 1 )
+	{
+		if( strcmp( ppcBenchArgv[ 1 ], "rm" ) == 0 )
+		{
+			ePolicy = eBenchRM;
+		}
+		else if( strcmp( ppcBenchArgv[ 1 ], "edf-budget" ) == 0 )
+		{
+			ePolicy = eBenchEDFBudget;
+		}
+	}
+
+	lLoad = lBenchArgument( 2, 90 );
+	lDuration = lBenchArgument( 3, benchDEFAULT_DURATION );
+
+	/* Each task gets an equal share of the utilisation. */
+	for( i = 0; i < benchNUM_TASKS; i++ )
+	{
+		xTasks[ i ].xCost = ( TickType_t ) ( ( xTasks[ i ].xPeriod * lLoad ) / ( 100 * benchNUM_TASKS ) );
+	}
+
+	pxBenchTickHook = prvChargeTick;
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	for( i = 0; i < benchNUM_TASKS; i++ )
+	{
+		snprintf( xName, sizeof( xName ), "P%lu", ( unsigned long ) xTasks[ i ].xPeriod );
+
+		if( ePolicy == eBenchRM )
+		{
+			/* Shortest period, highest priority. */
+			xTaskCreate( prvRMTask, xName, configMINIMAL_STACK_SIZE, &xTasks[ i ], benchMONITOR_PRIORITY - 1 - i, &xTasks[ i ].xHandle );
+		}
+		else
+		{
+		EDFParameters_t xParameters;
+
+			xParameters.xPeriod = xTasks[ i ].xPeriod;
+			xParameters.xRelativeDeadline = xTasks[ i ].xPeriod;
+			/* One tick of slack for the tick that lands on the boundary
+			between two jobs, which the kernel charges to the next job. */
+			xParameters.xBudget = ( ePolicy == eBenchEDFBudget ) ? xTasks[ i ].xCost + 1 : 0;
+			xParameters.pxDeadlineMissHook = NULL;
+			xTaskCreateEDF( prvEDFTask, xName, configMINIMAL_STACK_SIZE, &xTasks[ i ], &xParameters, &xTasks[ i ].xHandle );
+		}
+	}
+
+	vTaskStartScheduler();
+
+	for( ;; );
+}
@@ -0,0 +1,222 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> latency of event group bits set from an interrupt or a task
+ */
+
+/*
+ * A task waits for bit 0 of an event group, which is set over and over, and
+ * the time from the set to the task running is reported.  Other tasks wait
+ * for bits 1 to 23, which are never set.
+ *
+ *   bench_event_groups isr|task|set [<other waiting tasks>] [<duration in ticks>]
+ *
+ * isr   The tick hook sets bit 0 with xEventGroupSetBitsFromISR() every tick.
+ * task  A task of a lower priority sets bit 0 with xEventGroupSetBits() as
+ *       soon as the waiting task blocks again.
+ * set   No task waits for bit 0, and the cost of xEventGroupSetBits() on its
+ *       own is reported, which is the cost of looking at the waiting tasks.
+ *
+ * bench_event_groups sets the bits from the interrupt itself and files the
+ * waiting tasks under the bits they wait for.  bench_event_groups_deferred is
+ * the same benchmark with the kernel as before, where the interrupt hands the
+ * set over to the timer service task and every waiting task is looked at.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION	2000
+#define benchHISTOGRAM_US		10000
+#define benchBIT				( ( EventBits_t ) 1 )
+#define benchOTHER_BITS			23
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 2 )
+#define benchWAITER_PRIORITY	( configMAX_PRIORITIES - 3 )
+#define benchSETTER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+
+static BaseType_t xFromISR;
+static BaseType_t xSetOnly;
+static long lOtherWaiters;
+static long lDuration;
+
+static EventGroupHandle_t xEventGroup;
+static volatile uint64_t ullSetNs;
+static volatile BaseType_t xMeasuring = pdFALSE;
+
+static unsigned long ulWakes;
+static volatile unsigned long ulSets;
+static uint64_t ullLatencySumNs;
+static uint64_t ullMaxLatencyNs;
+static unsigned long ulHistogram[ benchHISTOGRAM_US + 1 ];
+
+/*----------------------------------------------------------------------------*/
+
+static void prvTickHook( void )
+{
+	/* Only once the last set has been seen, so each set is measured.  The tick
+	interrupt switches to the woken task on its way out. */
+	if( ullSetNs == 0 )
+	{
+		ullSetNs = ullBenchNowNs();
+		( void ) xEventGroupSetBitsFromISR( xEventGroup, benchBIT, NULL );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSetterTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xSetOnly != pdFALSE )
+		{
+			( void ) xEventGroupSetBits( xEventGroup, benchBIT );
+			ulSets++;
+		}
+		else
+		{
+			/* Runs when the waiting task has blocked again. */
+			ullSetNs = ullBenchNowNs();
+			( void ) xEventGroupSetBits( xEventGroup, benchBIT );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+uint64_t ullLatencyNs;
+EventBits_t uxBits;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		uxBits = xEventGroupWaitBits( xEventGroup, benchBIT, pdTRUE, pdFALSE, portMAX_DELAY );
+		ullLatencyNs = ullBenchNowNs() - ullSetNs;
+		configASSERT( ( uxBits & benchBIT ) != 0 );
+
+		if( xMeasuring != pdFALSE )
+		{
+			ulWakes++;
+			ullLatencySumNs += ullLatencyNs;
+			ullMaxLatencyNs = ( ullLatencyNs > ullMaxLatencyNs ) ? ullLatencyNs : ullMaxLatencyNs;
+			ulHistogram[ ( ullLatencyNs / 1000ULL < benchHISTOGRAM_US ) ? ullLatencyNs / 1000ULL : benchHISTOGRAM_US ]++;
+		}
+
+		ullSetNs = 0;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvOtherWaiterTask( void *pvParameters )
+{
+const EventBits_t uxBit = benchBIT << ( 1 + ( ( uintptr_t ) pvParameters % benchOTHER_BITS ) );
+
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xEventGroup, uxBit, pdTRUE, pdFALSE, portMAX_DELAY );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+unsigned long ulCount = 0, ulP99Us = 0, ulSetsStart;
+uint64_t ullStartNs;
+long x;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 100 );
+
+	ulSetsStart = ulSets;
+	ullStartNs = ullBenchNowNs();
+	xMeasuring = pdTRUE;
+	vTaskDelay( ( TickType_t ) lDuration );
+	xMeasuring = pdFALSE;
+
+	vTaskSuspendAll();
+
+	if( xSetOnly != pdFALSE )
+	{
+		printf( "bench=event_groups direct_isr=%d bit_index=%d mode=set other_waiters=%ld ns_per_set=%.0f\n",
+				configUSE_EVENT_GROUP_DIRECT_ISR,
+				configUSE_EVENT_GROUP_BIT_INDEX,
+				lOtherWaiters,
+				( double ) ( ullBenchNowNs() - ullStartNs ) / ( double ) ( ulSets - ulSetsStart ) );
+
+		exit( 0 );
+	}
+
+	for( x = 0; x <= benchHISTOGRAM_US; x++ )
+	{
+		ulCount += ulHistogram[ x ];
+
+		if( ulCount * 100UL >= ulWakes * 99UL )
+		{
+			ulP99Us = ( unsigned long ) x;
+			break;
+		}
+	}
+
+	printf( "bench=event_groups direct_isr=%d bit_index=%d mode=%s other_waiters=%ld wakes=%lu mean_us=%.1f p99_us=%lu max_us=%.1f\n",
+			configUSE_EVENT_GROUP_DIRECT_ISR,
+			configUSE_EVENT_GROUP_BIT_INDEX,
+			( xFromISR != pdFALSE ) ? "isr" : "task",
+			lOtherWaiters,
+			ulWakes,
+			( ulWakes > 0 ) ? ( ( double ) ullLatencySumNs / ( double ) ulWakes ) / 1000.0 : 0.0,
+			ulP99Us,
+			( double ) ullMaxLatencyNs / 1000.0 );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "isr";
+long x;
+
+	xFromISR = ( strcmp( pcMode, "isr" ) == 0 ) ? pdTRUE : pdFALSE;
+	xSetOnly = ( strcmp( pcMode, "set" ) == 0 ) ? pdTRUE : pdFALSE;
+	lOtherWaiters = lBenchArgument( 2, 0 );
+	lDuration = lBenchArgument( 3, benchDEFAULT_DURATION );
+
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup );
+
+	for( x = 0; x < lOtherWaiters; x++ )
+	{
+		xTaskCreate( prvOtherWaiterTask, "Other", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchWAITER_PRIORITY, NULL );
+	}
+
+	if( xSetOnly == pdFALSE )
+	{
+		xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, NULL, benchWAITER_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	if( xFromISR != pdFALSE )
+	{
+		pxBenchTickHook = prvTickHook;
+	}
+	else
+	{
+		xTaskCreate( prvSetterTask, "Setter", configMINIMAL_STACK_SIZE, NULL, benchSETTER_PRIORITY, NULL );
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> rounds of an xEventGroupSync() barrier between many tasks
+ */
+
+/*
+ * Participants meet at an xEventGroupSync() barrier over and over, each with a
+ * bit of its own, and the number of rounds per second is reported.
+ *
+ *   bench_event_sync task|isr [<participants>] [<duration in ticks>]
+ *
+ * task  All the participants are tasks.
+ * isr   The last participant is the tick interrupt, which sets its bit with
+ *       xEventGroupSetBitsFromISR() once per round, so there is at most one
+ *       round per tick.
+ *
+ * bench_event_sync has 64-bit event bits, so up to 56 participants.
+ * bench_event_sync_24 is the same benchmark with event bits as wide as the
+ * tick count, 24 participants at most.
+ *
+ * Each participant checks xEventGroupSync() returns with the bits of all the
+ * participants set, and in the end that no participant got more than one round
+ * ahead of another.  The interrupt is not counted.
+ */
+
+#include <string.h>
+#include <limits.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION		1000
+#define benchMAX_PARTICIPANTS		( ( long ) ( sizeof( EventBits_t ) * 8 ) - 8 )
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchPARTICIPANT_PRIORITY	( tskIDLE_PRIORITY + 1 )
+
+static BaseType_t xFromISR;
+static long lParticipants;
+static long lTasks;
+static long lDuration;
+
+static EventGroupHandle_t xEventGroup;
+static EventBits_t uxAllBits;
+
+static volatile unsigned long ulRounds[ 64 ];
+static volatile unsigned long ulISRSets;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvTickHook( void )
+{
+	/* Once per round: the first participant has left the last round the
+	interrupt took part in. */
+	if( ulRounds[ 0 ] == ulISRSets )
+	{
+		ulISRSets++;
+		( void ) xEventGroupSetBitsFromISR( xEventGroup, ( ( EventBits_t ) 1 ) << ( lParticipants - 1 ), NULL );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvParticipantTask( void *pvParameters )
+{
+const long lParticipant = ( long ) ( uintptr_t ) pvParameters;
+const EventBits_t uxBit = ( ( EventBits_t ) 1 ) << lParticipant;
+EventBits_t uxBits;
+
+	for( ;; )
+	{
+		uxBits = xEventGroupSync( xEventGroup, uxBit, uxAllBits, portMAX_DELAY );
+		configASSERT( ( uxBits & uxAllBits ) == uxAllBits );
+		ulRounds[ lParticipant ]++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulRoundsStart, ulMin, ulMax;
+long x;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 100 );
+
+	ulRoundsStart = ulRounds[ 0 ];
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	vTaskSuspendAll();
+
+	ulMin = ULONG_MAX;
+	ulMax = 0;
+	for( x = 0; x < lTasks; x++ )
+	{
+		ulMin = ( ulRounds[ x ] < ulMin ) ? ulRounds[ x ] : ulMin;
+		ulMax = ( ulRounds[ x ] > ulMax ) ? ulRounds[ x ] : ulMax;
+	}
+
+	configASSERT( ulMax - ulMin <= 1UL );
+
+	printf( "bench=event_sync event_bits=%u mode=%s participants=%ld rounds=%lu rounds_per_s=%.0f us_per_round=%.1f max_ahead=%lu\n",
+			( unsigned ) ( sizeof( EventBits_t ) * 8 ),
+			( xFromISR != pdFALSE ) ? "isr" : "task",
+			lParticipants,
+			ulRounds[ 0 ] - ulRoundsStart,
+			( ( double ) ( ulRounds[ 0 ] - ulRoundsStart ) * 1e9 ) / ( double ) ullWallNs,
+			( ulRounds[ 0 ] != ulRoundsStart ) ? ( ( double ) ullWallNs / 1000.0 ) / ( double ) ( ulRounds[ 0 ] - ulRoundsStart ) : 0.0,
+			ulMax - ulMin );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "task";
+long x;
+
+	xFromISR = ( strcmp( pcMode, "isr" ) == 0 ) ? pdTRUE : pdFALSE;
+	lParticipants = lBenchArgument( 2, benchMAX_PARTICIPANTS );
+	lDuration = lBenchArgument( 3, benchDEFAULT_DURATION );
+
+	configASSERT( ( lParticipants > 1 ) && ( lParticipants <= benchMAX_PARTICIPANTS ) );
+
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup );
+
+	uxAllBits = ( ( ( EventBits_t ) 1 ) << lParticipants ) - ( EventBits_t ) 1;
+
+	/* The interrupt stands in for the last participant. */
+	lTasks = ( xFromISR != pdFALSE ) ? lParticipants - 1 : lParticipants;
+
+	for( x = 0; x < lTasks; x++ )
+	{
+		xTaskCreate( prvParticipantTask, "Sync", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchPARTICIPANT_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	if( xFromISR != pdFALSE )
+	{
+		pxBenchTickHook = prvTickHook;
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> several writers to one message buffer
+ */
+
+/*
+ * Writer tasks, as acquisition tasks would, send samples to one reader task, a
+ * logger, and the number of messages the reader receives per second is
+ * reported.
+ *
+ *   bench_lanes mutex|lanes <writers> [<message size>] [<buffer size>] [<duration in ticks>]
+ *
+ * With mutex, the writers share one message buffer and take a mutex around
+ * each xMessageBufferSend(), which is what is needed today to have more than
+ * one writer.  With lanes, the message buffer is created with
+ * xMessageBufferCreateMultiProducer() and each writer sends to its own lane
+ * without a mutex.  Both use the same amount of storage: with lanes, the
+ * buffer size is shared out between the lanes.
+ *
+ * Each sample carries the number of its writer and a count, and the reader
+ * checks the samples of each writer arrive in order.  The writers have the
+ * same priority, above the reader.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "message_buffer.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION	1000
+#define benchMAX_WRITERS		64
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 2 )
+#define benchWRITER_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define benchREADER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+
+typedef struct BenchSample
+{
+	uint32_t ulWriter;
+	uint32_t ulCount;
+} BenchSample_t;
+
+static BaseType_t xLanes;
+static long lWriters;
+static long lMessageSize;
+static long lBufferSize;
+static long lDuration;
+
+static MessageBufferHandle_t xBuffer;
+static SemaphoreHandle_t xMutex;
+
+static volatile unsigned long ulReads;
+static uint32_t ulExpectedCount[ benchMAX_WRITERS ];
+
+/*----------------------------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+const uint32_t ulWriter = ( uint32_t ) ( uintptr_t ) pvParameters;
+MessageBufferHandle_t xLane = NULL;
+uint8_t *pucSample;
+BenchSample_t xSample;
+size_t xSent;
+
+	pucSample = ( uint8_t * ) pvPortMalloc( ( size_t ) lMessageSize );
+	configASSERT( pucSample );
+	memset( pucSample, ( int ) ulWriter, ( size_t ) lMessageSize );
+
+	if( xLanes != pdFALSE )
+	{
+		xLane = xMessageBufferGetLane( xBuffer, ( size_t ) ulWriter );
+	}
+
+	xSample.ulWriter = ulWriter;
+
+	for( xSample.ulCount = 0; ; xSample.ulCount++ )
+	{
+		memcpy( pucSample, &xSample, sizeof( xSample ) );
+
+		if( xLanes != pdFALSE )
+		{
+			xSent = xMessageBufferSend( xLane, pucSample, ( size_t ) lMessageSize, portMAX_DELAY );
+		}
+		else
+		{
+			( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+			xSent = xMessageBufferSend( xBuffer, pucSample, ( size_t ) lMessageSize, portMAX_DELAY );
+			( void ) xSemaphoreGive( xMutex );
+		}
+
+		configASSERT( xSent == ( size_t ) lMessageSize );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+uint8_t *pucSample;
+BenchSample_t xSample;
+size_t xReceived;
+
+	( void ) pvParameters;
+
+	pucSample = ( uint8_t * ) pvPortMalloc( ( size_t ) lMessageSize );
+	configASSERT( pucSample );
+
+	for( ;; )
+	{
+		xReceived = xMessageBufferReceive( xBuffer, pucSample, ( size_t ) lMessageSize, portMAX_DELAY );
+		configASSERT( xReceived == ( size_t ) lMessageSize );
+
+		memcpy( &xSample, pucSample, sizeof( xSample ) );
+		configASSERT( xSample.ulWriter < ( uint32_t ) lWriters );
+		configASSERT( xSample.ulCount == ulExpectedCount[ xSample.ulWriter ] );
+		ulExpectedCount[ xSample.ulWriter ]++;
+
+		ulReads++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulReadsStart;
+uint32_t ulMin, ulMax;
+long x;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 100 );
+
+	ulReadsStart = ulReads;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	vTaskSuspendAll();
+
+	/* How evenly the writers got through, over the whole run. */
+	ulMin = UINT32_MAX;
+	ulMax = 0;
+	for( x = 0; x < lWriters; x++ )
+	{
+		ulMin = ( ulExpectedCount[ x ] < ulMin ) ? ulExpectedCount[ x ] : ulMin;
+		ulMax = ( ulExpectedCount[ x ] > ulMax ) ? ulExpectedCount[ x ] : ulMax;
+	}
+
+	printf( "bench=lanes mode=%s writers=%ld size=%ld buffer=%ld msgs_per_s=%.0f mb_per_s=%.1f min_writer=%lu max_writer=%lu\n",
+			( xLanes != pdFALSE ) ? "lanes" : "mutex",
+			lWriters,
+			lMessageSize,
+			lBufferSize,
+			( ( double ) ( ulReads - ulReadsStart ) * 1e9 ) / ( double ) ullWallNs,
+			( ( double ) ( ulReads - ulReadsStart ) * ( double ) lMessageSize * 1000.0 ) / ( double ) ullWallNs,
+			( unsigned long ) ulMin,
+			( unsigned long ) ulMax );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "lanes";
+long x;
+
+	xLanes = ( strcmp( pcMode, "lanes" ) == 0 ) ? pdTRUE : pdFALSE;
+	lWriters = lBenchArgument( 2, 8 );
+	lMessageSize = lBenchArgument( 3, 64 );
+	lBufferSize = lBenchArgument( 4, 16384 );
+	lDuration = lBenchArgument( 5, benchDEFAULT_DURATION );
+
+	configASSERT( ( lWriters > 0 ) && ( lWriters <= benchMAX_WRITERS ) );
+	configASSERT( lMessageSize >= ( long ) sizeof( BenchSample_t ) );
+
+	if( xLanes != pdFALSE )
+	{
+		xBuffer = xMessageBufferCreateMultiProducer( ( size_t ) lWriters, ( size_t ) ( lBufferSize / lWriters ) );
+	}
+	else
+	{
+		xBuffer = xMessageBufferCreate( ( size_t ) lBufferSize );
+		xMutex = xSemaphoreCreateMutex();
+		configASSERT( xMutex );
+	}
+
+	configASSERT( xBuffer );
+
+	for( x = 0; x < lWriters; x++ )
+	{
+		xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchWRITER_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, benchREADER_PRIORITY, NULL );
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
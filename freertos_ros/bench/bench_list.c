@@ -0,0 +1,350 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> sorted list insertion, with and without the skip index
+ */
+
+/*
+ * Built twice: bench_list with configUSE_LIST_SKIP_INDEX set to 1 and
+ * bench_list_plain with the list alone.  The timing wheel is off in both, so
+ * delayed tasks are in sorted lists.  Three modes:
+ *
+ *   bench_list delayed <items> [<max delay in ticks>] [<operations>]
+ *     The items are in objects the size of a TCB and are inserted with random
+ *     wake times, so that neighbours in the list are not neighbours in
+ *     memory, as with TCBs in the heap.  Then the item at the head is removed and inserted again at a random
+ *     delay after it, as the tick interrupt and the tasks do with the delayed
+ *     list.  The scheduler is not started: the port cannot run more than a
+ *     few dozen threads, so a hundred thousand items are only possible as
+ *     list items.
+ *
+ *   bench_list priority <items> [<priorities>] [<operations>]
+ *     The same with the values of an event list, a task priority out of a
+ *     few, so that most items have the same value as others.
+ *
+ *   bench_list waiters <tasks> [<rounds>]
+ *     Tasks of random priorities block on a semaphore one after the other,
+ *     then a task of a higher priority gives it once per waiter, and the
+ *     waiters check that they are woken by priority, and in the order they
+ *     blocked for the same priority.
+ *
+ * The list modes check the order of the list, and of the index, at the end.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_OPERATIONS		100000
+#define benchMAX_WAITERS			48
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchWAITER_PRIORITIES		( configMAX_PRIORITIES - 4 )
+
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+	#define benchLIST_NAME			"skip"
+#else
+	#define benchLIST_NAME			"plain"
+#endif
+
+/* An object holding a list item, as big as a TCB, with the links of the item
+at the end as in a TCB. */
+#if( configUSE_LIST_SKIP_INDEX == 1 )
+	typedef struct BENCH_OWNER
+	{
+		ListItem_t xItem;
+		uint8_t ucRest[ sizeof( StaticTask_t ) - sizeof( ListItem_t ) - ( sizeof( ListSkipLink_t ) * configLIST_SKIP_LEVELS ) ];
+		ListSkipLink_t xLinks[ configLIST_SKIP_LEVELS ];
+	} BenchOwner_t;
+#else
+	typedef struct BENCH_OWNER
+	{
+		ListItem_t xItem;
+		uint8_t ucRest[ sizeof( StaticTask_t ) - sizeof( ListItem_t ) ];
+	} BenchOwner_t;
+#endif
+
+static long lCount;
+static long lRange;
+static long lOperations;
+
+static SemaphoreHandle_t xSemaphore;
+static TaskHandle_t xWaiters[ benchMAX_WAITERS ];
+static volatile UBaseType_t uxLastPriority;
+static volatile unsigned long ulLastTicket;
+static volatile unsigned long ulTicket;
+static volatile unsigned long ulWakeUps;
+static volatile unsigned long ulOutOfOrder;
+static volatile long lBlocked;
+
+static uint32_t ulSeed = 0x12345678UL;
+
+/*----------------------------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+	/* xorshift32, the same sequence for both list structures. */
+	ulSeed ^= ulSeed << 13;
+	ulSeed ^= ulSeed >> 17;
+	ulSeed ^= ulSeed << 5;
+	return ulSeed;
+}
+/*----------------------------------------------------------------------------*/
+
+static ListItemValue_t prvNextValue( ListItemValue_t xNow, int iPriorities )
+{
+	if( iPriorities != 0 )
+	{
+		/* What vTaskPlaceOnEventList() stores, inverted priorities. */
+		return ( ListItemValue_t ) ( configMAX_PRIORITIES - ( prvRandom() % ( uint32_t ) lRange ) );
+	}
+	else
+	{
+		return xNow + ( ListItemValue_t ) ( 1 + ( prvRandom() % ( uint32_t ) lRange ) );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvCheckList( List_t *pxList )
+{
+const ListItem_t *pxItem;
+ListItemValue_t xPrevious = 0;
+UBaseType_t uxItems = 0;
+
+	for( pxItem = listGET_HEAD_ENTRY( pxList ); pxItem != listGET_END_MARKER( pxList ); pxItem = listGET_NEXT( pxItem ) )
+	{
+		configASSERT( listGET_LIST_ITEM_VALUE( pxItem ) >= xPrevious );
+		configASSERT( listLIST_ITEM_CONTAINER( pxItem ) == ( void * ) pxList );
+		xPrevious = listGET_LIST_ITEM_VALUE( pxItem );
+		uxItems++;
+	}
+
+	configASSERT( uxItems == listCURRENT_LIST_LENGTH( pxList ) );
+
+	#if( configUSE_LIST_SKIP_INDEX == 1 )
+	{
+	const ListSkipLink_t *pxLink;
+	UBaseType_t uxLevel;
+
+		/* Every level links items of the level below in the same order, with
+		the links the items were given. */
+		for( uxLevel = 0; uxLevel < ( UBaseType_t ) configLIST_SKIP_LEVELS; uxLevel++ )
+		{
+			pxItem = listGET_HEAD_ENTRY( pxList );
+			uxItems = 0;
+
+			for( pxLink = &( pxList->xSkipHeads[ uxLevel ] ); pxLink->pxNext != NULL; pxLink = pxLink->pxNext )
+			{
+				configASSERT( pxLink->pxNext->pxPrevious == pxLink );
+
+				while( pxItem != pxLink->pxNext->pxItem )
+				{
+					configASSERT( pxItem != listGET_END_MARKER( pxList ) );
+					pxItem = listGET_NEXT( pxItem );
+				}
+
+				configASSERT( pxItem->uxSkipLevels > uxLevel );
+				configASSERT( &( pxItem->pxSkipLinks[ uxLevel ] ) == pxLink->pxNext );
+				uxItems++;
+			}
+
+			printf( "bench=list check level=%lu items=%lu\n", ( unsigned long ) uxLevel + 1, ( unsigned long ) uxItems );
+		}
+	}
+	#endif /* configUSE_LIST_SKIP_INDEX */
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvBenchList( int iPriorities )
+{
+static List_t xList;
+BenchOwner_t *pxOwners;
+ListItem_t *pxItem;
+ListItemValue_t xNow = 0;
+uint64_t ullStart, ullInsertNs, ullCycleNs;
+long i;
+
+	/* Too many for the FreeRTOS heap. */
+	pxOwners = ( BenchOwner_t * ) malloc( sizeof( BenchOwner_t ) * ( size_t ) lCount );
+	configASSERT( pxOwners );
+
+	vListInitialise( &xList );
+
+	for( i = 0; i < lCount; i++ )
+	{
+		vListInitialiseItem( &( pxOwners[ i ].xItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxOwners[ i ].xItem ), &( pxOwners[ i ] ) );
+
+		#if( configUSE_LIST_SKIP_INDEX == 1 )
+		{
+			listSET_LIST_ITEM_SKIP_LINKS( &( pxOwners[ i ].xItem ), pxOwners[ i ].xLinks );
+		}
+		#endif
+		listSET_LIST_ITEM_VALUE( &( pxOwners[ i ].xItem ), prvNextValue( xNow, iPriorities ) );
+	}
+
+	ullStart = ullBenchNowNs();
+	for( i = 0; i < lCount; i++ )
+	{
+		vListInsert( &xList, &( pxOwners[ i ].xItem ) );
+	}
+	ullInsertNs = ullBenchNowNs() - ullStart;
+
+	/* Take the item at the head and insert it again, as a task that wakes
+	and sleeps again or a waiter that gets the object and waits again. */
+	ullStart = ullBenchNowNs();
+	for( i = 0; i < lOperations; i++ )
+	{
+		pxItem = listGET_HEAD_ENTRY( &xList );
+		xNow = listGET_LIST_ITEM_VALUE( pxItem );
+		( void ) uxListRemove( pxItem );
+		listSET_LIST_ITEM_VALUE( pxItem, prvNextValue( xNow, iPriorities ) );
+		vListInsert( &xList, pxItem );
+	}
+	ullCycleNs = ullBenchNowNs() - ullStart;
+
+	prvCheckList( &xList );
+
+	printf( "bench=list mode=%s list=%s items=%ld range=%ld fill_insert_ns=%.1f remove_insert_ns=%.1f item_bytes=%lu list_bytes=%lu\n",
+			( iPriorities != 0 ) ? "priority" : "delayed",
+			benchLIST_NAME,
+			lCount,
+			lRange,
+			( double ) ullInsertNs / ( double ) lCount,
+			( double ) ullCycleNs / ( double ) lOperations,
+			( unsigned long ) sizeof( ListItem_t ),
+			( unsigned long ) sizeof( List_t ) );
+
+	free( pxOwners );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+const UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+unsigned long ulMyTicket;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* The monitor lets the waiters block one at a time, so the tickets
+		give the order in which they blocked. */
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		taskENTER_CRITICAL();
+		ulMyTicket = ulTicket++;
+		lBlocked++;
+		taskEXIT_CRITICAL();
+
+		configASSERT( xSemaphoreTake( xSemaphore, portMAX_DELAY ) == pdPASS );
+
+		taskENTER_CRITICAL();
+		{
+			/* Woken by priority, then in the order of blocking. */
+			if( ( uxPriority > uxLastPriority ) || ( ( uxPriority == uxLastPriority ) && ( ulMyTicket < ulLastTicket ) ) )
+			{
+				ulOutOfOrder++;
+			}
+
+			uxLastPriority = uxPriority;
+			ulLastTicket = ulMyTicket;
+			ulWakeUps++;
+			lBlocked--;
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+long lRound, i;
+TaskHandle_t xWaiter;
+uint64_t ullStart, ullGiveNs = 0;
+
+	( void ) pvParameters;
+
+	for( lRound = 0; lRound < lOperations; lRound++ )
+	{
+		/* Let the waiters block, starting from another one each round. */
+		for( i = 0; i < lCount; i++ )
+		{
+			xWaiter = xWaiters[ ( i + lRound ) % lCount ];
+			xTaskNotifyGive( xWaiter );
+
+			do
+			{
+				vTaskDelay( 1 );
+			} while( ( lBlocked != ( i + 1 ) ) || ( eTaskGetState( xWaiter ) != eBlocked ) );
+		}
+
+		uxLastPriority = configMAX_PRIORITIES;
+		ulLastTicket = 0;
+
+		for( i = 0; i < lCount; i++ )
+		{
+			ullStart = ullBenchNowNs();
+			configASSERT( xSemaphoreGive( xSemaphore ) == pdPASS );
+			ullGiveNs += ullBenchNowNs() - ullStart;
+
+			/* Let the woken waiter take it. */
+			do
+			{
+				vTaskDelay( 1 );
+			} while( lBlocked != ( lCount - ( i + 1 ) ) );
+		}
+	}
+
+	vTaskSuspendAll();
+	printf( "bench=list mode=waiters list=%s tasks=%ld rounds=%ld wakeups=%lu out_of_order=%lu give_ns=%.0f\n",
+			benchLIST_NAME,
+			lCount,
+			lOperations,
+			ulWakeUps,
+			ulOutOfOrder,
+			( double ) ullGiveNs / ( double ) ( lCount * lOperations ) );
+
+	exit( ( ulOutOfOrder == 0 ) ? 0 : 1 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "delayed";
+long i;
+
+	if( strcmp( pcMode, "waiters" ) == 0 )
+	{
+		lCount = lBenchArgument( 2, benchMAX_WAITERS );
+		lOperations = lBenchArgument( 3, 20 );
+		configASSERT( ( lCount > 0 ) && ( lCount <= benchMAX_WAITERS ) );
+
+		xSemaphore = xSemaphoreCreateBinary();
+		configASSERT( xSemaphore );
+
+		for( i = 0; i < lCount; i++ )
+		{
+			xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1 + ( prvRandom() % benchWAITER_PRIORITIES ), &( xWaiters[ i ] ) );
+		}
+
+		xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+		vTaskStartScheduler();
+	}
+	else
+	{
+		lCount = lBenchArgument( 2, 10000 );
+		lRange = lBenchArgument( 3, ( strcmp( pcMode, "priority" ) == 0 ) ? 4 : 10000 );
+		lOperations = lBenchArgument( 4, benchDEFAULT_OPERATIONS );
+		configASSERT( ( lCount > 0 ) && ( lRange > 0 ) && ( lOperations > 0 ) );
+
+		prvBenchList( ( strcmp( pcMode, "priority" ) == 0 ) ? 1 : 0 );
+	}
+
+	exit( 0 );
+}
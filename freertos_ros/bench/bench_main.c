@@ -0,0 +1,117 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> host benchmarks of the FreeRTOS kernel on the ROS port
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+
+#include "bench.h"
+
+/* Referenced by configCPU_CLOCK_HZ, not used by the port. */
+uint32_t SystemCoreClock = 1000000UL;
+
+int iBenchArgc = 0;
+char **ppcBenchArgv = NULL;
+void ( *pxBenchTickHook )( void ) = NULL;
+void ( *pxBenchTickCost )( uint64_t ullNs ) = NULL;
+unsigned long ulBenchTickPeriodUs = 1000000UL / configTICK_RATE_HZ;
+
+/*----------------------------------------------------------------------------*/
+
+/* Plays the role of the ROS node: call the port tick handler periodically. */
+static void *prvTickThread( void *pvParameters )
+{
+struct timespec xNext;
+uint64_t ullStartNs;
+
+	( void ) pvParameters;
+	clock_gettime( CLOCK_MONOTONIC, &xNext );
+
+	for( ;; )
+	{
+		xNext.tv_nsec += ( long ) ( ulBenchTickPeriodUs * 1000UL );
+		while( xNext.tv_nsec >= 1000000000L )
+		{
+			xNext.tv_nsec -= 1000000000L;
+			xNext.tv_sec++;
+		}
+
+		clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xNext, NULL );
+
+		ullStartNs = ullBenchNowNs();
+		vPortSysTickHandler( 0 );
+
+		if( pxBenchTickCost != NULL )
+		{
+			pxBenchTickCost( ullBenchNowNs() - ullStartNs );
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	if( pxBenchTickHook != NULL )
+	{
+		pxBenchTickHook();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+void vBenchAssertFailed( const char *pcFile, int iLine )
+{
+	fprintf( stderr, "bench: assert failed at %s:%d\n", pcFile, iLine );
+	abort();
+}
+/*----------------------------------------------------------------------------*/
+
+long lBenchArgument( int xIndex, long lDefault )
+{
+	if( xIndex < iBenchArgc )
+	{
+		return strtol( ppcBenchArgv[ xIndex ], NULL, 0 );
+	}
+
+	return lDefault;
+}
+/*----------------------------------------------------------------------------*/
+
+uint32_t ulBenchNowUs( void )
+{
+	return ( uint32_t ) ( ullBenchNowNs() / 1000ULL );
+}
+/*----------------------------------------------------------------------------*/
+
+int main( int argc, char **argv )
+{
+pthread_t xTickThread;
+
+	/* -t <us> overrides the tick period of the host tick thread. */
+	if( ( argc > 2 ) && ( strcmp( argv[ 1 ], "-t" ) == 0 ) )
+	{
+		ulBenchTickPeriodUs = strtoul( argv[ 2 ], NULL, 0 );
+		argc -= 2;
+		argv += 2;
+	}
+
+	iBenchArgc = argc;
+	ppcBenchArgv = argv;
+	setvbuf( stdout, NULL, _IOLBF, 0 );
+
+	pthread_create( &xTickThread, NULL, prvTickThread, NULL );
+
+	/* Does not return, the benchmark ends the process. */
+	vStartFreeRTOS();
+
+	return 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> a high priority task blocked behind a chain of held mutexes
+ */
+
+/*
+ * A chain of tasks each holds a mutex and waits for the mutex of the task
+ * below it, and a high priority task then takes the mutex at the top of the
+ * chain.  Only the task at the bottom of the chain can run, for <work> us,
+ * then the chain unwinds.  A task with a priority between the chain and the
+ * high priority task is made ready at the same time and runs for <spin> us.
+ *
+ *   bench_mutex_chain [<chain length>] [<work us>] [<spin us>] [<rounds>]
+ *
+ * bench_mutex_chain passes the priority of the high priority task on down the
+ * chain, so the bottom task runs before the spinning task and the high priority
+ * task waits for about <work> us.  bench_mutex_chain_single is the same
+ * benchmark with a single level of inheritance: the bottom task keeps the
+ * priority of the task just above it, so the spinning task runs first and the
+ * wait is about <work> + <spin> us.
+ *
+ * The wait of the high priority task is reported, then the contention
+ * statistics of the mutexes at the top and at the bottom of the chain.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "bench.h"
+
+#define benchMAX_CHAIN				8
+#define benchCHAIN_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+static long lChain;
+static long lWorkUs;
+static long lSpinUs;
+static long lRounds;
+
+static SemaphoreHandle_t xMutexes[ benchMAX_CHAIN ];
+static TaskHandle_t xChainTasks[ benchMAX_CHAIN ];
+static TaskHandle_t xSpinTask;
+static TaskHandle_t xHighTask;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvBusyWaitUs( const long lUs )
+{
+const uint64_t ullEnd = ullBenchNowNs() + ( ( uint64_t ) lUs * 1000ULL );
+
+	while( ullBenchNowNs() < ullEnd )
+	{
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvChainTask( void *pvParameters )
+{
+const long lLink = ( long ) ( uintptr_t ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		configASSERT( xSemaphoreTake( xMutexes[ lLink ], portMAX_DELAY ) == pdPASS );
+
+		/* Each task above has a higher priority, so it runs as soon as it is
+		notified, takes its own mutex and blocks on this one.  By the time
+		this returns the whole chain above is blocked. */
+		if( lLink + 1 < lChain )
+		{
+			xTaskNotifyGive( xChainTasks[ lLink + 1 ] );
+		}
+
+		if( lLink == 0 )
+		{
+			/* The chain is set up, let the high priority task in. */
+			xTaskNotifyGive( xHighTask );
+			prvBusyWaitUs( lWorkUs );
+		}
+		else
+		{
+			configASSERT( xSemaphoreTake( xMutexes[ lLink - 1 ], portMAX_DELAY ) == pdPASS );
+			configASSERT( xSemaphoreGive( xMutexes[ lLink - 1 ] ) == pdPASS );
+		}
+
+		configASSERT( xSemaphoreGive( xMutexes[ lLink ] ) == pdPASS );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSpinTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		prvBusyWaitUs( lSpinUs );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvHighTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWaitNs, ullTotalNs = 0, ullMaxNs = 0;
+MutexStats_t xTop, xBottom;
+long lRound;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	for( lRound = 0; lRound < lRounds; lRound++ )
+	{
+		xTaskNotifyGive( xChainTasks[ 0 ] );
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		/* The spinning task is ready when the high priority task blocks. */
+		xTaskNotifyGive( xSpinTask );
+
+		ullStartNs = ullBenchNowNs();
+		configASSERT( xSemaphoreTake( xMutexes[ lChain - 1 ], portMAX_DELAY ) == pdPASS );
+		ullWaitNs = ullBenchNowNs() - ullStartNs;
+		configASSERT( xSemaphoreGive( xMutexes[ lChain - 1 ] ) == pdPASS );
+
+		configASSERT( uxTaskPriorityGet( xChainTasks[ 0 ] ) == benchCHAIN_PRIORITY );
+
+		ullTotalNs += ullWaitNs;
+		ullMaxNs = ( ullWaitNs > ullMaxNs ) ? ullWaitNs : ullMaxNs;
+
+		/* Let the spinning task finish before the next round. */
+		vTaskDelay( ( TickType_t ) ( ( ( unsigned long ) lSpinUs / ulBenchTickPeriodUs ) + 2UL ) );
+	}
+
+	vSemaphoreGetMutexStats( xMutexes[ lChain - 1 ], &xTop );
+	vSemaphoreGetMutexStats( xMutexes[ 0 ], &xBottom );
+
+	printf( "bench=mutex_chain transitive=%d chain=%ld work_us=%ld spin_us=%ld rounds=%ld avg_wait_us=%.1f max_wait_us=%.1f "
+			"top_acquisitions=%lu top_contended=%lu top_max_hold_us=%lu top_max_wait_us=%lu "
+			"bottom_acquisitions=%lu bottom_contended=%lu bottom_max_hold_us=%lu bottom_max_wait_us=%lu\n",
+			configUSE_TRANSITIVE_PRIORITY_INHERITANCE,
+			lChain,
+			lWorkUs,
+			lSpinUs,
+			lRounds,
+			( double ) ullTotalNs / ( ( double ) lRounds * 1000.0 ),
+			( double ) ullMaxNs / 1000.0,
+			( unsigned long ) xTop.ulAcquisitions,
+			( unsigned long ) xTop.ulContendedWaits,
+			( unsigned long ) xTop.ulMaxHoldTime,
+			( unsigned long ) xTop.ulMaxWaitTime,
+			( unsigned long ) xBottom.ulAcquisitions,
+			( unsigned long ) xBottom.ulContendedWaits,
+			( unsigned long ) xBottom.ulMaxHoldTime,
+			( unsigned long ) xBottom.ulMaxWaitTime );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+long x;
+
+	lChain = lBenchArgument( 1, 3 );
+	lWorkUs = lBenchArgument( 2, 2000 );
+	lSpinUs = lBenchArgument( 3, 20000 );
+	lRounds = lBenchArgument( 4, 50 );
+
+	configASSERT( ( lChain > 1 ) && ( lChain <= benchMAX_CHAIN ) );
+	configASSERT( benchCHAIN_PRIORITY + lChain + 1 < configTIMER_TASK_PRIORITY );
+
+	/* The chain from the bottom up at rising priorities, then the spinning
+	task, then the high priority task. */
+	for( x = 0; x < lChain; x++ )
+	{
+		xMutexes[ x ] = xSemaphoreCreateMutex();
+		configASSERT( xMutexes[ x ] );
+		xTaskCreate( prvChainTask, "Chain", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchCHAIN_PRIORITY + x, &( xChainTasks[ x ] ) );
+	}
+
+	xTaskCreate( prvSpinTask, "Spin", configMINIMAL_STACK_SIZE, NULL, benchCHAIN_PRIORITY + lChain, &xSpinTask );
+	xTaskCreate( prvHighTask, "High", configMINIMAL_STACK_SIZE, NULL, benchCHAIN_PRIORITY + lChain + 1, &xHighTask );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
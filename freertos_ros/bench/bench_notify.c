@@ -0,0 +1,302 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> signalling a task on several channels, queue against notifications
+ */
+
+/*
+ * A consumer task receives events on <channels> channels.  The tick hook sends
+ * <burst> events on channel 0 every tick, as a driver would from its
+ * interrupt, and a sender task of a lower priority per other channel sends
+ * <burst> events on its channel every tick.
+ *
+ *   bench_notify [-t <tick us>] queue|notify|single [<channels>] [<burst>] [<duration in ticks>]
+ *
+ * queue   The events are the channel numbers sent to one queue, which the
+ *         consumer receives one at a time.
+ * notify  A notification index per channel: each event is a give on the
+ *         index of its channel, and the consumer takes the count of each
+ *         index in turn.
+ * single  The channel numbers are sent to the one notification value with
+ *         eSetValueWithOverwrite, as without indexes: events that race are
+ *         lost.
+ *
+ * The events received per second, the wakes of the consumer per second, the
+ * cost of a send from a task, the heap used by the channels and the number of
+ * lost events are reported.  Events are lost with single, and with queue if
+ * the queue, four bursts of every channel deep, is full when the tick hook
+ * sends.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION		2000
+#define benchMAX_CHANNELS			configTASK_NOTIFICATION_ARRAY_ENTRIES
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchCONSUMER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define benchSENDER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+typedef enum
+{
+	eBenchQueue,
+	eBenchNotify,
+	eBenchSingle
+} BenchMode_t;
+
+static const char * const pcModes[] = { "queue", "notify", "single" };
+
+static BenchMode_t eMode;
+static long lChannels;
+static long lBurst;
+static long lDuration;
+
+static TaskHandle_t xConsumer;
+static QueueHandle_t xQueue;
+
+static volatile BaseType_t xSending = pdTRUE;
+static volatile unsigned long ulSent[ benchMAX_CHANNELS ];
+static volatile unsigned long ulReceived[ benchMAX_CHANNELS ];
+static volatile unsigned long ulWakes;
+static volatile unsigned long ulTaskSends;
+static volatile uint64_t ullSendNs;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvTickHook( void )
+{
+uint32_t ulChannel = 0;
+long x;
+
+	if( xSending == pdFALSE )
+	{
+		return;
+	}
+
+	/* The tick interrupt switches to the woken consumer on its way out. */
+	for( x = 0; x < lBurst; x++ )
+	{
+		switch( eMode )
+		{
+			case eBenchQueue:
+				/* Counted as lost when the queue is full. */
+				( void ) xQueueSendFromISR( xQueue, &ulChannel, NULL );
+				break;
+
+			case eBenchNotify:
+				vTaskNotifyGiveIndexedFromISR( xConsumer, ulChannel, NULL );
+				break;
+
+			default:
+				( void ) xTaskNotifyFromISR( xConsumer, ulChannel, eSetValueWithOverwrite, NULL );
+				break;
+		}
+
+		ulSent[ ulChannel ]++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSenderTask( void *pvParameters )
+{
+const uint32_t ulChannel = ( uint32_t ) ( uintptr_t ) pvParameters;
+uint64_t ullStartNs;
+long x;
+
+	for( ;; )
+	{
+		vTaskDelay( 1 );
+
+		for( x = 0; ( x < lBurst ) && ( xSending != pdFALSE ); x++ )
+		{
+			ullStartNs = ullBenchNowNs();
+
+			switch( eMode )
+			{
+				case eBenchQueue:
+					configASSERT( xQueueSend( xQueue, &ulChannel, portMAX_DELAY ) == pdPASS );
+					break;
+
+				case eBenchNotify:
+					( void ) xTaskNotifyGiveIndexed( xConsumer, ulChannel );
+					break;
+
+				default:
+					( void ) xTaskNotify( xConsumer, ulChannel, eSetValueWithOverwrite );
+					break;
+			}
+
+			ullSendNs += ullBenchNowNs() - ullStartNs;
+			ulTaskSends++;
+			ulSent[ ulChannel ]++;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+UBaseType_t uxChannel = 0;
+uint32_t ulValue;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		switch( eMode )
+		{
+			case eBenchQueue:
+				configASSERT( xQueueReceive( xQueue, &ulValue, portMAX_DELAY ) == pdPASS );
+				ulReceived[ ulValue ]++;
+				break;
+
+			case eBenchNotify:
+				/* Every channel is sent to each tick, so the channels are taken
+				in turn, all the events of a channel at once. */
+				ulReceived[ uxChannel ] += ulTaskNotifyTakeIndexed( uxChannel, pdTRUE, portMAX_DELAY );
+				uxChannel = ( uxChannel + 1 ) % ( UBaseType_t ) lChannels;
+				break;
+
+			default:
+				configASSERT( xTaskNotifyWait( 0, 0, &ulValue, portMAX_DELAY ) == pdPASS );
+				ulReceived[ ulValue ]++;
+				break;
+		}
+
+		ulWakes++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static unsigned long prvSum( volatile unsigned long * const pulCounts )
+{
+unsigned long ulTotal = 0;
+long x;
+
+	for( x = 0; x < lChannels; x++ )
+	{
+		ulTotal += pulCounts[ x ];
+	}
+
+	return ulTotal;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulReceivedStart, ulWakesStart, ulPending = 0, ulLost;
+uint32_t ulCount;
+long x;
+const size_t xChannelBytes = ( size_t ) ( uintptr_t ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	ulReceivedStart = prvSum( ulReceived );
+	ulWakesStart = ulWakes;
+	ulTaskSends = 0;
+	ullSendNs = 0;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	/* Stop the senders and let the consumer catch up, then count what it has
+	not taken yet. */
+	xSending = pdFALSE;
+	vTaskDelay( 2 );
+
+	switch( eMode )
+	{
+		case eBenchQueue:
+			ulPending = ( unsigned long ) uxQueueMessagesWaiting( xQueue );
+			break;
+
+		case eBenchNotify:
+			for( x = 0; x < lChannels; x++ )
+			{
+				( void ) xTaskNotifyAndQueryIndexed( xConsumer, ( UBaseType_t ) x, 0, eNoAction, &ulCount );
+				ulPending += ulCount;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	vTaskSuspendAll();
+
+	ulLost = prvSum( ulSent ) - prvSum( ulReceived ) - ulPending;
+
+	printf( "bench=notify mode=%s channels=%ld burst=%ld tick_us=%lu events_per_s=%.0f wakes_per_s=%.0f send_ns=%.0f channel_heap_bytes=%lu lost=%lu\n",
+			pcModes[ eMode ],
+			lChannels,
+			lBurst,
+			ulBenchTickPeriodUs,
+			( ( double ) ( prvSum( ulReceived ) - ulReceivedStart ) * 1e9 ) / ( double ) ullWallNs,
+			( ( double ) ( ulWakes - ulWakesStart ) * 1e9 ) / ( double ) ullWallNs,
+			( ulTaskSends != 0 ) ? ( double ) ullSendNs / ( double ) ulTaskSends : 0.0,
+			( unsigned long ) xChannelBytes,
+			ulLost );
+
+	configASSERT( ( eMode != eBenchNotify ) || ( ulLost == 0 ) );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "notify";
+size_t xChannelBytes = 0;
+long x;
+
+	for( x = 0; x < ( long ) ( sizeof( pcModes ) / sizeof( pcModes[ 0 ] ) ); x++ )
+	{
+		if( strcmp( pcMode, pcModes[ x ] ) == 0 )
+		{
+			eMode = ( BenchMode_t ) x;
+		}
+	}
+
+	lChannels = lBenchArgument( 2, 4 );
+	lBurst = lBenchArgument( 3, 1 );
+	lDuration = lBenchArgument( 4, benchDEFAULT_DURATION );
+
+	configASSERT( ( lChannels > 0 ) && ( lChannels <= benchMAX_CHANNELS ) );
+	configASSERT( lBurst > 0 );
+
+	if( eMode == eBenchQueue )
+	{
+		xQueue = xQueueCreate( ( UBaseType_t ) ( 4 * lChannels * lBurst ), sizeof( uint32_t ) );
+		configASSERT( xQueue );
+		xChannelBytes = sizeof( StaticQueue_t ) + ( ( size_t ) ( 4 * lChannels * lBurst ) * sizeof( uint32_t ) );
+	}
+
+	xTaskCreate( prvConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, NULL, benchCONSUMER_PRIORITY, &xConsumer );
+
+	for( x = 1; x < lChannels; x++ )
+	{
+		xTaskCreate( prvSenderTask, "Sender", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchSENDER_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) xChannelBytes, benchMONITOR_PRIORITY, NULL );
+
+	pxBenchTickHook = prvTickHook;
+
+	vTaskStartScheduler();
+
+	return 0;
+}
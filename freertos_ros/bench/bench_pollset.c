@@ -0,0 +1,329 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> one task waiting on many queues, queue set against poll set
+ */
+
+/*
+ * A producer task sends <burst> events every tick to <sources> queues of four
+ * items, a different queue for each event, and a consumer task of a lower
+ * priority receives them all.
+ *
+ *   bench_pollset [-t <tick us>] queueset|level|edge [<sources>] [<burst>] [<duration in ticks>]
+ *
+ * queueset  The queues are in a queue set: the consumer selects a queue from
+ *           the set, then receives the one item the set says it holds.
+ * level     The queues are in a poll set, level triggered: the consumer takes
+ *           up to 32 ready queues per wait and receives one item of each,
+ *           queues that still hold items are returned again.
+ * edge      The queues are in a poll set, edge triggered: the consumer takes
+ *           up to 32 ready queues per wait and empties each.
+ *
+ * The events received per second, the events returned per wait, the cost of
+ * a send and of receiving an event (the time blocked left out), the memory of
+ * the set, the sends that found their queue full and the number of lost events
+ * (always 0) are reported.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "pollset.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION		2000
+#define benchMAX_SOURCES			4096
+#define benchQUEUE_LENGTH			4
+#define benchMAX_EVENTS				32
+#define benchSTRIDE					97
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchPRODUCER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define benchCONSUMER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+typedef enum
+{
+	eBenchQueueSet,
+	eBenchLevel,
+	eBenchEdge
+} BenchMode_t;
+
+static const char * const pcModes[] = { "queueset", "level", "edge" };
+
+static BenchMode_t eMode;
+static long lSources;
+static long lBurst;
+static long lDuration;
+
+static QueueHandle_t xQueues[ benchMAX_SOURCES ];
+static QueueSetHandle_t xQueueSet;
+static PollSetHandle_t xPollSet;
+static PollSetEvent_t xEvents[ benchMAX_EVENTS ];
+
+static volatile BaseType_t xSending = pdTRUE;
+static volatile unsigned long ulSent;
+static volatile unsigned long ulFailedSends;
+static volatile unsigned long ulReceived;
+static volatile unsigned long ulWaits;
+static volatile uint64_t ullSendNs;
+static volatile uint64_t ullReceiveNs;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+uint32_t ulValue = 0;
+long lSource = 0, x;
+uint64_t ullStartNs;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( 1 );
+
+		for( x = 0; ( x < lBurst ) && ( xSending != pdFALSE ); x++ )
+		{
+			/* Spread over the sources, as events from many drivers. */
+			lSource = ( lSource + benchSTRIDE ) % lSources;
+
+			ullStartNs = ullBenchNowNs();
+
+			if( xQueueSend( xQueues[ lSource ], &ulValue, 0 ) == pdPASS )
+			{
+				ulSent++;
+			}
+			else
+			{
+				ulFailedSends++;
+			}
+
+			ullSendNs += ullBenchNowNs() - ullStartNs;
+			ulValue++;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReceiveFromSet( TickType_t xTicksToWait )
+{
+QueueSetMemberHandle_t xMember;
+uint32_t ulValue;
+uint64_t ullStartNs = ullBenchNowNs();
+
+	xMember = xQueueSelectFromSet( xQueueSet, xTicksToWait );
+
+	if( xTicksToWait != 0 )
+	{
+		/* Leave the time blocked out. */
+		ullStartNs = ullBenchNowNs();
+	}
+
+	if( xMember != NULL )
+	{
+		configASSERT( xQueueReceive( ( QueueHandle_t ) xMember, &ulValue, 0 ) == pdPASS );
+		ulReceived++;
+		ulWaits++;
+	}
+
+	ullReceiveNs += ullBenchNowNs() - ullStartNs;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReceiveFromPollSet( TickType_t xTicksToWait )
+{
+UBaseType_t uxEvents, x;
+uint32_t ulValue;
+uint64_t ullStartNs = ullBenchNowNs();
+
+	uxEvents = uxPollSetWait( xPollSet, xEvents, benchMAX_EVENTS, xTicksToWait );
+
+	if( xTicksToWait != 0 )
+	{
+		/* Leave the time blocked out. */
+		ullStartNs = ullBenchNowNs();
+	}
+
+	for( x = 0; x < uxEvents; x++ )
+	{
+		if( eMode == eBenchLevel )
+		{
+			/* The queue is returned again while it holds items. */
+			if( xQueueReceive( ( QueueHandle_t ) xEvents[ x ].pvSource, &ulValue, 0 ) == pdPASS )
+			{
+				ulReceived++;
+			}
+		}
+		else
+		{
+			/* The queue is not returned again until it is sent to. */
+			while( xQueueReceive( ( QueueHandle_t ) xEvents[ x ].pvSource, &ulValue, 0 ) == pdPASS )
+			{
+				ulReceived++;
+			}
+		}
+	}
+
+	if( uxEvents != 0 )
+	{
+		ulWaits++;
+	}
+
+	ullReceiveNs += ullBenchNowNs() - ullStartNs;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+unsigned long ulReceivedBefore;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Take what is ready without blocking, then block for more. */
+		ulReceivedBefore = ulReceived;
+
+		if( eMode == eBenchQueueSet )
+		{
+			prvReceiveFromSet( 0 );
+		}
+		else
+		{
+			prvReceiveFromPollSet( 0 );
+		}
+
+		if( ulReceived == ulReceivedBefore )
+		{
+			if( eMode == eBenchQueueSet )
+			{
+				prvReceiveFromSet( portMAX_DELAY );
+			}
+			else
+			{
+				prvReceiveFromPollSet( portMAX_DELAY );
+			}
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulReceivedStart, ulWaitsStart, ulSentStart, ulPending = 0, ulLost;
+long x;
+const size_t xSetBytes = ( size_t ) ( uintptr_t ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	ulReceivedStart = ulReceived;
+	ulWaitsStart = ulWaits;
+	ulSentStart = ulSent;
+	ullSendNs = 0;
+	ullReceiveNs = 0;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	/* Stop the producer and let the consumer catch up, then count what it has
+	not taken yet. */
+	xSending = pdFALSE;
+	vTaskDelay( 2 );
+
+	vTaskSuspendAll();
+
+	for( x = 0; x < lSources; x++ )
+	{
+		ulPending += ( unsigned long ) uxQueueMessagesWaiting( xQueues[ x ] );
+	}
+
+	ulLost = ulSent - ulReceived - ulPending;
+
+	printf( "bench=pollset mode=%s sources=%ld burst=%ld tick_us=%lu events_per_s=%.0f events_per_wait=%.1f send_ns=%.0f receive_ns=%.0f set_bytes=%lu full_sends=%lu lost=%lu\n",
+			pcModes[ eMode ],
+			lSources,
+			lBurst,
+			ulBenchTickPeriodUs,
+			( ( double ) ( ulReceived - ulReceivedStart ) * 1e9 ) / ( double ) ullWallNs,
+			( ulWaits != ulWaitsStart ) ? ( double ) ( ulReceived - ulReceivedStart ) / ( double ) ( ulWaits - ulWaitsStart ) : 0.0,
+			( ulSent != ulSentStart ) ? ( double ) ullSendNs / ( double ) ( ulSent - ulSentStart ) : 0.0,
+			( ulReceived != ulReceivedStart ) ? ( double ) ullReceiveNs / ( double ) ( ulReceived - ulReceivedStart ) : 0.0,
+			( unsigned long ) xSetBytes,
+			ulFailedSends,
+			ulLost );
+
+	configASSERT( ulLost == 0 );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "edge";
+size_t xSetBytes;
+long x;
+
+	for( x = 0; x < ( long ) ( sizeof( pcModes ) / sizeof( pcModes[ 0 ] ) ); x++ )
+	{
+		if( strcmp( pcMode, pcModes[ x ] ) == 0 )
+		{
+			eMode = ( BenchMode_t ) x;
+		}
+	}
+
+	lSources = lBenchArgument( 2, 1024 );
+	lBurst = lBenchArgument( 3, 64 );
+	lDuration = lBenchArgument( 4, benchDEFAULT_DURATION );
+
+	configASSERT( ( lSources > 0 ) && ( lSources <= benchMAX_SOURCES ) );
+	configASSERT( lBurst > 0 );
+
+	if( eMode == eBenchQueueSet )
+	{
+		/* A queue set holds a handle for each item of each of its queues. */
+		xQueueSet = xQueueCreateSet( ( UBaseType_t ) ( lSources * benchQUEUE_LENGTH ) );
+		configASSERT( xQueueSet );
+		xSetBytes = sizeof( StaticQueue_t ) + ( ( size_t ) ( lSources * benchQUEUE_LENGTH ) * sizeof( QueueSetMemberHandle_t ) );
+	}
+	else
+	{
+		xPollSet = xPollSetCreate( ( UBaseType_t ) lSources );
+		configASSERT( xPollSet );
+		xSetBytes = sizeof( StaticPollSet_t ) + ( ( size_t ) lSources * sizeof( StaticPollSetMember_t ) );
+	}
+
+	for( x = 0; x < lSources; x++ )
+	{
+		xQueues[ x ] = xQueueCreate( benchQUEUE_LENGTH, sizeof( uint32_t ) );
+		configASSERT( xQueues[ x ] );
+
+		if( eMode == eBenchQueueSet )
+		{
+			configASSERT( xQueueAddToSet( xQueues[ x ], xQueueSet ) == pdPASS );
+		}
+		else
+		{
+			configASSERT( xPollSetAddQueue( xPollSet, xQueues[ x ], ( eMode == eBenchLevel ) ? pollsetLEVEL_TRIGGERED : pollsetEDGE_TRIGGERED, NULL ) != NULL );
+		}
+	}
+
+	xTaskCreate( prvProducerTask, "Producer", configMINIMAL_STACK_SIZE, NULL, benchPRODUCER_PRIORITY, NULL );
+	xTaskCreate( prvConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, NULL, benchCONSUMER_PRIORITY, NULL );
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) xSetBytes, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
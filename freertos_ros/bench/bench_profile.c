@@ -0,0 +1,197 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> switch and queue throughput of the build profiles of the kernel
+ */
+
+/*
+ * The same tasks with the kernel built as by the profiles of ROS/Makefile.
+ *
+ *   bench_profile_<profile> [-t <tick us>] switch|queue|pingpong [<duration in ticks>]
+ *
+ * switch    Two tasks of the same priority yield to each other in turn.  The
+ *           switches per second are reported.
+ * queue     One task sends an item to a queue and receives it back, without
+ *           blocking: the cost of the calls into the kernel alone.  The send
+ *           and receive pairs per second are reported.
+ * pingpong  Two tasks pass an item back and forth through two queues, each
+ *           blocking on its queue in turn: two switches and four queue
+ *           operations per round trip.  The round trips per second are
+ *           reported.
+ *
+ * bench_profile_debug links the kernel as the libfreertos.so of the debug
+ * profile (-O0 -g), bench_profile_release as the libfreertos.so of the release
+ * profile (-O2, link time optimisation inside the library, the API exported
+ * only), and bench_profile_static links the objects of the release profile
+ * into the executable, as a node that links libfreertos.a with -flto.  The
+ * benchmark itself is built with -O2 in all three.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "bench.h"
+
+#ifndef benchPROFILE
+	#define benchPROFILE				"unknown"
+#endif
+
+#define benchDEFAULT_DURATION		2000
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+typedef enum
+{
+	eBenchSwitch,
+	eBenchQueue,
+	eBenchPingPong
+} BenchMode_t;
+
+static const char * const pcModes[] = { "switch", "queue", "pingpong" };
+
+static BenchMode_t eMode;
+static long lDuration;
+
+static QueueHandle_t xPing;
+static QueueHandle_t xPong;
+
+static volatile unsigned long ulOperations;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulOperations++;
+		taskYIELD();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvQueueTask( void *pvParameters )
+{
+uint32_t ulValue = 0;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		configASSERT( xQueueSend( xPing, &ulValue, 0 ) == pdPASS );
+		configASSERT( xQueueReceive( xPing, &ulValue, 0 ) == pdPASS );
+		ulValue++;
+		ulOperations++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvPingTask( void *pvParameters )
+{
+uint32_t ulValue = 0;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		configASSERT( xQueueSend( xPing, &ulValue, portMAX_DELAY ) == pdPASS );
+		configASSERT( xQueueReceive( xPong, &ulValue, portMAX_DELAY ) == pdPASS );
+		ulValue++;
+		ulOperations++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvPongTask( void *pvParameters )
+{
+uint32_t ulValue;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		configASSERT( xQueueReceive( xPing, &ulValue, portMAX_DELAY ) == pdPASS );
+		configASSERT( xQueueSend( xPong, &ulValue, portMAX_DELAY ) == pdPASS );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulStart, ulCount;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	ulStart = ulOperations;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	ulCount = ulOperations - ulStart;
+
+	printf( "bench=profile profile=%s mode=%s tick_us=%lu ops_per_s=%.0f op_ns=%.0f\n",
+			benchPROFILE,
+			pcModes[ eMode ],
+			ulBenchTickPeriodUs,
+			( ( double ) ulCount * 1e9 ) / ( double ) ullWallNs,
+			( ulCount != 0 ) ? ( double ) ullWallNs / ( double ) ulCount : 0.0 );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "switch";
+long x;
+
+	for( x = 0; x < ( long ) ( sizeof( pcModes ) / sizeof( pcModes[ 0 ] ) ); x++ )
+	{
+		if( strcmp( pcMode, pcModes[ x ] ) == 0 )
+		{
+			eMode = ( BenchMode_t ) x;
+		}
+	}
+
+	lDuration = lBenchArgument( 2, benchDEFAULT_DURATION );
+
+	xPing = xQueueCreate( 1, sizeof( uint32_t ) );
+	xPong = xQueueCreate( 1, sizeof( uint32_t ) );
+	configASSERT( xPing && xPong );
+
+	if( eMode == eBenchSwitch )
+	{
+		xTaskCreate( prvYieldTask, "Yield1", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+		xTaskCreate( prvYieldTask, "Yield2", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+	}
+	else if( eMode == eBenchQueue )
+	{
+		xTaskCreate( prvQueueTask, "Queue", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+	}
+	else
+	{
+		xTaskCreate( prvPingTask, "Ping", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+		xTaskCreate( prvPongTask, "Pong", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
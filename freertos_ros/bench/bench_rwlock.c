@@ -0,0 +1,275 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> read-mostly data under a reader-writer lock and under a mutex
+ */
+
+/*
+ * Reader tasks of the same priority read a shared table, for <section us>
+ * each time, over and over, while a writer task of a higher priority rewrites
+ * the table every <write period> ticks.  Time slicing switches between the
+ * readers on each tick, so readers are often preempted in the middle of a
+ * read.  The number of reads per second, the wait of the writer and the wait
+ * of the readers are reported.
+ *
+ *   bench_rwlock [-t <tick us>] rwlock|mutex [<readers>] [<section us>] [<write period>] [<duration in ticks>]
+ *
+ * rwlock  The table is read under xRWLockTakeRead() and written under
+ *         xRWLockTakeWrite(): readers only wait for the writer.
+ * mutex   The table is read and written under one mutex: a reader preempted
+ *         in the middle of a read keeps the other readers out.
+ *
+ * The readers check every read sees the table as the writer left it.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rwlock.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION		1000
+#define benchMAX_READERS			32
+#define benchTABLE_ENTRIES			64
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchWRITER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define benchREADER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+static BaseType_t xUseRWLock;
+static long lReaders;
+static long lSectionUs;
+static long lWritePeriod;
+static long lDuration;
+
+static RWLockHandle_t xRWLock;
+static SemaphoreHandle_t xMutex;
+
+static volatile uint32_t ulTable[ benchTABLE_ENTRIES ];
+static volatile unsigned long ulReads[ benchMAX_READERS ];
+static volatile unsigned long ulTornReads;
+static volatile unsigned long ulWrites;
+static volatile uint64_t ullWriteWaitNs;
+static volatile uint64_t ullMaxWriteWaitNs;
+static volatile uint64_t ullMaxReadWaitNs;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvBusyWaitUs( const long lUs )
+{
+const uint64_t ullEnd = ullBenchNowNs() + ( ( uint64_t ) lUs * 1000ULL );
+
+	while( ullBenchNowNs() < ullEnd )
+	{
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvTakeForReading( void )
+{
+	if( xUseRWLock != pdFALSE )
+	{
+		configASSERT( xRWLockTakeRead( xRWLock, portMAX_DELAY ) == pdPASS );
+	}
+	else
+	{
+		configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvGiveForReading( void )
+{
+	if( xUseRWLock != pdFALSE )
+	{
+		configASSERT( xRWLockGiveRead( xRWLock ) == pdPASS );
+	}
+	else
+	{
+		configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+const long lReader = ( long ) ( uintptr_t ) pvParameters;
+uint64_t ullStartNs, ullWaitNs;
+uint32_t ulFirst;
+long x;
+
+	for( ;; )
+	{
+		ullStartNs = ullBenchNowNs();
+		prvTakeForReading();
+		ullWaitNs = ullBenchNowNs() - ullStartNs;
+		{
+			/* The writer sets every entry to the same value, so different
+			values mean it got in during the read. */
+			ulFirst = ulTable[ 0 ];
+			prvBusyWaitUs( lSectionUs );
+
+			for( x = 1; x < benchTABLE_ENTRIES; x++ )
+			{
+				if( ulTable[ x ] != ulFirst )
+				{
+					ulTornReads++;
+					break;
+				}
+			}
+		}
+		prvGiveForReading();
+
+		ulReads[ lReader ]++;
+
+		if( ullWaitNs > ullMaxReadWaitNs )
+		{
+			ullMaxReadWaitNs = ullWaitNs;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWaitNs;
+long x;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( ( TickType_t ) lWritePeriod );
+
+		ullStartNs = ullBenchNowNs();
+
+		if( xUseRWLock != pdFALSE )
+		{
+			configASSERT( xRWLockTakeWrite( xRWLock, portMAX_DELAY ) == pdPASS );
+		}
+		else
+		{
+			configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+		}
+
+		ullWaitNs = ullBenchNowNs() - ullStartNs;
+
+		for( x = 0; x < benchTABLE_ENTRIES; x++ )
+		{
+			ulTable[ x ] = ( uint32_t ) ulWrites + 1UL;
+		}
+
+		if( xUseRWLock != pdFALSE )
+		{
+			configASSERT( xRWLockGiveWrite( xRWLock ) == pdPASS );
+		}
+		else
+		{
+			configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+		}
+
+		ulWrites++;
+		ullWriteWaitNs += ullWaitNs;
+
+		if( ullWaitNs > ullMaxWriteWaitNs )
+		{
+			ullMaxWriteWaitNs = ullWaitNs;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulStart = 0, ulTotal, ulMin, ulWritesStart;
+long x;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	for( x = 0; x < lReaders; x++ )
+	{
+		ulStart += ulReads[ x ];
+	}
+
+	ulWritesStart = ulWrites;
+	ullWriteWaitNs = 0;
+	ullMaxWriteWaitNs = 0;
+	ullMaxReadWaitNs = 0;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	vTaskSuspendAll();
+
+	ulTotal = 0;
+	ulMin = ~0UL;
+	for( x = 0; x < lReaders; x++ )
+	{
+		ulTotal += ulReads[ x ];
+		ulMin = ( ulReads[ x ] < ulMin ) ? ulReads[ x ] : ulMin;
+	}
+
+	printf( "bench=rwlock mode=%s readers=%ld section_us=%ld write_period=%ld tick_us=%lu reads_per_s=%.0f min_reader=%lu max_read_wait_us=%.1f writes=%lu avg_write_wait_us=%.1f max_write_wait_us=%.1f torn_reads=%lu\n",
+			( xUseRWLock != pdFALSE ) ? "rwlock" : "mutex",
+			lReaders,
+			lSectionUs,
+			lWritePeriod,
+			ulBenchTickPeriodUs,
+			( ( double ) ( ulTotal - ulStart ) * 1e9 ) / ( double ) ullWallNs,
+			ulMin,
+			( double ) ullMaxReadWaitNs / 1000.0,
+			ulWrites - ulWritesStart,
+			( ulWrites != ulWritesStart ) ? ( double ) ullWriteWaitNs / ( ( double ) ( ulWrites - ulWritesStart ) * 1000.0 ) : 0.0,
+			( double ) ullMaxWriteWaitNs / 1000.0,
+			ulTornReads );
+
+	configASSERT( ulTornReads == 0 );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "rwlock";
+long x;
+
+	xUseRWLock = ( strcmp( pcMode, "mutex" ) != 0 ) ? pdTRUE : pdFALSE;
+	lReaders = lBenchArgument( 2, 8 );
+	lSectionUs = lBenchArgument( 3, 20 );
+	lWritePeriod = lBenchArgument( 4, 10 );
+	lDuration = lBenchArgument( 5, benchDEFAULT_DURATION );
+
+	configASSERT( ( lReaders > 0 ) && ( lReaders <= benchMAX_READERS ) );
+	configASSERT( lWritePeriod > 0 );
+
+	xRWLock = xRWLockCreate();
+	configASSERT( xRWLock );
+	xMutex = xSemaphoreCreateMutex();
+	configASSERT( xMutex );
+
+	for( x = 0; x < lReaders; x++ )
+	{
+		xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchREADER_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, benchWRITER_PRIORITY, NULL );
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,381 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> throughput of shared memory stream buffers between processes
+ */
+
+/*
+ * A writer sends messages of the same size to a reader, and the throughput is
+ * reported in bytes per second.
+ *
+ *   bench_shm shm|shm-zero-copy|local|tcp <message size> [<buffer size>] [<duration in ticks>]
+ *
+ * shm - the writer task is in this process, the reader task in a second
+ *     process that runs bench_shm again with its own FreeRTOS instance, and
+ *     the message buffer is a shared memory segment.
+ * shm-zero-copy - the same with reserve/commit and peek/consume.
+ * local - both tasks in this process, on the same shared memory segment.
+ * tcp - what a ROS topic between two nodes on the same host goes through:
+ *     two host threads, no FreeRTOS, a loopback TCP connection and messages
+ *     framed with their length as TCPROS frames them.
+ *
+ * The writer has the higher priority: it fills the buffer and blocks until
+ * there is room for the next message.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "shm_stream_buffer.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION	1000
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 2 )
+#define benchWRITER_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define benchREADER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+#define benchSEGMENT_NAME		"/bench_shm"
+
+static BaseType_t xZeroCopy;
+static long lMessageSize;
+static long lBufferSize;
+static long lDuration;
+
+static ShmStreamBufferHandle_t xBuffer;
+static uint8_t *pucWriteData;
+static uint8_t *pucReadData;
+static pid_t xReaderProcess = -1;
+
+static volatile uint64_t ullBytesWritten;
+static volatile unsigned long ulWrites;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+StreamBufferRegion_t xRegion;
+size_t xSent;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xZeroCopy != pdFALSE )
+		{
+			xSent = xShmStreamBufferReserve( xBuffer, ( size_t ) lMessageSize, &xRegion, portMAX_DELAY );
+			configASSERT( xSent == ( size_t ) lMessageSize );
+
+			memset( xRegion.pucFirst, ( int ) ulWrites, xRegion.xFirstLength );
+			if( xRegion.xSecondLength > 0 )
+			{
+				memset( xRegion.pucSecond, ( int ) ulWrites, xRegion.xSecondLength );
+			}
+
+			xSent = xShmStreamBufferCommit( xBuffer, xSent );
+		}
+		else
+		{
+			memset( pucWriteData, ( int ) ulWrites, ( size_t ) lMessageSize );
+			xSent = xShmStreamBufferSend( xBuffer, pucWriteData, ( size_t ) lMessageSize, portMAX_DELAY );
+		}
+
+		configASSERT( xSent == ( size_t ) lMessageSize );
+		ullBytesWritten += xSent;
+		ulWrites++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+StreamBufferRegion_t xRegion;
+size_t xReceived;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xZeroCopy != pdFALSE )
+		{
+			xReceived = xShmStreamBufferPeekContiguous( xBuffer, &xRegion, portMAX_DELAY );
+			configASSERT( xReceived == ( size_t ) lMessageSize );
+			( void ) xShmStreamBufferConsume( xBuffer, xReceived );
+		}
+		else
+		{
+			xReceived = xShmStreamBufferReceive( xBuffer, pucReadData, ( size_t ) lMessageSize, portMAX_DELAY );
+			configASSERT( xReceived == ( size_t ) lMessageSize );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReport( const char *pcTransport, uint64_t ullBytes, unsigned long ulMessages, uint64_t ullWallNs )
+{
+	printf( "bench=shm transport=%s size=%ld buffer=%ld mb_per_s=%.1f messages_per_s=%.0f\n",
+			pcTransport,
+			lMessageSize,
+			lBufferSize,
+			( ( double ) ullBytes * 1000.0 ) / ( double ) ullWallNs,
+			( ( double ) ulMessages * 1e9 ) / ( double ) ullWallNs );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+const char *pcTransport = ( const char * ) pvParameters;
+uint64_t ullStartNs, ullWallNs, ullBytesStart;
+unsigned long ulWritesStart;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 100 );
+
+	ullBytesStart = ullBytesWritten;
+	ulWritesStart = ulWrites;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	vTaskSuspendAll();
+
+	/* The buffer holds at most lBufferSize bytes the reader has not read, so
+	what was written is what was read. */
+	prvReport( pcTransport, ullBytesWritten - ullBytesStart, ulWrites - ulWritesStart, ullWallNs );
+
+	if( xReaderProcess > 0 )
+	{
+		kill( xReaderProcess, SIGKILL );
+		waitpid( xReaderProcess, NULL, 0 );
+	}
+
+	( void ) xShmStreamBufferUnlink( benchSEGMENT_NAME );
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvStartReaderProcess( const char *pcTransport )
+{
+char pcSize[ 32 ], pcBuffer[ 32 ];
+
+	snprintf( pcSize, sizeof( pcSize ), "%ld", lMessageSize );
+	snprintf( pcBuffer, sizeof( pcBuffer ), "%ld", lBufferSize );
+
+	xReaderProcess = fork();
+	configASSERT( xReaderProcess >= 0 );
+
+	if( xReaderProcess == 0 )
+	{
+		/* Only this thread is in the child, exec at once.  The reader must not
+		outlive the writer. */
+		prctl( PR_SET_PDEATHSIG, SIGKILL );
+		execl( "/proc/self/exe", "bench_shm", "reader", pcTransport, pcSize, pcBuffer, ( char * ) NULL );
+		_exit( 1 );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static int iTcpReader;
+static int iTcpWriter;
+static volatile uint64_t ullTcpBytesRead;
+static volatile unsigned long ulTcpReads;
+
+static void prvTcpReadAll( int iSocket, uint8_t *pucData, size_t xLength )
+{
+ssize_t xRead;
+
+	while( xLength > 0 )
+	{
+		xRead = read( iSocket, pucData, xLength );
+		configASSERT( xRead > 0 );
+		pucData += xRead;
+		xLength -= ( size_t ) xRead;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void *prvTcpWriterThread( void *pvParameters )
+{
+uint32_t ulLength = ( uint32_t ) lMessageSize;
+struct iovec xVector[ 2 ];
+ssize_t xWritten;
+unsigned long ulMessage = 0;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		memset( pucWriteData, ( int ) ulMessage++, ( size_t ) lMessageSize );
+
+		xVector[ 0 ].iov_base = &ulLength;
+		xVector[ 0 ].iov_len = sizeof( ulLength );
+		xVector[ 1 ].iov_base = pucWriteData;
+		xVector[ 1 ].iov_len = ( size_t ) lMessageSize;
+
+		while( xVector[ 0 ].iov_len + xVector[ 1 ].iov_len > 0 )
+		{
+			xWritten = writev( iTcpWriter, ( xVector[ 0 ].iov_len > 0 ) ? &xVector[ 0 ] : &xVector[ 1 ], ( xVector[ 0 ].iov_len > 0 ) ? 2 : 1 );
+			configASSERT( xWritten > 0 );
+
+			if( ( size_t ) xWritten >= xVector[ 0 ].iov_len )
+			{
+				xWritten -= ( ssize_t ) xVector[ 0 ].iov_len;
+				xVector[ 0 ].iov_len = 0;
+				xVector[ 1 ].iov_base = ( uint8_t * ) xVector[ 1 ].iov_base + xWritten;
+				xVector[ 1 ].iov_len -= ( size_t ) xWritten;
+			}
+			else
+			{
+				xVector[ 0 ].iov_base = ( uint8_t * ) xVector[ 0 ].iov_base + xWritten;
+				xVector[ 0 ].iov_len -= ( size_t ) xWritten;
+			}
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+static void *prvTcpReaderThread( void *pvParameters )
+{
+uint32_t ulLength;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		prvTcpReadAll( iTcpReader, ( uint8_t * ) &ulLength, sizeof( ulLength ) );
+		configASSERT( ulLength == ( uint32_t ) lMessageSize );
+		prvTcpReadAll( iTcpReader, pucReadData, ulLength );
+
+		ullTcpBytesRead += ulLength;
+		ulTcpReads++;
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunTcp( void )
+{
+struct sockaddr_in xAddress;
+socklen_t xAddressLength = sizeof( xAddress );
+pthread_t xWriter, xReader;
+uint64_t ullStartNs, ullWallNs, ullBytesStart;
+unsigned long ulReadsStart;
+int iListener, iOne = 1;
+
+	memset( &xAddress, 0, sizeof( xAddress ) );
+	xAddress.sin_family = AF_INET;
+	xAddress.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+	iListener = socket( AF_INET, SOCK_STREAM, 0 );
+	configASSERT( bind( iListener, ( struct sockaddr * ) &xAddress, sizeof( xAddress ) ) == 0 );
+	configASSERT( listen( iListener, 1 ) == 0 );
+	configASSERT( getsockname( iListener, ( struct sockaddr * ) &xAddress, &xAddressLength ) == 0 );
+
+	iTcpWriter = socket( AF_INET, SOCK_STREAM, 0 );
+	configASSERT( connect( iTcpWriter, ( struct sockaddr * ) &xAddress, sizeof( xAddress ) ) == 0 );
+	iTcpReader = accept( iListener, NULL, NULL );
+	configASSERT( iTcpReader >= 0 );
+
+	/* As roscpp does for a subscriber that asks for tcp_nodelay. */
+	setsockopt( iTcpWriter, IPPROTO_TCP, TCP_NODELAY, &iOne, sizeof( iOne ) );
+
+	pthread_create( &xReader, NULL, prvTcpReaderThread, NULL );
+	pthread_create( &xWriter, NULL, prvTcpWriterThread, NULL );
+
+	usleep( 100000 );
+	ullBytesStart = ullTcpBytesRead;
+	ulReadsStart = ulTcpReads;
+	ullStartNs = ullBenchNowNs();
+	usleep( ( useconds_t ) ( ( unsigned long ) lDuration * ulBenchTickPeriodUs ) );
+	ullWallNs = ullBenchNowNs() - ullStartNs;
+
+	prvReport( "tcp", ullTcpBytesRead - ullBytesStart, ulTcpReads - ulReadsStart, ullWallNs );
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcTransport = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "shm";
+BaseType_t xReader = pdFALSE;
+
+	/* The second process of the shm transports: bench_shm reader <transport> ... */
+	if( strcmp( pcTransport, "reader" ) == 0 )
+	{
+		xReader = pdTRUE;
+		iBenchArgc--;
+		ppcBenchArgv++;
+		pcTransport = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "shm";
+	}
+
+	xZeroCopy = ( strstr( pcTransport, "-zero-copy" ) != NULL ) ? pdTRUE : pdFALSE;
+	lMessageSize = lBenchArgument( 2, 256 );
+	lBufferSize = lBenchArgument( 3, ( lMessageSize * 16 > 65536 ) ? lMessageSize * 16 : 65536 );
+	lDuration = lBenchArgument( 4, benchDEFAULT_DURATION );
+
+	configASSERT( lMessageSize > 0 );
+	configASSERT( lBufferSize > lMessageSize + ( long ) sizeof( size_t ) );
+
+	pucWriteData = ( uint8_t * ) pvPortMalloc( ( size_t ) lMessageSize );
+	pucReadData = ( uint8_t * ) pvPortMalloc( ( size_t ) lMessageSize );
+	configASSERT( pucWriteData && pucReadData );
+
+	if( strcmp( pcTransport, "tcp" ) == 0 )
+	{
+		prvRunTcp();
+	}
+
+	if( xReader != pdFALSE )
+	{
+		/* Created by the writer process, take its size and type. */
+		xBuffer = xShmStreamBufferOpen( benchSEGMENT_NAME, 0, 0, pdTRUE );
+		configASSERT( xBuffer );
+
+		xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, benchREADER_PRIORITY, NULL );
+	}
+	else
+	{
+		/* A segment left over by a run that was killed. */
+		( void ) xShmStreamBufferUnlink( benchSEGMENT_NAME );
+
+		xBuffer = xShmStreamBufferOpen( benchSEGMENT_NAME, ( size_t ) lBufferSize, 1, pdTRUE );
+		configASSERT( xBuffer );
+
+		if( strcmp( pcTransport, "local" ) == 0 )
+		{
+			xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, benchREADER_PRIORITY, NULL );
+		}
+		else
+		{
+			prvStartReaderProcess( pcTransport );
+		}
+
+		xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, benchWRITER_PRIORITY, NULL );
+		xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, ( void * ) pcTransport, benchMONITOR_PRIORITY, NULL );
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,344 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> state published at 1 kHz to many readers
+ */
+
+/*
+ * A writer task publishes a state of <size> bytes on each tick, and reader
+ * tasks of the same priority read the latest state over and over, with time
+ * slicing between them.  Host threads that are not tasks, as the thread of a
+ * ROS node, can read the state too.  Each state is filled with its version,
+ * so a read that mixes two states is seen.
+ *
+ *   bench_snapshot queue|mutex|seqlock|rcu [<readers>] [<size>] [<host threads>] [<duration in ticks>]
+ *
+ * queue    A queue of one item per reader: the writer overwrites the item of
+ *          each reader, and a reader peeks at its own.
+ * mutex    One copy of the state, read and written under a mutex.
+ * seqlock  A snapshot of one buffer: readers copy the state again if it was
+ *          written meanwhile.
+ * rcu      A snapshot of three buffers: readers pin the latest one.  A write
+ *          is dropped when readers preempted in the middle of a read pin both
+ *          older buffers.
+ *
+ * The reads per second of the tasks and of the host threads, the cost of a
+ * write, the number of dropped writes, the number of reads that were retried
+ * and the number of torn reads (always 0) are reported.  Host threads only
+ * read snapshots.
+ */
+
+#include <pthread.h>
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "snapshot.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION		1000
+#define benchMAX_READERS			48
+#define benchMAX_HOST_THREADS		8
+#define benchMAX_WORDS				1024
+#define benchRCU_BUFFERS			3
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchWRITER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define benchREADER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+typedef enum
+{
+	eBenchQueue,
+	eBenchMutex,
+	eBenchSeqlock,
+	eBenchRcu
+} BenchMode_t;
+
+static const char * const pcModes[] = { "queue", "mutex", "seqlock", "rcu" };
+
+static BenchMode_t eMode;
+static long lReaders;
+static long lWords;
+static long lHostThreads;
+static long lDuration;
+
+static SnapshotHandle_t xSnapshot;
+static SemaphoreHandle_t xMutex;
+static QueueHandle_t xQueues[ benchMAX_READERS ];
+static uint32_t ulShared[ benchMAX_WORDS ];
+
+static volatile unsigned long ulReads[ benchMAX_READERS ];
+static volatile unsigned long ulRetries;
+static volatile unsigned long ulTornReads;
+static volatile unsigned long ulWrites;
+static volatile unsigned long ulDroppedWrites;
+static volatile uint64_t ullWriteNs;
+
+static volatile int iHostStop;
+static volatile unsigned long ulHostReads[ benchMAX_HOST_THREADS ];
+static volatile unsigned long ulHostRetries[ benchMAX_HOST_THREADS ];
+static volatile unsigned long ulHostTornReads;
+
+/*----------------------------------------------------------------------------*/
+
+/* Returns pdFALSE if the words are not all the same. */
+static BaseType_t prvCheckState( const uint32_t * const pulState )
+{
+long x;
+
+	for( x = 1; x < lWords; x++ )
+	{
+		if( pulState[ x ] != pulState[ 0 ] )
+		{
+			return pdFALSE;
+		}
+	}
+
+	return pdTRUE;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+uint32_t ulState[ benchMAX_WORDS ];
+uint64_t ullStartNs;
+long x;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( 1 );
+
+		for( x = 0; x < lWords; x++ )
+		{
+			ulState[ x ] = ( uint32_t ) ulWrites + 1U;
+		}
+
+		ullStartNs = ullBenchNowNs();
+
+		switch( eMode )
+		{
+			case eBenchQueue:
+				for( x = 0; x < lReaders; x++ )
+				{
+					( void ) xQueueOverwrite( xQueues[ x ], ulState );
+				}
+				break;
+
+			case eBenchMutex:
+				configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+				memcpy( ulShared, ulState, ( size_t ) lWords * sizeof( uint32_t ) );
+				configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+				break;
+
+			default:
+				if( xSnapshotWrite( xSnapshot, ulState ) == pdFAIL )
+				{
+					ulDroppedWrites++;
+				}
+				break;
+		}
+
+		ullWriteNs += ullBenchNowNs() - ullStartNs;
+		ulWrites++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+const long lReader = ( long ) ( uintptr_t ) pvParameters;
+uint32_t ulState[ benchMAX_WORDS ];
+UBaseType_t uxRetries;
+
+	for( ;; )
+	{
+		switch( eMode )
+		{
+			case eBenchQueue:
+				/* Empty until the first write. */
+				if( xQueuePeek( xQueues[ lReader ], ulState, 0 ) == pdFAIL )
+				{
+					continue;
+				}
+				break;
+
+			case eBenchMutex:
+				configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+				memcpy( ulState, ulShared, ( size_t ) lWords * sizeof( uint32_t ) );
+				configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+				break;
+
+			default:
+				( void ) ulSnapshotRead( xSnapshot, ulState, &uxRetries );
+				ulRetries += uxRetries;
+				break;
+		}
+
+		if( prvCheckState( ulState ) == pdFALSE )
+		{
+			ulTornReads++;
+		}
+
+		ulReads[ lReader ]++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void *prvHostReaderThread( void *pvArgument )
+{
+const long lThread = ( long ) ( uintptr_t ) pvArgument;
+uint32_t ulState[ benchMAX_WORDS ];
+UBaseType_t uxRetries;
+
+	/* A thread of the node, not a task: it reads the snapshot beside the
+	kernel, on another core of the host. */
+	while( iHostStop == 0 )
+	{
+		( void ) ulSnapshotRead( xSnapshot, ulState, &uxRetries );
+		ulHostRetries[ lThread ] += uxRetries;
+
+		if( prvCheckState( ulState ) == pdFALSE )
+		{
+			ulHostTornReads++;
+		}
+
+		ulHostReads[ lThread ]++;
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+static unsigned long prvSum( volatile unsigned long * const pulCounts, const long lCounts )
+{
+unsigned long ulTotal = 0;
+long x;
+
+	for( x = 0; x < lCounts; x++ )
+	{
+		ulTotal += pulCounts[ x ];
+	}
+
+	return ulTotal;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulStart, ulHostStart, ulHostRetriesStart, ulWritesStart, ulDroppedStart;
+double dWallS;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	ulStart = prvSum( ulReads, lReaders );
+	ulHostStart = prvSum( ulHostReads, lHostThreads );
+	ulHostRetriesStart = prvSum( ulHostRetries, lHostThreads );
+	ulWritesStart = ulWrites;
+	ulDroppedStart = ulDroppedWrites;
+	ulRetries = 0;
+	ullWriteNs = 0;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	vTaskSuspendAll();
+	iHostStop = 1;
+	dWallS = ( double ) ullWallNs / 1e9;
+
+	printf( "bench=snapshot mode=%s readers=%ld size=%ld host_threads=%ld reads_per_s=%.0f host_reads_per_s=%.0f writes_per_s=%.0f write_ns=%.0f dropped_writes=%lu retries=%lu host_retries=%lu torn_reads=%lu\n",
+			pcModes[ eMode ],
+			lReaders,
+			lWords * ( long ) sizeof( uint32_t ),
+			lHostThreads,
+			( double ) ( prvSum( ulReads, lReaders ) - ulStart ) / dWallS,
+			( double ) ( prvSum( ulHostReads, lHostThreads ) - ulHostStart ) / dWallS,
+			( double ) ( ulWrites - ulWritesStart ) / dWallS,
+			( ulWrites != ulWritesStart ) ? ( double ) ullWriteNs / ( double ) ( ulWrites - ulWritesStart ) : 0.0,
+			ulDroppedWrites - ulDroppedStart,
+			ulRetries,
+			prvSum( ulHostRetries, lHostThreads ) - ulHostRetriesStart,
+			ulTornReads + ulHostTornReads );
+
+	configASSERT( ( ulTornReads + ulHostTornReads ) == 0 );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "rcu";
+pthread_t xThread;
+long x;
+
+	for( x = 0; x < ( long ) ( sizeof( pcModes ) / sizeof( pcModes[ 0 ] ) ); x++ )
+	{
+		if( strcmp( pcMode, pcModes[ x ] ) == 0 )
+		{
+			eMode = ( BenchMode_t ) x;
+		}
+	}
+
+	lReaders = lBenchArgument( 2, 8 );
+	lWords = lBenchArgument( 3, 64 ) / ( long ) sizeof( uint32_t );
+	lHostThreads = lBenchArgument( 4, 0 );
+	lDuration = lBenchArgument( 5, benchDEFAULT_DURATION );
+
+	configASSERT( ( lReaders > 0 ) && ( lReaders <= benchMAX_READERS ) );
+	configASSERT( ( lWords > 0 ) && ( lWords <= benchMAX_WORDS ) );
+	configASSERT( ( lHostThreads >= 0 ) && ( lHostThreads <= benchMAX_HOST_THREADS ) );
+	configASSERT( ( lHostThreads == 0 ) || ( eMode >= eBenchSeqlock ) );
+
+	switch( eMode )
+	{
+		case eBenchQueue:
+			for( x = 0; x < lReaders; x++ )
+			{
+				xQueues[ x ] = xQueueCreate( 1, ( UBaseType_t ) lWords * sizeof( uint32_t ) );
+				configASSERT( xQueues[ x ] );
+			}
+			break;
+
+		case eBenchMutex:
+			xMutex = xSemaphoreCreateMutex();
+			configASSERT( xMutex );
+			break;
+
+		default:
+			xSnapshot = xSnapshotCreate( ( size_t ) lWords * sizeof( uint32_t ), ( eMode == eBenchSeqlock ) ? 1 : benchRCU_BUFFERS );
+			configASSERT( xSnapshot );
+			break;
+	}
+
+	for( x = 0; x < lReaders; x++ )
+	{
+		xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE + benchMAX_WORDS, ( void * ) ( uintptr_t ) x, benchREADER_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE + benchMAX_WORDS, NULL, benchWRITER_PRIORITY, NULL );
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	for( x = 0; x < lHostThreads; x++ )
+	{
+		configASSERT( pthread_create( &xThread, NULL, prvHostReaderThread, ( void * ) ( uintptr_t ) x ) == 0 );
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
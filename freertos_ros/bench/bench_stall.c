@@ -0,0 +1,168 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> recovery of the tick after a stall of the host
+ */
+
+/*
+ * Stalls the tick thread from the tick hook, as a page fault or a neighbour
+ * process would, and measures how long the kernel takes to get its tick
+ * count back within one tick of the wall clock.
+ *
+ *   bench_stall [<stall in ms>] [<stalls>] [<sleeper tasks>]
+ *
+ * bench_stall hands the missed ticks to the kernel in one call of the tick
+ * handler, bench_stall_single is built with configPORT_MAX_CATCH_UP_TICKS 1
+ * and gets them from the tick thread one call at a time.  Sleeper tasks with
+ * short delays make the kernel unblock tasks and switch while it catches up.
+ */
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+
+#include <unistd.h>
+
+#include "bench.h"
+
+#define benchTICKS_BETWEEN_STALLS	500
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define benchSLEEPER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+static long lStallMs;
+static long lStalls;
+
+static uint64_t ullStartNs;
+static TickType_t xStartTick;
+static TickType_t xNextStallTick;
+static long lStallsDone;
+static BaseType_t xRecovering = pdFALSE;
+static uint64_t ullStallEndNs;
+static PortTickStats_t xStatsAtStallEnd;
+
+/* Sums over the stalls. */
+static uint64_t ullRecoveryNs;
+static uint64_t ullMaxRecoveryNs;
+static unsigned long ulRecoveryCalls;
+static unsigned long ulRecoverySwitches;
+
+static volatile unsigned long ulWakeUps;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvStallHook( void )
+{
+const uint64_t ullPeriodNs = 1000000000ULL / configTICK_RATE_HZ;
+TickType_t xTick = xTaskGetTickCountFromISR();
+uint64_t ullNowNs = ullBenchNowNs();
+PortTickStats_t xStats;
+TickType_t xWallTick;
+uint64_t ullRecovery;
+
+	if( ullStartNs == 0 )
+	{
+		ullStartNs = ullNowNs;
+		xStartTick = xTick;
+		xNextStallTick = xTick + benchTICKS_BETWEEN_STALLS;
+		return;
+	}
+
+	/* The tick the kernel would be at if no tick had been missed. */
+	xWallTick = xStartTick + ( TickType_t ) ( ( ullNowNs - ullStartNs ) / ullPeriodNs );
+
+	if( xRecovering != pdFALSE )
+	{
+		if( ( TickType_t ) ( xWallTick - xTick ) <= ( TickType_t ) 1 )
+		{
+			vPortGetTickStats( &xStats );
+
+			ullRecovery = ullNowNs - ullStallEndNs;
+			ullRecoveryNs += ullRecovery;
+			if( ullRecovery > ullMaxRecoveryNs )
+			{
+				ullMaxRecoveryNs = ullRecovery;
+			}
+
+			ulRecoveryCalls += xStats.ulHandlerCalls - xStatsAtStallEnd.ulHandlerCalls;
+			ulRecoverySwitches += xStats.ulContextSwitches - xStatsAtStallEnd.ulContextSwitches;
+			xRecovering = pdFALSE;
+			xNextStallTick = xTick + benchTICKS_BETWEEN_STALLS;
+		}
+	}
+	else if( ( lStallsDone < lStalls ) && ( xTick == xNextStallTick ) )
+	{
+		usleep( ( useconds_t ) ( lStallMs * 1000 ) );
+		ullStallEndNs = ullBenchNowNs();
+		vPortGetTickStats( &xStatsAtStallEnd );
+		lStallsDone++;
+		xRecovering = pdTRUE;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSleeperTask( void *pvParameters )
+{
+const TickType_t xDelay = ( TickType_t ) ( uintptr_t ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( xDelay );
+		ulWakeUps++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+PortTickStats_t xStats;
+double dStalls;
+
+	( void ) pvParameters;
+
+	while( ( lStallsDone < lStalls ) || ( xRecovering != pdFALSE ) )
+	{
+		vTaskDelay( 100 );
+	}
+
+	vTaskSuspendAll();
+	vPortGetTickStats( &xStats );
+	dStalls = ( double ) lStalls;
+
+	printf( "bench=stall catch_up=%lu stall_ms=%ld stalls=%ld recovery_us=%.1f max_recovery_us=%.1f calls=%.1f switches=%.1f max_batch=%lu dropped=%lu wakeups=%lu\n",
+			( unsigned long ) configPORT_MAX_CATCH_UP_TICKS,
+			lStallMs,
+			lStalls,
+			( double ) ullRecoveryNs / ( dStalls * 1000.0 ),
+			( double ) ullMaxRecoveryNs / 1000.0,
+			( double ) ulRecoveryCalls / dStalls,
+			( double ) ulRecoverySwitches / dStalls,
+			xStats.ulMaxBatch,
+			xStats.ulDroppedTicks,
+			ulWakeUps );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+long lSleepers, i;
+
+	lStallMs = lBenchArgument( 1, 100 );
+	lStalls = lBenchArgument( 2, 10 );
+	lSleepers = lBenchArgument( 3, 8 );
+
+	pxBenchTickHook = prvStallHook;
+
+	for( i = 0; i < lSleepers; i++ )
+	{
+		xTaskCreate( prvSleeperTask, "Sleeper", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ( i + 1 ), benchSLEEPER_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> throughput of stream and message buffers
+ */
+
+/*
+ * A writer task sends blocks of the same size to a reader task through a
+ * stream buffer or a message buffer, and the throughput is reported in bytes
+ * per second.
+ *
+ *   bench_stream stream|message[-zero-copy] <write size> [<buffer size>] [<duration in ticks>]
+ *
+ * The writer fills each block with memset(), as a serializer would.  It does
+ * so in a buffer of its own that xStreamBufferSend() copies in, or with
+ * -zero-copy, in the region handed out by xStreamBufferReserve().  Likewise the
+ * reader copies the data out with xStreamBufferReceive(), or with -zero-copy
+ * looks at it in place with xStreamBufferPeekContiguous().
+ *
+ * The writer has the higher priority: it fills the buffer and blocks, then
+ * the reader empties it.  bench_stream is built with
+ * configUSE_LOCK_FREE_STREAM_BUFFERS, and the writer waits for half of the
+ * buffer to be free with xStreamBufferSetSendTriggerLevel().
+ * bench_stream_locked is the same benchmark with a critical section around
+ * each send and receive and a writer that is woken by each read.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION	1000
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 2 )
+#define benchWRITER_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define benchREADER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+
+static BaseType_t xMessages;
+static BaseType_t xZeroCopy;
+static long lWriteSize;
+static long lBufferSize;
+static long lDuration;
+
+static StreamBufferHandle_t xBuffer;
+static uint8_t *pucWriteData;
+static uint8_t *pucReadData;
+
+static volatile uint64_t ullBytesRead;
+static volatile unsigned long ulWrites;
+static volatile unsigned long ulReads;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+StreamBufferRegion_t xRegion;
+size_t xSent;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xZeroCopy != pdFALSE )
+		{
+			xSent = xStreamBufferReserve( xBuffer, ( size_t ) lWriteSize, &xRegion, portMAX_DELAY );
+			configASSERT( xSent == ( size_t ) lWriteSize );
+
+			memset( xRegion.pucFirst, ( int ) ulWrites, xRegion.xFirstLength );
+			if( xRegion.xSecondLength > 0 )
+			{
+				memset( xRegion.pucSecond, ( int ) ulWrites, xRegion.xSecondLength );
+			}
+
+			xSent = xStreamBufferCommit( xBuffer, xSent );
+		}
+		else if( xMessages != pdFALSE )
+		{
+			memset( pucWriteData, ( int ) ulWrites, ( size_t ) lWriteSize );
+			xSent = xMessageBufferSend( xBuffer, pucWriteData, ( size_t ) lWriteSize, portMAX_DELAY );
+		}
+		else
+		{
+			memset( pucWriteData, ( int ) ulWrites, ( size_t ) lWriteSize );
+			xSent = xStreamBufferSend( xBuffer, pucWriteData, ( size_t ) lWriteSize, portMAX_DELAY );
+		}
+
+		configASSERT( xSent == ( size_t ) lWriteSize );
+		ulWrites++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+StreamBufferRegion_t xRegion;
+size_t xReceived;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xZeroCopy != pdFALSE )
+		{
+			/* The whole stream, or the next message, where it lies. */
+			xReceived = xStreamBufferPeekContiguous( xBuffer, &xRegion, portMAX_DELAY );
+			configASSERT( ( xMessages == pdFALSE ) || ( xReceived == ( size_t ) lWriteSize ) );
+			configASSERT( ( xRegion.xFirstLength + xRegion.xSecondLength ) == xReceived );
+			( void ) xStreamBufferConsume( xBuffer, xReceived );
+		}
+		else if( xMessages != pdFALSE )
+		{
+			xReceived = xMessageBufferReceive( xBuffer, pucReadData, ( size_t ) lWriteSize, portMAX_DELAY );
+			configASSERT( xReceived == ( size_t ) lWriteSize );
+		}
+		else
+		{
+			/* Take everything that is there. */
+			xReceived = xStreamBufferReceive( xBuffer, pucReadData, ( size_t ) lBufferSize, portMAX_DELAY );
+		}
+
+		ullBytesRead += xReceived;
+		ulReads++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs, ullBytesStart;
+unsigned long ulWritesStart, ulReadsStart;
+
+	( void ) pvParameters;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 100 );
+
+	ullBytesStart = ullBytesRead;
+	ulWritesStart = ulWrites;
+	ulReadsStart = ulReads;
+	ullStartNs = ullBenchNowNs();
+
+	/* Checked against the host clock, the port now and then returns from a
+	delay early when the tasks switch this often. */
+	do
+	{
+		vTaskDelay( ( TickType_t ) lDuration );
+		ullWallNs = ullBenchNowNs() - ullStartNs;
+	} while( ullWallNs < ( ( uint64_t ) lDuration * ( uint64_t ) ulBenchTickPeriodUs * 1000ULL ) );
+
+	vTaskSuspendAll();
+
+	printf( "bench=stream lock_free=%d type=%s zero_copy=%d size=%ld buffer=%ld mb_per_s=%.1f writes_per_s=%.0f reads_per_s=%.0f\n",
+			configUSE_LOCK_FREE_STREAM_BUFFERS,
+			( xMessages != pdFALSE ) ? "message" : "stream",
+			( xZeroCopy != pdFALSE ) ? 1 : 0,
+			lWriteSize,
+			lBufferSize,
+			( ( double ) ( ullBytesRead - ullBytesStart ) * 1000.0 ) / ( double ) ullWallNs,
+			( ( double ) ( ulWrites - ulWritesStart ) * 1e9 ) / ( double ) ullWallNs,
+			( ( double ) ( ulReads - ulReadsStart ) * 1e9 ) / ( double ) ullWallNs );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "stream";
+
+	xMessages = ( strncmp( pcMode, "message", 7 ) == 0 ) ? pdTRUE : pdFALSE;
+	xZeroCopy = ( strstr( pcMode, "-zero-copy" ) != NULL ) ? pdTRUE : pdFALSE;
+	lWriteSize = lBenchArgument( 2, 16 );
+	lBufferSize = lBenchArgument( 3, ( lWriteSize * 4 > 4096 ) ? lWriteSize * 4 : 4096 );
+	lDuration = lBenchArgument( 4, benchDEFAULT_DURATION );
+
+	/* A message also stores its length. */
+	if( xMessages != pdFALSE )
+	{
+		lBufferSize += ( long ) sizeof( size_t );
+	}
+
+	configASSERT( lWriteSize > 0 );
+	configASSERT( lBufferSize > lWriteSize );
+
+	pucWriteData = ( uint8_t * ) pvPortMalloc( ( size_t ) lWriteSize );
+	pucReadData = ( uint8_t * ) pvPortMalloc( ( size_t ) lBufferSize );
+	configASSERT( pucWriteData && pucReadData );
+
+	if( xMessages != pdFALSE )
+	{
+		xBuffer = xMessageBufferCreate( ( size_t ) lBufferSize );
+	}
+	else
+	{
+		xBuffer = xStreamBufferCreate( ( size_t ) lBufferSize, 1 );
+	}
+
+	configASSERT( xBuffer );
+
+	#if( configUSE_LOCK_FREE_STREAM_BUFFERS == 1 )
+	{
+		xStreamBufferSetSendTriggerLevel( xBuffer, ( size_t ) ( lBufferSize / 2 ) );
+	}
+	#endif
+
+	xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, benchWRITER_PRIORITY, NULL );
+	xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, benchREADER_PRIORITY, NULL );
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
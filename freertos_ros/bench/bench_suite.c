@@ -0,0 +1,684 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> suite of kernel microbenchmarks with percentiles, to track the port
+ */
+
+/*
+ * The costs of the kernel and of the Linux port, sample by sample, each case
+ * summed up on one line of percentiles so that runs can be compared across
+ * changes of the port.
+ *
+ *   bench_suite [-t <tick us>] [<case>|all] [<samples>]
+ *
+ * yield        A task yields to another task of the same priority: the time
+ *              from the yield to the other task running.
+ * semaphore    A task gives a semaphore to a task of the same priority and
+ *              takes a second semaphore the other task gives back: the round
+ *              trip, two switches.
+ * queue_4, queue_64, queue_1024
+ *              A task sends an item of 4, 64 and 1024 bytes to a queue and
+ *              receives it back, without blocking: the pair.
+ * stream       A task writes 1 KB at a time to a 16 KB stream buffer that a
+ *              task of a lower priority reads 4 KB at a time: the write,
+ *              blocked time included.  The throughput is reported too.
+ * notify       A task notifies a task of a higher priority waiting on its
+ *              notification: the time from the notification to the waiting
+ *              task running.
+ * notify_isr   The same from the tick interrupt, one sample per tick.
+ * timer        An auto-reload timer of one tick: the difference between the
+ *              period and the time between two callbacks, one sample per
+ *              tick.
+ * tick         The tick handler of the port, vPortSysTickHandler(), called
+ *              by the host tick thread with the idle task running, one sample
+ *              per tick.
+ * task         A task creates a task of a lower priority and deletes it: the
+ *              pair, host thread start and end of the port included.
+ * heap         pvPortMalloc() of 16 B to 4 KB and vPortFree() of the oldest
+ *              of 64 blocks held: the pair.
+ *
+ * Each case prints
+ *
+ *   bench=suite case=<case> unit=ns samples=<n> min=... mean=... p50=... p90=... p99=... p999=... max=... rejected=<n>
+ *
+ * with the percentiles by nearest rank, and stream also bytes_per_s=....  The
+ * cases of one sample per tick take at most benchMAX_TICK_SAMPLES samples.
+ * rejected counts the samples of yield and notify left out because the
+ * stamp they are measured from was taken after the time they end at: the
+ * measuring task was switched out between reading the two and the stamp was
+ * taken again meanwhile.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_SAMPLES		10000
+#define benchMAX_TICK_SAMPLES		2000
+#define benchCONTROL_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define benchSTREAM_BYTES			( 16 * 1024 )
+#define benchSTREAM_WRITE			1024
+#define benchSTREAM_READ			4096
+#define benchHEAP_BLOCKS			64
+
+typedef struct BenchCase
+{
+	const char *pcName;
+	void ( *pxRun )( void );
+} BenchCase_t;
+
+static unsigned long ulSamples;
+
+static uint64_t *pullSamples;
+static volatile unsigned long ulCount;
+static unsigned long ulTarget;
+
+static SemaphoreHandle_t xDone;
+static TaskHandle_t xTasks[ 2 ];
+static volatile uint64_t ullStampNs;
+static volatile uint64_t ullHandoffNs[ 2 ];
+static volatile unsigned long ulRejected;
+
+static SemaphoreHandle_t xPing;
+static SemaphoreHandle_t xPong;
+static StreamBufferHandle_t xStream;
+static volatile unsigned long ulStreamBytes;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvStart( unsigned long ulMaxSamples )
+{
+	ulTarget = ( ulSamples < ulMaxSamples ) ? ulSamples : ulMaxSamples;
+	ulCount = 0;
+	ullStampNs = 0;
+	ullHandoffNs[ 0 ] = 0;
+	ullHandoffNs[ 1 ] = 0;
+	ulRejected = 0;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRecord( uint64_t ullNs )
+{
+	if( ulCount < ulTarget )
+	{
+		pullSamples[ ulCount ] = ullNs;
+		ulCount++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+/* Record the time from ullThenNs to ullNowNs, or count it as rejected if the
+stamp is the later of the two. */
+static void prvRecordSince( uint64_t ullThenNs, uint64_t ullNowNs )
+{
+	if( ullNowNs >= ullThenNs )
+	{
+		prvRecord( ullNowNs - ullThenNs );
+	}
+	else
+	{
+		ulRejected++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+/* Called by the tasks of a case when they have taken all the samples: wake
+the control task, which deletes them. */
+static void prvFinishFromTask( void )
+{
+	if( ulCount >= ulTarget )
+	{
+		xSemaphoreGive( xDone );
+		vTaskSuspend( NULL );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvDeleteTasks( void )
+{
+BaseType_t x;
+
+	for( x = 0; x < 2; x++ )
+	{
+		if( xTasks[ x ] != NULL )
+		{
+			vTaskDelete( xTasks[ x ] );
+			xTasks[ x ] = NULL;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWaitAndDeleteTasks( void )
+{
+	configASSERT( xSemaphoreTake( xDone, portMAX_DELAY ) == pdPASS );
+	prvDeleteTasks();
+}
+/*----------------------------------------------------------------------------*/
+
+static int prvCompareSamples( const void *pvA, const void *pvB )
+{
+const uint64_t ullA = *( const uint64_t * ) pvA;
+const uint64_t ullB = *( const uint64_t * ) pvB;
+
+	return ( ullA > ullB ) - ( ullA < ullB );
+}
+/*----------------------------------------------------------------------------*/
+
+static uint64_t prvPercentile( unsigned long ulPerMille )
+{
+unsigned long ulRank = ( ( ulCount * ulPerMille ) + 999UL ) / 1000UL;
+
+	return pullSamples[ ( ulRank != 0 ) ? ulRank - 1 : 0 ];
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvReport( const char *pcCase, const char *pcExtra )
+{
+uint64_t ullSum = 0;
+unsigned long x;
+
+	if( ulCount == 0 )
+	{
+		printf( "bench=suite case=%s unit=ns samples=0 rejected=%lu\n", pcCase, ulRejected );
+		return;
+	}
+
+	qsort( pullSamples, ulCount, sizeof( pullSamples[ 0 ] ), prvCompareSamples );
+
+	for( x = 0; x < ulCount; x++ )
+	{
+		ullSum += pullSamples[ x ];
+	}
+
+	printf( "bench=suite case=%s unit=ns samples=%lu min=%llu mean=%.0f p50=%llu p90=%llu p99=%llu p999=%llu max=%llu rejected=%lu%s\n",
+			pcCase,
+			ulCount,
+			( unsigned long long ) pullSamples[ 0 ],
+			( double ) ullSum / ( double ) ulCount,
+			( unsigned long long ) prvPercentile( 500 ),
+			( unsigned long long ) prvPercentile( 900 ),
+			( unsigned long long ) prvPercentile( 990 ),
+			( unsigned long long ) prvPercentile( 999 ),
+			( unsigned long long ) pullSamples[ ulCount - 1 ],
+			ulRejected,
+			( pcExtra != NULL ) ? pcExtra : "" );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+const UBaseType_t uxSelf = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+const UBaseType_t uxOther = ( UBaseType_t ) 1 - uxSelf;
+uint64_t ullNowNs, ullThenNs;
+
+	for( ;; )
+	{
+		/* The other task stamped the time just before it yielded.  Each task
+		measures only the handoffs to it, from the stamp of the other task,
+		and takes the stamp so that it is used once: if the other task was
+		switched out by the tick before it stamped, there is nothing to
+		measure. */
+		ullNowNs = ullBenchNowNs();
+		ullThenNs = ullHandoffNs[ uxOther ];
+
+		if( ullThenNs != 0 )
+		{
+			ullHandoffNs[ uxOther ] = 0;
+			prvRecordSince( ullThenNs, ullNowNs );
+		}
+
+		prvFinishFromTask();
+
+		ullHandoffNs[ uxSelf ] = ullBenchNowNs();
+		taskYIELD();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunYield( void )
+{
+	prvStart( ulSamples );
+
+	xTaskCreate( prvYieldTask, "Yield1", configMINIMAL_STACK_SIZE, ( void * ) 0, benchTASK_PRIORITY, &xTasks[ 0 ] );
+	xTaskCreate( prvYieldTask, "Yield2", configMINIMAL_STACK_SIZE, ( void * ) 1, benchTASK_PRIORITY, &xTasks[ 1 ] );
+
+	prvWaitAndDeleteTasks();
+	prvReport( "yield", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvPingTask( void *pvParameters )
+{
+uint64_t ullStartNs;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ullStartNs = ullBenchNowNs();
+		xSemaphoreGive( xPing );
+		configASSERT( xSemaphoreTake( xPong, portMAX_DELAY ) == pdPASS );
+		prvRecord( ullBenchNowNs() - ullStartNs );
+
+		prvFinishFromTask();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvPongTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		configASSERT( xSemaphoreTake( xPing, portMAX_DELAY ) == pdPASS );
+		xSemaphoreGive( xPong );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunSemaphore( void )
+{
+	prvStart( ulSamples );
+
+	xPing = xSemaphoreCreateBinary();
+	xPong = xSemaphoreCreateBinary();
+	configASSERT( xPing && xPong );
+
+	xTaskCreate( prvPongTask, "Pong", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, &xTasks[ 1 ] );
+	xTaskCreate( prvPingTask, "Ping", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, &xTasks[ 0 ] );
+
+	prvWaitAndDeleteTasks();
+
+	vSemaphoreDelete( xPing );
+	vSemaphoreDelete( xPong );
+
+	prvReport( "semaphore", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunQueue( const char *pcCase, size_t xItemSize )
+{
+QueueHandle_t xQueue;
+uint8_t ucItem[ 1024 ];
+uint64_t ullStartNs;
+
+	configASSERT( xItemSize <= sizeof( ucItem ) );
+	memset( ucItem, 0x5a, sizeof( ucItem ) );
+
+	prvStart( ulSamples );
+
+	xQueue = xQueueCreate( 1, ( UBaseType_t ) xItemSize );
+	configASSERT( xQueue );
+
+	while( ulCount < ulTarget )
+	{
+		ullStartNs = ullBenchNowNs();
+		configASSERT( xQueueSend( xQueue, ucItem, 0 ) == pdPASS );
+		configASSERT( xQueueReceive( xQueue, ucItem, 0 ) == pdPASS );
+		prvRecord( ullBenchNowNs() - ullStartNs );
+	}
+
+	vQueueDelete( xQueue );
+
+	prvReport( pcCase, NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunQueue4( void )
+{
+	prvRunQueue( "queue_4", 4 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunQueue64( void )
+{
+	prvRunQueue( "queue_64", 64 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunQueue1024( void )
+{
+	prvRunQueue( "queue_1024", 1024 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvStreamWriterTask( void *pvParameters )
+{
+static uint8_t ucData[ benchSTREAM_WRITE ];
+uint64_t ullStartNs;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( ulCount < ulTarget )
+		{
+			ullStartNs = ullBenchNowNs();
+			configASSERT( xStreamBufferSend( xStream, ucData, sizeof( ucData ), portMAX_DELAY ) == sizeof( ucData ) );
+			prvRecord( ullBenchNowNs() - ullStartNs );
+		}
+		else
+		{
+			/* The reader ends the case when it has read it all. */
+			vTaskSuspend( NULL );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvStreamReaderTask( void *pvParameters )
+{
+static uint8_t ucData[ benchSTREAM_READ ];
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulStreamBytes += ( unsigned long ) xStreamBufferReceive( xStream, ucData, sizeof( ucData ), portMAX_DELAY );
+
+		if( ulStreamBytes >= ( ulTarget * benchSTREAM_WRITE ) )
+		{
+			xSemaphoreGive( xDone );
+			vTaskSuspend( NULL );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunStream( void )
+{
+char cExtra[ 48 ];
+uint64_t ullStartNs, ullWallNs;
+
+	prvStart( ulSamples );
+	ulStreamBytes = 0;
+
+	xStream = xStreamBufferCreate( benchSTREAM_BYTES, 1 );
+	configASSERT( xStream );
+
+	ullStartNs = ullBenchNowNs();
+
+	xTaskCreate( prvStreamReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, &xTasks[ 1 ] );
+	xTaskCreate( prvStreamWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY + 1, &xTasks[ 0 ] );
+
+	prvWaitAndDeleteTasks();
+	ullWallNs = ullBenchNowNs() - ullStartNs;
+
+	vStreamBufferDelete( xStream );
+
+	snprintf( cExtra, sizeof( cExtra ), " bytes_per_s=%.0f", ( ( double ) ulStreamBytes * 1e9 ) / ( double ) ullWallNs );
+	prvReport( "stream", cExtra );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvNotifyWaiterTask( void *pvParameters )
+{
+uint64_t ullNowNs;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		ullNowNs = ullBenchNowNs();
+		prvRecordSince( ullStampNs, ullNowNs );
+
+		prvFinishFromTask();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvNotifierTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* The waiter runs before xTaskNotifyGive() returns. */
+		ullStampNs = ullBenchNowNs();
+		( void ) xTaskNotifyGive( xTasks[ 0 ] );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunNotify( void )
+{
+	prvStart( ulSamples );
+
+	xTaskCreate( prvNotifyWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY + 1, &xTasks[ 0 ] );
+	xTaskCreate( prvNotifierTask, "Notifier", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, &xTasks[ 1 ] );
+
+	prvWaitAndDeleteTasks();
+	prvReport( "notify", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvNotifyTickHook( void )
+{
+	/* The tick interrupt switches to the woken waiter on its way out. */
+	if( ( xTasks[ 0 ] != NULL ) && ( ulCount < ulTarget ) )
+	{
+		ullStampNs = ullBenchNowNs();
+		vTaskNotifyGiveFromISR( xTasks[ 0 ], NULL );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunNotifyISR( void )
+{
+	prvStart( benchMAX_TICK_SAMPLES );
+
+	xTaskCreate( prvNotifyWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY + 1, &xTasks[ 0 ] );
+	pxBenchTickHook = prvNotifyTickHook;
+
+	configASSERT( xSemaphoreTake( xDone, portMAX_DELAY ) == pdPASS );
+
+	/* Let a tick under way leave the hook before the waiter goes. */
+	pxBenchTickHook = NULL;
+	vTaskDelay( 2 );
+
+	prvDeleteTasks();
+	prvReport( "notify_isr", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xExpiredTimer )
+{
+const uint64_t ullPeriodNs = ( uint64_t ) ulBenchTickPeriodUs * 1000ULL;
+uint64_t ullNowNs = ullBenchNowNs(), ullIntervalNs;
+
+	if( ullStampNs != 0 )
+	{
+		ullIntervalNs = ullNowNs - ullStampNs;
+		prvRecord( ( ullIntervalNs > ullPeriodNs ) ? ullIntervalNs - ullPeriodNs : ullPeriodNs - ullIntervalNs );
+
+		if( ulCount >= ulTarget )
+		{
+			( void ) xTimerStop( xExpiredTimer, 0 );
+			xSemaphoreGive( xDone );
+		}
+	}
+
+	ullStampNs = ullNowNs;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunTimer( void )
+{
+TimerHandle_t xTimer;
+
+	prvStart( benchMAX_TICK_SAMPLES );
+
+	xTimer = xTimerCreate( "Jitter", 1, pdTRUE, NULL, prvTimerCallback );
+	configASSERT( xTimer );
+	configASSERT( xTimerStart( xTimer, portMAX_DELAY ) == pdPASS );
+
+	configASSERT( xSemaphoreTake( xDone, portMAX_DELAY ) == pdPASS );
+	configASSERT( xTimerDelete( xTimer, portMAX_DELAY ) == pdPASS );
+
+	prvReport( "timer", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvTickCost( uint64_t ullNs )
+{
+	prvRecord( ullNs );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunTick( void )
+{
+	prvStart( benchMAX_TICK_SAMPLES );
+
+	/* Only the idle task runs while the ticks are timed. */
+	pxBenchTickCost = prvTickCost;
+
+	while( ulCount < ulTarget )
+	{
+		vTaskDelay( 10 );
+	}
+
+	pxBenchTickCost = NULL;
+
+	prvReport( "tick", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvCreatedTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunTask( void )
+{
+TaskHandle_t xTask;
+uint64_t ullStartNs;
+
+	prvStart( ulSamples );
+
+	while( ulCount < ulTarget )
+	{
+		ullStartNs = ullBenchNowNs();
+		configASSERT( xTaskCreate( prvCreatedTask, "Created", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, &xTask ) == pdPASS );
+		vTaskDelete( xTask );
+		prvRecord( ullBenchNowNs() - ullStartNs );
+	}
+
+	/* Let the idle task free the deleted tasks. */
+	vTaskDelay( 10 );
+
+	prvReport( "task", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRunHeap( void )
+{
+static const size_t xSizes[] = { 16, 64, 256, 1024, 4096, 48, 512 };
+void *pvBlocks[ benchHEAP_BLOCKS ] = { NULL };
+unsigned long x = 0;
+uint64_t ullStartNs;
+
+	prvStart( ulSamples );
+
+	while( ulCount < ulTarget )
+	{
+		ullStartNs = ullBenchNowNs();
+		vPortFree( pvBlocks[ x % benchHEAP_BLOCKS ] );
+		pvBlocks[ x % benchHEAP_BLOCKS ] = pvPortMalloc( xSizes[ x % ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ) ] );
+		prvRecord( ullBenchNowNs() - ullStartNs );
+
+		configASSERT( pvBlocks[ x % benchHEAP_BLOCKS ] );
+		x++;
+	}
+
+	for( x = 0; x < benchHEAP_BLOCKS; x++ )
+	{
+		vPortFree( pvBlocks[ x ] );
+	}
+
+	prvReport( "heap", NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static const BenchCase_t xCases[] =
+{
+	{ "yield", prvRunYield },
+	{ "semaphore", prvRunSemaphore },
+	{ "queue_4", prvRunQueue4 },
+	{ "queue_64", prvRunQueue64 },
+	{ "queue_1024", prvRunQueue1024 },
+	{ "stream", prvRunStream },
+	{ "notify", prvRunNotify },
+	{ "notify_isr", prvRunNotifyISR },
+	{ "timer", prvRunTimer },
+	{ "tick", prvRunTick },
+	{ "task", prvRunTask },
+	{ "heap", prvRunHeap }
+};
+
+static void prvControlTask( void *pvParameters )
+{
+const char *pcCase = ( const char * ) pvParameters;
+BaseType_t xRan = pdFALSE;
+size_t x;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	for( x = 0; x < sizeof( xCases ) / sizeof( xCases[ 0 ] ); x++ )
+	{
+		if( ( strcmp( pcCase, "all" ) == 0 ) || ( strcmp( pcCase, xCases[ x ].pcName ) == 0 ) )
+		{
+			xCases[ x ].pxRun();
+			xRan = pdTRUE;
+		}
+	}
+
+	if( xRan == pdFALSE )
+	{
+		fprintf( stderr, "bench_suite: unknown case %s\n", pcCase );
+		exit( 1 );
+	}
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcCase = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "all";
+
+	ulSamples = ( unsigned long ) lBenchArgument( 2, benchDEFAULT_SAMPLES );
+	configASSERT( ulSamples > 0 );
+
+	pullSamples = malloc( ulSamples * sizeof( pullSamples[ 0 ] ) );
+	configASSERT( pullSamples );
+
+	xDone = xSemaphoreCreateBinary();
+	configASSERT( xDone );
+
+	printf( "bench=suite tick_us=%lu samples=%lu\n", ulBenchTickPeriodUs, ulSamples );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, ( void * ) pcCase, benchCONTROL_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
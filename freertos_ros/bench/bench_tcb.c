@@ -0,0 +1,382 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> context switch and tick costs, TCBs from a slab against the heap
+ */
+
+/*
+ * The cost of the context switches and of the ticks of the kernel, with the
+ * hardware counters of the host when the kernel lets the process read them.
+ *
+ *   bench_tcb [-t <tick us>] switch [<tasks>] [<duration in ticks>]
+ *   bench_tcb [-t <tick us>] tick [<tasks>] [<rounds>]
+ *
+ * switch  <tasks> tasks of the same priority yield to each other in turn.  The
+ *         switches per second and the cost of a switch are reported.
+ * tick    <tasks> tasks delay for benchPERIOD ticks, and a task of a higher
+ *         priority moves the tick count on benchPERIOD ticks at a time with
+ *         xTaskIncrementTick() in a critical section, which wakes them all.
+ *         The cost of a tick and the cost of the wake of a task (the ticks
+ *         divided by the tasks woken) are reported.
+ *
+ * bench_tcb takes the TCBs from slabs of cache aligned TCBs
+ * (configUSE_TCB_SLAB), bench_tcb_heap from the heap, where each TCB sits
+ * next to the stack of its task.  The distance between the TCBs of two tasks
+ * created in turn and the share of TCBs that start on a cache line are
+ * reported with the costs.
+ *
+ * The counters are the cycles, instructions, cache misses and level 1 data
+ * cache read misses of all the threads of the process, over the switches or
+ * over the ticks only, per switch or per wake.  perf=unavailable is reported
+ * when perf_event_open() fails, as it does with a kernel.perf_event_paranoid
+ * above 2 or in most containers.  A switch of the Linux port is a signal to
+ * one thread and a wait of another, which the counters of a switch include.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION		2000
+#define benchDEFAULT_ROUNDS			200
+#define benchMAX_TASKS				1000
+#define benchPERIOD					( ( TickType_t ) 100 )
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+#define benchCOUNTERS				4
+
+typedef enum
+{
+	eBenchSwitch,
+	eBenchTick
+} BenchMode_t;
+
+static const char * const pcModes[] = { "switch", "tick" };
+
+static const struct
+{
+	uint32_t ulType;
+	uint64_t ullConfig;
+	const char *pcName;
+} xCounters[ benchCOUNTERS ] =
+{
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "cache_misses" },
+	{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ), "l1d_misses" }
+};
+
+static BenchMode_t eMode;
+static long lTasks;
+static long lDuration;
+
+static int iCounterFds[ benchCOUNTERS ];
+static BaseType_t xCountersOpen = pdFALSE;
+
+static TaskHandle_t xTasks[ benchMAX_TASKS ];
+
+static volatile unsigned long ulSwitches;
+static volatile unsigned long ulWakes;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvOpenCounters( void )
+{
+struct perf_event_attr xAttributes;
+long x;
+
+	/* Opened by the first thread before it creates the others, the counters
+	count the threads of the tasks too. */
+	for( x = 0; x < benchCOUNTERS; x++ )
+	{
+		memset( &xAttributes, 0, sizeof( xAttributes ) );
+		xAttributes.size = sizeof( xAttributes );
+		xAttributes.type = xCounters[ x ].ulType;
+		xAttributes.config = xCounters[ x ].ullConfig;
+		xAttributes.disabled = 1;
+		xAttributes.inherit = 1;
+		xAttributes.exclude_kernel = 1;
+		xAttributes.exclude_hv = 1;
+
+		iCounterFds[ x ] = ( int ) syscall( __NR_perf_event_open, &xAttributes, 0, -1, -1, 0 );
+
+		if( iCounterFds[ x ] < 0 )
+		{
+			while( x > 0 )
+			{
+				x--;
+				close( iCounterFds[ x ] );
+			}
+
+			return;
+		}
+	}
+
+	xCountersOpen = pdTRUE;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvCountersEnable( BaseType_t xEnable )
+{
+long x;
+
+	if( xCountersOpen != pdFALSE )
+	{
+		for( x = 0; x < benchCOUNTERS; x++ )
+		{
+			( void ) ioctl( iCounterFds[ x ], ( xEnable != pdFALSE ) ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0 );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvPrintCounters( unsigned long ulEvents )
+{
+uint64_t ullValue;
+long x;
+
+	if( xCountersOpen == pdFALSE )
+	{
+		printf( " perf=unavailable" );
+		return;
+	}
+
+	for( x = 0; x < benchCOUNTERS; x++ )
+	{
+		/* The sum of the counter of this thread and of the threads created
+		after it was opened. */
+		if( read( iCounterFds[ x ], &ullValue, sizeof( ullValue ) ) != ( ssize_t ) sizeof( ullValue ) )
+		{
+			ullValue = 0;
+		}
+
+		printf( " %s=%.1f", xCounters[ x ].pcName, ( ulEvents != 0 ) ? ( double ) ullValue / ( double ) ulEvents : 0.0 );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvPrintLayout( void )
+{
+uintptr_t uxLow = UINTPTR_MAX, uxHigh = 0, uxTCB;
+unsigned long ulAligned = 0;
+long x;
+
+	for( x = 0; x < lTasks; x++ )
+	{
+		uxTCB = ( uintptr_t ) xTasks[ x ];
+
+		if( uxTCB < uxLow )
+		{
+			uxLow = uxTCB;
+		}
+
+		if( uxTCB > uxHigh )
+		{
+			uxHigh = uxTCB;
+		}
+
+		if( ( uxTCB % ( uintptr_t ) portCACHE_LINE_SIZE ) == 0 )
+		{
+			ulAligned++;
+		}
+	}
+
+	printf( " tcb_bytes=%lu tcb_stride=%.0f tcb_aligned=%.2f",
+			( unsigned long ) sizeof( StaticTask_t ),
+			( lTasks > 1 ) ? ( double ) ( uxHigh - uxLow ) / ( double ) ( lTasks - 1 ) : 0.0,
+			( double ) ulAligned / ( double ) lTasks );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulSwitches++;
+		taskYIELD();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvDelayTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( benchPERIOD );
+		ulWakes++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWaitAllDelayed( void )
+{
+long x;
+
+	for( x = 0; x < lTasks; x++ )
+	{
+		while( eTaskGetState( xTasks[ x ] ) != eBlocked )
+		{
+			vTaskDelay( 1 );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static unsigned long prvSwitchMonitor( void )
+{
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulStart, ulCount;
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 10 );
+
+	ulStart = ulSwitches;
+	ullStartNs = ullBenchNowNs();
+	prvCountersEnable( pdTRUE );
+
+	vTaskDelay( ( TickType_t ) lDuration );
+
+	prvCountersEnable( pdFALSE );
+	ullWallNs = ullBenchNowNs() - ullStartNs;
+	ulCount = ulSwitches - ulStart;
+
+	printf( "bench=tcb mode=switch slab=%d tasks=%ld tick_us=%lu switches_per_s=%.0f switch_ns=%.0f",
+			configUSE_TCB_SLAB,
+			lTasks,
+			ulBenchTickPeriodUs,
+			( ( double ) ulCount * 1e9 ) / ( double ) ullWallNs,
+			( ulCount != 0 ) ? ( double ) ullWallNs / ( double ) ulCount : 0.0 );
+
+	return ulCount;
+}
+/*----------------------------------------------------------------------------*/
+
+static unsigned long prvTickMonitor( void )
+{
+uint64_t ullStartNs, ullTickNs = 0;
+unsigned long ulWoken = 0, ulTicks = 0, ulBefore;
+long lRound;
+TickType_t x;
+
+	for( lRound = 0; lRound < lDuration; lRound++ )
+	{
+		/* Let the tasks woken by the last round run and delay again. */
+		prvWaitAllDelayed();
+		ulBefore = ulWakes;
+
+		prvCountersEnable( pdTRUE );
+
+		taskENTER_CRITICAL();
+		{
+			/* The tasks woken are moved to the ready list, but do not run
+			before this task delays. */
+			ullStartNs = ullBenchNowNs();
+
+			for( x = 0; x < benchPERIOD; x++ )
+			{
+				( void ) xTaskIncrementTick();
+			}
+
+			ullTickNs += ullBenchNowNs() - ullStartNs;
+		}
+		taskEXIT_CRITICAL();
+
+		prvCountersEnable( pdFALSE );
+
+		ulTicks += ( unsigned long ) benchPERIOD;
+
+		vTaskDelay( 1 );
+		prvWaitAllDelayed();
+		ulWoken += ulWakes - ulBefore;
+	}
+
+	printf( "bench=tcb mode=tick slab=%d tasks=%ld tick_us=%lu wakes_per_tick=%.2f tick_ns=%.0f wake_ns=%.1f",
+			configUSE_TCB_SLAB,
+			lTasks,
+			ulBenchTickPeriodUs,
+			( double ) ulWoken / ( double ) ulTicks,
+			( double ) ullTickNs / ( double ) ulTicks,
+			( ulWoken != 0 ) ? ( double ) ullTickNs / ( double ) ulWoken : 0.0 );
+
+	return ulWoken;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+unsigned long ulEvents;
+
+	( void ) pvParameters;
+
+	/* The switches, or the tasks woken by the ticks. */
+	if( eMode == eBenchSwitch )
+	{
+		ulEvents = prvSwitchMonitor();
+	}
+	else
+	{
+		ulEvents = prvTickMonitor();
+	}
+
+	vTaskSuspendAll();
+	prvPrintLayout();
+	prvPrintCounters( ulEvents );
+	printf( "\n" );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "switch";
+long x;
+
+	for( x = 0; x < ( long ) ( sizeof( pcModes ) / sizeof( pcModes[ 0 ] ) ); x++ )
+	{
+		if( strcmp( pcMode, pcModes[ x ] ) == 0 )
+		{
+			eMode = ( BenchMode_t ) x;
+		}
+	}
+
+	if( eMode == eBenchSwitch )
+	{
+		lTasks = lBenchArgument( 2, 8 );
+		lDuration = lBenchArgument( 3, benchDEFAULT_DURATION );
+	}
+	else
+	{
+		lTasks = lBenchArgument( 2, 512 );
+		lDuration = lBenchArgument( 3, benchDEFAULT_ROUNDS );
+	}
+
+	configASSERT( ( lTasks > 0 ) && ( lTasks <= benchMAX_TASKS ) );
+
+	prvOpenCounters();
+
+	for( x = 0; x < lTasks; x++ )
+	{
+		xTaskCreate( ( eMode == eBenchSwitch ) ? prvYieldTask : prvDelayTask, "Task", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, &( xTasks[ x ] ) );
+		configASSERT( xTasks[ x ] );
+	}
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
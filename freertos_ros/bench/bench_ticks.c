@@ -0,0 +1,235 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> delays and timers over years of a 100 kHz tick
+ */
+
+/*
+ * Tasks delay and timers expire with the periods of a long running node, and
+ * the kernel is run for years of a virtual 100 kHz tick: a tick stands for
+ * 10 us.  Each time every task is blocked, the idle task moves the tick count
+ * on to the next task to wake rather than sleeping (tickless idle, see
+ * vBenchSuppressTicksAndSleep()), so years pass in seconds.
+ *
+ *   bench_ticks [<simulated years>]
+ *
+ * bench_ticks has a 64-bit tick count.  bench_ticks_32 is the same benchmark
+ * with a 32-bit tick count, which wraps every 11.9 hours at 100 kHz.
+ *
+ * The tasks and timer callbacks check they run at the tick they are due, on a
+ * 64-bit time made of the tick count and the number of times it wrapped, and
+ * the number of early wakes (an error) and the latest wake are reported.  A
+ * wake can be a few ticks late when the host tick comes in while the idle task
+ * moves the tick count.  The periods fit in a 32-bit tick count, 6 hours at
+ * most.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define benchVIRTUAL_TICK_HZ		100000ULL
+#define benchMINUTE					( ( TickType_t ) ( 60ULL * benchVIRTUAL_TICK_HZ ) )
+#define benchHOUR					( ( TickType_t ) ( 60ULL * 60ULL * benchVIRTUAL_TICK_HZ ) )
+#define benchYEAR					( 365ULL * 24ULL * 60ULL * 60ULL * benchVIRTUAL_TICK_HZ )
+#define benchMONITOR_PRIORITY		( configMAX_PRIORITIES - 2 )
+#define benchTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+typedef struct BenchPeriod
+{
+	const char *pcName;
+	TickType_t xPeriod;
+	uint64_t ullDue;
+} BenchPeriod_t;
+
+static BenchPeriod_t xTaskPeriods[] =
+{
+	{ "1h", benchHOUR, 0 },
+	{ "6h", 6 * benchHOUR, 0 },
+};
+
+static BenchPeriod_t xTimerPeriods[] =
+{
+	{ "3h", 3 * benchHOUR, 0 },
+	{ "5h", 5 * benchHOUR, 0 },
+};
+
+/* The task that delays relative to when it runs, as vTaskDelay() does. */
+static const TickType_t xRelativeDelay = 45 * benchMINUTE;
+
+static uint64_t ullEndTicks;
+static volatile unsigned long ulTaskWakes;
+static volatile unsigned long ulTimerExpiries;
+static volatile unsigned long ulEarly;
+static volatile uint64_t ullMaxLateTicks;
+
+/*----------------------------------------------------------------------------*/
+
+/* The tick count, with the number of times it wrapped above it. */
+static uint64_t prvVirtualNow( void )
+{
+TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	#if( configUSE_64_BIT_TICKS == 1 )
+		return ( uint64_t ) xTimeOut.xTimeOnEntering;
+	#else
+		return ( ( uint64_t ) xTimeOut.xOverflowCount << 32 ) | ( uint64_t ) xTimeOut.xTimeOnEntering;
+	#endif
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvCheckDue( const uint64_t ullDue )
+{
+const uint64_t ullNow = prvVirtualNow();
+
+	if( ullNow < ullDue )
+	{
+		ulEarly++;
+	}
+	else if( ullNow - ullDue > ullMaxLateTicks )
+	{
+		ullMaxLateTicks = ullNow - ullDue;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+void vBenchSuppressTicksAndSleep( uint64_t ullExpectedIdleTime )
+{
+const TickType_t xExpectedIdleTime = ( TickType_t ) ullExpectedIdleTime;
+
+	/* Called by the idle task with the scheduler suspended.  Instead of
+	sleeping, step the tick count to the tick before the next task wakes and
+	count that tick, which xTaskResumeAll() processes on its way out. */
+	vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+
+	taskENTER_CRITICAL();
+	{
+		( void ) xTaskIncrementTick();
+
+		#if( configUSE_64_BIT_TICKS == 0 )
+		{
+			/* With only tasks in the overflow list, the next wake time is
+			portMAX_DELAY - go on to the tick that wraps. */
+			if( ( TickType_t ) ( xTaskGetTickCount() + ( TickType_t ) 1 ) == portMAX_DELAY )
+			{
+				( void ) xTaskIncrementTick();
+			}
+		}
+		#endif
+	}
+	taskEXIT_CRITICAL();
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+BenchPeriod_t * const pxPeriod = ( BenchPeriod_t * ) pvParameters;
+TickType_t xLastWakeTime = xTaskGetTickCount();
+
+	pxPeriod->ullDue = prvVirtualNow();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, pxPeriod->xPeriod );
+		pxPeriod->ullDue += pxPeriod->xPeriod;
+		prvCheckDue( pxPeriod->ullDue );
+		ulTaskWakes++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRelativeTask( void *pvParameters )
+{
+uint64_t ullDue;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ullDue = prvVirtualNow() + xRelativeDelay;
+		vTaskDelay( xRelativeDelay );
+		prvCheckDue( ullDue );
+		ulTaskWakes++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+BenchPeriod_t * const pxPeriod = ( BenchPeriod_t * ) pvTimerGetTimerID( xTimer );
+
+	pxPeriod->ullDue += pxPeriod->xPeriod;
+	prvCheckDue( pxPeriod->ullDue );
+	ulTimerExpiries++;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs, ullNow;
+TimeOut_t xTimeOut;
+size_t x;
+
+	( void ) pvParameters;
+
+	ullStartNs = ullBenchNowNs();
+
+	for( x = 0; x < sizeof( xTimerPeriods ) / sizeof( xTimerPeriods[ 0 ] ); x++ )
+	{
+		xTimerPeriods[ x ].ullDue = prvVirtualNow();
+		( void ) xTimerStart( xTimerCreate( xTimerPeriods[ x ].pcName, xTimerPeriods[ x ].xPeriod, pdTRUE, &( xTimerPeriods[ x ] ), prvTimerCallback ), portMAX_DELAY );
+	}
+
+	do
+	{
+		vTaskDelay( 6 * benchHOUR );
+		ullNow = prvVirtualNow();
+	} while( ullNow < ullEndTicks );
+
+	ullWallNs = ullBenchNowNs() - ullStartNs;
+
+	vTaskSuspendAll();
+	vTaskSetTimeOutState( &xTimeOut );
+
+	printf( "bench=ticks tick_bits=%u years=%.1f ticks=%llu wraps=%ld task_wakes=%lu timer_expiries=%lu early=%lu max_late_ticks=%llu wall_s=%.1f\n",
+			( unsigned ) ( sizeof( TickType_t ) * 8 ),
+			( double ) ullNow / ( double ) benchYEAR,
+			( unsigned long long ) ullNow,
+			( long ) xTimeOut.xOverflowCount,
+			ulTaskWakes,
+			ulTimerExpiries,
+			ulEarly,
+			( unsigned long long ) ullMaxLateTicks,
+			( double ) ullWallNs / 1e9 );
+
+	configASSERT( ulEarly == 0 );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+size_t x;
+
+	ullEndTicks = ( uint64_t ) lBenchArgument( 1, 10 ) * benchYEAR;
+
+	for( x = 0; x < sizeof( xTaskPeriods ) / sizeof( xTaskPeriods[ 0 ] ); x++ )
+	{
+		xTaskCreate( prvPeriodicTask, xTaskPeriods[ x ].pcName, configMINIMAL_STACK_SIZE, &( xTaskPeriods[ x ] ), benchTASK_PRIORITY, NULL );
+	}
+
+	xTaskCreate( prvRelativeTask, "45min", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> latency of a timer next to slow timer callbacks
+ */
+
+/*
+ * A critical auto reload timer with a 5 tick period shares the kernel with
+ * timers whose callbacks each take several milliseconds.
+ *
+ *   bench_timer_services shared|isolated [<slow callback in ms>] [<slow timers>] [<duration in ticks>]
+ *
+ * shared    Every timer is bound to the first timer service task, as with a
+ *           single timer daemon.
+ * isolated  The slow timers are bound to the second timer service task, at a
+ *           low priority, and the critical timer stays on the first one.
+ *
+ * The latency of the critical callback is measured from the time of the tick
+ * at which it is due, on the host clock that drives the tick.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION	3000
+#define benchCRITICAL_PERIOD	5
+#define benchSLOW_PERIOD		20
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 2 )
+
+static BaseType_t xIsolated;
+static long lSlowMs;
+static long lSlowTimers;
+static long lDuration;
+
+static uint64_t ullFirstNs;
+static TickType_t xFirstTick;
+static TickType_t xExpectedTick;
+static BaseType_t xMeasuring = pdFALSE;
+
+static volatile unsigned long ulCriticalCallbacks;
+static volatile unsigned long ulLateCallbacks;
+static volatile uint64_t ullLatencySumNs;
+static volatile uint64_t ullMaxLatencyNs;
+static volatile unsigned long ulSlowCallbacks;
+
+/*----------------------------------------------------------------------------*/
+
+static void prvCriticalCallback( TimerHandle_t xTimer )
+{
+const uint64_t ullPeriodNs = ( uint64_t ) ulBenchTickPeriodUs * 1000ULL;
+uint64_t ullNowNs = ullBenchNowNs();
+uint64_t ullDueNs, ullLatencyNs;
+
+	( void ) xTimer;
+
+	if( ullFirstNs == 0 )
+	{
+		/* The reference for the time of the following ticks. */
+		ullFirstNs = ullNowNs;
+		xFirstTick = xTaskGetTickCount();
+		xExpectedTick = xFirstTick;
+	}
+
+	ullDueNs = ullFirstNs + ( ( uint64_t ) ( TickType_t ) ( xExpectedTick - xFirstTick ) * ullPeriodNs );
+	ullLatencyNs = ( ullNowNs > ullDueNs ) ? ( ullNowNs - ullDueNs ) : 0;
+	xExpectedTick += benchCRITICAL_PERIOD;
+
+	if( xMeasuring == pdFALSE )
+	{
+		return;
+	}
+
+	ulCriticalCallbacks++;
+	ullLatencySumNs += ullLatencyNs;
+
+	if( ullLatencyNs > ullMaxLatencyNs )
+	{
+		ullMaxLatencyNs = ullLatencyNs;
+	}
+
+	if( ullLatencyNs > ullPeriodNs )
+	{
+		ulLateCallbacks++;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSlowCallback( TimerHandle_t xTimer )
+{
+uint64_t ullEndNs = ullBenchNowNs() + ( ( uint64_t ) lSlowMs * 1000000ULL );
+
+	( void ) xTimer;
+
+	/* Busy, as a callback that does real work would be. */
+	while( ullBenchNowNs() < ullEndNs )
+	{
+	}
+
+	ulSlowCallbacks++;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+TimerHandle_t xCritical, xSlow;
+unsigned long ulSlowStart;
+long i;
+
+	( void ) pvParameters;
+
+	xCritical = xTimerCreateForService( "Critical", benchCRITICAL_PERIOD, pdTRUE, NULL, prvCriticalCallback, 0 );
+	configASSERT( xCritical );
+	xTimerStart( xCritical, portMAX_DELAY );
+
+	for( i = 0; i < lSlowTimers; i++ )
+	{
+		/* Spread the slow timers over their period. */
+		xSlow = xTimerCreateForService( "Slow", benchSLOW_PERIOD, pdTRUE, NULL, prvSlowCallback, ( xIsolated != pdFALSE ) ? 1 : 0 );
+		configASSERT( xSlow );
+		vTaskDelay( benchSLOW_PERIOD / lSlowTimers + 1 );
+		xTimerStart( xSlow, portMAX_DELAY );
+	}
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 200 );
+	ulSlowStart = ulSlowCallbacks;
+	xMeasuring = pdTRUE;
+
+	vTaskDelay( ( TickType_t ) lDuration );
+
+	xMeasuring = pdFALSE;
+	vTaskSuspendAll();
+	printf( "bench=timer_services mode=%s services=%d slow_ms=%ld slow_timers=%ld ticks=%ld callbacks=%lu mean_latency_us=%.1f max_latency_us=%.1f late=%lu slow_callbacks=%lu\n",
+			( xIsolated != pdFALSE ) ? "isolated" : "shared",
+			configTIMER_SERVICE_TASKS,
+			lSlowMs,
+			lSlowTimers,
+			lDuration,
+			ulCriticalCallbacks,
+			( ulCriticalCallbacks != 0 ) ? ( ( double ) ullLatencySumNs / ( 1000.0 * ( double ) ulCriticalCallbacks ) ) : 0.0,
+			( double ) ullMaxLatencyNs / 1000.0,
+			ulLateCallbacks,
+			ulSlowCallbacks - ulSlowStart );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "isolated";
+
+	xIsolated = ( strcmp( pcMode, "shared" ) == 0 ) ? pdFALSE : pdTRUE;
+	lSlowMs = lBenchArgument( 2, 5 );
+	lSlowTimers = lBenchArgument( 3, 1 );
+	lDuration = lBenchArgument( 4, benchDEFAULT_DURATION );
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
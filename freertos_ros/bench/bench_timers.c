@@ -0,0 +1,220 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> CPU time of the timer service task
+ */
+
+/*
+ * Measures the CPU time of the timer service task, and of the task that
+ * sends it commands, with many active timers.
+ *
+ *   bench_timers reset|reset-bulk|expire <timers> [<duration in ticks>]
+ *
+ * reset       Watchdog timers with a 100 tick period.  A feeder task resets
+ *             every one of them each 10 ticks with xTimerReset(), so they
+ *             never expire.
+ * reset-bulk  The same with a single xTimerResetBulk() per cycle.
+ * expire      Auto reload timers with periods from 10 to 100 ticks that
+ *             nobody resets, so the cost is in expiry processing.
+ *
+ * CPU time is the thread CPU clock of each task's pthread, read from the
+ * task itself; the timer service task reads it in a pended function call.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_DURATION	2000
+#define benchWATCHDOG_PERIOD	100
+#define benchFEED_PERIOD		10
+#define benchFEEDER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 2 )
+
+typedef enum
+{
+	eBenchReset,
+	eBenchResetBulk,
+	eBenchExpire
+} eBenchMode;
+
+static eBenchMode eMode;
+static long lTimers;
+static long lDuration;
+
+static TimerHandle_t *pxTimers;
+static volatile unsigned long ulCallbacks;
+static volatile unsigned long ulCycles;
+
+static volatile uint64_t ullDaemonCpuNs;
+static volatile uint64_t ullFeederCpuNs;
+static volatile BaseType_t xSampled;
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t prvThreadCpuNs( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_THREAD_CPUTIME_ID, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSampleDaemonCpu( void *pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+	( void ) ulParameter2;
+
+	ullDaemonCpuNs = prvThreadCpuNs();
+	xSampled = pdTRUE;
+}
+/*----------------------------------------------------------------------------*/
+
+static uint64_t prvGetDaemonCpuNs( void )
+{
+	xSampled = pdFALSE;
+	xTimerPendFunctionCall( prvSampleDaemonCpu, NULL, 0, portMAX_DELAY );
+
+	/* The timer service task has the higher priority. */
+	while( xSampled == pdFALSE )
+	{
+		vTaskDelay( 1 );
+	}
+
+	return ullDaemonCpuNs;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	ulCallbacks++;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvFeederTask( void *pvParameters )
+{
+TickType_t xLastWakeTime = xTaskGetTickCount();
+uint64_t ullStart = prvThreadCpuNs();
+long i;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, benchFEED_PERIOD );
+
+		if( eMode == eBenchResetBulk )
+		{
+			xTimerResetBulk( pxTimers, ( UBaseType_t ) lTimers, portMAX_DELAY );
+		}
+		else
+		{
+			for( i = 0; i < lTimers; i++ )
+			{
+				xTimerReset( pxTimers[ i ], portMAX_DELAY );
+			}
+		}
+
+		ulCycles++;
+		ullFeederCpuNs = prvThreadCpuNs() - ullStart;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+uint64_t ullStartNs, ullWallNs, ullDaemonStart, ullDaemonNs, ullFeederStart;
+unsigned long ulCallbacksStart, ulCyclesStart;
+TickType_t xPeriod;
+long i;
+
+	( void ) pvParameters;
+
+	pxTimers = ( TimerHandle_t * ) pvPortMalloc( sizeof( TimerHandle_t ) * ( size_t ) lTimers );
+	configASSERT( pxTimers );
+
+	for( i = 0; i < lTimers; i++ )
+	{
+		if( eMode == eBenchExpire )
+		{
+			xPeriod = ( TickType_t ) ( 10 + ( ( i * 7919 ) % 91 ) );
+		}
+		else
+		{
+			xPeriod = benchWATCHDOG_PERIOD;
+		}
+
+		pxTimers[ i ] = xTimerCreate( "T", xPeriod, ( eMode == eBenchExpire ) ? pdTRUE : pdFALSE, NULL, prvTimerCallback );
+		configASSERT( pxTimers[ i ] );
+	}
+
+	/* Start them in bulk, the single command queue is short. */
+	xTimerStartBulk( pxTimers, ( UBaseType_t ) lTimers, portMAX_DELAY );
+
+	if( eMode != eBenchExpire )
+	{
+		xTaskCreate( prvFeederTask, "Feeder", configMINIMAL_STACK_SIZE, NULL, benchFEEDER_PRIORITY, NULL );
+	}
+
+	/* Leave the start up out of the measurement. */
+	vTaskDelay( 200 );
+
+	ullFeederStart = ullFeederCpuNs;
+	ulCallbacksStart = ulCallbacks;
+	ulCyclesStart = ulCycles;
+	ullDaemonStart = prvGetDaemonCpuNs();
+	ullStartNs = ullBenchNowNs();
+
+	vTaskDelay( ( TickType_t ) lDuration );
+
+	ullDaemonNs = prvGetDaemonCpuNs() - ullDaemonStart;
+	ullWallNs = ullBenchNowNs() - ullStartNs;
+
+	vTaskSuspendAll();
+	printf( "bench=timers mode=%s timers=%ld wheel=%d ticks=%ld daemon_cpu_pct=%.2f feeder_cpu_pct=%.2f callbacks=%lu cycles=%lu\n",
+			( eMode == eBenchReset ) ? "reset" : ( ( eMode == eBenchResetBulk ) ? "reset-bulk" : "expire" ),
+			lTimers,
+			configUSE_TIMING_WHEEL,
+			lDuration,
+			( 100.0 * ( double ) ullDaemonNs ) / ( double ) ullWallNs,
+			( 100.0 * ( double ) ( ullFeederCpuNs - ullFeederStart ) ) / ( double ) ullWallNs,
+			ulCallbacks - ulCallbacksStart,
+			ulCycles - ulCyclesStart );
+
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "reset";
+
+	if( strcmp( pcMode, "reset-bulk" ) == 0 )
+	{
+		eMode = eBenchResetBulk;
+	}
+	else if( strcmp( pcMode, "expire" ) == 0 )
+	{
+		eMode = eBenchExpire;
+	}
+	else
+	{
+		eMode = eBenchReset;
+	}
+
+	lTimers = lBenchArgument( 2, 1000 );
+	lDuration = lBenchArgument( 3, benchDEFAULT_DURATION );
+
+	xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
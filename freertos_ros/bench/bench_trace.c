@@ -0,0 +1,335 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> recording the scheduling and replaying it
+ */
+
+/*
+ * Built with configPORT_TRACE set to 1, see ros/portable/port_trace.h.
+ *
+ *   bench_trace [-t <tick us>] switch off|record [<switches>]
+ *   bench_trace [-t <tick us>] workload record|replay <file> [<messages>]
+ *   bench_trace dump <file>
+ *
+ * switch    Two tasks of the same priority yield to each other, with the trace
+ *           off or recording: the cost of a switch and of its record.
+ * workload  Worker tasks of one priority, time sliced by the tick, spin for a
+ *           pseudo random number of iterations and send the result to a
+ *           consumer task, now and then after a delay.  A host thread passes
+ *           data taken from the host clock to the consumer from a simulated
+ *           interrupt, as a ROS callback would.  The consumer hashes the
+ *           messages in the order it receives them, so the hash depends on
+ *           how the tasks interleaved, and ends the run after <messages>.
+ *           Recorded then replayed, the run reports the same hash and no
+ *           divergence.
+ * dump      Prints the records of a trace file.
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "port.h"
+#include "port_trace.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_SWITCHES		20000
+#define benchDEFAULT_MESSAGES		3000
+#define benchWORKERS				4
+#define benchSPIN_MIN				2000
+#define benchSPIN_RANGE				20000
+#define benchINPUT_PERIOD_US		300
+#define benchQUEUE_LENGTH			16
+#define benchCONSUMER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define benchWORKER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+typedef struct BENCH_MESSAGE
+{
+	uint32_t ulSource;			/* A worker, or benchWORKERS for the host thread. */
+	uint32_t ulValue;
+} BenchMessage_t;
+
+static const char *pcMode;
+static long lCount;
+static QueueHandle_t xQueue;
+
+static volatile unsigned long ulSwitches;
+static volatile BaseType_t xSwitching = pdTRUE;
+
+/*----------------------------------------------------------------------------*/
+
+static uint32_t prvNext( uint32_t *pulState )
+{
+	*pulState = ( *pulState * 1664525UL ) + 1013904223UL;
+	return *pulState;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	while( xSwitching != pdFALSE )
+	{
+		ulSwitches++;
+		taskYIELD();
+	}
+
+	vTaskSuspend( NULL );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSwitchMonitorTask( void *pvParameters )
+{
+PortTraceStats_t xStats;
+uint64_t ullStartNs, ullWallNs;
+unsigned long ulDone;
+
+	( void ) pvParameters;
+
+	ullStartNs = ullBenchNowNs();
+	while( ulSwitches < ( unsigned long ) lCount )
+	{
+		vTaskDelay( 1 );
+	}
+	ullWallNs = ullBenchNowNs() - ullStartNs;
+	ulDone = ulSwitches;
+	xSwitching = pdFALSE;
+
+	vPortGetTraceStats( &xStats );
+
+	printf( "bench=trace mode=switch trace=%s switches=%lu switch_ns=%.0f records=%lu record_bytes=%lu dropped=%lu\n",
+			pcMode,
+			ulDone,
+			( double ) ullWallNs / ( double ) ulDone,
+			xStats.ulRecords,
+			xStats.ulRecords * ( unsigned long ) sizeof( PortTraceRecord_t ),
+			xStats.ulDroppedRecords );
+
+	( void ) xPortTraceStop();
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+BenchMessage_t xMessage;
+uint32_t ulState = ( uint32_t ) ( uintptr_t ) pvParameters;
+volatile uint32_t ulSpin;
+uint32_t x, ulSpins;
+
+	xMessage.ulSource = ( uint32_t ) ( uintptr_t ) pvParameters;
+
+	for( ;; )
+	{
+		/* Work that the tick cuts at any point: it makes no kernel call. */
+		ulSpins = benchSPIN_MIN + ( prvNext( &ulState ) % benchSPIN_RANGE );
+		for( x = 0, ulSpin = 0; x < ulSpins; x++ )
+		{
+			ulSpin = ulSpin + x;
+		}
+
+		xMessage.ulValue = prvNext( &ulState );
+		configASSERT( xQueueSend( xQueue, &xMessage, portMAX_DELAY ) == pdPASS );
+
+		if( ( xMessage.ulValue & 0x7U ) == 0 )
+		{
+			vTaskDelay( 1 );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvInputHandler( void *pvParameter )
+{
+BenchMessage_t *pxMessage = ( BenchMessage_t * ) pvParameter;
+BaseType_t xWoken = pdFALSE;
+
+	/* Replaying, the data are the recorded ones. */
+	( void ) xPortTraceInput( pxMessage, sizeof( *pxMessage ) );
+	( void ) xQueueSendFromISR( xQueue, pxMessage, &xWoken );
+
+	return xWoken;
+}
+/*----------------------------------------------------------------------------*/
+
+static void *prvInputThread( void *pvParameters )
+{
+BenchMessage_t xMessage;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		usleep( benchINPUT_PERIOD_US );
+
+		/* Different from run to run. */
+		xMessage.ulSource = benchWORKERS;
+		xMessage.ulValue = ( uint32_t ) ullBenchNowNs();
+		vPortRunAsInterrupt( prvInputHandler, &xMessage );
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+PortTraceStats_t xStats;
+BenchMessage_t xMessage;
+uint64_t ullHash = 14695981039346656037ULL;
+unsigned long ulMessages = 0, ulInputs = 0;
+uint64_t ullStartNs;
+pthread_t xInputThread;
+
+	( void ) pvParameters;
+
+	/* The interrupts before the first task runs would not be in the trace. */
+	pthread_create( &xInputThread, NULL, prvInputThread, NULL );
+
+	ullStartNs = ullBenchNowNs();
+
+	while( ulMessages < ( unsigned long ) lCount )
+	{
+		configASSERT( xQueueReceive( xQueue, &xMessage, portMAX_DELAY ) == pdPASS );
+
+		/* FNV-1a over the messages in the order received. */
+		ullHash = ( ullHash ^ xMessage.ulSource ) * 1099511628211ULL;
+		ullHash = ( ullHash ^ xMessage.ulValue ) * 1099511628211ULL;
+		ulMessages++;
+		if( xMessage.ulSource == benchWORKERS )
+		{
+			ulInputs++;
+		}
+	}
+
+	vTaskSuspendAll();
+
+	vPortGetTraceStats( &xStats );
+
+	printf( "bench=trace mode=workload trace=%s messages=%lu inputs=%lu ticks=%lu ms=%.0f hash=0x%016llx records=%lu dropped=%lu replayed_inputs=%lu checked_decisions=%lu divergences=%lu diverged_record=%lu\n",
+			pcMode,
+			ulMessages,
+			ulInputs,
+			( unsigned long ) xTaskGetTickCount(),
+			( double ) ( ullBenchNowNs() - ullStartNs ) / 1e6,
+			( unsigned long long ) ullHash,
+			xStats.ulRecords,
+			xStats.ulDroppedRecords,
+			xStats.ulReplayedInputs,
+			xStats.ulCheckedDecisions,
+			xStats.ulDivergences,
+			xStats.ulDivergedRecord );
+
+	( void ) xPortTraceStop();
+	exit( 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvDump( const char *pcPath )
+{
+static const char * const pcTypes[] = { "none", "switch", "block", "tick", "interrupt", "input" };
+PortTraceHeader_t xHeader;
+PortTraceRecord_t xRecord;
+unsigned long ulCounts[ 6 ] = { 0 };
+uint32_t ulIndex;
+FILE *pxFile = fopen( pcPath, "rb" );
+
+	configASSERT( pxFile != NULL );
+	configASSERT( fread( &xHeader, sizeof( xHeader ), 1, pxFile ) == 1 );
+	configASSERT( ( xHeader.ulMagic == portTRACE_MAGIC ) && ( xHeader.usRecordSize == sizeof( xRecord ) ) );
+
+	for( ulIndex = 0; ulIndex < xHeader.ulRecords; ulIndex++ )
+	{
+		configASSERT( fread( &xRecord, sizeof( xRecord ), 1, pxFile ) == 1 );
+
+		if( xRecord.ucType > portTRACE_INPUT )
+		{
+			continue;
+		}
+
+		ulCounts[ xRecord.ucType ]++;
+		printf( "%lu %s detail=%u task=%u entry=%lu time_ns=%lu value=0x%lx\n",
+				( unsigned long ) ulIndex,
+				pcTypes[ xRecord.ucType ],
+				( unsigned ) xRecord.ucDetail,
+				( unsigned ) xRecord.usTask,
+				( unsigned long ) xRecord.ulEntry,
+				( unsigned long ) xRecord.ulTimeNs,
+				( unsigned long ) xRecord.ulValue );
+
+		/* The data of an input, not records. */
+		if( xRecord.ucType == portTRACE_INPUT )
+		{
+			ulIndex += ( uint32_t ) portTRACE_INPUT_RECORDS( xRecord.ulValue );
+			configASSERT( fseek( pxFile, ( long ) ( portTRACE_INPUT_RECORDS( xRecord.ulValue ) * sizeof( xRecord ) ), SEEK_CUR ) == 0 );
+		}
+	}
+
+	fclose( pxFile );
+
+	printf( "bench=trace mode=dump records=%lu tick_rate_hz=%lu switches=%lu blocks=%lu ticks=%lu interrupts=%lu inputs=%lu\n",
+			( unsigned long ) xHeader.ulRecords,
+			( unsigned long ) xHeader.ulTickRateHz,
+			ulCounts[ portTRACE_SWITCH ],
+			ulCounts[ portTRACE_BLOCK ],
+			ulCounts[ portTRACE_TICK ],
+			ulCounts[ portTRACE_INTERRUPT ],
+			ulCounts[ portTRACE_INPUT ] );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcBench = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "workload";
+long x;
+
+	pcMode = ( iBenchArgc > 2 ) ? ppcBenchArgv[ 2 ] : "record";
+
+	if( strcmp( pcBench, "dump" ) == 0 )
+	{
+		configASSERT( iBenchArgc > 2 );
+		prvDump( ppcBenchArgv[ 2 ] );
+		exit( 0 );
+	}
+
+	if( strcmp( pcBench, "switch" ) == 0 )
+	{
+		lCount = lBenchArgument( 3, benchDEFAULT_SWITCHES );
+
+		if( strcmp( pcMode, "record" ) == 0 )
+		{
+			configASSERT( xPortTraceStart( ePortTraceRecord, "/dev/null" ) == pdPASS );
+		}
+
+		xTaskCreate( prvYieldTask, "Yield", configMINIMAL_STACK_SIZE, NULL, benchWORKER_PRIORITY, NULL );
+		xTaskCreate( prvYieldTask, "Yield", configMINIMAL_STACK_SIZE, NULL, benchWORKER_PRIORITY, NULL );
+		xTaskCreate( prvSwitchMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchCONSUMER_PRIORITY, NULL );
+	}
+	else
+	{
+		configASSERT( iBenchArgc > 3 );
+		lCount = lBenchArgument( 4, benchDEFAULT_MESSAGES );
+
+		configASSERT( xPortTraceStart( ( strcmp( pcMode, "replay" ) == 0 ) ? ePortTraceReplay : ePortTraceRecord, ppcBenchArgv[ 3 ] ) == pdPASS );
+
+		xQueue = xQueueCreate( benchQUEUE_LENGTH, sizeof( BenchMessage_t ) );
+		configASSERT( xQueue );
+
+		for( x = 0; x < benchWORKERS; x++ )
+		{
+			xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchWORKER_PRIORITY, NULL );
+		}
+
+		xTaskCreate( prvConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, NULL, benchCONSUMER_PRIORITY, NULL );
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
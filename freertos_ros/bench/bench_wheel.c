@@ -0,0 +1,288 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	bench --> timing wheel against the sorted delayed lists
+ */
+
+/*
+ * Three modes:
+ *
+ *   bench_wheel lists <sleepers> [<max delay in ticks>]
+ *     Inserts the sleepers with random delays, then expires them tick by
+ *     tick, once with a sorted List_t as the kernel does without the wheel
+ *     and once with the wheel and its sorted list for the far items.  The
+ *     scheduler is not started: the port cannot run more than a few dozen
+ *     threads, so a hundred thousand sleepers are only possible as list
+ *     items.  Needs configUSE_TIMING_WHEEL, the other two modes compare
+ *     the kernel with and without it.
+ *
+ *   bench_wheel tasks <tasks> [<max delay>] [<duration in ticks>]
+ *     Tasks that sleep for random delays and check that they never wake
+ *     before their time.
+ *
+ *   bench_wheel timers <timers> [<max period>] [<duration in ticks>]
+ *     Auto reload timers with random periods, checked the same way in the
+ *     callback.
+ */
+
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_MAX_DELAY	10000
+#define benchDEFAULT_DURATION	3000
+#define benchMONITOR_PRIORITY	( configMAX_PRIORITIES - 2 )
+#define benchSLEEPER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+
+static long lCount;
+static long lMaxDelay;
+static long lDuration;
+
+static volatile unsigned long ulWakeUps;
+static volatile unsigned long ulEarly;
+static volatile unsigned long ulLate;
+static volatile TickType_t xMaxLateness;
+
+static uint32_t ulSeed = 0x12345678UL;
+
+/*----------------------------------------------------------------------------*/
+
+static TickType_t prvRandomDelay( void )
+{
+	/* xorshift32, the same sequence for both list structures. */
+	ulSeed ^= ulSeed << 13;
+	ulSeed ^= ulSeed >> 17;
+	ulSeed ^= ulSeed << 5;
+	return ( TickType_t ) ( 1 + ( ulSeed % ( uint32_t ) lMaxDelay ) );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvRecordWakeUp( TickType_t xExpected, TickType_t xNow )
+{
+TickType_t xLateness;
+
+	ulWakeUps++;
+
+	if( ( int32_t ) ( xNow - xExpected ) < 0 )
+	{
+		ulEarly++;
+	}
+	else if( xNow != xExpected )
+	{
+		xLateness = xNow - xExpected;
+		ulLate++;
+		if( xLateness > xMaxLateness )
+		{
+			xMaxLateness = xLateness;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+#if( configUSE_TIMING_WHEEL == 1 )
+
+static void prvBenchLists( void )
+{
+static List_t xSorted, xFar;
+static ListWheel_t xWheel;
+ListItem_t *pxItems;
+List_t *pxExpired;
+TickType_t xNow, xEnd;
+uint64_t ullStart, ullInsertNs, ullExpireNs;
+unsigned long ulExpired;
+long i;
+int iPass;
+
+	pxItems = ( ListItem_t * ) pvPortMalloc( sizeof( ListItem_t ) * ( size_t ) lCount );
+	configASSERT( pxItems );
+
+	for( iPass = 0; iPass < 2; iPass++ )
+	{
+		ulSeed = 0x12345678UL;
+		ulExpired = 0;
+		xEnd = ( TickType_t ) lMaxDelay;
+
+		vListInitialise( &xSorted );
+		vListInitialise( &xFar );
+		vListWheelInitialise( &xWheel, 0 );
+
+		for( i = 0; i < lCount; i++ )
+		{
+			vListInitialiseItem( &( pxItems[ i ] ) );
+			listSET_LIST_ITEM_VALUE( &( pxItems[ i ] ), prvRandomDelay() );
+		}
+
+		ullStart = ullBenchNowNs();
+		for( i = 0; i < lCount; i++ )
+		{
+			if( iPass == 0 )
+			{
+				vListInsert( &xSorted, &( pxItems[ i ] ) );
+			}
+			else if( xListWheelInsert( &xWheel, &( pxItems[ i ] ) ) == pdFAIL )
+			{
+				vListInsert( &xFar, &( pxItems[ i ] ) );
+			}
+		}
+		ullInsertNs = ullBenchNowNs() - ullStart;
+
+		ullStart = ullBenchNowNs();
+		for( xNow = 1; xNow <= xEnd; xNow++ )
+		{
+			if( iPass == 0 )
+			{
+				/* What xTaskIncrementTick() does with the delayed list. */
+				while( ( listLIST_IS_EMPTY( &xSorted ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xSorted ) <= xNow ) )
+				{
+					( void ) uxListRemove( listGET_HEAD_ENTRY( &xSorted ) );
+					ulExpired++;
+				}
+			}
+			else
+			{
+				vListWheelMigrate( &xWheel, &xFar );
+				pxExpired = pxListWheelAdvance( &xWheel );
+
+				while( listLIST_IS_EMPTY( pxExpired ) == pdFALSE )
+				{
+					( void ) uxListRemove( listGET_HEAD_ENTRY( pxExpired ) );
+					ulExpired++;
+				}
+			}
+		}
+		ullExpireNs = ullBenchNowNs() - ullStart;
+
+		configASSERT( ulExpired == ( unsigned long ) lCount );
+
+		printf( "bench=wheel mode=lists list=%s sleepers=%ld max_delay=%ld insert_ns=%.1f expire_ns=%.1f tick_ns=%.1f\n",
+				( iPass == 0 ) ? "sorted" : "wheel",
+				lCount,
+				lMaxDelay,
+				( double ) ullInsertNs / ( double ) lCount,
+				( double ) ullExpireNs / ( double ) lCount,
+				( double ) ullExpireNs / ( double ) xEnd );
+	}
+
+	vPortFree( pxItems );
+}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*----------------------------------------------------------------------------*/
+
+static void prvSleeperTask( void *pvParameters )
+{
+TickType_t xDelay, xExpected;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		xDelay = prvRandomDelay();
+		taskEXIT_CRITICAL();
+
+		xExpected = xTaskGetTickCount() + xDelay;
+		vTaskDelay( xDelay );
+		prvRecordWakeUp( xExpected, xTaskGetTickCount() );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+TickType_t *pxExpected = ( TickType_t * ) pvTimerGetTimerID( xTimer );
+
+	prvRecordWakeUp( *pxExpected, xTaskGetTickCount() );
+	*pxExpected += xTimerGetPeriod( xTimer );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvMonitorTask( void *pvParameters )
+{
+TimerHandle_t xTimer;
+TickType_t *pxExpected;
+TickType_t xStart;
+BaseType_t xResult;
+int iTimers = ( pvParameters != NULL ) ? 1 : 0;
+long i;
+
+	if( iTimers != 0 )
+	{
+		pxExpected = ( TickType_t * ) pvPortMalloc( sizeof( TickType_t ) * ( size_t ) lCount );
+		configASSERT( pxExpected );
+
+		/* Start the timers from a task, the command queue is short.  The
+		daemon has the higher priority and empties it at each resume. */
+		for( i = 0; i < lCount; i++ )
+		{
+			xTimer = xTimerCreate( "W", prvRandomDelay(), pdTRUE, &( pxExpected[ i ] ), prvTimerCallback );
+			configASSERT( xTimer );
+
+			vTaskSuspendAll();
+			pxExpected[ i ] = xTaskGetTickCount() + xTimerGetPeriod( xTimer );
+			xResult = xTimerStart( xTimer, 0 );
+			( void ) xTaskResumeAll();
+			configASSERT( xResult == pdPASS );
+		}
+	}
+
+	xStart = xTaskGetTickCount();
+	vTaskDelay( ( TickType_t ) lDuration );
+
+	vTaskSuspendAll();
+	printf( "bench=wheel mode=%s count=%ld max_delay=%ld ticks=%lu wakeups=%lu early=%lu late=%lu max_late=%lu\n",
+			( iTimers != 0 ) ? "timers" : "tasks",
+			lCount,
+			lMaxDelay,
+			( unsigned long ) ( xTaskGetTickCount() - xStart ),
+			ulWakeUps,
+			ulEarly,
+			ulLate,
+			( unsigned long ) xMaxLateness );
+
+	exit( ( ulEarly == 0 ) ? 0 : 1 );
+}
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+const char *pcMode = ( iBenchArgc > 1 ) ? ppcBenchArgv[ 1 ] : "lists";
+long i;
+
+	#if( configUSE_TIMING_WHEEL == 1 )
+	if( strcmp( pcMode, "lists" ) == 0 )
+	{
+		lCount = lBenchArgument( 2, 10000 );
+		lMaxDelay = lBenchArgument( 3, benchDEFAULT_MAX_DELAY );
+		prvBenchLists();
+		exit( 0 );
+	}
+	#endif
+
+	lCount = lBenchArgument( 2, ( strcmp( pcMode, "tasks" ) == 0 ) ? 32 : 1000 );
+	lMaxDelay = lBenchArgument( 3, 100 );
+	lDuration = lBenchArgument( 4, benchDEFAULT_DURATION );
+
+	if( strcmp( pcMode, "tasks" ) == 0 )
+	{
+		for( i = 0; i < lCount; i++ )
+		{
+			xTaskCreate( prvSleeperTask, "Sleeper", configMINIMAL_STACK_SIZE, NULL, benchSLEEPER_PRIORITY, NULL );
+		}
+
+		xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, benchMONITOR_PRIORITY, NULL );
+	}
+	else
+	{
+		xTaskCreate( prvMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 4, ( void * ) 1, benchMONITOR_PRIORITY, NULL );
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,119 @@
+################################################################################
+# Github from gr0mph
+#	https://github.com/gr0mph
+# CMake function to build the kernel and the port for one ROS node
+################################################################################
+
+# freertos_add_kernel(<target>
+#   [CONFIG_DIR <dir>]
+#   [HEAP 1|4]
+#   [TICK_RATE_HZ <hz>]
+#   [MAX_PRIORITIES <priorities>]
+#   [TOTAL_HEAP_SIZE <bytes>]
+#   [DEFINITIONS <macro>=<value> ...]
+#   [SOURCES <file> ...]
+#   [INCLUDE_DIRS <dir> ...])
+#
+# Adds a static library <target> with the kernel and the POSIX port compiled
+# for the node that links it, so that each node has a kernel of its own
+# configuration instead of sharing the one of libfreertos.so.
+#
+# CONFIG_DIR      The directory of the FreeRTOSConfig.h of the node, by default
+#                 freertos_ros/source.  It comes first in the include path, so
+#                 its FreeRTOSConfig.h is the one the kernel, SOURCES and the
+#                 node all see.
+# HEAP            The heap scheme: 1 (ros/portable/heap_1.c, as libfreertos.so)
+#                 or 4 (heap_4.c, which frees).  Default 1.
+# TICK_RATE_HZ, MAX_PRIORITIES, TOTAL_HEAP_SIZE
+#                 configTICK_RATE_HZ, configMAX_PRIORITIES and
+#                 configTOTAL_HEAP_SIZE.  The FreeRTOSConfig.h must leave them
+#                 under #ifndef, as freertos_ros/source/FreeRTOSConfig.h does.
+# DEFINITIONS     Other configuration macros, on the same terms.
+# SOURCES         The C sources of the node that run on the kernel, for example
+#                 freertos_ros/source/freertos_hello.c.
+# INCLUDE_DIRS    The directories of their headers, after CONFIG_DIR.
+#
+# The definitions and the include directories are PUBLIC: the node is compiled
+# with the configuration of its kernel, which the sizes of the static objects
+# and the priorities depend on.  The optimisation follows CMAKE_BUILD_TYPE.
+
+include(CMakeParseArguments)
+
+get_filename_component(FREERTOS_ROS_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+
+set(FREERTOS_KERNEL_SOURCES
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/event_groups.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/list.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/pollset.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/queue.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/rwlock.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/snapshot.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/stream_buffer.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/tasks.c
+  ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/timers.c
+  ${FREERTOS_ROS_DIR}/ros/portable/port.c
+  ${FREERTOS_ROS_DIR}/ros/portable/port_trace.c
+  ${FREERTOS_ROS_DIR}/ros/portable/shm_stream_buffer.c)
+
+set(FREERTOS_HEAP_1 ${FREERTOS_ROS_DIR}/ros/portable/heap_1.c)
+set(FREERTOS_HEAP_4 ${FREERTOS_ROS_DIR}/amazon-freertos/FreeRTOS/portable/heap_4.c)
+
+find_package(Threads REQUIRED)
+
+function(freertos_add_kernel T)
+  cmake_parse_arguments(KERNEL
+    ""
+    "CONFIG_DIR;HEAP;TICK_RATE_HZ;MAX_PRIORITIES;TOTAL_HEAP_SIZE"
+    "DEFINITIONS;SOURCES;INCLUDE_DIRS"
+    ${ARGN})
+
+  if(KERNEL_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "freertos_add_kernel(${T}): unknown arguments ${KERNEL_UNPARSED_ARGUMENTS}")
+  endif()
+
+  if(NOT KERNEL_CONFIG_DIR)
+    set(KERNEL_CONFIG_DIR ${FREERTOS_ROS_DIR}/source)
+  endif()
+
+  if(NOT KERNEL_HEAP)
+    set(KERNEL_HEAP 1)
+  endif()
+
+  if(NOT DEFINED FREERTOS_HEAP_${KERNEL_HEAP})
+    message(FATAL_ERROR "freertos_add_kernel(${T}): HEAP must be 1 or 4")
+  endif()
+
+  set(definitions ${KERNEL_DEFINITIONS} configFRTOS_MEMORY_SCHEME=${KERNEL_HEAP})
+
+  if(KERNEL_TICK_RATE_HZ)
+    list(APPEND definitions configTICK_RATE_HZ=${KERNEL_TICK_RATE_HZ})
+  endif()
+
+  if(KERNEL_MAX_PRIORITIES)
+    list(APPEND definitions configMAX_PRIORITIES=${KERNEL_MAX_PRIORITIES})
+  endif()
+
+  if(KERNEL_TOTAL_HEAP_SIZE)
+    list(APPEND definitions configTOTAL_HEAP_SIZE=${KERNEL_TOTAL_HEAP_SIZE})
+  endif()
+
+  add_library(${T} STATIC
+    ${FREERTOS_KERNEL_SOURCES}
+    ${FREERTOS_HEAP_${KERNEL_HEAP}}
+    ${KERNEL_SOURCES})
+
+  target_include_directories(${T} PUBLIC
+    ${KERNEL_CONFIG_DIR}
+    ${KERNEL_INCLUDE_DIRS}
+    ${FREERTOS_ROS_DIR}/ros/portable
+    ${FREERTOS_ROS_DIR}/amazon-freertos/include)
+
+  target_compile_definitions(${T} PUBLIC ${definitions})
+
+  # gnu99 as ROS/Makefile, and position independent code for the PIE of the
+  # node.
+  target_compile_options(${T} PRIVATE $<$<COMPILE_LANGUAGE:C>:-std=gnu99> -Wall)
+  set_target_properties(${T} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+
+  target_link_libraries(${T} PUBLIC ${CMAKE_THREAD_LIBS_INIT})
+endfunction()
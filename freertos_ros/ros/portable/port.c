@@ -54,6 +54,31 @@
 
 extern uint32_t SystemCoreClock; /* in Kinetis SDK, this contains the system core clock speed */
 
+/*----------------------------------------------------------------------------*/
+/* The port traces thread creation and every switch on stdout.  Set
+ * configPORT_VERBOSE to 0 in FreeRTOSConfig.h to leave stdout to the
+ * application (the benchmarks under bench/ need it). */
+#ifndef configPORT_VERBOSE
+#define configPORT_VERBOSE			1
+#endif
+
+#if ( configPORT_VERBOSE == 1 )
+#define portTRACE_PRINTF( ... )		printf( __VA_ARGS__ )
+#else
+#define portTRACE_PRINTF( ... )
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* The caller of vPortSysTickHandler() can fall behind when the host stalls.
+ * With configPORT_MAX_CATCH_UP_TICKS above 1 the port measures the time since
+ * the last tick against configTICK_RATE_HZ and hands up to that many missed
+ * ticks to the kernel in one call, under one lock and with one context switch
+ * decision.  Ticks missed beyond the limit are dropped.  1 keeps one tick per
+ * call whatever the time, for a caller that ticks at its own rate. */
+#ifndef configPORT_MAX_CATCH_UP_TICKS
+#define configPORT_MAX_CATCH_UP_TICKS	1
+#endif
+
 /*----------------------------------------------------------------------------*/
 #ifndef MAX_NUMBER_OF_TASKS
 #define MAX_NUMBER_OF_TASKS 		( _POSIX_THREAD_THREADS_MAX )
@@ -87,16 +112,36 @@ static pthread_t 				hMainThread = ( pthread_t )NULL;
 /*----------------------------------------------------------------------------*/
 
 static volatile portBASE_TYPE xSentinel = 0;
+/* The thread of a deleted task that vPortCleanUpTCB() resumes to end it. */
+static volatile pthread_t hThreadToEnd = ( pthread_t )NULL;
 static volatile portBASE_TYPE	xWaitForNewTask = 0;
 static volatile portBASE_TYPE xSchedulerEnd = pdFALSE;
 
+/* pdTRUE, pdFALSE, or portINTERRUPT_IN_SERVICE while a host thread runs a
+ * tick or an interrupt handler. */
+#define portINTERRUPT_IN_SERVICE	( ( portBASE_TYPE ) 2 )
 static volatile portBASE_TYPE xInterruptsEnabled = pdTRUE;
 static volatile portBASE_TYPE xServicingTick = pdFALSE; //pdTRUE;
+/* The task thread that a tick or an interrupt handler resumed: it takes the
+ * interrupts out of service when it runs. */
+static volatile pthread_t hInterruptResumedThread = ( pthread_t )NULL;
 static volatile portBASE_TYPE	xStartFirstTask = pdFALSE;
 
 static volatile portBASE_TYPE xPendYield = pdFALSE;
 static volatile portLONG lIndexOfLastAddedTask = 0;
 static volatile unsigned portBASE_TYPE uxCriticalNesting;
+
+#if ( configPORT_TRACE == 1 )
+/* Only the tasks count kernel entries, not the host threads that run the
+ * ticks and the interrupts. */
+static __thread portBASE_TYPE xIsTaskThread = pdFALSE;
+#endif
+
+static PortTickStats_t xTickStats = { 0 };
+static TickType_t xPendedTicks = 0;
+#if ( configPORT_MAX_CATCH_UP_TICKS > 1 )
+static unsigned long long ullNextTickNs = 0;
+#endif
 /*----------------------------------------------------------------------------*/
 
 /*----------------------------------------------------------------------------
@@ -124,6 +169,14 @@ static void prvSuspendThread( pthread_t xThreadId );
 
 static void prvDeleteThread( void *xThreadId );
 
+#if ( configPORT_MAX_CATCH_UP_TICKS > 1 )
+static TickType_t prvGetTicksToProcess( void );
+#endif
+
+static portBASE_TYPE prvEnterInterrupt( void );
+static void prvDisableInterrupts( void );
+static portBASE_TYPE prvSwitchFromInterrupt( pthread_t xTaskToSuspend );
+
 /*----------------------------------------------------------------------------*/
 
 /*
@@ -147,7 +200,7 @@ portSTACK_TYPE *pxPortInitialiseStack
 	void *pvParameters
 )
 {
-	printf("pxPortInitialiseStack \n");
+	portTRACE_PRINTF("pxPortInitialiseStack \n");
 
 	/* Should actually keep this struct on the stack. */
 	xParams pxThisThread;
@@ -244,7 +297,7 @@ portBASE_TYPE xPortStartScheduler( void )
 	sigset_t xSignalsBlocked;
 	portLONG lIndex;
 
-	printf("xPortStartScheduler\n");
+	portTRACE_PRINTF("xPortStartScheduler\n");
 
 	/* Establish the signals to block before they are needed. */
 	sigfillset( &xSignalToBlock );
@@ -328,7 +381,7 @@ void vPortExitCritical( void )
 		/* Have we missed ticks? This is the equivalent of pending an interrupt. */
 		if ( xPendYield == pdTRUE )
 		{
-			printf("%lx : vPortExitCritical -- call vPortYield\n",  pthread_self());
+			portTRACE_PRINTF("%lx : vPortExitCritical -- call vPortYield\n",  pthread_self());
 			xPendYield = pdFALSE;
 			vPortYield();
 		}
@@ -341,49 +394,232 @@ void vPortExitCritical( void )
 void vPortSysTickHandler( int sig )
 {
 	pthread_t xTaskToSuspend;
-	pthread_t xTaskToResume;
+	TickType_t xTicks = 1;
 
 	if( xStartFirstTask == pdFALSE )
 		return;
 
 	//printf("vPortSysTickHandler \n");
 
-	pthread_mutex_lock( &xSingleThreadMutex );
+	xTickStats.ulHandlerCalls++;
+
+#if ( configPORT_MAX_CATCH_UP_TICKS > 1 )
+	/* Nothing to do when an earlier call already processed this tick, and
+	 * no tick is pending. */
+	xTicks = prvGetTicksToProcess();
+	if( ( xTicks == 0 ) && ( xPendedTicks == 0 ) )
+		return;
+#endif
+
+	/* The running task is in a critical section and may be changing the
+	 * kernel lists.  Hold the tick pending, as the interrupt would be, and
+	 * process it with the next one. */
+	if ( prvEnterInterrupt() == pdFALSE )
+	{
+		xPendedTicks += xTicks;
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+		return;
+	}
+
+	xTicks += xPendedTicks;
+	xPendedTicks = 0;
+
+#if ( configPORT_TRACE == 1 )
+	/* Replaying, a tick comes in where the trace has one. */
+	if ( xPortTraceTick( &xTicks ) == pdFALSE )
+	{
+		xInterruptsEnabled = pdTRUE;
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+		return;
+	}
+#endif
 
 	xServicingTick = pdTRUE;
 
 	xTaskToSuspend = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
 
 	/* Tick Increment. */
-	xTaskIncrementTick();
+	if ( xTicks > 1 )
+	{
+		xTaskIncrementTicks( xTicks );
+	}
+	else
+	{
+		xTaskIncrementTick();
+	}
+
+	xTickStats.ulTicks += xTicks;
+	if( xTicks > 1 )
+	{
+		xTickStats.ulBatches++;
+	}
+	if( xTicks > xTickStats.ulMaxBatch )
+	{
+		xTickStats.ulMaxBatch = xTicks;
+	}
 
 	/* Select Next Task. */
 #if ( configUSE_PREEMPTION == 1 )
 	vTaskSwitchContext();
 #endif
 
-	xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
+	if ( prvSwitchFromInterrupt( xTaskToSuspend ) != pdFALSE )
+	{
+		xTickStats.ulContextSwitches++;
+	}
+
+	xServicingTick = pdFALSE;
+}
+
+/*----------------------------------------------------------------------------*/
 
-	/* The only thread that can process this tick is the running thread. */
+void vPortRunAsInterrupt( PortInterruptHandler_t pxHandler, void *pvParameter )
+{
+	pthread_t xTaskToSuspend;
+#if ( configPORT_TRACE == 1 )
+	/* The handler in the trace, by its place in the program. */
+	const uint32_t ulHandler = ( uint32_t )( ( uintptr_t )pxHandler - ( uintptr_t )vPortRunAsInterrupt );
+#endif
+
+	/* No task can wait for the interrupt yet. */
+	if( xStartFirstTask == pdFALSE )
+	{
+		( void ) pxHandler( pvParameter );
+		return;
+	}
+
+	/* Unlike a tick, the handler cannot be pended: wait for the running task
+	 * to leave its critical section. */
+	for ( ;; )
+	{
+		if ( prvEnterInterrupt() != pdFALSE )
+		{
+#if ( configPORT_TRACE == 1 )
+			/* Replaying, also wait for the turn of the handler in the trace. */
+			if ( xPortTraceInterrupt( ulHandler ) != pdFALSE )
+			{
+				break;
+			}
+			xInterruptsEnabled = pdTRUE;
+#else
+			break;
+#endif
+		}
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+		sched_yield();
+	}
+
+	xServicingTick = pdTRUE;
+
+	xTaskToSuspend = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
+
+	if ( pxHandler( pvParameter ) != pdFALSE )
+	{
+		vTaskSwitchContext();
+	}
+
+	( void ) prvSwitchFromInterrupt( xTaskToSuspend );
+
+	xServicingTick = pdFALSE;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvEnterInterrupt( void )
+{
+	portBASE_TYPE xEnabled = pdTRUE;
+
+	/* Returns with xSingleThreadMutex held.  The running task keeps running
+	 * while a host thread services an interrupt: mark the interrupt in
+	 * service so that the task waits in vPortDisableInterrupts() rather than
+	 * change the kernel lists under the handler. */
+	pthread_mutex_lock( &xSingleThreadMutex );
+
+	return __atomic_compare_exchange_n( &xInterruptsEnabled, &xEnabled, portINTERRUPT_IN_SERVICE,
+										pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) ? pdTRUE : pdFALSE;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvSwitchFromInterrupt( pthread_t xTaskToSuspend )
+{
+	pthread_t xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
+
+	/* Called with xSingleThreadMutex held, from a host thread that is not a
+	 * task, once the kernel has selected the task to run. */
 	if ( xTaskToSuspend != xTaskToResume )
 	{
-		printf("vPortSysTickHandler - s %lx - r %lx\n", xTaskToSuspend, xTaskToResume);
+		portTRACE_PRINTF("prvSwitchFromInterrupt - s %lx - r %lx\n", xTaskToSuspend, xTaskToResume);
 
-		/* Remember and switch the critical nesting. */
+		/* Remember the critical nesting. */
 		prvSetTaskCriticalNesting( xTaskToSuspend, uxCriticalNesting );
+		/* Unlike a task that yields, the current task does not wait for the
+		 * switch: stop it before the next task runs, so that the two never run
+		 * together. */
+		prvSuspendThread( xTaskToSuspend );
+		while ( xSentinel == 0 )
+		{
+			sched_yield();
+		}
+		/* Switch the critical nesting and resume next task. */
 		uxCriticalNesting = prvGetTaskCriticalNesting( xTaskToResume );
-		/* Resume next task. */
+		hInterruptResumedThread = xTaskToResume;
 		prvResumeThread( xTaskToResume );
-		/* Suspend the current task. */
-		prvSuspendThread( xTaskToSuspend );
+		return pdTRUE;
 	}
-	else
+
+	/* Yielding to self, the interrupt found the interrupts enabled. */
+	xInterruptsEnabled = pdTRUE;
+	(void)pthread_mutex_unlock( &xSingleThreadMutex );
+	return pdFALSE;
+}
+
+/*----------------------------------------------------------------------------*/
+
+#if ( configPORT_MAX_CATCH_UP_TICKS > 1 )
+static TickType_t prvGetTicksToProcess( void )
+{
+	const unsigned long long ullPeriodNs = 1000000000ULL / configTICK_RATE_HZ;
+	unsigned long long ullNowNs;
+	unsigned long long ullTicks;
+	struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	ullNowNs = ( ( unsigned long long )xNow.tv_sec * 1000000000ULL ) + ( unsigned long long )xNow.tv_nsec;
+
+	/* The first tick is due now. */
+	if ( ullNextTickNs == 0 )
 	{
-		/* Yielding to self */
-		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+		ullNextTickNs = ullNowNs;
 	}
 
-	xServicingTick = pdFALSE;
+	/* Half a period of tolerance, the caller does not tick exactly on time. */
+	ullNowNs += ullPeriodNs / 2;
+	if ( ullNowNs < ullNextTickNs )
+	{
+		return 0;
+	}
+
+	ullTicks = ( ( ullNowNs - ullNextTickNs ) / ullPeriodNs ) + 1;
+	ullNextTickNs += ullTicks * ullPeriodNs;
+
+	if ( ullTicks > configPORT_MAX_CATCH_UP_TICKS )
+	{
+		xTickStats.ulDroppedTicks += ( unsigned long )( ullTicks - configPORT_MAX_CATCH_UP_TICKS );
+		ullTicks = configPORT_MAX_CATCH_UP_TICKS;
+	}
+
+	return ( TickType_t )ullTicks;
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+void vPortGetTickStats( PortTickStats_t *pxStats )
+{
+	/* Only the tick thread writes the counters, a task may read a count that
+	 * is one tick old. */
+	*pxStats = xTickStats;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -410,9 +646,34 @@ void vPortYield( void )
 {
 	pthread_t xTaskToSuspend;
 	pthread_t xTaskToResume;
+#if ( configPORT_TRACE == 1 )
+	/* A yield outside of a critical section is a kernel entry.  With the
+	 * interrupts disabled, from vPortExitCritical(), no input can be due. */
+	const portBASE_TYPE xEntry = ( ( xIsTaskThread != pdFALSE ) && ( uxCriticalNesting == 0 ) ) ? pdTRUE : pdFALSE;
+	const portBASE_TYPE xGate = ( ( xEntry != pdFALSE ) && ( xInterruptsEnabled != pdFALSE ) ) ? pdTRUE : pdFALSE;
+
+	for ( ;; )
+	{
+		if ( xGate != pdFALSE )
+		{
+			vPortTraceGate();
+		}
 
+		pthread_mutex_lock( &xSingleThreadMutex );
+
+		if ( ( xEntry == pdFALSE ) || ( xPortTraceKernelEntry( xGate ) != pdFALSE ) )
+		{
+			break;
+		}
+
+		/* Switched out after the gate, the task came back with an input
+		 * due: let it in first. */
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+	}
+#else
 	//printf("<<lock>> vPortYield -- xSingleThreadMutex \n");
 	pthread_mutex_lock( &xSingleThreadMutex );
+#endif
 
 	xTaskToSuspend = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
 	vTaskSwitchContext();
@@ -420,7 +681,7 @@ void vPortYield( void )
 	xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
 	if ( xTaskToSuspend != xTaskToResume )
 	{
-		printf("vPortYield - s %lx - r %lx\n", xTaskToSuspend, xTaskToResume);
+		portTRACE_PRINTF("vPortYield - s %lx - r %lx\n", xTaskToSuspend, xTaskToResume);
 
 		/* Remember and switch the critical nesting. */
 		prvSetTaskCriticalNesting( xTaskToSuspend, uxCriticalNesting );
@@ -439,9 +700,53 @@ void vPortYield( void )
 
 /*----------------------------------------------------------------------------*/
 
+void vPortIdle( void )
+{
+	sched_yield();
+}
+
+/*----------------------------------------------------------------------------*/
+
 void vPortDisableInterrupts( void )
 {
-	xInterruptsEnabled = pdFALSE;
+#if ( configPORT_TRACE == 1 )
+	/* The outermost critical section of a task is a kernel entry. */
+	if ( ( xIsTaskThread != pdFALSE ) && ( xInterruptsEnabled != pdFALSE ) )
+	{
+		for ( ;; )
+		{
+			vPortTraceGate();
+			prvDisableInterrupts();
+
+			if ( xPortTraceKernelEntry( pdTRUE ) != pdFALSE )
+			{
+				return;
+			}
+
+			/* Switched out after the gate, the task came back with an input
+			 * due: let it in first. */
+			xInterruptsEnabled = pdTRUE;
+		}
+	}
+#endif
+
+	prvDisableInterrupts();
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void prvDisableInterrupts( void )
+{
+	portBASE_TYPE xEnabled = pdTRUE;
+
+	/* On the hardware the task would not run until the interrupt returns. */
+	while ( ( xInterruptsEnabled != pdFALSE ) &&
+			( __atomic_compare_exchange_n( &xInterruptsEnabled, &xEnabled, pdFALSE,
+										   pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) == 0 ) )
+	{
+		xEnabled = pdTRUE;
+		sched_yield();
+	}
 }
 
 /*----------------------------------------------------------------------------*/
@@ -456,7 +761,12 @@ void vPortEnableInterrupts( void )
 portBASE_TYPE xPortSetInterruptMask( void )
 {
 	portBASE_TYPE xReturn = xInterruptsEnabled;
-	xInterruptsEnabled = pdFALSE;
+
+	/* In a handler, the interrupts stay marked in service. */
+	if ( xReturn != portINTERRUPT_IN_SERVICE )
+	{
+		vPortDisableInterrupts();
+	}
 	return xReturn;
 }
 
@@ -478,7 +788,7 @@ void vPortForciblyEndThread( void *pxTaskToDelete )
 
 void *prvWaitForStart( void * pvParams )
 {
-	printf("prvWaitForStart %lx \n", pthread_self());
+	portTRACE_PRINTF("prvWaitForStart %lx \n", pthread_self());
 
 	xParams * pxParams = ( xParams * )pvParams;
 
@@ -491,6 +801,10 @@ void *prvWaitForStart( void * pvParams )
 	//pthread_self());
 	pthread_mutex_lock( &xSingleThreadMutex );
 
+#if ( configPORT_TRACE == 1 )
+	xIsTaskThread = pdTRUE;
+#endif
+
 	prvSuspendThread( pthread_self() );
 
 	//printf("prvWaitForStart -- start function\n");
@@ -508,6 +822,8 @@ void prvSuspendSignalHandler(int sig)
 {
 	//printf("%lx prvSuspendSignalHandler %d\n", pthread_self(), sig);
 	sigset_t xSignals;
+	portBASE_TYPE xInterrupts;
+	portBASE_TYPE xEnabled;
 
 	/* Only interested in the resume signal. */
 	sigemptyset( &xSignals );
@@ -521,16 +837,37 @@ void prvSuspendSignalHandler(int sig)
 	/* Wait on the resume signal. */
 	sigwait( &xSignals, &sig );
 
+	/* The task of this thread was deleted: end the thread, it holds no lock
+	 * and the kernel no longer knows it. */
+	if ( hThreadToEnd == pthread_self() )
+	{
+		hThreadToEnd = ( pthread_t )NULL;
+		pthread_exit( NULL );
+	}
+
 	/* Will resume here when the SIG_RESUME signal is received. */
 	/* Need to set the interrupts based on the task's critical nesting. */
 	//printf("prvSuspendSignalHandler %lx\n", pthread_self());
-	if ( uxCriticalNesting == 0 )
+	xInterrupts = ( uxCriticalNesting == 0 ) ? pdTRUE : pdFALSE;
+
+	if ( hInterruptResumedThread == pthread_self() )
 	{
-		vPortEnableInterrupts();
+		/* Not vPortDisableInterrupts(), the interrupt that resumed this task
+		 * is still marked in service. */
+		hInterruptResumedThread = ( pthread_t )NULL;
+		xInterruptsEnabled = xInterrupts;
 	}
 	else
 	{
-		vPortDisableInterrupts();
+		/* Resumed by a task that yielded.  A tick or an interrupt may have
+		 * come in since and already switched this task out: leave it in
+		 * service, or a second host thread would enter a handler beside it. */
+		xEnabled = xInterruptsEnabled;
+		while ( ( xEnabled != portINTERRUPT_IN_SERVICE ) &&
+				( __atomic_compare_exchange_n( &xInterruptsEnabled, &xEnabled, xInterrupts,
+											   pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) == 0 ) )
+		{
+		}
 	}
 }
 /*----------------------------------------------------------------------------*/
@@ -710,7 +1047,7 @@ unsigned portBASE_TYPE prvGetTaskCriticalNesting( pthread_t xThreadId )
 
 void prvDeleteThread( void *xThreadId )
 {
-	printf("prvDeleteThread\n");
+	portTRACE_PRINTF("prvDeleteThread\n");
 	portLONG lIndex;
 	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
 	{
@@ -752,6 +1089,43 @@ void vPortAddTaskHandle( void *pxTaskHandle )
 
 /*----------------------------------------------------------------------------*/
 
+/*
+ *	Called when the TCB of a deleted task is freed.  The thread of the task
+ *	waits in prvSuspendSignalHandler() for a resume: it is resumed to end
+ *	itself, and its entry is given back once it has, so that a new task
+ *	allocated at the same address is not taken for it.  The thread is
+ *	detached, its stack goes with it.
+ */
+void vPortCleanUpTCB( void *pxTCB )
+{
+	portLONG lIndex;
+
+	vPortEnterCritical();
+	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
+	{
+		if ( pxThreads[ lIndex ].hTask == ( TaskHandle_t )pxTCB )
+		{
+			/* A task deleting itself was suspended by its own yield before
+			 * the idle task frees it, so the resume is not lost: the signal
+			 * stays pending until the thread waits for it. */
+			hThreadToEnd = pxThreads[ lIndex ].hThread;
+			prvResumeThread( pxThreads[ lIndex ].hThread );
+			while ( hThreadToEnd != ( pthread_t )NULL )
+			{
+				sched_yield();
+			}
+
+			pxThreads[ lIndex ].hThread = ( pthread_t )NULL;
+			pxThreads[ lIndex ].hTask = ( TaskHandle_t )NULL;
+			pxThreads[ lIndex ].uxCriticalNesting = 0;
+			break;
+		}
+	}
+	vPortExitCritical();
+}
+
+/*----------------------------------------------------------------------------*/
+
 unsigned long ulPortGetTimerValue( void )
 {
 	//	TODO
@@ -774,7 +1148,7 @@ extern int freeRTOS_main(void);
 
 void vStartFreeRTOS( void )
 {
-	printf("vStartFreeRTOS\n");
+	portTRACE_PRINTF("vStartFreeRTOS\n");
 
   freeRTOS_main();
 }
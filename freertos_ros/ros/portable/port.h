@@ -7,10 +7,15 @@
 #ifndef PORT_H
 #define PORT_H
 
+/* The ROS node may include port.h first. */
+#include "FreeRTOS.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+portBEGIN_EXPORTED_API
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -19,11 +24,41 @@ extern "C" {
  */
 void vPortSysTickHandler( int sig );
 
+/*
+ *  Counters of the tick handler, since the scheduler started
+ */
+typedef struct PORT_TICK_STATS
+{
+	unsigned long ulHandlerCalls;		/* Calls to vPortSysTickHandler(). */
+	unsigned long ulTicks;				/* Ticks given to the kernel. */
+	unsigned long ulBatches;			/* Calls that processed more than one tick. */
+	unsigned long ulMaxBatch;			/* Most ticks processed by one call. */
+	unsigned long ulDroppedTicks;		/* Missed ticks beyond configPORT_MAX_CATCH_UP_TICKS. */
+	unsigned long ulContextSwitches;	/* Switches decided by the tick handler. */
+} PortTickStats_t;
+
+void vPortGetTickStats( PortTickStats_t *pxStats );
+
+/*
+ *  Simulated interrupt, for host threads that are not tasks
+ *
+ *  vPortRunAsInterrupt() runs pxHandler as the tick handler runs the tick:
+ *  with the running task held, so the handler can call the FromISR API
+ *  functions.  The handler returns pdTRUE when it woke a task that should
+ *  run now, as *pxHigherPriorityTaskWoken would.  It must not be called from
+ *  a task.
+ */
+typedef portBASE_TYPE ( *PortInterruptHandler_t )( void *pvParameter );
+
+void vPortRunAsInterrupt( PortInterruptHandler_t pxHandler, void *pvParameter );
+
 /*
  *  Start the program
  */
 void vStartFreeRTOS( void );
 
+portEND_EXPORTED_API
+
 #ifdef __cplusplus
 }
 #endif
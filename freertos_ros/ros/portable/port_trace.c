@@ -0,0 +1,669 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	portable --> record and replay of the scheduling of the kernel
+ */
+
+/*----------------------------------------------------------------------------
+ * The trace of the scheduling, see port_trace.h.
+ *
+ * Recording, each record takes the next slot of a buffer allocated by
+ * xPortTraceStart(): the tasks, the tick and the interrupts add records
+ * without a lock, an atomic add reserves the slots.  A record that does not
+ * fit is dropped and counted, the trace stops there.
+ *
+ * Replaying, the trace is read with two cursors: one on the inputs - the
+ * ticks and the interrupts, with the data of each interrupt - and one on the
+ * decisions - the switches and the blocks.  An input is let in when the
+ * kernel entries of the tasks reach the count of its record, and vPortTraceGate()
+ * holds a task that would go past that count until it is.  Each decision is
+ * checked against the next one of the trace.
+ *----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port_trace.h"
+
+#if( configPORT_TRACE == 1 )
+
+/* The records a recording holds, 1 MiB of memory. */
+#ifndef configPORT_TRACE_RECORDS
+	#define configPORT_TRACE_RECORDS	65536
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static volatile ePortTraceMode eTraceMode = ePortTraceOff;
+static PortTraceRecord_t *pxRecords = NULL;
+static size_t xCapacity = 0;
+static char *pcTracePath = NULL;
+static unsigned long long ullStartNs = 0;
+
+/* Recording: the slots reserved, beyond xCapacity when records are dropped.
+ * Replaying: the records of the trace. */
+static volatile size_t xRecords = 0;
+
+/* Kernel entries of the tasks; only the running task counts them, outside
+ * of an interrupt. */
+static volatile uint32_t ulEntries = 0;
+static uint16_t usCurrentTask = 0;
+
+/* Replaying: the next tick or interrupt, the data of the interrupt in
+ * service, and the next decision. */
+static volatile size_t xNextInput = 0;
+static size_t xNextData = 0;
+static size_t xNextDecision = 0;
+static pthread_mutex_t xReplayMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static unsigned long ulDroppedRecords = 0;
+static unsigned long ulReplayedInputs = 0;
+static unsigned long ulCheckedDecisions = 0;
+static unsigned long ulDivergences = 0;
+static unsigned long ulDivergedRecord = 0;
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Reserve xCount slots and fill the first with a record of the running task.
+ * Returns NULL, and counts a drop, when the buffer is full.
+ */
+static PortTraceRecord_t *prvAppend( uint8_t ucType, uint8_t ucDetail, uint32_t ulValue, size_t xCount );
+
+/*
+ * The index of the record after xIndex, past the data of an input.
+ */
+static size_t prvSkip( size_t xIndex );
+
+/*
+ * From xIndex on, the index of the next tick or interrupt, or of the next
+ * decision.  xRecords when there is none.
+ */
+static size_t prvFindInput( size_t xIndex );
+static size_t prvFindDecision( size_t xIndex );
+
+/*
+ * Replaying, take the input at xIndex in, or check the decision of the
+ * running task against the next one of the trace.
+ */
+static void prvConsumeInput( size_t xIndex );
+static void prvCheckDecision( uint8_t ucType, uint8_t ucDetail, uint32_t ulValue, BaseType_t xCompareValue );
+
+/*
+ * Stop the replay at the record xIndex and go on live.
+ */
+static void prvDiverge( size_t xIndex, const char *pcWhat );
+
+static void prvEndReplayIfDone( void );
+static BaseType_t prvSave( void );
+static void prvSaveAtExit( void );
+static unsigned long long prvNowNs( void );
+
+/*----------------------------------------------------------------------------*/
+
+static unsigned long long prvNowNs( void )
+{
+	struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( unsigned long long )xNow.tv_sec * 1000000000ULL ) + ( unsigned long long )xNow.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+
+static PortTraceRecord_t *prvAppend( uint8_t ucType, uint8_t ucDetail, uint32_t ulValue, size_t xCount )
+{
+	PortTraceRecord_t *pxRecord;
+	size_t xIndex = __atomic_fetch_add( &xRecords, xCount, __ATOMIC_RELAXED );
+
+	if( ( xIndex + xCount ) > xCapacity )
+	{
+		__atomic_fetch_add( &ulDroppedRecords, 1, __ATOMIC_RELAXED );
+		return NULL;
+	}
+
+	pxRecord = &pxRecords[ xIndex ];
+	pxRecord->ucDetail = ucDetail;
+	pxRecord->usTask = usCurrentTask;
+	pxRecord->ulEntry = __atomic_load_n( &ulEntries, __ATOMIC_RELAXED );
+	pxRecord->ulTimeNs = ( uint32_t )( prvNowNs() - ullStartNs );
+	pxRecord->ulValue = ulValue;
+	/* The type last, a slot that was never filled reads portTRACE_NONE. */
+	__atomic_store_n( &pxRecord->ucType, ucType, __ATOMIC_RELEASE );
+
+	return pxRecord;
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvSkip( size_t xIndex )
+{
+	if( pxRecords[ xIndex ].ucType == portTRACE_INPUT )
+	{
+		xIndex += portTRACE_INPUT_RECORDS( pxRecords[ xIndex ].ulValue );
+	}
+
+	return xIndex + 1;
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvFindInput( size_t xIndex )
+{
+	while( ( xIndex < xRecords ) &&
+		   ( pxRecords[ xIndex ].ucType != portTRACE_TICK ) &&
+		   ( pxRecords[ xIndex ].ucType != portTRACE_INTERRUPT ) )
+	{
+		xIndex = prvSkip( xIndex );
+	}
+
+	return ( xIndex < xRecords ) ? xIndex : xRecords;
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvFindDecision( size_t xIndex )
+{
+	while( ( xIndex < xRecords ) &&
+		   ( pxRecords[ xIndex ].ucType != portTRACE_SWITCH ) &&
+		   ( pxRecords[ xIndex ].ucType != portTRACE_BLOCK ) )
+	{
+		xIndex = prvSkip( xIndex );
+	}
+
+	return ( xIndex < xRecords ) ? xIndex : xRecords;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvDiverge( size_t xIndex, const char *pcWhat )
+{
+	/* Called with xReplayMutex held. */
+	if( eTraceMode != ePortTraceReplay )
+	{
+		return;
+	}
+
+	ulDivergences = 1;
+	ulDivergedRecord = ( unsigned long )xIndex;
+	eTraceMode = ePortTraceOff;
+
+	fprintf( stderr, "port_trace: the replay diverges at record %lu (%s), going on live\n",
+			 ( unsigned long )xIndex, pcWhat );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvEndReplayIfDone( void )
+{
+	/* Called with xReplayMutex held. */
+	if( ( xNextInput >= xRecords ) && ( xNextDecision >= xRecords ) )
+	{
+		eTraceMode = ePortTraceOff;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvConsumeInput( size_t xIndex )
+{
+	/* Called with xReplayMutex held.  The data of an interrupt are the inputs
+	 * recorded after it, before the next tick or interrupt. */
+	xNextData = prvSkip( xIndex );
+	__atomic_store_n( &xNextInput, prvFindInput( xNextData ), __ATOMIC_RELEASE );
+	ulReplayedInputs++;
+
+	prvEndReplayIfDone();
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvCheckDecision( uint8_t ucType, uint8_t ucDetail, uint32_t ulValue, BaseType_t xCompareValue )
+{
+	const PortTraceRecord_t *pxRecord;
+
+	pthread_mutex_lock( &xReplayMutex );
+
+	if( eTraceMode == ePortTraceReplay )
+	{
+		if( xNextDecision >= xRecords )
+		{
+			prvDiverge( xRecords, "a decision past the end of the trace" );
+		}
+		else
+		{
+			pxRecord = &pxRecords[ xNextDecision ];
+
+			if( ( pxRecord->ucType != ucType ) ||
+				( pxRecord->ucDetail != ucDetail ) ||
+				( pxRecord->usTask != usCurrentTask ) ||
+				( pxRecord->ulEntry != ulEntries ) ||
+				( ( xCompareValue != pdFALSE ) && ( pxRecord->ulValue != ulValue ) ) )
+			{
+				prvDiverge( xNextDecision, ( ucType == portTRACE_SWITCH ) ? "another task switched in" : "another block" );
+			}
+			else
+			{
+				ulCheckedDecisions++;
+				xNextDecision = prvFindDecision( prvSkip( xNextDecision ) );
+				prvEndReplayIfDone();
+			}
+		}
+	}
+
+	pthread_mutex_unlock( &xReplayMutex );
+}
+/*----------------------------------------------------------------------------*/
+
+void vPortTraceSwitchedIn( UBaseType_t uxTask, TickType_t xTickCount )
+{
+	/* Called on each selection of a task, from a yield or an interrupt.  The
+	 * trace keeps the switches only. */
+	if( ( uint16_t )uxTask == usCurrentTask )
+	{
+		return;
+	}
+
+	usCurrentTask = ( uint16_t )uxTask;
+
+	if( eTraceMode == ePortTraceRecord )
+	{
+		( void ) prvAppend( portTRACE_SWITCH, 0, ( uint32_t )xTickCount, 1 );
+	}
+	else if( eTraceMode == ePortTraceReplay )
+	{
+		prvCheckDecision( portTRACE_SWITCH, 0, ( uint32_t )xTickCount, pdTRUE );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+void vPortTraceBlocking( uint8_t ucKind, const void *pvObject, TickType_t xValue )
+{
+	/* The address of an object differs from run to run, a tick does not. */
+	const uint32_t ulValue = ( pvObject != NULL ) ? ( uint32_t )( uintptr_t )pvObject : ( uint32_t )xValue;
+
+	if( eTraceMode == ePortTraceRecord )
+	{
+		( void ) prvAppend( portTRACE_BLOCK, ucKind, ulValue, 1 );
+	}
+	else if( eTraceMode == ePortTraceReplay )
+	{
+		prvCheckDecision( portTRACE_BLOCK, ucKind, ulValue, ( pvObject == NULL ) ? pdTRUE : pdFALSE );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+void vPortTraceGate( void )
+{
+	size_t xIndex;
+	uint32_t ulEntry;
+
+	/* The task is about to enter the kernel: an input recorded before this
+	 * entry comes in first. */
+	while( eTraceMode == ePortTraceReplay )
+	{
+		/* The task can be switched out between two reads and come back with
+		 * both changed: the count did not move while the input was read. */
+		do
+		{
+			ulEntry = __atomic_load_n( &ulEntries, __ATOMIC_ACQUIRE );
+			xIndex = __atomic_load_n( &xNextInput, __ATOMIC_ACQUIRE );
+		} while( ulEntry != __atomic_load_n( &ulEntries, __ATOMIC_ACQUIRE ) );
+
+		if( ( xIndex >= xRecords ) || ( pxRecords[ xIndex ].ulEntry > ulEntry ) )
+		{
+			break;
+		}
+
+		if( pxRecords[ xIndex ].ulEntry < ulEntry )
+		{
+			pthread_mutex_lock( &xReplayMutex );
+			prvDiverge( xIndex, "an input the tasks went past" );
+			pthread_mutex_unlock( &xReplayMutex );
+			break;
+		}
+
+		sched_yield();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xPortTraceKernelEntry( BaseType_t xCheck )
+{
+	size_t xIndex;
+
+	/* Called with the interrupts disabled or xSingleThreadMutex held, so no
+	 * input comes in meanwhile.  A task switched out after vPortTraceGate()
+	 * can find an input due on its return. */
+	if( ( xCheck != pdFALSE ) && ( eTraceMode == ePortTraceReplay ) )
+	{
+		xIndex = __atomic_load_n( &xNextInput, __ATOMIC_ACQUIRE );
+
+		if( ( xIndex < xRecords ) && ( pxRecords[ xIndex ].ulEntry <= ulEntries ) )
+		{
+			return pdFALSE;
+		}
+	}
+
+	__atomic_fetch_add( &ulEntries, 1, __ATOMIC_RELEASE );
+
+	return pdTRUE;
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xPortTraceTick( TickType_t *pxTicks )
+{
+	BaseType_t xReturn = pdTRUE;
+	size_t xIndex;
+
+	if( eTraceMode == ePortTraceRecord )
+	{
+		( void ) prvAppend( portTRACE_TICK, 0, ( uint32_t )*pxTicks, 1 );
+	}
+	else if( eTraceMode == ePortTraceReplay )
+	{
+		pthread_mutex_lock( &xReplayMutex );
+
+		xIndex = xNextInput;
+		if( eTraceMode != ePortTraceReplay )
+		{
+			/* Diverged meanwhile, the tick is live. */
+		}
+		else if( xIndex >= xRecords )
+		{
+			/* No input left, the last decisions come without one. */
+			xReturn = pdFALSE;
+		}
+		else if( pxRecords[ xIndex ].ulEntry < ulEntries )
+		{
+			prvDiverge( xIndex, "an input the tasks went past" );
+		}
+		else if( ( pxRecords[ xIndex ].ucType == portTRACE_TICK ) && ( pxRecords[ xIndex ].ulEntry == ulEntries ) )
+		{
+			*pxTicks = ( TickType_t )pxRecords[ xIndex ].ulValue;
+			prvConsumeInput( xIndex );
+		}
+		else
+		{
+			/* Not the turn of a tick yet: the ticks in between were not in
+			 * the recording. */
+			xReturn = pdFALSE;
+		}
+
+		pthread_mutex_unlock( &xReplayMutex );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xPortTraceInterrupt( uint32_t ulHandler )
+{
+	BaseType_t xReturn = pdTRUE;
+	size_t xIndex;
+
+	if( eTraceMode == ePortTraceRecord )
+	{
+		( void ) prvAppend( portTRACE_INTERRUPT, 0, ulHandler, 1 );
+	}
+	else if( eTraceMode == ePortTraceReplay )
+	{
+		pthread_mutex_lock( &xReplayMutex );
+
+		xIndex = xNextInput;
+		if( eTraceMode != ePortTraceReplay )
+		{
+			/* Diverged meanwhile, the interrupt is live. */
+		}
+		else if( xIndex >= xRecords )
+		{
+			xReturn = pdFALSE;
+		}
+		else if( pxRecords[ xIndex ].ulEntry < ulEntries )
+		{
+			prvDiverge( xIndex, "an input the tasks went past" );
+		}
+		else if( ( pxRecords[ xIndex ].ucType == portTRACE_INTERRUPT ) &&
+				 ( pxRecords[ xIndex ].ulEntry == ulEntries ) &&
+				 ( pxRecords[ xIndex ].ulValue == ulHandler ) )
+		{
+			prvConsumeInput( xIndex );
+		}
+		else
+		{
+			/* The turn of a tick, or of another handler. */
+			xReturn = pdFALSE;
+		}
+
+		pthread_mutex_unlock( &xReplayMutex );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xPortTraceInput( void *pvData, size_t xLength )
+{
+	PortTraceRecord_t *pxRecord;
+	size_t xIndex;
+
+	/* Before the first task runs, vPortRunAsInterrupt() calls the handler
+	 * directly: the trace has no interrupt to take the data in. */
+	if( usCurrentTask == 0 )
+	{
+		return xLength;
+	}
+
+	if( eTraceMode == ePortTraceRecord )
+	{
+		pxRecord = prvAppend( portTRACE_INPUT, 0, ( uint32_t )xLength, 1 + portTRACE_INPUT_RECORDS( xLength ) );
+		if( pxRecord != NULL )
+		{
+			memcpy( pxRecord + 1, pvData, xLength );
+		}
+	}
+	else if( eTraceMode == ePortTraceReplay )
+	{
+		pthread_mutex_lock( &xReplayMutex );
+
+		/* The data recorded in this interrupt, decisions of the tasks may sit
+		 * in between. */
+		xIndex = xNextData;
+		while( ( xIndex < xRecords ) &&
+			   ( ( pxRecords[ xIndex ].ucType == portTRACE_SWITCH ) ||
+				 ( pxRecords[ xIndex ].ucType == portTRACE_BLOCK ) ||
+				 ( pxRecords[ xIndex ].ucType == portTRACE_NONE ) ) )
+		{
+			xIndex++;
+		}
+
+		if( ( xIndex < xRecords ) && ( pxRecords[ xIndex ].ucType == portTRACE_INPUT ) )
+		{
+			if( xLength > pxRecords[ xIndex ].ulValue )
+			{
+				xLength = pxRecords[ xIndex ].ulValue;
+			}
+			memcpy( pvData, &pxRecords[ xIndex + 1 ], xLength );
+			xNextData = prvSkip( xIndex );
+			ulReplayedInputs++;
+		}
+		else
+		{
+			prvDiverge( xNextInput, "data that the recording did not have" );
+		}
+
+		pthread_mutex_unlock( &xReplayMutex );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xLength;
+}
+/*----------------------------------------------------------------------------*/
+
+static BaseType_t prvSave( void )
+{
+	PortTraceHeader_t xHeader;
+	FILE *pxFile;
+	size_t xCount = ( xRecords < xCapacity ) ? xRecords : xCapacity;
+	BaseType_t xReturn = pdFAIL;
+
+	xHeader.ulMagic = portTRACE_MAGIC;
+	xHeader.usVersion = portTRACE_VERSION;
+	xHeader.usRecordSize = ( uint16_t )sizeof( PortTraceRecord_t );
+	xHeader.ulTickRateHz = ( uint32_t )configTICK_RATE_HZ;
+	xHeader.ulRecords = ( uint32_t )xCount;
+
+	pxFile = fopen( pcTracePath, "wb" );
+	if( pxFile != NULL )
+	{
+		if( ( fwrite( &xHeader, sizeof( xHeader ), 1, pxFile ) == 1 ) &&
+			( fwrite( pxRecords, sizeof( PortTraceRecord_t ), xCount, pxFile ) == xCount ) )
+		{
+			xReturn = pdPASS;
+		}
+
+		if( fclose( pxFile ) != 0 )
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSaveAtExit( void )
+{
+	if( eTraceMode == ePortTraceRecord )
+	{
+		( void ) xPortTraceStop();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xPortTraceStart( ePortTraceMode eMode, const char *pcPath )
+{
+	static BaseType_t xAtExit = pdFALSE;
+	PortTraceHeader_t xHeader;
+	FILE *pxFile;
+	size_t xCount = 0;
+
+	if( ( eMode == ePortTraceOff ) || ( pcPath == NULL ) )
+	{
+		return xPortTraceStop();
+	}
+
+	free( pcTracePath );
+	pcTracePath = strdup( pcPath );
+	free( pxRecords );
+	pxRecords = NULL;
+	eTraceMode = ePortTraceOff;
+
+	if( eMode == ePortTraceRecord )
+	{
+		xCount = configPORT_TRACE_RECORDS;
+		pxRecords = calloc( xCount, sizeof( PortTraceRecord_t ) );
+	}
+	else
+	{
+		pxFile = fopen( pcPath, "rb" );
+		if( pxFile != NULL )
+		{
+			if( ( fread( &xHeader, sizeof( xHeader ), 1, pxFile ) == 1 ) &&
+				( xHeader.ulMagic == portTRACE_MAGIC ) &&
+				( xHeader.usVersion == portTRACE_VERSION ) &&
+				( xHeader.usRecordSize == sizeof( PortTraceRecord_t ) ) )
+			{
+				xCount = xHeader.ulRecords;
+				/* One more record, an empty trace is not an allocation of 0. */
+				pxRecords = calloc( xCount + 1, sizeof( PortTraceRecord_t ) );
+				if( ( pxRecords != NULL ) &&
+					( fread( pxRecords, sizeof( PortTraceRecord_t ), xCount, pxFile ) != xCount ) )
+				{
+					free( pxRecords );
+					pxRecords = NULL;
+				}
+			}
+			fclose( pxFile );
+		}
+	}
+
+	if( ( pxRecords == NULL ) || ( pcTracePath == NULL ) )
+	{
+		return pdFAIL;
+	}
+
+	xCapacity = xCount;
+	xRecords = ( eMode == ePortTraceRecord ) ? 0 : xCount;
+	ulEntries = 0;
+	usCurrentTask = 0;
+	xNextInput = ( eMode == ePortTraceReplay ) ? prvFindInput( 0 ) : 0;
+	xNextData = 0;
+	xNextDecision = ( eMode == ePortTraceReplay ) ? prvFindDecision( 0 ) : 0;
+	ulDroppedRecords = 0;
+	ulReplayedInputs = 0;
+	ulCheckedDecisions = 0;
+	ulDivergences = 0;
+	ulDivergedRecord = 0;
+	ullStartNs = prvNowNs();
+
+	if( xAtExit == pdFALSE )
+	{
+		xAtExit = pdTRUE;
+		( void ) atexit( prvSaveAtExit );
+	}
+
+	eTraceMode = eMode;
+
+	return pdPASS;
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xPortTraceStop( void )
+{
+	const ePortTraceMode eMode = eTraceMode;
+
+	pthread_mutex_lock( &xReplayMutex );
+	eTraceMode = ePortTraceOff;
+	pthread_mutex_unlock( &xReplayMutex );
+
+	if( eMode == ePortTraceRecord )
+	{
+		return prvSave();
+	}
+
+	return pdPASS;
+}
+/*----------------------------------------------------------------------------*/
+
+void vPortGetTraceStats( PortTraceStats_t *pxStats )
+{
+	pxStats->eMode = eTraceMode;
+	pxStats->ulRecords = ( unsigned long )( ( xRecords < xCapacity ) ? xRecords : xCapacity );
+	pxStats->ulDroppedRecords = ulDroppedRecords;
+	pxStats->ulReplayedInputs = ulReplayedInputs;
+	pxStats->ulCheckedDecisions = ulCheckedDecisions;
+	pxStats->ulDivergences = ulDivergences;
+	pxStats->ulDivergedRecord = ulDivergedRecord;
+}
+/*----------------------------------------------------------------------------*/
+
+#endif /* configPORT_TRACE */
@@ -0,0 +1,150 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	portable --> record and replay of the scheduling of the kernel
+ */
+
+#ifndef PORT_TRACE_H
+#define PORT_TRACE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include port_trace.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+portBEGIN_EXPORTED_API
+
+/*
+ * With configPORT_TRACE set to 1 in FreeRTOSConfig.h the port records, in a
+ * compact binary trace, every scheduling decision of the kernel - each task
+ * switched in, each task that blocks and on what - and every input from
+ * outside the kernel: the ticks, the simulated interrupts of
+ * vPortRunAsInterrupt() and the data their handlers pass through
+ * xPortTraceInput(), a ROS message for example.  The port can then replay the
+ * trace, in the same program: it holds the ticks and the interrupts until the
+ * tasks reach the point at which they came in the recording, and hands the
+ * handlers the recorded data, so that the tasks interleave as they did.
+ *
+ * The point is counted in kernel entries: the critical sections and the
+ * yields of the tasks, and vTaskSuspendAll().  An input comes in between two
+ * of them, and in the replay a task that would enter the kernel again waits
+ * for the inputs due before.  A task thus makes the same calls to the kernel
+ * in the same order as long as what it does between them depends only on the
+ * kernel and on the recorded inputs: not on the host clock, nor on data that
+ * host threads change other than through vPortRunAsInterrupt(), nor on kernel
+ * state read without a critical section while an interrupt may change it (the
+ * idle task looking at its ready list, lock-free stream buffers).  The replay
+ * checks each decision against the trace; at the first one unlike it, the
+ * replay stops and the program goes on live.
+ *
+ * The host thread that calls vPortSysTickHandler() keeps ticking in the
+ * replay, and each call brings in the next recorded tick once it is due.  The
+ * host threads that call vPortRunAsInterrupt() must call it again for each
+ * recorded interrupt, with the same handlers: a call waits until the trace
+ * comes to an interrupt of its handler.  The calls made before the first task
+ * runs are not in the trace, the host threads had better wait for it.
+ */
+
+/* The trace file: a header, then the records. */
+#define portTRACE_MAGIC				0x52545246UL	/* "FRTR" */
+#define portTRACE_VERSION			1
+
+typedef struct PORT_TRACE_HEADER
+{
+	uint32_t ulMagic;				/* portTRACE_MAGIC. */
+	uint16_t usVersion;				/* portTRACE_VERSION. */
+	uint16_t usRecordSize;			/* sizeof( PortTraceRecord_t ). */
+	uint32_t ulTickRateHz;			/* configTICK_RATE_HZ of the recording. */
+	uint32_t ulRecords;				/* Records that follow. */
+} PortTraceHeader_t;
+
+/*
+ * ucType      One of the portTRACE_ types below.
+ * ucDetail    portTRACE_BLOCK: what the task blocks on, a portTRACE_BLOCK_
+ *             value.
+ * usTask      The task running, or switched in, by its TCB number (the
+ *             xTaskNumber of TaskStatus_t); 0 before the first switch.
+ * ulEntry     Kernel entries of the tasks before the record.
+ * ulTimeNs    Host time since the start of the trace, in nanoseconds, modulo
+ *             2^32: at least one tick comes between two records 4.29 s apart,
+ *             so a reader can carry the wraps.
+ * ulValue     portTRACE_SWITCH: the tick count.  portTRACE_BLOCK: the queue,
+ *             the stream buffer (the low 32 bits of its address, to tell them
+ *             apart within one trace, which the replay does not compare), or
+ *             the tick to wake for portTRACE_BLOCK_DELAY_UNTIL.
+ *             portTRACE_TICK: the ticks given to the kernel at once.  portTRACE_INTERRUPT: the handler, by its
+ *             offset from vPortRunAsInterrupt().  portTRACE_INPUT: the length
+ *             of the data, which fill the records that follow.
+ */
+typedef struct PORT_TRACE_RECORD
+{
+	uint8_t ucType;
+	uint8_t ucDetail;
+	uint16_t usTask;
+	uint32_t ulEntry;
+	uint32_t ulTimeNs;
+	uint32_t ulValue;
+} PortTraceRecord_t;
+
+#define portTRACE_NONE				0	/* Never written, the buffer was full. */
+#define portTRACE_SWITCH			1	/* The kernel switched usTask in. */
+#define portTRACE_BLOCK				2	/* usTask blocks. */
+#define portTRACE_TICK				3
+#define portTRACE_INTERRUPT			4
+#define portTRACE_INPUT				5
+
+/* The records taken by the data of a portTRACE_INPUT record. */
+#define portTRACE_INPUT_RECORDS( ulLength )	\
+	( ( ( size_t ) ( ulLength ) + sizeof( PortTraceRecord_t ) - 1 ) / sizeof( PortTraceRecord_t ) )
+
+typedef enum
+{
+	ePortTraceOff = 0,
+	ePortTraceRecord,
+	ePortTraceReplay
+} ePortTraceMode;
+
+/*
+ * Record, or replay the trace of the file pcPath, from the start of the
+ * scheduler: the call comes before vStartFreeRTOS().  A recording
+ * holds configPORT_TRACE_RECORDS records in memory and is written to pcPath
+ * by xPortTraceStop(), or when the process exits.  Returns pdFAIL if the
+ * memory or the file cannot be had.
+ */
+BaseType_t xPortTraceStart( ePortTraceMode eMode, const char *pcPath );
+
+/*
+ * Stop recording and write the trace, or stop replaying and go on live.
+ */
+BaseType_t xPortTraceStop( void );
+
+/*
+ * Called by an interrupt handler of vPortRunAsInterrupt() on the data it
+ * brings in.  Recording, the data go into the trace.  Replaying, the recorded
+ * data replace them, up to xLength bytes.  Returns the length of the data.
+ */
+size_t xPortTraceInput( void *pvData, size_t xLength );
+
+typedef struct PORT_TRACE_STATS
+{
+	ePortTraceMode eMode;				/* Off once a replay ends or diverges. */
+	unsigned long ulRecords;			/* Records written, or in the trace replayed. */
+	unsigned long ulDroppedRecords;		/* Records lost, the buffer full. */
+	unsigned long ulReplayedInputs;		/* Ticks, interrupts and data replayed. */
+	unsigned long ulCheckedDecisions;	/* Decisions replayed as recorded. */
+	unsigned long ulDivergences;		/* 1 if the replay stopped on a decision unlike the trace. */
+	unsigned long ulDivergedRecord;		/* The record it stopped at. */
+} PortTraceStats_t;
+
+void vPortGetTraceStats( PortTraceStats_t *pxStats );
+
+portEND_EXPORTED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORT_TRACE_H */
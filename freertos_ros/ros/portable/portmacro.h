@@ -38,6 +38,14 @@
 	extern "C" {
 #endif
 
+/* The kernel headers declare the FreeRTOS API between these, so that the API
+is what libfreertos.so exports when it is built with -fvisibility=hidden, as
+the release profile of ROS/Makefile does. */
+#define portBEGIN_EXPORTED_API		_Pragma( "GCC visibility push(default)" )
+#define portEND_EXPORTED_API		_Pragma( "GCC visibility pop" )
+
+portBEGIN_EXPORTED_API
+
 /******************************************************************************
 	Defines
 ******************************************************************************/
@@ -57,16 +65,35 @@ typedef portSTACK_TYPE StackType_t;
 typedef long BaseType_t;
 typedef unsigned long UBaseType_t;
 
+/* Record and replay of the scheduling, see port_trace.h. */
+#ifndef configPORT_TRACE
+	#define configPORT_TRACE	0
+#endif
+
 #if( configUSE_16_BIT_TICKS == 1 )
     typedef uint16_t TickType_t;
     #define portMAX_DELAY ( TickType_t ) 0xffff
+#elif( configUSE_64_BIT_TICKS == 1 )
+    /* The tick count does not overflow in the life of a node, even at a
+    100 kHz tick rate, see configUSE_64_BIT_TICKS. */
+    typedef uint64_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffffffffffffffffULL
+
+	/* 64-bit tick type on a 64-bit architecture.  The replay of a trace
+	needs the tasks to read the tick count in a critical section, as an
+	interrupt changes it. */
+	#if( configPORT_TRACE == 0 )
+		#define portTICK_TYPE_IS_ATOMIC 1
+	#endif
 #else
     typedef uint32_t TickType_t;
     #define portMAX_DELAY ( TickType_t ) 0xffffffffUL
 
 	/* 32/64-bit tick type on a 32/64-bit architecture, so reads of the tick
 	count do not need to be guarded with a critical section. */
-	#define portTICK_TYPE_IS_ATOMIC 1
+	#if( configPORT_TRACE == 0 )
+		#define portTICK_TYPE_IS_ATOMIC 1
+	#endif
 #endif
 
 /* Hardware specifics. */
@@ -80,6 +107,14 @@ typedef unsigned long UBaseType_t;
 	#define portBYTE_ALIGNMENT		4
 #endif
 
+/* The width of the host word.  On a 64-bit host event groups hold 56 bits
+rather than 24, see configUSE_64_BIT_EVENT_BITS. */
+#if defined( __LP64__ )
+	#define portNATIVE_WORD_BITS	64
+#else
+	#define portNATIVE_WORD_BITS	32
+#endif
+
 //TODO: check portREMOVE_STATIC_QUALIFIER
 //#define portREMOVE_STATIC_QUALIFIER
 
@@ -112,6 +147,13 @@ extern void vPortExitCritical( void );
 #define portENTER_CRITICAL()                  vPortEnterCritical()
 #define portEXIT_CRITICAL()                   vPortExitCritical()
 
+/* The idle task leaves the processor to the host threads, the tick thread
+ * and the threads that wait for other processes, rather than spin until the
+ * next tick takes it away. */
+extern void vPortIdle( void );
+
+#define portIDLE()                            vPortIdle()
+
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site. */
@@ -122,6 +164,15 @@ extern void vPortExitCritical( void );
 
 #define portNOP()
 
+/* Tasks are host threads that may run on different cores, and the tick thread
+ * runs beside them, so data shared without a critical section needs real
+ * ordering. */
+#define portLOAD_ACQUIRE( pxAddress )				__atomic_load_n( ( pxAddress ), __ATOMIC_ACQUIRE )
+#define portSTORE_RELEASE( pxAddress, xValue )		__atomic_store_n( ( pxAddress ), ( xValue ), __ATOMIC_RELEASE )
+#define portMEMORY_BARRIER()						__atomic_thread_fence( __ATOMIC_SEQ_CST )
+#define portFETCH_AND_INCREMENT( pulValue )			__atomic_fetch_add( ( pulValue ), 1U, __ATOMIC_RELAXED )
+#define portFETCH_AND_DECREMENT( pulValue )			__atomic_fetch_sub( ( pulValue ), 1U, __ATOMIC_RELAXED )
+
 /* TODO: END */
 
 #define portOUTPUT_BYTE( a, b )
@@ -132,6 +183,60 @@ extern void vPortExitCritical( void );
 extern void vPortAddTaskHandle( void *pxTaskHandle );
 #define traceTASK_CREATE( pxNewTCB )			vPortAddTaskHandle( pxNewTCB )
 
+/* Forget the thread of a deleted task when its TCB is freed, before the heap
+ * can give the same address to the TCB of a new task. */
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )				vPortCleanUpTCB( pxTCB )
+
+#if( configPORT_TRACE == 1 )
+
+	#if( configUSE_TRACE_FACILITY != 1 )
+		#error configPORT_TRACE needs configUSE_TRACE_FACILITY set to 1, the trace names the tasks by their TCB number
+	#endif
+
+	/* What a task blocks on, in a portTRACE_BLOCK record. */
+	#define portTRACE_BLOCK_QUEUE_SEND				1
+	#define portTRACE_BLOCK_QUEUE_RECEIVE			2
+	#define portTRACE_BLOCK_QUEUE_PEEK				3
+	#define portTRACE_BLOCK_STREAM_SEND				4
+	#define portTRACE_BLOCK_STREAM_RECEIVE			5
+	#define portTRACE_BLOCK_DELAY					6
+	#define portTRACE_BLOCK_DELAY_UNTIL				7
+	#define portTRACE_BLOCK_NOTIFY_TAKE				8
+	#define portTRACE_BLOCK_NOTIFY_WAIT				9
+	#define portTRACE_BLOCK_EVENT_GROUP				10
+
+	extern void vPortTraceSwitchedIn( UBaseType_t uxTask, TickType_t xTickCount );
+	extern void vPortTraceBlocking( uint8_t ucKind, const void *pvObject, TickType_t xValue );
+
+	/* Called by port.c: around each kernel entry of a task, and with a tick
+	or an interrupt in service.  They return pdFALSE when the replay holds
+	the entry, the tick or the interrupt back. */
+	extern void vPortTraceGate( void );
+	extern BaseType_t xPortTraceKernelEntry( BaseType_t xCheck );
+	extern BaseType_t xPortTraceTick( TickType_t *pxTicks );
+	extern BaseType_t xPortTraceInterrupt( uint32_t ulHandler );
+
+	/* The task switched out is the one switched in before. */
+	#define traceTASK_SWITCHED_IN()										vPortTraceSwitchedIn( pxCurrentTCB->uxTCBNumber, xTickCount )
+	#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )						vPortTraceBlocking( portTRACE_BLOCK_QUEUE_SEND, ( pxQueue ), 0 )
+	#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )					vPortTraceBlocking( portTRACE_BLOCK_QUEUE_RECEIVE, ( pxQueue ), 0 )
+	#define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )						vPortTraceBlocking( portTRACE_BLOCK_QUEUE_PEEK, ( pxQueue ), 0 )
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )		vPortTraceBlocking( portTRACE_BLOCK_STREAM_SEND, ( xStreamBuffer ), 0 )
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )		vPortTraceBlocking( portTRACE_BLOCK_STREAM_RECEIVE, ( xStreamBuffer ), 0 )
+	#define traceTASK_DELAY()											vPortTraceBlocking( portTRACE_BLOCK_DELAY, NULL, 0 )
+	#define traceTASK_DELAY_UNTIL( xTimeToWake )						vPortTraceBlocking( portTRACE_BLOCK_DELAY_UNTIL, NULL, ( xTimeToWake ) )
+	#define traceTASK_NOTIFY_TAKE_BLOCK()								vPortTraceBlocking( portTRACE_BLOCK_NOTIFY_TAKE, NULL, 0 )
+	#define traceTASK_NOTIFY_WAIT_BLOCK()								vPortTraceBlocking( portTRACE_BLOCK_NOTIFY_WAIT, NULL, 0 )
+	#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )	vPortTraceBlocking( portTRACE_BLOCK_EVENT_GROUP, ( xEventGroup ), 0 )
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )			vPortTraceBlocking( portTRACE_BLOCK_EVENT_GROUP, ( xEventGroup ), 0 )
+
+	/* vTaskSuspendAll() is a kernel entry of the trace: an interrupt comes
+	in before or after it, not between the count and the suspension. */
+	#define portSUSPEND_ALL_IN_CRITICAL			1
+
+#endif /* configPORT_TRACE */
+
 /* Posix Signal definitions that can be changed or read as appropriate. */
 #define SIG_SUSPEND					SIGUSR1
 #define SIG_RESUME					SIGUSR2
@@ -150,6 +255,8 @@ extern void vPortAddTaskHandle( void *pxTaskHandle );
 extern unsigned long ulPortGetTimerValue( void );
 #define portGET_RUN_TIME_COUNTER_VALUE()			ulPortGetTimerValue()			/* Query the System time stats for this process. */
 
+portEND_EXPORTED_API
+
 #ifdef __cplusplus
 } /* extern C */
 #endif
@@ -0,0 +1,805 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	portable --> stream buffers shared between processes
+ */
+
+/*----------------------------------------------------------------------------
+ * A stream buffer in a POSIX shared memory segment, see shm_stream_buffer.h.
+ *
+ * The segment holds the control block and the storage area, laid out as in
+ * stream_buffer.c: only the writer moves xHead, only the reader moves xTail,
+ * and each side publishes its index once the bytes it covers are copied.
+ *
+ * Each direction has a futex word in the segment, bumped by the other side
+ * each time it publishes an index.  A task cannot wait on a futex itself - its
+ * thread would hold the whole FreeRTOS instance - so each process that opens
+ * the segment has two host threads, one per direction, that do.  A task that
+ * has to block records itself and what it waits for, bumps the futex word to
+ * get the host thread's attention, and waits for a task notification.  The
+ * host thread sleeps on the futex until the condition holds, then notifies the
+ * task from a simulated interrupt.  The other side only makes the futex system
+ * call when a host thread is waiting and what it waits for is there.
+ *----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "shm_stream_buffer.h"
+
+/*----------------------------------------------------------------------------*/
+
+#define shmMAGIC							( ( uint32_t ) 0x53534246UL )	/* Written last by the process that creates the segment. */
+#define shmBYTES_TO_STORE_MESSAGE_LENGTH	( sizeof( size_t ) )
+#define shmSTORAGE_OFFSET					( ( sizeof( ShmStreamBufferControl_t ) + 63 ) & ~( ( size_t ) 63 ) )
+#define shmOPEN_TIMEOUT_MS					1000
+
+/* The control block, at the start of the segment.  The same in every
+ * process, so it holds no pointer. */
+typedef struct SHM_STREAM_BUFFER_CONTROL
+{
+	uint32_t ulMagic;
+	uint32_t ulIsMessageBuffer;
+	size_t xLength;					/* The size of the storage area, one more than the size of the buffer. */
+	size_t xTriggerLevelBytes;
+	size_t xHead;					/* Moved by the writer only. */
+	size_t xTail;					/* Moved by the reader only. */
+	uint32_t ulDataSequence;		/* Futex, bumped when data is committed. */
+	uint32_t ulSpaceSequence;		/* Futex, bumped when data is consumed. */
+	uint32_t ulReaderWaiting;		/* Set while the reader's host thread sleeps on ulDataSequence. */
+	uint32_t ulWriterWaiting;		/* Set while the writer's host thread sleeps on ulSpaceSequence. */
+	size_t xReaderWakeLevel;		/* The bytes the reader waits for. */
+	size_t xWriterWakeLevel;		/* The free bytes the writer waits for. */
+} ShmStreamBufferControl_t;
+
+struct SHM_STREAM_BUFFER;
+
+/* One direction of a process's view of the segment. */
+typedef struct SHM_WAITER
+{
+	struct SHM_STREAM_BUFFER *pxBuffer;
+	BaseType_t xIsReader;
+	uint32_t *pulSequence;			/* The futex word of the direction. */
+	uint32_t *pulWaiting;
+	size_t *pxWakeLevel;
+	volatile TaskHandle_t xTaskWaiting;	/* The task of this process blocked in this direction, if any. */
+	volatile size_t xTaskWakeLevel;
+	pthread_t xThread;
+} ShmWaiter_t;
+
+typedef struct SHM_STREAM_BUFFER
+{
+	ShmStreamBufferControl_t *pxControl;
+	uint8_t *pucBuffer;
+	size_t xMappedSize;
+	volatile BaseType_t xClosing;
+	ShmWaiter_t xReader;
+	ShmWaiter_t xWriter;
+} ShmStreamBuffer_t;
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * The bytes the reader can read, and the bytes the writer can write.
+ */
+static size_t prvBytesInBuffer( const ShmStreamBufferControl_t * const pxControl );
+static size_t prvSpacesAvailable( const ShmStreamBufferControl_t * const pxControl );
+
+/*
+ * Block the calling task until the bytes, or the free bytes, of the direction
+ * of pxWaiter reach xLevel or xTicksToWait expires.  Returns the bytes, or the
+ * free bytes, there are.
+ */
+static size_t prvWait( ShmWaiter_t * const pxWaiter, size_t xLevel, TickType_t xTicksToWait );
+
+/*
+ * Bump the futex word of a direction, and wake the host thread waiting on it
+ * when xWake is pdTRUE or when what it waits for is there.
+ */
+static void prvSignal( ShmWaiter_t * const pxWaiter, BaseType_t xWake );
+
+/*
+ * The host thread of a direction, and the simulated interrupt it uses to wake
+ * the task.
+ */
+static void *prvWaiterThread( void *pvParameters );
+static portBASE_TYPE prvWakeTask( void *pvParameter );
+
+static void prvGetRegion( const ShmStreamBuffer_t * const pxBuffer, size_t xIndex, size_t xCount, StreamBufferRegion_t * const pxRegion );
+static size_t prvAdvanceIndex( const ShmStreamBufferControl_t * const pxControl, size_t xIndex, size_t xCount );
+static size_t prvCopyIn( ShmStreamBuffer_t * const pxBuffer, const uint8_t *pucData, size_t xCount, size_t xIndex );
+static size_t prvCopyOut( const ShmStreamBuffer_t * const pxBuffer, uint8_t *pucData, size_t xCount, size_t xIndex );
+
+/*----------------------------------------------------------------------------*/
+
+static long prvFutexWait( uint32_t *pulWord, uint32_t ulExpected )
+{
+	/* Not FUTEX_PRIVATE_FLAG, the other side is in another process. */
+	return syscall( SYS_futex, pulWord, FUTEX_WAIT, ulExpected, NULL, NULL, 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvFutexWake( uint32_t *pulWord )
+{
+	( void ) syscall( SYS_futex, pulWord, FUTEX_WAKE, INT_MAX, NULL, NULL, 0 );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvInitialiseWaiter( ShmStreamBuffer_t *pxBuffer, ShmWaiter_t *pxWaiter, BaseType_t xIsReader )
+{
+ShmStreamBufferControl_t * const pxControl = pxBuffer->pxControl;
+
+	pxWaiter->pxBuffer = pxBuffer;
+	pxWaiter->xIsReader = xIsReader;
+	pxWaiter->xTaskWaiting = NULL;
+	pxWaiter->xTaskWakeLevel = 0;
+
+	if( xIsReader != pdFALSE )
+	{
+		pxWaiter->pulSequence = &( pxControl->ulDataSequence );
+		pxWaiter->pulWaiting = &( pxControl->ulReaderWaiting );
+		pxWaiter->pxWakeLevel = &( pxControl->xReaderWakeLevel );
+	}
+	else
+	{
+		pxWaiter->pulSequence = &( pxControl->ulSpaceSequence );
+		pxWaiter->pulWaiting = &( pxControl->ulWriterWaiting );
+		pxWaiter->pxWakeLevel = &( pxControl->xWriterWakeLevel );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+ShmStreamBufferHandle_t xShmStreamBufferOpen( const char *pcName,
+											  size_t xBufferSizeBytes,
+											  size_t xTriggerLevelBytes,
+											  BaseType_t xIsMessageBuffer )
+{
+ShmStreamBuffer_t *pxBuffer;
+ShmStreamBufferControl_t *pxControl;
+BaseType_t xCreated = pdTRUE;
+struct stat xStat;
+sigset_t xAllSignals, xOldSignals;
+size_t xMappedSize;
+void *pvMapping;
+int iFd, iWait, iError;
+
+	iFd = shm_open( pcName, O_RDWR | O_CREAT | O_EXCL, 0600 );
+
+	if( iFd >= 0 )
+	{
+		if( xBufferSizeBytes == ( size_t ) 0 )
+		{
+			( void ) close( iFd );
+			( void ) shm_unlink( pcName );
+			return NULL;
+		}
+
+		xMappedSize = shmSTORAGE_OFFSET + xBufferSizeBytes + 1;
+
+		if( ftruncate( iFd, ( off_t ) xMappedSize ) != 0 )
+		{
+			( void ) close( iFd );
+			( void ) shm_unlink( pcName );
+			return NULL;
+		}
+	}
+	else if( errno == EEXIST )
+	{
+		xCreated = pdFALSE;
+		iFd = shm_open( pcName, O_RDWR, 0 );
+
+		if( iFd < 0 )
+		{
+			return NULL;
+		}
+
+		/* The creator may not have sized the segment yet. */
+		for( iWait = 0; iWait < shmOPEN_TIMEOUT_MS; iWait++ )
+		{
+			if( ( fstat( iFd, &xStat ) == 0 ) && ( ( size_t ) xStat.st_size > shmSTORAGE_OFFSET ) )
+			{
+				break;
+			}
+			usleep( 1000 );
+		}
+
+		if( iWait == shmOPEN_TIMEOUT_MS )
+		{
+			( void ) close( iFd );
+			return NULL;
+		}
+
+		xMappedSize = ( size_t ) xStat.st_size;
+	}
+	else
+	{
+		return NULL;
+	}
+
+	pvMapping = mmap( NULL, xMappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, iFd, 0 );
+	( void ) close( iFd );
+
+	if( pvMapping == MAP_FAILED )
+	{
+		if( xCreated != pdFALSE )
+		{
+			( void ) shm_unlink( pcName );
+		}
+		return NULL;
+	}
+
+	pxControl = ( ShmStreamBufferControl_t * ) pvMapping;
+
+	if( xCreated != pdFALSE )
+	{
+		/* ftruncate() zeroed the segment. */
+		if( xTriggerLevelBytes == ( size_t ) 0 )
+		{
+			xTriggerLevelBytes = ( size_t ) 1;
+		}
+
+		pxControl->xLength = xBufferSizeBytes + 1;
+		pxControl->xTriggerLevelBytes = xTriggerLevelBytes;
+		pxControl->ulIsMessageBuffer = ( xIsMessageBuffer != pdFALSE ) ? 1U : 0U;
+		__atomic_store_n( &( pxControl->ulMagic ), shmMAGIC, __ATOMIC_RELEASE );
+	}
+	else
+	{
+		for( iWait = 0; iWait < shmOPEN_TIMEOUT_MS; iWait++ )
+		{
+			if( __atomic_load_n( &( pxControl->ulMagic ), __ATOMIC_ACQUIRE ) == shmMAGIC )
+			{
+				break;
+			}
+			usleep( 1000 );
+		}
+
+		/* Not initialised, or not the buffer that was asked for. */
+		if( ( iWait == shmOPEN_TIMEOUT_MS ) ||
+			( ( shmSTORAGE_OFFSET + pxControl->xLength ) > xMappedSize ) ||
+			( ( xBufferSizeBytes != ( size_t ) 0 ) &&
+			  ( ( pxControl->xLength != ( xBufferSizeBytes + 1 ) ) ||
+				( pxControl->ulIsMessageBuffer != ( ( xIsMessageBuffer != pdFALSE ) ? 1U : 0U ) ) ) ) )
+		{
+			( void ) munmap( pvMapping, xMappedSize );
+			return NULL;
+		}
+	}
+
+	pxBuffer = ( ShmStreamBuffer_t * ) pvPortMalloc( sizeof( ShmStreamBuffer_t ) );
+
+	if( pxBuffer == NULL )
+	{
+		( void ) munmap( pvMapping, xMappedSize );
+		return NULL;
+	}
+
+	pxBuffer->pxControl = pxControl;
+	pxBuffer->pucBuffer = ( uint8_t * ) pvMapping + shmSTORAGE_OFFSET;
+	pxBuffer->xMappedSize = xMappedSize;
+	pxBuffer->xClosing = pdFALSE;
+	prvInitialiseWaiter( pxBuffer, &( pxBuffer->xReader ), pdTRUE );
+	prvInitialiseWaiter( pxBuffer, &( pxBuffer->xWriter ), pdFALSE );
+
+	/* The host threads must never take the signals the port uses to suspend
+	 * and resume tasks. */
+	sigfillset( &xAllSignals );
+	pthread_sigmask( SIG_SETMASK, &xAllSignals, &xOldSignals );
+	iError = pthread_create( &( pxBuffer->xReader.xThread ), NULL, prvWaiterThread, &( pxBuffer->xReader ) );
+
+	if( iError == 0 )
+	{
+		iError = pthread_create( &( pxBuffer->xWriter.xThread ), NULL, prvWaiterThread, &( pxBuffer->xWriter ) );
+
+		if( iError != 0 )
+		{
+			/* Stop the reader thread, as vShmStreamBufferClose() does. */
+			pxBuffer->xClosing = pdTRUE;
+			prvSignal( &( pxBuffer->xReader ), pdTRUE );
+			( void ) pthread_join( pxBuffer->xReader.xThread, NULL );
+		}
+	}
+
+	pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+
+	if( iError != 0 )
+	{
+		( void ) munmap( pvMapping, xMappedSize );
+
+		if( xCreated != pdFALSE )
+		{
+			( void ) shm_unlink( pcName );
+		}
+
+		vPortFree( pxBuffer );
+		return NULL;
+	}
+
+	return ( ShmStreamBufferHandle_t ) pxBuffer;
+}
+/*----------------------------------------------------------------------------*/
+
+void vShmStreamBufferClose( ShmStreamBufferHandle_t xBuffer )
+{
+ShmStreamBuffer_t * const pxBuffer = ( ShmStreamBuffer_t * ) xBuffer;
+
+	configASSERT( pxBuffer );
+	configASSERT( pxBuffer->xReader.xTaskWaiting == NULL );
+	configASSERT( pxBuffer->xWriter.xTaskWaiting == NULL );
+
+	pxBuffer->xClosing = pdTRUE;
+	prvSignal( &( pxBuffer->xReader ), pdTRUE );
+	prvSignal( &( pxBuffer->xWriter ), pdTRUE );
+	( void ) pthread_join( pxBuffer->xReader.xThread, NULL );
+	( void ) pthread_join( pxBuffer->xWriter.xThread, NULL );
+
+	( void ) munmap( ( void * ) pxBuffer->pxControl, pxBuffer->xMappedSize );
+	vPortFree( pxBuffer );
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xShmStreamBufferUnlink( const char *pcName )
+{
+	return ( shm_unlink( pcName ) == 0 ) ? pdPASS : pdFAIL;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferReserve( ShmStreamBufferHandle_t xBuffer,
+								size_t xDataLengthBytes,
+								StreamBufferRegion_t * const pxRegion,
+								TickType_t xTicksToWait )
+{
+ShmStreamBuffer_t * const pxBuffer = ( ShmStreamBuffer_t * ) xBuffer;
+ShmStreamBufferControl_t * const pxControl = pxBuffer->pxControl;
+size_t xReturn, xSpace, xBytesToStoreMessageLength = 0;
+
+	configASSERT( pxRegion );
+	configASSERT( xDataLengthBytes > ( size_t ) 0 );
+
+	if( pxControl->ulIsMessageBuffer != 0U )
+	{
+		xBytesToStoreMessageLength = shmBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+
+	xSpace = prvWait( &( pxBuffer->xWriter ), xDataLengthBytes + xBytesToStoreMessageLength, xTicksToWait );
+
+	if( xBytesToStoreMessageLength != ( size_t ) 0 )
+	{
+		/* A message is reserved whole or not at all. */
+		xReturn = ( xSpace >= ( xDataLengthBytes + xBytesToStoreMessageLength ) ) ? xDataLengthBytes : ( size_t ) 0;
+	}
+	else
+	{
+		xReturn = configMIN( xSpace, xDataLengthBytes );
+	}
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		/* The length of a message goes in front of it at the commit. */
+		prvGetRegion( pxBuffer, prvAdvanceIndex( pxControl, pxControl->xHead, xBytesToStoreMessageLength ), xReturn, pxRegion );
+	}
+	else
+	{
+		prvGetRegion( pxBuffer, 0, 0, pxRegion );
+	}
+
+	return xReturn;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferCommit( ShmStreamBufferHandle_t xBuffer, size_t xDataLengthBytes )
+{
+ShmStreamBuffer_t * const pxBuffer = ( ShmStreamBuffer_t * ) xBuffer;
+ShmStreamBufferControl_t * const pxControl = pxBuffer->pxControl;
+size_t xNextHead;
+
+	if( xDataLengthBytes > ( size_t ) 0 )
+	{
+		xNextHead = pxControl->xHead;
+
+		if( pxControl->ulIsMessageBuffer != 0U )
+		{
+			configASSERT( ( xDataLengthBytes + shmBYTES_TO_STORE_MESSAGE_LENGTH ) <= prvSpacesAvailable( pxControl ) );
+			xNextHead = prvCopyIn( pxBuffer, ( const uint8_t * ) &xDataLengthBytes, shmBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+		}
+		else
+		{
+			configASSERT( xDataLengthBytes <= prvSpacesAvailable( pxControl ) );
+		}
+
+		xNextHead = prvAdvanceIndex( pxControl, xNextHead, xDataLengthBytes );
+		portSTORE_RELEASE( &( pxControl->xHead ), xNextHead );
+
+		prvSignal( &( pxBuffer->xReader ), pdFALSE );
+	}
+
+	return xDataLengthBytes;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferPeekContiguous( ShmStreamBufferHandle_t xBuffer,
+									   StreamBufferRegion_t * const pxRegion,
+									   TickType_t xTicksToWait )
+{
+ShmStreamBuffer_t * const pxBuffer = ( ShmStreamBuffer_t * ) xBuffer;
+ShmStreamBufferControl_t * const pxControl = pxBuffer->pxControl;
+size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength = 0, xIndex;
+
+	configASSERT( pxRegion );
+
+	if( pxControl->ulIsMessageBuffer != 0U )
+	{
+		xBytesToStoreMessageLength = shmBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+
+	xBytesAvailable = prvWait( &( pxBuffer->xReader ), configMAX( pxControl->xTriggerLevelBytes, xBytesToStoreMessageLength + 1 ), xTicksToWait );
+
+	if( xBytesAvailable > xBytesToStoreMessageLength )
+	{
+		xIndex = pxControl->xTail;
+
+		if( xBytesToStoreMessageLength != ( size_t ) 0 )
+		{
+			xIndex = prvCopyOut( pxBuffer, ( uint8_t * ) &xReturn, xBytesToStoreMessageLength, xIndex );
+			configASSERT( xReturn <= ( xBytesAvailable - xBytesToStoreMessageLength ) );
+		}
+		else
+		{
+			xReturn = xBytesAvailable;
+		}
+
+		prvGetRegion( pxBuffer, xIndex, xReturn, pxRegion );
+	}
+	else
+	{
+		prvGetRegion( pxBuffer, 0, 0, pxRegion );
+	}
+
+	return xReturn;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferConsume( ShmStreamBufferHandle_t xBuffer, size_t xBytesToConsume )
+{
+ShmStreamBuffer_t * const pxBuffer = ( ShmStreamBuffer_t * ) xBuffer;
+ShmStreamBufferControl_t * const pxControl = pxBuffer->pxControl;
+size_t xNextTail, xNextMessageLength;
+
+	if( xBytesToConsume > ( size_t ) 0 )
+	{
+		xNextTail = pxControl->xTail;
+
+		if( pxControl->ulIsMessageBuffer != 0U )
+		{
+			configASSERT( prvBytesInBuffer( pxControl ) > shmBYTES_TO_STORE_MESSAGE_LENGTH );
+			xNextTail = prvCopyOut( pxBuffer, ( uint8_t * ) &xNextMessageLength, shmBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+			configASSERT( xBytesToConsume == xNextMessageLength );
+		}
+		else
+		{
+			configASSERT( xBytesToConsume <= prvBytesInBuffer( pxControl ) );
+		}
+
+		xNextTail = prvAdvanceIndex( pxControl, xNextTail, xBytesToConsume );
+		portSTORE_RELEASE( &( pxControl->xTail ), xNextTail );
+
+		prvSignal( &( pxBuffer->xWriter ), pdFALSE );
+	}
+
+	return xBytesToConsume;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferSend( ShmStreamBufferHandle_t xBuffer,
+							 const void *pvTxData,
+							 size_t xDataLengthBytes,
+							 TickType_t xTicksToWait )
+{
+ShmStreamBuffer_t * const pxBuffer = ( ShmStreamBuffer_t * ) xBuffer;
+StreamBufferRegion_t xRegion;
+size_t xReturn;
+
+	configASSERT( pvTxData );
+
+	xReturn = xShmStreamBufferReserve( xBuffer, xDataLengthBytes, &xRegion, xTicksToWait );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		( void ) prvCopyIn( pxBuffer, ( const uint8_t * ) pvTxData, xReturn, ( size_t ) ( xRegion.pucFirst - pxBuffer->pucBuffer ) );
+		( void ) xShmStreamBufferCommit( xBuffer, xReturn );
+	}
+
+	return xReturn;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferReceive( ShmStreamBufferHandle_t xBuffer,
+								void *pvRxData,
+								size_t xBufferLengthBytes,
+								TickType_t xTicksToWait )
+{
+ShmStreamBuffer_t * const pxBuffer = ( ShmStreamBuffer_t * ) xBuffer;
+StreamBufferRegion_t xRegion;
+size_t xReturn;
+
+	configASSERT( pvRxData );
+
+	xReturn = xShmStreamBufferPeekContiguous( xBuffer, &xRegion, xTicksToWait );
+
+	if( pxBuffer->pxControl->ulIsMessageBuffer != 0U )
+	{
+		/* A message that does not fit is left in the buffer. */
+		if( xReturn > xBufferLengthBytes )
+		{
+			xReturn = 0;
+		}
+	}
+	else
+	{
+		xReturn = configMIN( xReturn, xBufferLengthBytes );
+	}
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		( void ) prvCopyOut( pxBuffer, ( uint8_t * ) pvRxData, xReturn, ( size_t ) ( xRegion.pucFirst - pxBuffer->pucBuffer ) );
+		( void ) xShmStreamBufferConsume( xBuffer, xReturn );
+	}
+
+	return xReturn;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferBytesAvailable( ShmStreamBufferHandle_t xBuffer )
+{
+	return prvBytesInBuffer( ( ( ShmStreamBuffer_t * ) xBuffer )->pxControl );
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xShmStreamBufferSpacesAvailable( ShmStreamBufferHandle_t xBuffer )
+{
+	return prvSpacesAvailable( ( ( ShmStreamBuffer_t * ) xBuffer )->pxControl );
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvWait( ShmWaiter_t * const pxWaiter, size_t xLevel, TickType_t xTicksToWait )
+{
+const ShmStreamBufferControl_t * const pxControl = pxWaiter->pxBuffer->pxControl;
+TimeOut_t xTimeOut;
+size_t xAvailable;
+
+	xAvailable = ( pxWaiter->xIsReader != pdFALSE ) ? prvBytesInBuffer( pxControl ) : prvSpacesAvailable( pxControl );
+
+	if( ( xAvailable < xLevel ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			taskENTER_CRITICAL();
+			{
+				xAvailable = ( pxWaiter->xIsReader != pdFALSE ) ? prvBytesInBuffer( pxControl ) : prvSpacesAvailable( pxControl );
+
+				if( xAvailable >= xLevel )
+				{
+					taskEXIT_CRITICAL();
+					break;
+				}
+
+				/* Clear notification state as going to wait. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one task per direction. */
+				configASSERT( pxWaiter->xTaskWaiting == NULL );
+				pxWaiter->xTaskWakeLevel = xLevel;
+				pxWaiter->xTaskWaiting = xTaskGetCurrentTaskHandle();
+			}
+			taskEXIT_CRITICAL();
+
+			/* Hand the wait over to the host thread. */
+			prvSignal( pxWaiter, pdTRUE );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxWaiter->xTaskWaiting = NULL;
+
+			xAvailable = ( pxWaiter->xIsReader != pdFALSE ) ? prvBytesInBuffer( pxControl ) : prvSpacesAvailable( pxControl );
+
+		} while( ( xAvailable < xLevel ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+	}
+
+	return xAvailable;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvSignal( ShmWaiter_t * const pxWaiter, BaseType_t xWake )
+{
+const ShmStreamBufferControl_t * const pxControl = pxWaiter->pxBuffer->pxControl;
+size_t xAvailable;
+
+	/* The index was published before the bump, so a host thread that reads
+	 * the futex word after the bump sees the data or the space.  One that read
+	 * it before sleeps with a stale value, and the futex does not let it. */
+	( void ) __atomic_add_fetch( pxWaiter->pulSequence, 1U, __ATOMIC_SEQ_CST );
+
+	if( ( xWake == pdFALSE ) && ( __atomic_load_n( pxWaiter->pulWaiting, __ATOMIC_SEQ_CST ) != 0U ) )
+	{
+		xAvailable = ( pxWaiter->xIsReader != pdFALSE ) ? prvBytesInBuffer( pxControl ) : prvSpacesAvailable( pxControl );
+		xWake = ( xAvailable >= __atomic_load_n( pxWaiter->pxWakeLevel, __ATOMIC_RELAXED ) ) ? pdTRUE : pdFALSE;
+	}
+
+	if( xWake != pdFALSE )
+	{
+		prvFutexWake( pxWaiter->pulSequence );
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void *prvWaiterThread( void *pvParameters )
+{
+ShmWaiter_t * const pxWaiter = ( ShmWaiter_t * ) pvParameters;
+const ShmStreamBufferControl_t * const pxControl = pxWaiter->pxBuffer->pxControl;
+uint32_t ulSequence;
+size_t xAvailable;
+BaseType_t xWaiting = pdFALSE;
+
+	while( pxWaiter->pxBuffer->xClosing == pdFALSE )
+	{
+		/* Read before the task is checked: a task that blocks afterwards
+		 * bumps the word, and the wait returns at once. */
+		ulSequence = __atomic_load_n( pxWaiter->pulSequence, __ATOMIC_SEQ_CST );
+
+		if( pxWaiter->xTaskWaiting != NULL )
+		{
+			/* Tell the other side what to wake this thread for, then look at
+			 * the buffer again. */
+			__atomic_store_n( pxWaiter->pxWakeLevel, pxWaiter->xTaskWakeLevel, __ATOMIC_RELAXED );
+			__atomic_store_n( pxWaiter->pulWaiting, 1U, __ATOMIC_SEQ_CST );
+			xWaiting = pdTRUE;
+			ulSequence = __atomic_load_n( pxWaiter->pulSequence, __ATOMIC_SEQ_CST );
+
+			xAvailable = ( pxWaiter->xIsReader != pdFALSE ) ? prvBytesInBuffer( pxControl ) : prvSpacesAvailable( pxControl );
+
+			if( xAvailable >= pxWaiter->xTaskWakeLevel )
+			{
+				__atomic_store_n( pxWaiter->pulWaiting, 0U, __ATOMIC_SEQ_CST );
+				xWaiting = pdFALSE;
+				vPortRunAsInterrupt( prvWakeTask, pxWaiter );
+				continue;
+			}
+		}
+		else if( xWaiting != pdFALSE )
+		{
+			/* Nobody to wake, the other side need not make system calls.  The
+			 * flag is shared with the thread of the other process for the same
+			 * direction, only clear it when this thread set it. */
+			__atomic_store_n( pxWaiter->pulWaiting, 0U, __ATOMIC_SEQ_CST );
+			xWaiting = pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) prvFutexWait( pxWaiter->pulSequence, ulSequence );
+	}
+
+	if( xWaiting != pdFALSE )
+	{
+		__atomic_store_n( pxWaiter->pulWaiting, 0U, __ATOMIC_SEQ_CST );
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvWakeTask( void *pvParameter )
+{
+ShmWaiter_t * const pxWaiter = ( ShmWaiter_t * ) pvParameter;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* The task may have timed out in the meantime. */
+	if( pxWaiter->xTaskWaiting != NULL )
+	{
+		( void ) xTaskNotifyFromISR( pxWaiter->xTaskWaiting, ( uint32_t ) 0, eNoAction, &xHigherPriorityTaskWoken );
+		pxWaiter->xTaskWaiting = NULL;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const ShmStreamBufferControl_t * const pxControl )
+{
+size_t xCount;
+
+	xCount = pxControl->xLength + portLOAD_ACQUIRE( &( pxControl->xHead ) );
+	xCount -= portLOAD_ACQUIRE( &( pxControl->xTail ) );
+
+	if( xCount >= pxControl->xLength )
+	{
+		xCount -= pxControl->xLength;
+	}
+
+	return xCount;
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvSpacesAvailable( const ShmStreamBufferControl_t * const pxControl )
+{
+size_t xSpace;
+
+	xSpace = pxControl->xLength + portLOAD_ACQUIRE( &( pxControl->xTail ) );
+	xSpace -= portLOAD_ACQUIRE( &( pxControl->xHead ) );
+	xSpace -= ( size_t ) 1;
+
+	if( xSpace >= pxControl->xLength )
+	{
+		xSpace -= pxControl->xLength;
+	}
+
+	return xSpace;
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvGetRegion( const ShmStreamBuffer_t * const pxBuffer, size_t xIndex, size_t xCount, StreamBufferRegion_t * const pxRegion )
+{
+	pxRegion->xFirstLength = configMIN( pxBuffer->pxControl->xLength - xIndex, xCount );
+	pxRegion->pucFirst = ( pxRegion->xFirstLength > ( size_t ) 0 ) ? &( pxBuffer->pucBuffer[ xIndex ] ) : NULL;
+	pxRegion->xSecondLength = xCount - pxRegion->xFirstLength;
+	pxRegion->pucSecond = ( pxRegion->xSecondLength > ( size_t ) 0 ) ? pxBuffer->pucBuffer : NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvAdvanceIndex( const ShmStreamBufferControl_t * const pxControl, size_t xIndex, size_t xCount )
+{
+size_t xNextIndex = xIndex + xCount;
+
+	if( xNextIndex >= pxControl->xLength )
+	{
+		xNextIndex -= pxControl->xLength;
+	}
+
+	return xNextIndex;
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvCopyIn( ShmStreamBuffer_t * const pxBuffer, const uint8_t *pucData, size_t xCount, size_t xIndex )
+{
+size_t xFirstLength = configMIN( pxBuffer->pxControl->xLength - xIndex, xCount );
+
+	memcpy( &( pxBuffer->pucBuffer[ xIndex ] ), pucData, xFirstLength );
+
+	if( xCount > xFirstLength )
+	{
+		memcpy( pxBuffer->pucBuffer, &( pucData[ xFirstLength ] ), xCount - xFirstLength );
+	}
+
+	return prvAdvanceIndex( pxBuffer->pxControl, xIndex, xCount );
+}
+/*----------------------------------------------------------------------------*/
+
+static size_t prvCopyOut( const ShmStreamBuffer_t * const pxBuffer, uint8_t *pucData, size_t xCount, size_t xIndex )
+{
+size_t xFirstLength = configMIN( pxBuffer->pxControl->xLength - xIndex, xCount );
+
+	memcpy( pucData, &( pxBuffer->pucBuffer[ xIndex ] ), xFirstLength );
+
+	if( xCount > xFirstLength )
+	{
+		memcpy( &( pucData[ xFirstLength ] ), pxBuffer->pucBuffer, xCount - xFirstLength );
+	}
+
+	return prvAdvanceIndex( pxBuffer->pxControl, xIndex, xCount );
+}
+/*----------------------------------------------------------------------------*/
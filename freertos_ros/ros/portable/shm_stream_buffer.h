@@ -0,0 +1,110 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	portable --> stream buffers shared between processes
+ */
+
+#ifndef SHM_STREAM_BUFFER_H
+#define SHM_STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include shm_stream_buffer.h"
+#endif
+
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+portBEGIN_EXPORTED_API
+
+/*
+ * A stream buffer, or a message buffer, whose control block and storage area
+ * live in a named POSIX shared memory segment, so that tasks of the FreeRTOS
+ * instances of two processes - two ROS nodes that each load libfreertos.so -
+ * can stream data to each other without going through a ROS topic.
+ *
+ * The rules of stream_buffer.h apply: one writer and one reader, which may be
+ * in the same process or in two processes.  A task that has to wait blocks as
+ * on a stream buffer; the other process wakes it through a futex in the
+ * segment, which a host thread of the waiting process turns into a simulated
+ * interrupt (see vPortRunAsInterrupt()).  With a block time of 0 the
+ * functions do not use the kernel at all, so a plain thread of a ROS node can
+ * be the writer or the reader.
+ *
+ * Data is copied once by xShmStreamBufferSend() and xShmStreamBufferReceive(),
+ * and not at all with the reserve/commit and peek/consume functions.
+ */
+typedef void * ShmStreamBufferHandle_t;
+
+/*
+ * Open the segment pcName ("/name", as for shm_open()), creating and
+ * initialising it if it does not exist yet.  The process that creates the
+ * segment sets the size, trigger level and type; a process that opens an
+ * existing segment must pass the same size and type, or 0 as the size to
+ * take those of the segment.  Returns NULL on failure.
+ *
+ * The segment stays until xShmStreamBufferUnlink() is called, even when no
+ * process has it open.
+ */
+ShmStreamBufferHandle_t xShmStreamBufferOpen( const char *pcName,
+											  size_t xBufferSizeBytes,
+											  size_t xTriggerLevelBytes,
+											  BaseType_t xIsMessageBuffer );
+
+/*
+ * Close the segment in this process.  No task of this process may be blocked
+ * on it.
+ */
+void vShmStreamBufferClose( ShmStreamBufferHandle_t xBuffer );
+
+/*
+ * Remove the name of the segment, as shm_unlink() does.  Processes that have
+ * it open can go on using it.
+ */
+BaseType_t xShmStreamBufferUnlink( const char *pcName );
+
+/*
+ * As xStreamBufferSend() and xStreamBufferReceive(), or xMessageBufferSend()
+ * and xMessageBufferReceive() when the segment is a message buffer.
+ */
+size_t xShmStreamBufferSend( ShmStreamBufferHandle_t xBuffer,
+							 const void *pvTxData,
+							 size_t xDataLengthBytes,
+							 TickType_t xTicksToWait );
+
+size_t xShmStreamBufferReceive( ShmStreamBufferHandle_t xBuffer,
+								void *pvRxData,
+								size_t xBufferLengthBytes,
+								TickType_t xTicksToWait );
+
+/*
+ * As xStreamBufferReserve(), xStreamBufferCommit(),
+ * xStreamBufferPeekContiguous() and xStreamBufferConsume().  The regions
+ * point into the segment as mapped by this process.
+ */
+size_t xShmStreamBufferReserve( ShmStreamBufferHandle_t xBuffer,
+								size_t xDataLengthBytes,
+								StreamBufferRegion_t * const pxRegion,
+								TickType_t xTicksToWait );
+
+size_t xShmStreamBufferCommit( ShmStreamBufferHandle_t xBuffer, size_t xDataLengthBytes );
+
+size_t xShmStreamBufferPeekContiguous( ShmStreamBufferHandle_t xBuffer,
+									   StreamBufferRegion_t * const pxRegion,
+									   TickType_t xTicksToWait );
+
+size_t xShmStreamBufferConsume( ShmStreamBufferHandle_t xBuffer, size_t xBytesToConsume );
+
+size_t xShmStreamBufferBytesAvailable( ShmStreamBufferHandle_t xBuffer );
+
+size_t xShmStreamBufferSpacesAvailable( ShmStreamBufferHandle_t xBuffer );
+
+portEND_EXPORTED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHM_STREAM_BUFFER_H */
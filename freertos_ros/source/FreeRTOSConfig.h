@@ -42,33 +42,51 @@
 #define configUSE_PREEMPTION                    1
 #define configUSE_TICKLESS_IDLE                 0
 #define configCPU_CLOCK_HZ                      (SystemCoreClock)
+/* The tick rate, the priorities, the heap and its scheme can be tuned per node
+ * (see cmake/FreeRTOSKernel.cmake). */
+#ifndef configTICK_RATE_HZ
 #define configTICK_RATE_HZ                      ((TickType_t)200)
+#endif
+#ifndef configMAX_PRIORITIES
 #define configMAX_PRIORITIES                    5
+#endif
 #define configMINIMAL_STACK_SIZE                ((unsigned short)90)
 #define configMAX_TASK_NAME_LEN                 20
 #define configUSE_16_BIT_TICKS                  0
+/* The node runs for months, a 64-bit tick count does not wrap. */
+#define configUSE_64_BIT_TICKS                  1
 #define configIDLE_SHOULD_YIELD                 1
 #define configUSE_TASK_NOTIFICATIONS            1
 #define configUSE_MUTEXES                       1
 #define configUSE_RECURSIVE_MUTEXES             1
+/* The motor control stack nests locks: pass priorities on down chains of held
+ * mutexes, and count the contention of each mutex. */
+#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 1
+#define configUSE_MUTEX_STATS                   1
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_ALTERNATIVE_API               0 /* Deprecated! */
 #define configQUEUE_REGISTRY_SIZE               8
 #define configUSE_QUEUE_SETS                    0
+/* Nodes wait on many queues, stream buffers and notifications at once. */
+#define configUSE_POLL_SETS                     1
 #define configUSE_TIME_SLICING                  0
 #define configUSE_NEWLIB_REENTRANT              0
 #define configENABLE_BACKWARD_COMPATIBILITY     0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
 
 /* Used memory allocation (heap_x.c) */
+#ifndef configFRTOS_MEMORY_SCHEME
 #define configFRTOS_MEMORY_SCHEME               4
+#endif
 /* Tasks.c additions (e.g. Thread Aware Debug capability) */
 #define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H 1
 
 /* Memory allocation related definitions. */
 #define configSUPPORT_STATIC_ALLOCATION         0
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
+#ifndef configTOTAL_HEAP_SIZE
 #define configTOTAL_HEAP_SIZE                   ((size_t)(10 * 1024))
+#endif
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
@@ -38,6 +38,8 @@
 #include "queue.h"
 #include "timers.h"
 
+#include "freertos_hello.h"
+
 /* Freescale includes. */
 //CHECK #include "fsl_device_registers.h"
 //CHECK #include "fsl_debug_console.h"
@@ -58,6 +60,14 @@ static void hello_first(void *pvParameters);
 
 static void hello_second(void *pvParameters);
 
+/* The first task is the only writer, and the ROS node the reader: three
+buffers, so a write never has to wait for the node to finish reading. */
+#define hello_state_BUFFERS 3
+
+SnapshotHandle_t xHelloStateSnapshot = NULL;
+
+static volatile uint32_t ulSecondCount = 0;
+
 #include <stdio.h>
 #define PRINTF printf
 
@@ -69,8 +79,22 @@ static void hello_second(void *pvParameters);
  */
 int freeRTOS_main(void)
 {
+    SnapshotHandle_t xSnapshot;
+
     printf("freertos_hello --> main\n");
 
+    xSnapshot = xSnapshotCreate(sizeof(HelloState_t), hello_state_BUFFERS);
+    if (xSnapshot == NULL)
+    {
+        printf("Snapshot creation failed!.\r\n");
+        while (1)
+            ;
+    }
+
+    /* The ROS node polls the handle from its own thread: the release store
+    publishes the snapshot only once it is initialised. */
+    __atomic_store_n(&xHelloStateSnapshot, xSnapshot, __ATOMIC_RELEASE);
+
     /* Init board hardware. */
     //CHECK BOARD_InitPins();
     //CHECK BOARD_BootClockRUN();
@@ -101,9 +125,17 @@ int freeRTOS_main(void)
  */
 static void hello_first(void *pvParameters)
 {
+    HelloState_t xState = {0};
+
     for (;;)
     {
         PRINTF("\r\n1 --> Hello world.\r\n\r\n");
+
+        xState.ulFirstCount++;
+        xState.ulSecondCount = ulSecondCount;
+        xState.ullTick = (uint64_t)xTaskGetTickCount();
+        (void)xSnapshotWrite(xHelloStateSnapshot, &xState);
+
         vTaskDelay(100 / portTICK_PERIOD_MS);
     }
 }
@@ -116,6 +148,7 @@ static void hello_second(void *pvParameters)
     for (;;)
     {
         PRINTF("\r\n2 --> Hello world.\r\n\r\n");
+        ulSecondCount++;
         vTaskDelay(50 / portTICK_PERIOD_MS);
     }
 }
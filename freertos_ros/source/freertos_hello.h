@@ -0,0 +1,42 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	source --> state the hello tasks share with the ROS node
+ */
+
+#ifndef FREERTOS_HELLO_H
+#define FREERTOS_HELLO_H
+
+#include "FreeRTOS.h"
+#include "snapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+portBEGIN_EXPORTED_API
+
+/*
+ * The state the first hello task publishes each time it runs.  The ROS node
+ * reads it from its own thread, which is not a task, so it is published as a
+ * snapshot: reading it never blocks the tasks.
+ */
+typedef struct HELLO_STATE
+{
+	uint32_t ulFirstCount;		/* Messages printed by the first task. */
+	uint32_t ulSecondCount;		/* Messages printed by the second task. */
+	uint64_t ullTick;			/* Tick count when the state was published. */
+} HelloState_t;
+
+/* NULL until freeRTOS_main() has created it.  Stored with release semantics,
+so a thread other than the tasks reads it with an acquire load,
+__atomic_load_n( &xHelloStateSnapshot, __ATOMIC_ACQUIRE ). */
+extern SnapshotHandle_t xHelloStateSnapshot;
+
+portEND_EXPORTED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREERTOS_HELLO_H */
@@ -0,0 +1,261 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	source --> echo task between the ROS latency node and FreeRTOS
+ */
+
+#include <semaphore.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "message_buffer.h"
+#include "port.h"
+#if( configPORT_TRACE == 1 )
+	#include "port_trace.h"
+#endif
+
+#include "freertos_latency.h"
+
+/* Task priorities: the echo task above the load. */
+#define latency_echo_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define latency_load_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/* Room for a few messages of the largest size in each direction. */
+#define latency_BUFFER_BYTES		( 8 * ( latencyMAX_MESSAGE + sizeof( size_t ) ) )
+
+/* Iterations of a load task between two yields. */
+#define latency_load_SPIN			10000
+
+typedef struct LATENCY_TRANSFER
+{
+	void *pvMessage;
+	size_t xLength;
+	size_t xTransferred;
+} LatencyTransfer_t;
+
+static MessageBufferHandle_t xIngress = NULL;
+static MessageBufferHandle_t xEgress = NULL;
+static sem_t xEgressReady;
+
+static volatile BaseType_t xReady = pdFALSE;
+static volatile UBaseType_t uxActiveLoad = 0;
+static volatile uint32_t ulDroppedReplies = 0;
+
+static void prvEchoTask( void *pvParameters );
+static void prvLoadTask( void *pvParameters );
+
+/*----------------------------------------------------------------------------*/
+
+int freeRTOS_main( void )
+{
+UBaseType_t x;
+
+	printf( "freertos_latency --> main\n" );
+
+	xIngress = xMessageBufferCreate( latency_BUFFER_BYTES );
+	xEgress = xMessageBufferCreate( latency_BUFFER_BYTES );
+
+	if( ( xIngress == NULL ) || ( xEgress == NULL ) )
+	{
+		printf( "freertos_latency --> message buffer creation failed\n" );
+		return -1;
+	}
+
+	( void ) sem_init( &xEgressReady, 0, 0 );
+
+	/* The scheduler is not started on a failure, so the node gets the error
+	back from vStartFreeRTOS() rather than waiting for xLatencyReady(). */
+	if( xTaskCreate( prvEchoTask, "Echo", configMINIMAL_STACK_SIZE, NULL, latency_echo_PRIORITY, NULL ) != pdPASS )
+	{
+		printf( "freertos_latency --> echo task creation failed\n" );
+		return -1;
+	}
+
+	for( x = 0; x < latencyMAX_LOAD_TASKS; x++ )
+	{
+		if( xTaskCreate( prvLoadTask, "Load", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, latency_load_PRIORITY, NULL ) != pdPASS )
+		{
+			printf( "freertos_latency --> load task %lu creation failed\n", ( unsigned long ) x );
+			return -1;
+		}
+	}
+
+	xReady = pdTRUE;
+
+	vTaskStartScheduler();
+
+	for( ;; );
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvEchoTask( void *pvParameters )
+{
+static uint8_t ucMessage[ latencyMAX_MESSAGE ];
+LatencyStamps_t *pxStamps = ( LatencyStamps_t * ) ucMessage;
+size_t xLength;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xLength = xMessageBufferReceive( xIngress, ucMessage, sizeof( ucMessage ), portMAX_DELAY );
+
+		if( xLength >= sizeof( LatencyStamps_t ) )
+		{
+			pxStamps->ullTaskNs = ullLatencyNowNs();
+
+			/* sem_post() takes no lock, so the node thread is woken even if
+			this task is switched out right after. */
+			if( xMessageBufferSend( xEgress, ucMessage, xLength, 0 ) == xLength )
+			{
+				( void ) sem_post( &xEgressReady );
+			}
+			else
+			{
+				ulDroppedReplies++;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static void prvLoadTask( void *pvParameters )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+volatile uint32_t ulWork = 0;
+uint32_t x;
+
+	for( ;; )
+	{
+		if( uxIndex < uxActiveLoad )
+		{
+			for( x = 0; x < latency_load_SPIN; x++ )
+			{
+				ulWork++;
+			}
+
+			taskYIELD();
+		}
+		else
+		{
+			vTaskDelay( 10 );
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvSendIngress( void *pvParameter )
+{
+LatencyTransfer_t * const pxTransfer = ( LatencyTransfer_t * ) pvParameter;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	#if( configPORT_TRACE == 1 )
+	{
+		/* The ROS message is an input of the trace; replaying, the recorded
+		one takes its place.  The handlers run one at a time. */
+		static uint8_t ucMessage[ latencyMAX_MESSAGE ];
+
+		memcpy( ucMessage, pxTransfer->pvMessage, pxTransfer->xLength );
+		pxTransfer->xLength = xPortTraceInput( ucMessage, pxTransfer->xLength );
+		pxTransfer->pvMessage = ucMessage;
+	}
+	#endif
+
+	pxTransfer->xTransferred = xMessageBufferSendFromISR( xIngress, pxTransfer->pvMessage, pxTransfer->xLength, &xHigherPriorityTaskWoken );
+
+	return xHigherPriorityTaskWoken;
+}
+/*----------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvSetLoad( void *pvParameter )
+{
+UBaseType_t * const puxTasks = ( UBaseType_t * ) pvParameter;
+
+	#if( configPORT_TRACE == 1 )
+	{
+		( void ) xPortTraceInput( puxTasks, sizeof( *puxTasks ) );
+	}
+	#endif
+
+	uxActiveLoad = *puxTasks;
+
+	return pdFALSE;
+}
+/*----------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvReceiveEgress( void *pvParameter )
+{
+LatencyTransfer_t * const pxTransfer = ( LatencyTransfer_t * ) pvParameter;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	pxTransfer->xTransferred = xMessageBufferReceiveFromISR( xEgress, pxTransfer->pvMessage, pxTransfer->xLength, &xHigherPriorityTaskWoken );
+
+	return xHigherPriorityTaskWoken;
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xLatencyReady( void )
+{
+	return xReady;
+}
+/*----------------------------------------------------------------------------*/
+
+BaseType_t xLatencyIngress( const void *pvMessage, size_t xLength )
+{
+LatencyTransfer_t xTransfer;
+
+	configASSERT( xReady != pdFALSE );
+	configASSERT( ( xLength >= sizeof( LatencyStamps_t ) ) && ( xLength <= latencyMAX_MESSAGE ) );
+
+	xTransfer.pvMessage = ( void * ) pvMessage;
+	xTransfer.xLength = xLength;
+	xTransfer.xTransferred = 0;
+
+	vPortRunAsInterrupt( prvSendIngress, &xTransfer );
+
+	return ( xTransfer.xTransferred == xTransfer.xLength ) ? pdPASS : pdFAIL;
+}
+/*----------------------------------------------------------------------------*/
+
+size_t xLatencyEgress( void *pvBuffer, size_t xBufferLength )
+{
+LatencyTransfer_t xTransfer;
+
+	configASSERT( xReady != pdFALSE );
+
+	xTransfer.pvMessage = pvBuffer;
+	xTransfer.xLength = xBufferLength;
+	xTransfer.xTransferred = 0;
+
+	/* One post for each reply in the buffer. */
+	while( sem_wait( &xEgressReady ) != 0 )
+	{
+		/* Interrupted by the signals of the port, wait again. */
+	}
+
+	vPortRunAsInterrupt( prvReceiveEgress, &xTransfer );
+
+	return xTransfer.xTransferred;
+}
+/*----------------------------------------------------------------------------*/
+
+void vLatencySetLoad( UBaseType_t uxTasks )
+{
+	uxTasks = ( uxTasks < latencyMAX_LOAD_TASKS ) ? uxTasks : latencyMAX_LOAD_TASKS;
+
+	/* From an interrupt, so that the trace of the port has the change. */
+	vPortRunAsInterrupt( prvSetLoad, &uxTasks );
+}
+/*----------------------------------------------------------------------------*/
+
+uint32_t ulLatencyDroppedReplies( void )
+{
+	return ulDroppedReplies;
+}
@@ -0,0 +1,91 @@
+/*
+ * GitHub from gr0mph
+ * https://github.com/gr0mph
+ *	source --> echo task between the ROS latency node and FreeRTOS
+ */
+
+#ifndef FREERTOS_LATENCY_H
+#define FREERTOS_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+portBEGIN_EXPORTED_API
+
+/*
+ * The ROS latency node hands each message it receives to an echo task, which
+ * hands it back for the node to publish.  The node threads are not tasks:
+ * a message goes in through a simulated interrupt (vPortRunAsInterrupt()) into
+ * a message buffer the echo task waits on, and comes out through a second
+ * message buffer, with a host semaphore to wake the node thread.
+ *
+ * Each message starts with its stamps, filled in along the way, all from
+ * CLOCK_MONOTONIC (ullLatencyNowNs()).
+ */
+typedef struct LATENCY_STAMPS
+{
+	uint64_t ullSequence;		/* Set by the node when it publishes the request. */
+	uint64_t ullPublishNs;		/* Request published. */
+	uint64_t ullIngressNs;		/* Request received by the node, before xLatencyIngress(). */
+	uint64_t ullTaskNs;			/* Request received by the echo task. */
+	uint64_t ullEgressNs;		/* Reply out of xLatencyEgress(), before it is published. */
+} LatencyStamps_t;
+
+/* The largest message, stamps included. */
+#define latencyMAX_MESSAGE			8192
+
+/* Tasks of background load, below the echo task, for vLatencySetLoad(). */
+#define latencyMAX_LOAD_TASKS		8
+
+static inline uint64_t ullLatencyNowNs( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+
+/*
+ * pdTRUE once freeRTOS_main() has created the buffers and the tasks.
+ */
+BaseType_t xLatencyReady( void );
+
+/*
+ * Called from a node thread: pass a message of xLength bytes to the echo task.
+ * Returns pdFAIL, and the message is dropped, when the ingress buffer is full.
+ */
+BaseType_t xLatencyIngress( const void *pvMessage, size_t xLength );
+
+/*
+ * Called from one node thread: wait for the next reply of the echo task and
+ * copy it to pvBuffer.  Returns its length.
+ */
+size_t xLatencyEgress( void *pvBuffer, size_t xBufferLength );
+
+/*
+ * Keep uxTasks tasks of background load busy (at most latencyMAX_LOAD_TASKS).
+ * They spin at a priority below the echo task and yield to each other now and
+ * then, so the echo task preempts a running task and the tasks switch among
+ * themselves as they would under real work.
+ */
+void vLatencySetLoad( UBaseType_t uxTasks );
+
+/*
+ * Replies the echo task dropped because the egress buffer was full.
+ */
+uint32_t ulLatencyDroppedReplies( void );
+
+portEND_EXPORTED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREERTOS_LATENCY_H */
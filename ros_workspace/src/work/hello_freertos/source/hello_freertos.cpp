@@ -8,6 +8,11 @@
 #include <port.h>
 #include <pthread.h>
 
+// FreeRTOS snapshot of the state of the hello tasks
+#include <FreeRTOS.h>
+#include <snapshot.h>
+#include <freertos_hello.h>
+
 unsigned char g_sync;
 
 void *startRTOS(void *arguments){
@@ -20,11 +25,31 @@ void *tickRTOS(void *arguments){
   //ros::Rate loop_rate(200);
   ros::Rate loop_rate(20);
 
+  HelloState_t state;
+  SnapshotHandle_t snapshot;
+  uint32_t version, last_version = 0;
+
   while ( ros::ok() )
   {
 
     vPortSysTickHandler(0);
 
+    // Read the state the tasks published, without blocking them
+    snapshot = __atomic_load_n(&xHelloStateSnapshot, __ATOMIC_ACQUIRE);
+    if ( snapshot != NULL )
+    {
+      version = ulSnapshotRead(snapshot, &state, NULL);
+
+      if ( version != last_version )
+      {
+        last_version = version;
+        ROS_INFO_STREAM_THROTTLE(1.0, "FreeRTOS state " << version
+          << ": first=" << state.ulFirstCount
+          << " second=" << state.ulSecondCount
+          << " tick=" << state.ullTick);
+      }
+    }
+
     //ROS_INFO_STREAM("Tick!");
 
     ros::spinOnce();
@@ -0,0 +1,396 @@
+/*
+* GitHub from gr0mph
+* https://github.com/gr0mph
+*	portable --> latency from ROS to a FreeRTOS task and back
+ */
+// Include the ROS C++ APIs
+#include <ros/ros.h>
+#include <std_msgs/UInt8MultiArray.h>
+#include <port.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// FreeRTOS echo task, see freertos_ros/source/freertos_latency.c
+#include <FreeRTOS.h>
+#include <freertos_latency.h>
+#if ( configPORT_TRACE == 1 )
+#include <port_trace.h>
+#endif
+
+/*
+ * The node publishes requests on latency_ping at a fixed rate and subscribes
+ * to them itself.  The subscriber callback stamps each request and hands it
+ * to the FreeRTOS echo task, a thread of the node takes the reply back and
+ * publishes it on latency_pong, and the pong subscriber sums up the stamps.
+ *
+ * For each rate, payload and background load of the private parameters
+ *   ~rates     "100,1000,10000"  requests per second
+ *   ~payloads  "64,1024"         bytes per message, the stamps included
+ *   ~loads     "0,4"             busy FreeRTOS tasks below the echo task
+ *   ~duration  5.0               seconds of requests per run
+ *   ~trace     ""                "record:<file>" or "replay:<file>", with the
+ *                                kernel built with configPORT_TRACE=1
+ * the node reports the latency histograms of
+ *   rtt      publish of the request to the reply received
+ *   ingress  request callback to the echo task running
+ *   echo     echo task to the reply taken back by the node
+ *   egress   reply taken back to the reply received
+ * in the log and as one line on stdout per run:
+ *   bench=ros_latency rate=... payload=... load=... sent=... received=...
+ *   dropped=... rtt_p50_us=... rtt_p99_us=... rtt_max_us=... ...
+ *   rtt_hist_us=<bound>:<count>,...
+ * then shuts down.
+ */
+
+namespace
+{
+
+// Upper bounds of the histogram buckets, in microseconds; the last one takes
+// the rest.
+const uint64_t kBucketsUs[] = { 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000 };
+const size_t kBuckets = sizeof( kBucketsUs ) / sizeof( kBucketsUs[ 0 ] ) + 1;
+
+struct Samples
+{
+  std::vector<uint64_t> rtt, ingress, echo, egress;
+
+  void clear()
+  {
+    rtt.clear();
+    ingress.clear();
+    echo.clear();
+    egress.clear();
+  }
+};
+
+std::mutex g_mutex;
+Samples g_samples;
+uint64_t g_first_sequence = 0;
+unsigned long g_dropped_ingress = 0;
+
+ros::Publisher g_ping_pub;
+ros::Publisher g_pong_pub;
+
+std::vector<long> parseList(const std::string &text)
+{
+  std::vector<long> values;
+  std::stringstream stream(text);
+  std::string item;
+
+  while ( std::getline(stream, item, ',') )
+  {
+    if ( !item.empty() )
+      values.push_back(std::stol(item));
+  }
+
+  return values;
+}
+
+double percentileUs(std::vector<uint64_t> &samples, double fraction)
+{
+  if ( samples.empty() )
+    return 0.0;
+
+  size_t rank = (size_t)(fraction * samples.size() + 0.999999);
+  rank = std::min(std::max(rank, (size_t)1), samples.size());
+  return samples[rank - 1] / 1000.0;
+}
+
+std::string summary(const char *name, std::vector<uint64_t> &samples)
+{
+  char text[160];
+
+  std::sort(samples.begin(), samples.end());
+  snprintf(text, sizeof(text), " %s_p50_us=%.1f %s_p90_us=%.1f %s_p99_us=%.1f %s_max_us=%.1f",
+           name, percentileUs(samples, 0.5),
+           name, percentileUs(samples, 0.9),
+           name, percentileUs(samples, 0.99),
+           name, samples.empty() ? 0.0 : samples.back() / 1000.0);
+  return text;
+}
+
+std::string histogram(const std::vector<uint64_t> &samples)
+{
+  size_t counts[kBuckets] = { 0 };
+  std::stringstream text;
+
+  for ( uint64_t ns : samples )
+  {
+    size_t bucket = 0;
+    while ( bucket < kBuckets - 1 && ns > kBucketsUs[bucket] * 1000 )
+      bucket++;
+    counts[bucket]++;
+  }
+
+  for ( size_t bucket = 0; bucket < kBuckets; bucket++ )
+  {
+    if ( bucket != 0 )
+      text << ",";
+    if ( bucket < kBuckets - 1 )
+      text << kBucketsUs[bucket];
+    else
+      text << "inf";
+    text << ":" << counts[bucket];
+  }
+
+  return text.str();
+}
+
+// Request received: stamp it and pass it to the echo task
+void onPing(const std_msgs::UInt8MultiArray::ConstPtr &msg)
+{
+  static std::vector<uint8_t> message;
+
+  if ( msg->data.size() < sizeof(LatencyStamps_t) || msg->data.size() > latencyMAX_MESSAGE )
+    return;
+
+  message.assign(msg->data.begin(), msg->data.end());
+  LatencyStamps_t *stamps = reinterpret_cast<LatencyStamps_t *>(message.data());
+  stamps->ullIngressNs = ullLatencyNowNs();
+
+  if ( xLatencyIngress(message.data(), message.size()) != pdPASS )
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_dropped_ingress++;
+  }
+}
+
+// Reply received: the request has been around the loop
+void onPong(const std_msgs::UInt8MultiArray::ConstPtr &msg)
+{
+  const uint64_t now = ullLatencyNowNs();
+  LatencyStamps_t stamps;
+
+  if ( msg->data.size() < sizeof(LatencyStamps_t) )
+    return;
+
+  memcpy(&stamps, msg->data.data(), sizeof(stamps));
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+
+  // A late reply of the previous run
+  if ( stamps.ullSequence < g_first_sequence )
+    return;
+
+  g_samples.rtt.push_back(now - stamps.ullPublishNs);
+  g_samples.ingress.push_back(stamps.ullTaskNs - stamps.ullIngressNs);
+  g_samples.echo.push_back(stamps.ullEgressNs - stamps.ullTaskNs);
+  g_samples.egress.push_back(now - stamps.ullEgressNs);
+}
+
+// Takes the replies of the echo task back and publishes them
+void egressThread()
+{
+  std::vector<uint8_t> buffer(latencyMAX_MESSAGE);
+
+  while ( ros::ok() )
+  {
+    size_t length = xLatencyEgress(buffer.data(), buffer.size());
+    if ( length < sizeof(LatencyStamps_t) )
+      continue;
+
+    reinterpret_cast<LatencyStamps_t *>(buffer.data())->ullEgressNs = ullLatencyNowNs();
+
+    std_msgs::UInt8MultiArray reply;
+    reply.data.assign(buffer.begin(), buffer.begin() + length);
+    g_pong_pub.publish(reply);
+  }
+}
+
+// Plays the tick interrupt, at the tick rate of the kernel of the node
+void tickThread()
+{
+  struct timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+
+  while ( ros::ok() )
+  {
+    next.tv_nsec += 1000000000L / configTICK_RATE_HZ;
+    while ( next.tv_nsec >= 1000000000L )
+    {
+      next.tv_nsec -= 1000000000L;
+      next.tv_sec++;
+    }
+
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    vPortSysTickHandler(0);
+  }
+}
+
+// One run: requests at rate for duration seconds, then the report
+void run(long rate, long payload, long load, double duration, uint64_t &sequence)
+{
+  std_msgs::UInt8MultiArray request;
+  request.data.assign(payload, 0x5a);
+
+  vLatencySetLoad(load);
+
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_samples.clear();
+    g_first_sequence = sequence;
+    g_dropped_ingress = 0;
+  }
+  const uint32_t dropped_replies = ulLatencyDroppedReplies();
+
+  const long period_ns = 1000000000L / rate;
+  const unsigned long count = (unsigned long)(duration * rate);
+  struct timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+
+  for ( unsigned long sent = 0; sent < count && ros::ok(); sent++ )
+  {
+    next.tv_nsec += period_ns;
+    while ( next.tv_nsec >= 1000000000L )
+    {
+      next.tv_nsec -= 1000000000L;
+      next.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+    LatencyStamps_t *stamps = reinterpret_cast<LatencyStamps_t *>(request.data.data());
+    memset(stamps, 0, sizeof(*stamps));
+    stamps->ullSequence = sequence++;
+    stamps->ullPublishNs = ullLatencyNowNs();
+    g_ping_pub.publish(request);
+  }
+
+  // Let the last replies come back
+  ros::Duration(0.5).sleep();
+
+  Samples samples;
+  unsigned long dropped_ingress;
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    samples = g_samples;
+    dropped_ingress = g_dropped_ingress;
+    g_first_sequence = sequence;
+  }
+
+  std::string line = "bench=ros_latency rate=" + std::to_string(rate)
+    + " payload=" + std::to_string(payload)
+    + " load=" + std::to_string(load)
+    + " sent=" + std::to_string(count)
+    + " received=" + std::to_string(samples.rtt.size())
+    + " dropped=" + std::to_string(dropped_ingress + (ulLatencyDroppedReplies() - dropped_replies))
+    + summary("rtt", samples.rtt)
+    + summary("ingress", samples.ingress)
+    + summary("echo", samples.echo)
+    + summary("egress", samples.egress)
+    + " rtt_hist_us=" + histogram(samples.rtt);
+
+  printf("%s\n", line.c_str());
+  fflush(stdout);
+  ROS_INFO_STREAM(line);
+}
+
+void benchThread(ros::NodeHandle private_nh)
+{
+  std::string rates, payloads, loads;
+  double duration;
+
+  private_nh.param<std::string>("rates", rates, "100,1000,10000");
+  private_nh.param<std::string>("payloads", payloads, "64,1024");
+  private_nh.param<std::string>("loads", loads, "0,4");
+  private_nh.param("duration", duration, 5.0);
+
+  while ( xLatencyReady() == pdFALSE )
+    ros::Duration(0.01).sleep();
+
+  std::thread(egressThread).detach();
+
+  // Let the subscribers connect
+  ros::Duration(1.0).sleep();
+
+  uint64_t sequence = 1;
+
+  for ( long load : parseList(loads) )
+  {
+    for ( long payload : parseList(payloads) )
+    {
+      for ( long rate : parseList(rates) )
+      {
+        if ( rate <= 0 || payload < (long)sizeof(LatencyStamps_t) || payload > latencyMAX_MESSAGE )
+        {
+          ROS_WARN_STREAM("Skipped rate=" << rate << " payload=" << payload
+            << ": the payload takes " << sizeof(LatencyStamps_t) << " to " << latencyMAX_MESSAGE << " bytes");
+          continue;
+        }
+
+        run(rate, payload, load, duration, sequence);
+      }
+    }
+  }
+
+#if ( configPORT_TRACE == 1 )
+  PortTraceStats_t stats;
+  vPortGetTraceStats(&stats);
+  ROS_INFO_STREAM("Trace: " << stats.ulRecords << " records, " << stats.ulDroppedRecords << " dropped, "
+    << stats.ulReplayedInputs << " inputs and " << stats.ulCheckedDecisions << " decisions replayed, "
+    << stats.ulDivergences << " divergence at record " << stats.ulDivergedRecord);
+#endif
+
+  // Writes the trace of a recording
+  ros::shutdown();
+  exit(0);
+}
+
+// Records or replays the scheduling from the start of the kernel
+void startTrace(ros::NodeHandle &private_nh)
+{
+  std::string trace;
+  private_nh.param<std::string>("trace", trace, "");
+
+  if ( trace.empty() )
+    return;
+
+#if ( configPORT_TRACE == 1 )
+  const size_t colon = trace.find(':');
+  const std::string mode = trace.substr(0, colon);
+  const std::string path = (colon == std::string::npos) ? "" : trace.substr(colon + 1);
+
+  if ( (mode != "record" && mode != "replay") || path.empty() )
+    ROS_WARN_STREAM("Ignored trace " << trace << ": record:<file> or replay:<file>");
+  else if ( xPortTraceStart(mode == "record" ? ePortTraceRecord : ePortTraceReplay, path.c_str()) != pdPASS )
+    ROS_WARN_STREAM("Cannot " << mode << " the trace " << path);
+#else
+  ROS_WARN_STREAM("Ignored trace " << trace << ": the kernel is built without configPORT_TRACE");
+#endif
+}
+
+}
+
+// Standard C++ entry point
+int main(int argc, char** argv) {
+  ros::init(argc, argv, "latency_freertos_node");
+  ros::NodeHandle nh;
+  ros::NodeHandle private_nh("~");
+
+  g_ping_pub = nh.advertise<std_msgs::UInt8MultiArray>("latency_ping", 1000);
+  g_pong_pub = nh.advertise<std_msgs::UInt8MultiArray>("latency_pong", 1000);
+  ros::Subscriber ping_sub = nh.subscribe("latency_ping", 1000, onPing, ros::TransportHints().tcpNoDelay());
+  ros::Subscriber pong_sub = nh.subscribe("latency_pong", 1000, onPong, ros::TransportHints().tcpNoDelay());
+
+  // One thread for each subscriber, so a ping waits for no pong
+  ros::AsyncSpinner spinner(2);
+  spinner.start();
+
+  startTrace(private_nh);
+
+  std::thread(tickThread).detach();
+  std::thread(benchThread, private_nh).detach();
+
+  // Returns only if freeRTOS_main() failed, benchThread ends the process
+  vStartFreeRTOS();
+
+  ROS_ERROR_STREAM("FreeRTOS did not start: the latency buffers or tasks could not be created");
+  ros::shutdown();
+  return 1;
+}